@@ -0,0 +1,188 @@
+#include "AllocTracker.h"
+
+#ifdef ALLOC_TRACKING_ENABLED
+#include <algorithm>
+#include <assert.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+const size_t kTagCount = static_cast<size_t>(AllocTag::kCount);
+
+// 分類ごとの数（operator new から最初に呼ばれても使えるよう、定数で初期化される置き方にする）
+struct Counters {
+	std::atomic<uint64_t> frameAllocations{0};
+	std::atomic<uint64_t> frameBytes{0};
+	std::atomic<uint64_t> framePeakBytes{0};
+	std::atomic<uint64_t> liveBytes{0};
+	std::atomic<uint64_t> peakBytes{0};
+	std::atomic<uint64_t> totalAllocations{0};
+};
+constinit Counters counters[kTagCount];
+// EndFrame で写した前のフレームの数（メインスレッドだけが触る）
+constinit AllocTracker::TagStats lastFrame[kTagCount];
+
+constinit std::atomic<bool> breakOnSteadyState{true};
+constinit std::atomic<uint64_t> steadyStateViolations{0};
+
+thread_local AllocTag currentTag = AllocTag::kUntagged;
+thread_local int steadyStateDepth = 0;
+thread_local bool reporting = false;
+
+void UpdateMax(std::atomic<uint64_t>& target, uint64_t value) {
+	uint64_t current = target.load(std::memory_order_relaxed);
+	while (current < value && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+	}
+}
+
+// 確保した領域の直前に置く
+struct Header {
+	void* base;  // malloc が返した先頭
+	size_t size; // 要求された大きさ
+	AllocTag tag;
+};
+
+void* TrackedAllocate(size_t size, size_t alignment) {
+	alignment = std::max(alignment, alignof(std::max_align_t));
+	void* base = std::malloc(size + sizeof(Header) + alignment);
+	if (!base) {
+		return nullptr;
+	}
+	const uintptr_t address = (reinterpret_cast<uintptr_t>(base) + sizeof(Header) + alignment - 1) & ~(alignment - 1);
+	Header* header = reinterpret_cast<Header*>(address) - 1;
+	header->base = base;
+	header->size = size;
+	header->tag = currentTag;
+	AllocTracker::OnAllocate(header->tag, size);
+	// 計測用のバッファ（Profiler / Tracer がスレッドを初めて見たときなど）は見逃す
+	if (steadyStateDepth > 0 && !reporting && header->tag != AllocTag::kProfiler) {
+		// assert の中で確保されても入り直さないようにする
+		reporting = true;
+		AllocTracker::OnSteadyStateAllocation(size);
+		reporting = false;
+	}
+	return reinterpret_cast<void*>(address);
+}
+
+void TrackedFree(void* p) {
+	if (!p) {
+		return;
+	}
+	const Header* header = static_cast<Header*>(p) - 1;
+	AllocTracker::OnFree(header->tag, header->size);
+	std::free(header->base);
+}
+
+void* AllocateOrThrow(size_t size, size_t alignment) {
+	void* p = TrackedAllocate(size, alignment);
+	if (!p) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+} // namespace
+
+// グローバルの確保と解放の差し替え（配列・nothrow・境界指定・サイズ付きの形もすべて同じところを通す）
+void* operator new(size_t size) { return AllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new[](size_t size) { return AllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return TrackedAllocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return TrackedAllocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new(size_t size, std::align_val_t alignment) { return AllocateOrThrow(size, static_cast<size_t>(alignment)); }
+void* operator new[](size_t size, std::align_val_t alignment) { return AllocateOrThrow(size, static_cast<size_t>(alignment)); }
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return TrackedAllocate(size, static_cast<size_t>(alignment)); }
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return TrackedAllocate(size, static_cast<size_t>(alignment)); }
+void operator delete(void* p) noexcept { TrackedFree(p); }
+void operator delete[](void* p) noexcept { TrackedFree(p); }
+void operator delete(void* p, size_t) noexcept { TrackedFree(p); }
+void operator delete[](void* p, size_t) noexcept { TrackedFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { TrackedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { TrackedFree(p); }
+void operator delete(void* p, std::align_val_t) noexcept { TrackedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { TrackedFree(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { TrackedFree(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { TrackedFree(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { TrackedFree(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { TrackedFree(p); }
+
+void AllocTracker::OnAllocate(AllocTag tag, size_t size) {
+	Counters& counter = counters[static_cast<size_t>(tag)];
+	counter.frameAllocations.fetch_add(1, std::memory_order_relaxed);
+	counter.frameBytes.fetch_add(size, std::memory_order_relaxed);
+	counter.totalAllocations.fetch_add(1, std::memory_order_relaxed);
+	const uint64_t live = counter.liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+	UpdateMax(counter.framePeakBytes, live);
+	UpdateMax(counter.peakBytes, live);
+}
+
+void AllocTracker::OnFree(AllocTag tag, size_t size) { counters[static_cast<size_t>(tag)].liveBytes.fetch_sub(size, std::memory_order_relaxed); }
+
+void AllocTracker::OnSteadyStateAllocation(size_t size) {
+	steadyStateViolations.fetch_add(1, std::memory_order_relaxed);
+	if (breakOnSteadyState.load(std::memory_order_relaxed)) {
+		// 定常状態（GameScene::Update の kPlay など）で確保された。呼び出し履歴をたどって確保している所を直す
+		(void)size;
+		assert(!"allocation in steady state");
+	}
+}
+
+void AllocTracker::EndFrame() {
+	for (size_t i = 0; i < kTagCount; ++i) {
+		Counters& counter = counters[i];
+		TagStats& stats = lastFrame[i];
+		stats.frameAllocations = counter.frameAllocations.exchange(0, std::memory_order_relaxed);
+		stats.frameBytes = counter.frameBytes.exchange(0, std::memory_order_relaxed);
+		stats.liveBytes = counter.liveBytes.load(std::memory_order_relaxed);
+		stats.framePeakBytes = counter.framePeakBytes.exchange(stats.liveBytes, std::memory_order_relaxed);
+		stats.peakBytes = counter.peakBytes.load(std::memory_order_relaxed);
+		stats.totalAllocations = counter.totalAllocations.load(std::memory_order_relaxed);
+	}
+}
+
+AllocTracker::TagStats AllocTracker::GetStats(AllocTag tag) { return lastFrame[static_cast<size_t>(tag)]; }
+
+void AllocTracker::SetBreakOnSteadyStateAllocation(bool enable) { breakOnSteadyState.store(enable, std::memory_order_relaxed); }
+uint64_t AllocTracker::GetSteadyStateViolationCount() { return steadyStateViolations.load(std::memory_order_relaxed); }
+
+AllocTag AllocTracker::GetCurrentTag() { return currentTag; }
+void AllocTracker::SetCurrentTag(AllocTag tag) { currentTag = tag; }
+void AllocTracker::EnterSteadyState() { ++steadyStateDepth; }
+void AllocTracker::LeaveSteadyState() { --steadyStateDepth; }
+bool AllocTracker::IsInSteadyState() { return steadyStateDepth > 0; }
+
+#else
+
+// 数えないビルドでは何も記録しない
+void AllocTracker::EndFrame() {}
+AllocTracker::TagStats AllocTracker::GetStats(AllocTag) { return {}; }
+void AllocTracker::SetBreakOnSteadyStateAllocation(bool) {}
+uint64_t AllocTracker::GetSteadyStateViolationCount() { return 0; }
+void AllocTracker::OnAllocate(AllocTag, size_t) {}
+void AllocTracker::OnFree(AllocTag, size_t) {}
+void AllocTracker::OnSteadyStateAllocation(size_t) {}
+AllocTag AllocTracker::GetCurrentTag() { return AllocTag::kUntagged; }
+void AllocTracker::SetCurrentTag(AllocTag) {}
+void AllocTracker::EnterSteadyState() {}
+void AllocTracker::LeaveSteadyState() {}
+bool AllocTracker::IsInSteadyState() { return false; }
+
+#endif
+
+const char* AllocTracker::GetTagName(AllocTag tag) {
+	switch (tag) {
+	case AllocTag::kUntagged:
+		return "untagged";
+	case AllocTag::kScene:
+		return "scene";
+	case AllocTag::kAssets:
+		return "assets";
+	case AllocTag::kParticles:
+		return "particles";
+	case AllocTag::kProfiler:
+		return "profiler";
+	default:
+		return "?";
+	}
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// _DEBUG のビルドだけ有効（ほかのビルドでも使うときは ALLOC_TRACKING_ENABLED を定義する）
+#if !defined(ALLOC_TRACKING_ENABLED) && defined(_DEBUG)
+#define ALLOC_TRACKING_ENABLED
+#endif
+
+// 確保の分類（確保した時点でそのスレッドに設定されているもの）
+enum class AllocTag : uint8_t {
+	kUntagged,  // 分類なし（エンジンなど）
+	kScene,     // SceneArena のブロック
+	kAssets,    // モデル・テクスチャ・サウンドの読み込み
+	kParticles, // パーティクルの配列
+	kProfiler,  // Profiler / Tracer のバッファ
+	kCount,
+};
+
+// メモリ確保の集計
+// グローバルの operator new / delete を差し替えて、確保の前に大きさと分類を書いた小さなヘッダを置く。
+// 分類ごとに確保回数・バイト数（フレームごと）と、使用中のバイト数・その最大を数える。
+// 定常状態の区間（ALLOC_STEADY_STATE_SCOPE）の中で確保があれば、その場で assert で止める（呼び出し履歴で原因が分かる）。
+// ALLOC_TRACKING_ENABLED でないビルドでは差し替えず、マクロは空になる。
+class AllocTracker {
+public:
+	struct TagStats {
+		uint64_t frameAllocations = 0; // 前のフレームで確保した回数
+		uint64_t frameBytes = 0;       // 前のフレームで確保したバイト数
+		uint64_t framePeakBytes = 0;   // 前のフレームの使用中バイト数の最大
+		uint64_t liveBytes = 0;        // 使用中のバイト数
+		uint64_t peakBytes = 0;        // 使用中のバイト数の最大（起動から）
+		uint64_t totalAllocations = 0; // 確保した回数（起動から）
+	};
+
+	static const char* GetTagName(AllocTag tag);
+
+	// メインスレッドで毎フレーム最後に呼ぶ（Profiler::EndFrame から呼ばれる）
+	static void EndFrame();
+	static TagStats GetStats(AllocTag tag);
+
+	// 定常状態の区間で確保されたら assert で止めるか（既定は止める。止めずに数えるだけにもできる）
+	static void SetBreakOnSteadyStateAllocation(bool enable);
+	// 定常状態の区間で確保された回数
+	static uint64_t GetSteadyStateViolationCount();
+
+	// 確保と解放で呼ばれる
+	static void OnAllocate(AllocTag tag, size_t size);
+	static void OnFree(AllocTag tag, size_t size);
+	static void OnSteadyStateAllocation(size_t size);
+
+	// 呼んだスレッドの今の分類
+	static AllocTag GetCurrentTag();
+	static void SetCurrentTag(AllocTag tag);
+	// 呼んだスレッドが定常状態の区間にいる深さ（JobSystem は積んだときの状態をジョブに持たせて、実行するスレッドで入り直す）
+	static void EnterSteadyState();
+	static void LeaveSteadyState();
+	static bool IsInSteadyState();
+};
+
+// スコープの間、呼んだスレッドの確保を tag に数える
+class AllocTagScope {
+public:
+#ifdef ALLOC_TRACKING_ENABLED
+	explicit AllocTagScope(AllocTag tag) : previous_(AllocTracker::GetCurrentTag()) { AllocTracker::SetCurrentTag(tag); }
+	~AllocTagScope() { AllocTracker::SetCurrentTag(previous_); }
+#else
+	explicit AllocTagScope(AllocTag) {}
+#endif
+	AllocTagScope(const AllocTagScope&) = delete;
+	AllocTagScope& operator=(const AllocTagScope&) = delete;
+
+private:
+#ifdef ALLOC_TRACKING_ENABLED
+	AllocTag previous_;
+#endif
+};
+
+// 確保をいつも Tag に数える std のアロケータ（コンテナの型に分類を持たせる）
+template<typename T, AllocTag Tag> class TaggedAllocator {
+public:
+	using value_type = T;
+	template<typename U> struct rebind {
+		using other = TaggedAllocator<U, Tag>;
+	};
+
+	TaggedAllocator() = default;
+	template<typename U> TaggedAllocator(const TaggedAllocator<U, Tag>&) {}
+
+	T* allocate(size_t n) {
+		AllocTagScope scope(Tag);
+		return std::allocator<T>().allocate(n);
+	}
+	void deallocate(T* p, size_t n) { std::allocator<T>().deallocate(p, n); }
+
+	template<typename U> bool operator==(const TaggedAllocator<U, Tag>&) const { return true; }
+};
+
+#ifdef ALLOC_TRACKING_ENABLED
+// スコープの間、呼んだスレッドと、そこで積んだジョブ（JobSystem がどのスレッドで実行しても）で確保したら止める
+class SteadyStateScope {
+public:
+	SteadyStateScope() { AllocTracker::EnterSteadyState(); }
+	~SteadyStateScope() { AllocTracker::LeaveSteadyState(); }
+	SteadyStateScope(const SteadyStateScope&) = delete;
+	SteadyStateScope& operator=(const SteadyStateScope&) = delete;
+};
+
+#define ALLOC_CONCAT_INNER(a, b) a##b
+#define ALLOC_CONCAT(a, b) ALLOC_CONCAT_INNER(a, b)
+#define ALLOC_TAG_SCOPE(tag) AllocTagScope ALLOC_CONCAT(allocTagScope, __LINE__)(tag)
+#define ALLOC_STEADY_STATE_SCOPE() SteadyStateScope ALLOC_CONCAT(steadyStateScope, __LINE__)
+#else
+#define ALLOC_TAG_SCOPE(tag) ((void)0)
+#define ALLOC_STEADY_STATE_SCOPE() ((void)0)
+#endif
@@ -0,0 +1,142 @@
+#include "AssetCache.h"
+#include "AllocTracker.h"
+#include <assert.h>
+#include <filesystem>
+
+using namespace KamataEngine;
+
+namespace {
+// エンジンがテクスチャを読むディレクトリ
+const std::filesystem::path kTextureDirectory = "Resources";
+} // namespace
+
+AssetCache* AssetCache::GetInstance() {
+	static AssetCache instance;
+	return &instance;
+}
+
+CachedModel* AssetCache::AcquireModel(const std::string& name, bool smoothing) {
+	ALLOC_TAG_SCOPE(AllocTag::kAssets);
+	ModelEntry& entry = models_[name];
+	if (!entry.model) {
+		entry.model = CachedModel::CreateFromOBJ(name, smoothing);
+	}
+	++entry.refCount;
+	return entry.model;
+}
+
+CachedModel* AssetCache::AcquireModel(const std::string& name, const CachedModel::Source& source) {
+	ALLOC_TAG_SCOPE(AllocTag::kAssets);
+	ModelEntry& entry = models_[name];
+	if (!entry.model) {
+		entry.model = CachedModel::Create(name, source);
+	}
+	++entry.refCount;
+	return entry.model;
+}
+
+void AssetCache::ReleaseModel(CachedModel* model) {
+	if (!model) {
+		return;
+	}
+	for (auto& [name, entry] : models_) {
+		if (entry.model == model) {
+			assert(entry.refCount > 0);
+			--entry.refCount;
+			return;
+		}
+	}
+	// キャッシュを通さずに作ったモデルを渡された
+	assert(false);
+}
+
+uint32_t AssetCache::AcquireTexture(const std::string& fileName) {
+	ALLOC_TAG_SCOPE(AllocTag::kAssets);
+	auto it = textures_.find(fileName);
+	if (it == textures_.end()) {
+		it = textures_.emplace(fileName, HandleEntry{TextureManager::Load(ResolveTextureFile(fileName)), 0}).first;
+	}
+	++it->second.refCount;
+	return it->second.handle;
+}
+
+void AssetCache::ReleaseTexture(uint32_t textureHandle) {
+	for (auto& [name, entry] : textures_) {
+		if (entry.handle == textureHandle) {
+			assert(entry.refCount > 0);
+			--entry.refCount;
+			return;
+		}
+	}
+	assert(false);
+}
+
+std::string AssetCache::ResolveTextureFile(const std::string& fileName) {
+	std::filesystem::path ddsName = fileName;
+	ddsName.replace_extension(".dds");
+	std::error_code error;
+	const std::filesystem::file_time_type ddsTime = std::filesystem::last_write_time(kTextureDirectory / ddsName, error);
+	if (error) {
+		return fileName;
+	}
+	// 画像を描き直したのに変換し忘れていたら古い .dds は使わない
+	const std::filesystem::file_time_type sourceTime = std::filesystem::last_write_time(kTextureDirectory / fileName, error);
+	if (!error && sourceTime > ddsTime) {
+		return fileName;
+	}
+	return ddsName.generic_string();
+}
+
+uint32_t AssetCache::AcquireSound(const std::string& fileName) {
+	ALLOC_TAG_SCOPE(AllocTag::kAssets);
+	auto it = sounds_.find(fileName);
+	if (it == sounds_.end()) {
+		it = sounds_.emplace(fileName, HandleEntry{Audio::GetInstance()->LoadWave(fileName), 0}).first;
+	}
+	++it->second.refCount;
+	return it->second.handle;
+}
+
+void AssetCache::ReleaseSound(uint32_t soundHandle) {
+	for (auto& [name, entry] : sounds_) {
+		if (entry.handle == soundHandle) {
+			assert(entry.refCount > 0);
+			--entry.refCount;
+			return;
+		}
+	}
+	assert(false);
+}
+
+void AssetCache::EvictUnused() {
+	for (auto it = models_.begin(); it != models_.end();) {
+		if (it->second.refCount == 0) {
+			delete it->second.model;
+			it = models_.erase(it);
+		} else {
+			++it;
+		}
+	}
+	for (auto it = textures_.begin(); it != textures_.end();) {
+		if (it->second.refCount == 0) {
+			TextureManager::Unload(it->second.handle);
+			it = textures_.erase(it);
+		} else {
+			++it;
+		}
+	}
+	// Audio にはハンドル単位の解放がなく、読み直すとデータ枠を余計に使うだけなので、
+	// サウンドは参照数が 0 でも残しておく（Audio::Finalize でまとめて解放される）
+}
+
+void AssetCache::Clear() {
+	for (auto& [name, entry] : models_) {
+		delete entry.model;
+	}
+	models_.clear();
+	for (auto& [name, entry] : textures_) {
+		TextureManager::Unload(entry.handle);
+	}
+	textures_.clear();
+	sounds_.clear();
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include "CachedModel.h"
+#include "KamataEngine.h"
+#include <string>
+#include <unordered_map>
+
+using namespace KamataEngine;
+
+// シーンをまたいで使い回すアセットの置き場
+// モデル・テクスチャ・サウンドを名前で引き、一度読んだものは使い回す。
+// Acquire で参照数が増え、Release で減る。参照数が 0 になっても残しておき、
+// EvictUnused を呼んだときに初めて破棄する（リトライ時に読み直さないため）。
+class AssetCache {
+public:
+	static AssetCache* GetInstance();
+
+	// モデルを取得（なければ CachedModel::CreateFromOBJ で読む）
+	CachedModel* AcquireModel(const std::string& name, bool smoothing = true);
+	// ワーカースレッドで CachedModel::LoadSource を済ませたものから取得（すでにあれば source は使わない）
+	CachedModel* AcquireModel(const std::string& name, const CachedModel::Source& source);
+	void ReleaseModel(CachedModel* model);
+
+	// テクスチャを取得（なければ TextureManager::Load で読む）
+	// fileName は png の名前のままでよく、変換済みの .dds があればそちらを読む
+	uint32_t AcquireTexture(const std::string& fileName);
+	void ReleaseTexture(uint32_t textureHandle);
+	// Tools/TextureBaker が書いた .dds が Resources にあり、元の画像より古くなければその名前を、なければ fileName をそのまま返す
+	static std::string ResolveTextureFile(const std::string& fileName);
+
+	// サウンドを取得（なければ Audio::LoadWave で読む）
+	uint32_t AcquireSound(const std::string& fileName);
+	void ReleaseSound(uint32_t soundHandle);
+
+	// 参照数が 0 のものを破棄する
+	void EvictUnused();
+	// すべて破棄する（KamataEngine::Finalize の前に呼ぶ）
+	void Clear();
+
+	// 保持している数
+	size_t GetModelCount() const { return models_.size(); }
+	size_t GetTextureCount() const { return textures_.size(); }
+	size_t GetSoundCount() const { return sounds_.size(); }
+
+private:
+	AssetCache() = default;
+	~AssetCache() = default;
+	AssetCache(const AssetCache&) = delete;
+	AssetCache& operator=(const AssetCache&) = delete;
+
+	struct ModelEntry {
+		CachedModel* model = nullptr;
+		uint32_t refCount = 0;
+	};
+	struct HandleEntry {
+		uint32_t handle = 0;
+		uint32_t refCount = 0;
+	};
+
+	// 名前 → 実体
+	std::unordered_map<std::string, ModelEntry> models_;
+	std::unordered_map<std::string, HandleEntry> textures_;
+	std::unordered_map<std::string, HandleEntry> sounds_;
+};
@@ -0,0 +1,173 @@
+#include "AssetLoader.h"
+#include "AllocTracker.h"
+#include "AssetCache.h"
+#include "Profiler.h"
+#include "Trace.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+using namespace KamataEngine;
+
+namespace {
+// エンジンが読み込みに使うディレクトリ
+const std::filesystem::path kResourceDirectory = "Resources";
+// AssetCache::AcquireModel の既定と同じ
+const bool kModelSmoothing = true;
+
+// ファイルを最後まで読んで捨てる
+void ReadWholeFile(const std::filesystem::path& path) {
+	std::ifstream file(path, std::ios::binary);
+	char buffer[64 * 1024];
+	while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0) {
+	}
+}
+} // namespace
+
+AssetLoader* AssetLoader::GetInstance() {
+	static AssetLoader instance;
+	return &instance;
+}
+
+void AssetLoader::Initialize(uint32_t workerCount) {
+	stop_ = false;
+	workers_.reserve(workerCount);
+	for (uint32_t i = 0; i < workerCount; ++i) {
+		workers_.emplace_back(&AssetLoader::WorkerMain, this);
+	}
+}
+
+void AssetLoader::Finalize() {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stop_ = true;
+		fileQueue_.clear();
+	}
+	condition_.notify_all();
+	for (std::thread& worker : workers_) {
+		worker.join();
+	}
+	workers_.clear();
+	jobs_.clear();
+	createCursor_ = 0;
+}
+
+AssetLoader::Handle AssetLoader::Request(Kind kind, const std::string& name) {
+	ALLOC_TAG_SCOPE(AllocTag::kAssets);
+	// 同じものを要求済みならそのハンドルを返す（シーンを往復しても要求が増え続けないように）
+	for (size_t i = 0; i < jobs_.size(); ++i) {
+		if (jobs_[i]->kind == kind && jobs_[i]->name == name) {
+			return static_cast<Handle>(i);
+		}
+	}
+
+	auto job = std::make_unique<Job>();
+	job->kind = kind;
+	job->name = name;
+	Job* raw = job.get();
+	jobs_.push_back(std::move(job));
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		fileQueue_.push_back(raw);
+	}
+	condition_.notify_one();
+	return static_cast<Handle>(jobs_.size() - 1);
+}
+
+void AssetLoader::Update(double budgetSeconds) {
+	PROFILE_SCOPE("AssetLoader::Update");
+	using Clock = std::chrono::steady_clock;
+	const Clock::time_point start = Clock::now();
+
+	// 要求順に生成する。先頭がまだワーカーで処理中ならこのフレームは終わり
+	while (createCursor_ < jobs_.size()) {
+		Job& job = *jobs_[createCursor_];
+		if (job.state.load(std::memory_order_acquire) != State::kPrepared) {
+			break;
+		}
+		Create(job);
+		job.state.store(State::kReady, std::memory_order_release);
+		++createCursor_;
+
+		// 1件ごとに時間を見て、予算を使い切ったら次のフレームへ
+		if (std::chrono::duration<double>(Clock::now() - start).count() >= budgetSeconds) {
+			break;
+		}
+	}
+}
+
+bool AssetLoader::HasPrepared() const { return createCursor_ < jobs_.size() && jobs_[createCursor_]->state.load(std::memory_order_acquire) == State::kPrepared; }
+
+bool AssetLoader::IsReady(Handle handle) const { return handle < jobs_.size() && jobs_[handle]->state.load(std::memory_order_acquire) == State::kReady; }
+
+bool AssetLoader::IsAllReady() const { return createCursor_ == jobs_.size(); }
+
+float AssetLoader::GetProgress() const {
+	if (jobs_.empty()) {
+		return 1.0f;
+	}
+	return static_cast<float>(createCursor_) / static_cast<float>(jobs_.size());
+}
+
+void AssetLoader::WorkerMain() {
+	TRACE_THREAD_NAME("AssetLoader worker");
+	// このスレッドの確保はすべて読み込みのもの
+	ALLOC_TAG_SCOPE(AllocTag::kAssets);
+	while (true) {
+		Job* job = nullptr;
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			condition_.wait(lock, [this] { return stop_ || !fileQueue_.empty(); });
+			if (stop_) {
+				return;
+			}
+			job = fileQueue_.front();
+			fileQueue_.pop_front();
+		}
+
+		Prepare(*job);
+		job->state.store(State::kPrepared, std::memory_order_release);
+	}
+}
+
+void AssetLoader::Prepare(Job& job) {
+	PROFILE_SCOPE("AssetLoader::Prepare");
+	switch (job.kind) {
+	case Kind::kModel:
+		job.model = std::make_unique<CachedModel::Source>();
+		CachedModel::LoadSource(job.name, *job.model, kModelSmoothing);
+		// マテリアルのテクスチャはメインスレッドで TextureManager が読むので、ファイルだけ読んでおく
+		for (const MeshMaterial& material : job.model->mesh.materials) {
+			if (!material.textureFilename.empty()) {
+				ReadWholeFile(kResourceDirectory / job.name / material.textureFilename);
+			}
+		}
+		break;
+	case Kind::kTexture:
+		// TextureManager が実際に読むほう（変換済みの .dds があればそちら）
+		ReadWholeFile(kResourceDirectory / AssetCache::ResolveTextureFile(job.name));
+		break;
+	case Kind::kSound:
+		ReadWholeFile(kResourceDirectory / job.name);
+		break;
+	}
+}
+
+void AssetLoader::Create(Job& job) {
+	TRACE_SCOPE("AssetLoader::Create");
+	// 参照はすぐ返す。キャッシュには参照数 0 で残るので、使う側の Acquire で即座に取れる
+	AssetCache* assetCache = AssetCache::GetInstance();
+	switch (job.kind) {
+	case Kind::kModel:
+		assetCache->ReleaseModel(assetCache->AcquireModel(job.name, *job.model));
+		job.model.reset();
+		break;
+	case Kind::kTexture:
+		assetCache->ReleaseTexture(assetCache->AcquireTexture(job.name));
+		break;
+	case Kind::kSound:
+		assetCache->ReleaseSound(assetCache->AcquireSound(job.name));
+		break;
+	}
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include "CachedModel.h"
+#include "KamataEngine.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace KamataEngine;
+
+// アセットの先読み
+// モデルはワーカースレッドで CachedModel::LoadSource まで済ませる（.mesh の読み込み、なければ obj の変換・並べ替え・
+// LOD の作成と .mesh の書き出し）。メインスレッドの Update ではマテリアル・テクスチャ・バッファの生成だけを行い、
+// AssetCache に登録する。テクスチャとサウンドはエンジンがファイル名で読み込みと GPU 転送を1回で行うので、
+// ワーカーは読むファイル（テクスチャは変換済みの .dds）を読んで OS のファイルキャッシュに載せておくだけ。
+// メインスレッドの生成は1フレームあたりの時間を決めて少しずつ進める。
+// 登録が終わったアセットは参照数 0 のままキャッシュに残るので、後から Acquire すれば即座に返る。
+class AssetLoader {
+public:
+	enum class Kind {
+		kModel,   // CachedModel（Resources/名前/名前.mesh か obj）
+		kTexture, // TextureManager::Load
+		kSound,   // Audio::LoadWave
+	};
+
+	// 要求ごとのハンドル
+	using Handle = uint32_t;
+
+	static AssetLoader* GetInstance();
+
+	// workerCount: 読み込みと変換に使うスレッド数
+	void Initialize(uint32_t workerCount = 2);
+	void Finalize();
+
+	// 読み込みを要求する（同じものを何度要求してもよく、2回目以降は最初のハンドルを返す）
+	Handle Request(Kind kind, const std::string& name);
+
+	// メインスレッドで毎フレーム呼ぶ。ワーカーの処理が終わったものを budgetSeconds 秒ぶんまで生成する
+	// 生成は TextureManager の転送用コマンドリストやデスクリプタを使うので、描画スレッドが描いていない間に呼ぶ（RenderThread::WaitIdle の後）
+	void Update(double budgetSeconds = 0.004);
+	// Update で生成するものがあるか（ないフレームは描画スレッドを待たずに済ませる）
+	bool HasPrepared() const;
+
+	// 要求したアセットがキャッシュに入ったか
+	bool IsReady(Handle handle) const;
+	// これまでの要求がすべて終わったか
+	bool IsAllReady() const;
+	// 進捗（0〜1）
+	float GetProgress() const;
+
+private:
+	AssetLoader() = default;
+	~AssetLoader() = default;
+	AssetLoader(const AssetLoader&) = delete;
+	AssetLoader& operator=(const AssetLoader&) = delete;
+
+	enum class State {
+		kQueued,   // ワーカーの処理待ち
+		kPrepared, // ワーカーの処理済み（メインスレッドでの生成待ち）
+		kReady,    // キャッシュ登録済み
+	};
+
+	struct Job {
+		Kind kind;
+		std::string name;
+		std::atomic<State> state{State::kQueued};
+		std::unique_ptr<CachedModel::Source> model; // kModel のときワーカーが作る（生成したら捨てる）
+	};
+
+	// ワーカーの処理
+	void WorkerMain();
+	// ワーカースレッドでの処理（モデルは LoadSource、テクスチャとサウンドはファイルを OS のファイルキャッシュに載せる）
+	static void Prepare(Job& job);
+	// メインスレッドで AssetCache に登録する
+	static void Create(Job& job);
+
+	// 要求順に並べたもの（ハンドル＝添字）
+	std::vector<std::unique_ptr<Job>> jobs_;
+	// 次に生成を試みる位置（これより前はすべて kReady）
+	size_t createCursor_ = 0;
+
+	// ワーカーへの受け渡し
+	std::deque<Job*> fileQueue_;
+	std::mutex mutex_;
+	std::condition_variable condition_;
+	std::vector<std::thread> workers_;
+	bool stop_ = false;
+};
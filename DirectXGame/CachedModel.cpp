@@ -0,0 +1,407 @@
+#include "CachedModel.h"
+#include "AssetCache.h"
+#include "MeshCache.h"
+#include "MeshOptimizer.h"
+#include "MeshQuantizer.h"
+#include "MeshSimplifier.h"
+#include "Method.h"
+#include "ObjImporter.h"
+#include <algorithm>
+#include <assert.h>
+#include <cstddef>
+#include <cstring>
+#include <d3dcompiler.h>
+
+#pragma comment(lib, "d3dcompiler.lib")
+
+using namespace KamataEngine;
+
+// float の頂点は Mesh::VertexPosNormalUv と同じ並び（ObjVS が読む）
+static_assert(sizeof(Mesh::VertexPosNormalUv) == sizeof(MeshVertex), "MeshVertex must match Mesh::VertexPosNormalUv");
+
+namespace {
+// エンジンがモデルを読むディレクトリ
+const std::filesystem::path kModelDirectory = "Resources";
+// LOD のずれが画面上でこのピクセル数までなら粗い段を使う
+const float kLodPixelError = 1.0f;
+
+// Resources/shaders のシェーダーをコンパイルする（エンジンと同じく実行時に読む）
+Microsoft::WRL::ComPtr<ID3DBlob> CompileShader(const wchar_t* path, const char* target) {
+#ifdef _DEBUG
+	const UINT flags = D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
+#else
+	const UINT flags = 0;
+#endif
+	Microsoft::WRL::ComPtr<ID3DBlob> blob;
+	Microsoft::WRL::ComPtr<ID3DBlob> error;
+	const HRESULT result = D3DCompileFromFile(path, nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, "main", target, flags, 0, &blob, &error);
+	if (FAILED(result)) {
+		// エラーの内容を出力ウィンドウに出す
+		if (error) {
+			OutputDebugStringA(static_cast<const char*>(error->GetBufferPointer()));
+		}
+		assert(false);
+	}
+	return blob;
+}
+
+// モデルを囲む箱の中心
+Vector3 ComputeCenter(const std::vector<MeshVertex>& vertices) {
+	if (vertices.empty()) {
+		return {};
+	}
+	Vector3 minimum = {vertices[0].pos[0], vertices[0].pos[1], vertices[0].pos[2]};
+	Vector3 maximum = minimum;
+	for (const MeshVertex& vertex : vertices) {
+		minimum = {std::min(minimum.x, vertex.pos[0]), std::min(minimum.y, vertex.pos[1]), std::min(minimum.z, vertex.pos[2])};
+		maximum = {std::max(maximum.x, vertex.pos[0]), std::max(maximum.y, vertex.pos[1]), std::max(maximum.z, vertex.pos[2])};
+	}
+	return (minimum + maximum) * 0.5f;
+}
+} // namespace
+
+Microsoft::WRL::ComPtr<ID3D12RootSignature> CachedModel::sRootSignature_;
+Microsoft::WRL::ComPtr<ID3D12PipelineState> CachedModel::sPipelineStates_[2];
+ID3D12PipelineState* CachedModel::sBoundPipelineState_ = nullptr;
+
+void CachedModel::StaticInitialize() {
+	ID3D12Device* device = DirectXCommon::GetInstance()->GetDevice();
+
+	// ルートシグネチャ（Model::RoomParameter の並びの後ろに、位置の復元範囲のルート定数を足す）
+	CD3DX12_DESCRIPTOR_RANGE textureRange;
+	textureRange.Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0); // t0
+	CD3DX12_ROOT_PARAMETER rootParameters[kQuantizationRootParameter + 1] = {};
+	rootParameters[static_cast<UINT>(Model::RoomParameter::kWorldTransform)].InitAsConstantBufferView(0);
+	rootParameters[static_cast<UINT>(Model::RoomParameter::kCamera)].InitAsConstantBufferView(1);
+	rootParameters[static_cast<UINT>(Model::RoomParameter::kMaterial)].InitAsConstantBufferView(2);
+	rootParameters[static_cast<UINT>(Model::RoomParameter::kTexture)].InitAsDescriptorTable(1, &textureRange);
+	rootParameters[static_cast<UINT>(Model::RoomParameter::kLight)].InitAsConstantBufferView(3);
+	rootParameters[static_cast<UINT>(Model::RoomParameter::kObjectColor)].InitAsConstantBufferView(4);
+	rootParameters[kQuantizationRootParameter].InitAsConstants(sizeof(QuantizationConstants) / sizeof(uint32_t), 5, 0, D3D12_SHADER_VISIBILITY_VERTEX);
+	const CD3DX12_STATIC_SAMPLER_DESC sampler(0, D3D12_FILTER_MIN_MAG_MIP_LINEAR); // s0
+	CD3DX12_ROOT_SIGNATURE_DESC rootSignatureDesc;
+	rootSignatureDesc.Init(_countof(rootParameters), rootParameters, 1, &sampler, D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT);
+	Microsoft::WRL::ComPtr<ID3DBlob> signature;
+	Microsoft::WRL::ComPtr<ID3DBlob> error;
+	HRESULT result = D3D12SerializeRootSignature(&rootSignatureDesc, D3D_ROOT_SIGNATURE_VERSION_1_0, &signature, &error);
+	assert(SUCCEEDED(result));
+	result = device->CreateRootSignature(0, signature->GetBufferPointer(), signature->GetBufferSize(), IID_PPV_ARGS(&sRootSignature_));
+	assert(SUCCEEDED(result));
+
+	// 入力レイアウト（MeshVertex と QuantizedVertex）
+	const D3D12_INPUT_ELEMENT_DESC floatLayout[] = {
+	    {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, offsetof(MeshVertex, pos), D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	    {"NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, offsetof(MeshVertex, normal), D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	    {"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, offsetof(MeshVertex, uv), D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	};
+	const D3D12_INPUT_ELEMENT_DESC quantizedLayout[] = {
+	    {"POSITION", 0, DXGI_FORMAT_R16G16B16A16_UNORM, 0, offsetof(QuantizedVertex, pos), D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	    {"NORMAL", 0, DXGI_FORMAT_R16G16_SNORM, 0, offsetof(QuantizedVertex, normal), D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	    {"TEXCOORD", 0, DXGI_FORMAT_R16G16_FLOAT, 0, offsetof(QuantizedVertex, uv), D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	};
+
+	// 頂点シェーダーと入力レイアウトのほかは共通（エンジンのモデル用パイプラインと同じく、背面カリング・深度テスト・αブレンド）
+	const Microsoft::WRL::ComPtr<ID3DBlob> pixelShader = CompileShader(L"Resources/shaders/ObjPS.hlsl", "ps_5_0");
+	D3D12_GRAPHICS_PIPELINE_STATE_DESC desc = {};
+	desc.pRootSignature = sRootSignature_.Get();
+	desc.PS = CD3DX12_SHADER_BYTECODE(pixelShader.Get());
+	desc.SampleMask = D3D12_DEFAULT_SAMPLE_MASK;
+	desc.RasterizerState = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT);
+	desc.DepthStencilState = CD3DX12_DEPTH_STENCIL_DESC(D3D12_DEFAULT);
+	desc.DSVFormat = DXGI_FORMAT_D32_FLOAT;
+	D3D12_RENDER_TARGET_BLEND_DESC& blend = desc.BlendState.RenderTarget[0];
+	blend.RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
+	blend.BlendEnable = TRUE;
+	blend.BlendOp = D3D12_BLEND_OP_ADD;
+	blend.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+	blend.DestBlend = D3D12_BLEND_INV_SRC_ALPHA;
+	blend.BlendOpAlpha = D3D12_BLEND_OP_ADD;
+	blend.SrcBlendAlpha = D3D12_BLEND_ONE;
+	blend.DestBlendAlpha = D3D12_BLEND_ZERO;
+	desc.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+	desc.NumRenderTargets = 1;
+	desc.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+	desc.SampleDesc.Count = 1;
+
+	const Microsoft::WRL::ComPtr<ID3DBlob> floatShader = CompileShader(L"Resources/shaders/ObjVS.hlsl", "vs_5_0");
+	desc.VS = CD3DX12_SHADER_BYTECODE(floatShader.Get());
+	desc.InputLayout = {floatLayout, _countof(floatLayout)};
+	result = device->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(&sPipelineStates_[0]));
+	assert(SUCCEEDED(result));
+
+	const Microsoft::WRL::ComPtr<ID3DBlob> quantizedShader = CompileShader(L"Resources/shaders/ObjQuantizedVS.hlsl", "vs_5_0");
+	desc.VS = CD3DX12_SHADER_BYTECODE(quantizedShader.Get());
+	desc.InputLayout = {quantizedLayout, _countof(quantizedLayout)};
+	result = device->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(&sPipelineStates_[1]));
+	assert(SUCCEEDED(result));
+	(void)result;
+}
+
+void CachedModel::StaticFinalize() {
+	sPipelineStates_[0].Reset();
+	sPipelineStates_[1].Reset();
+	sRootSignature_.Reset();
+	sBoundPipelineState_ = nullptr;
+}
+
+CachedModel* CachedModel::CreateFromOBJ(const std::string& modelName, bool smoothing, bool quantize) {
+	Source source;
+	LoadSource(modelName, source, smoothing, quantize);
+	return Create(modelName, source);
+}
+
+void CachedModel::LoadSource(const std::string& modelName, Source& out, bool smoothing, bool quantize) {
+	const std::filesystem::path objPath = kModelDirectory / modelName / (modelName + ".obj");
+	const std::filesystem::path cachePath = MeshCache::GetCachePath(objPath);
+	const uint32_t flags = (smoothing ? MeshCache::kFlagSmoothing : 0u) | (quantize ? MeshCache::kFlagQuantized : 0u);
+	const uint64_t stamp = MeshCache::ComputeSourceStamp(objPath);
+
+	MeshData& mesh = out.mesh;
+	out.quantizedVertices.clear();
+	out.bounds = {};
+	MeshCache cache;
+	if (cache.Open(cachePath, flags, stamp)) {
+		// キャッシュが使えればマップしたメモリから取り出す（圧縮した頂点は戻さずに、そのまま GPU に送る）
+		out.loadedFromCache = true;
+		if (cache.IsQuantized()) {
+			cache.CopyTopologyTo(mesh);
+			const QuantizedVertex* vertices = cache.GetQuantizedVertices();
+			out.quantizedVertices.assign(vertices, vertices + cache.GetVertexCount());
+			out.bounds = cache.GetQuantizationBounds();
+		} else {
+			cache.CopyTo(mesh);
+		}
+	} else {
+		// obj を読み、AssetBaker と同じく並べ替えてから次回のために書き出す（書けなくてもそのまま使う）
+		out.loadedFromCache = false;
+		const bool imported = ObjImporter::Import(objPath, smoothing, mesh);
+		assert(imported);
+		(void)imported;
+		MeshOptimizer::Optimize(mesh);
+		MeshSimplifier::GenerateLods(mesh);
+		MeshCache::Write(cachePath, mesh, flags, stamp);
+		// 次回キャッシュから読んだときと同じ頂点にしておく（MeshCache::Write と同じ範囲で圧縮する）
+		if (quantize) {
+			out.bounds = MeshQuantizer::ComputeBounds(mesh.vertices.data(), mesh.vertices.size());
+			out.quantizedVertices.resize(mesh.vertices.size());
+			MeshQuantizer::Quantize(mesh.vertices.data(), mesh.vertices.size(), out.bounds, out.quantizedVertices.data());
+			mesh.vertices.clear();
+			mesh.vertices.shrink_to_fit();
+		}
+	}
+
+	// テクスチャは変換済みの .dds があればそちらを読む（名前はモデルのディレクトリからの相対のまま）
+	const std::string directoryPath = modelName + "/";
+	for (MeshMaterial& material : mesh.materials) {
+		if (!material.textureFilename.empty()) {
+			material.textureFilename = AssetCache::ResolveTextureFile(directoryPath + material.textureFilename).substr(directoryPath.size());
+		}
+	}
+
+	out.indices16.clear();
+	if (MeshCache::CanUse16BitIndices(mesh)) {
+		out.indices16.assign(mesh.indices.size(), 0);
+		std::transform(mesh.indices.begin(), mesh.indices.end(), out.indices16.begin(), [](uint32_t index) { return static_cast<uint16_t>(index); });
+		mesh.indices.clear();
+		mesh.indices.shrink_to_fit();
+	}
+}
+
+CachedModel* CachedModel::Create(const std::string& modelName, const Source& source) {
+	CachedModel* model = new CachedModel();
+	model->name_ = modelName;
+	model->loadedFromCache_ = source.loadedFromCache;
+	const MeshData& mesh = source.mesh;
+
+	// 頂点（圧縮したものは ObjQuantizedVS に位置の復元範囲を渡す。UNORM は 0〜1 で読めるので scale は 65535 倍する）
+	const void* vertexData = mesh.vertices.data();
+	size_t vertexCount = mesh.vertices.size();
+	uint32_t vertexStride = sizeof(MeshVertex);
+	if (!source.quantizedVertices.empty()) {
+		model->quantized_ = true;
+		for (int k = 0; k < 3; ++k) {
+			model->quantization_.offset[k] = source.bounds.offset[k];
+			model->quantization_.scale[k] = source.bounds.scale[k] * 65535.0f;
+		}
+		// 範囲の中心（位置の最小・最大で決めた範囲なので、頂点から求めるのと同じ）
+		model->center_ = {
+		    source.bounds.offset[0] + model->quantization_.scale[0] * 0.5f,
+		    source.bounds.offset[1] + model->quantization_.scale[1] * 0.5f,
+		    source.bounds.offset[2] + model->quantization_.scale[2] * 0.5f,
+		};
+		vertexData = source.quantizedVertices.data();
+		vertexCount = source.quantizedVertices.size();
+		vertexStride = sizeof(QuantizedVertex);
+	} else {
+		model->center_ = ComputeCenter(mesh.vertices);
+	}
+
+	if (!source.indices16.empty()) {
+		model->Build(vertexData, vertexCount, vertexStride, source.indices16.data(), static_cast<uint32_t>(source.indices16.size()), sizeof(uint16_t), mesh.subMeshes, mesh.materials, mesh.lods);
+	} else {
+		model->Build(vertexData, vertexCount, vertexStride, mesh.indices.data(), static_cast<uint32_t>(mesh.indices.size()), sizeof(uint32_t), mesh.subMeshes, mesh.materials, mesh.lods);
+	}
+	return model;
+}
+
+void CachedModel::Build(
+    const void* vertexData, size_t vertexCount, uint32_t vertexStride, const void* indexData, uint32_t indexCount, uint32_t indexSize, const std::vector<SubMesh>& subMeshes,
+    const std::vector<MeshMaterial>& materials, const std::vector<MeshLod>& lods) {
+	// マテリアル
+	const std::string directoryPath = name_ + "/";
+	materials_.reserve(materials.size());
+	for (const MeshMaterial& source : materials) {
+		std::unique_ptr<Material> material = Material::Create();
+		material->name_ = source.name;
+		material->ambient_ = {source.ambient[0], source.ambient[1], source.ambient[2]};
+		material->diffuse_ = {source.diffuse[0], source.diffuse[1], source.diffuse[2]};
+		material->specular_ = {source.specular[0], source.specular[1], source.specular[2]};
+		material->alpha_ = source.alpha;
+		// テクスチャがなければ白（Resources 直下）。変換済みの .dds があればそちらを読む
+		if (source.textureFilename.empty()) {
+			material->textureFilename_ = AssetCache::ResolveTextureFile("white1x1.png");
+			material->LoadTexture("");
+		} else {
+			// LoadSource で読むファイルの名前にしてある
+			material->textureFilename_ = source.textureFilename;
+			material->LoadTexture(directoryPath);
+		}
+		material->Update();
+		materials_.push_back(std::move(material));
+	}
+
+	// 描画単位（LOD0 のサブメッシュ、LOD1 のサブメッシュ…の順）
+	ranges_.reserve(subMeshes.size() * (lods.size() + 1));
+	lods_.push_back({0.0f, 0});
+	for (const MeshLod& lod : lods) {
+		lods_.push_back({lod.error, static_cast<uint32_t>(subMeshes.size() * lods_.size())});
+	}
+	for (size_t i = 0; i < subMeshes.size() * lods_.size(); ++i) {
+		const SubMesh& subMesh = subMeshes[i % subMeshes.size()];
+		const size_t level = i / subMeshes.size();
+		DrawRange range;
+		range.vertexOffset = subMesh.vertexOffset;
+		range.indexOffset = level == 0 ? subMesh.indexOffset : lods[level - 1].ranges[i % subMeshes.size()].indexOffset;
+		range.indexCount = level == 0 ? subMesh.indexCount : lods[level - 1].ranges[i % subMeshes.size()].indexCount;
+		if (subMesh.material >= 0) {
+			range.material = materials_[subMesh.material].get();
+		} else {
+			if (!defaultMaterial_) {
+				defaultMaterial_ = Material::Create();
+				defaultMaterial_->name_ = "no material";
+				defaultMaterial_->textureFilename_ = AssetCache::ResolveTextureFile("white1x1.png");
+				defaultMaterial_->LoadTexture("");
+				defaultMaterial_->Update();
+			}
+			range.material = defaultMaterial_.get();
+		}
+		ranges_.push_back(range);
+	}
+
+	// 頂点バッファ
+	const size_t vertexBytes = vertexCount * vertexStride;
+	vertexBuffer_ = CreateBuffer(vertexData, vertexBytes);
+	vbView_.BufferLocation = vertexBuffer_->GetGPUVirtualAddress();
+	vbView_.SizeInBytes = static_cast<UINT>(vertexBytes);
+	vbView_.StrideInBytes = vertexStride;
+
+	// インデックスバッファ
+	const size_t indexBytes = size_t{indexCount} * indexSize;
+	indexBuffer_ = CreateBuffer(indexData, indexBytes);
+	ibView_.BufferLocation = indexBuffer_->GetGPUVirtualAddress();
+	ibView_.Format = indexSize == sizeof(uint16_t) ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+	ibView_.SizeInBytes = static_cast<UINT>(indexBytes);
+}
+
+Microsoft::WRL::ComPtr<ID3D12Resource> CachedModel::CreateBuffer(const void* data, size_t size) {
+	ID3D12Device* device = DirectXCommon::GetInstance()->GetDevice();
+
+	// Mesh::CreateBuffers と同じくアップロードヒープに置く
+	CD3DX12_HEAP_PROPERTIES heapProps(D3D12_HEAP_TYPE_UPLOAD);
+	CD3DX12_RESOURCE_DESC resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(std::max<size_t>(size, 4));
+
+	Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+	HRESULT result = device->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &resourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&resource));
+	assert(SUCCEEDED(result));
+
+	void* mapped = nullptr;
+	result = resource->Map(0, nullptr, &mapped);
+	assert(SUCCEEDED(result));
+	(void)result;
+	std::memcpy(mapped, data, size);
+	resource->Unmap(0, nullptr);
+	return resource;
+}
+
+void CachedModel::PreDraw(ID3D12GraphicsCommandList* commandList) {
+	// Model::PreDraw が設定したエンジンのルートシグネチャから替える（パイプラインは Draw で頂点の形式に合わせて設定する）
+	commandList->SetGraphicsRootSignature(sRootSignature_.Get());
+	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	sBoundPipelineState_ = nullptr;
+}
+
+void CachedModel::Draw(const DrawBuffers& buffers, const Matrix4x4& world, const Matrix4x4& view, const Matrix4x4& projection, float nearZ) {
+	ModelCommon* modelCommon = ModelCommon::GetInstance();
+	ID3D12GraphicsCommandList* commandList = modelCommon->GetCommandList();
+
+	// 前に描いたモデルと頂点の形式が違うときだけパイプラインを替える（ルートシグネチャは同じなので、ルート引数は残る）
+	ID3D12PipelineState* pipelineState = sPipelineStates_[quantized_ ? 1 : 0].Get();
+	if (pipelineState != sBoundPipelineState_) {
+		commandList->SetPipelineState(pipelineState);
+		sBoundPipelineState_ = pipelineState;
+	}
+
+	// TransformCommand の代わりに、渡されたアドレスをそのまま設定する
+	modelCommon->LightCommand(lightGroup_);
+	commandList->SetGraphicsRootConstantBufferView(static_cast<UINT>(Model::RoomParameter::kWorldTransform), buffers.worldTransform);
+	commandList->SetGraphicsRootConstantBufferView(static_cast<UINT>(Model::RoomParameter::kCamera), buffers.camera);
+	if (buffers.objectColor) {
+		commandList->SetGraphicsRootConstantBufferView(static_cast<UINT>(Model::RoomParameter::kObjectColor), buffers.objectColor);
+	} else {
+		modelCommon->GetObjectColor()->SetGraphicsCommand(commandList, static_cast<UINT>(Model::RoomParameter::kObjectColor));
+	}
+	if (quantized_) {
+		commandList->SetGraphicsRoot32BitConstants(kQuantizationRootParameter, sizeof(QuantizationConstants) / sizeof(uint32_t), &quantization_, 0);
+	}
+
+	DrawRanges(commandList, SelectLod(world, view, projection, nearZ));
+}
+
+void CachedModel::DrawRanges(ID3D12GraphicsCommandList* commandList, size_t lod) const {
+	commandList->IASetVertexBuffers(0, 1, &vbView_);
+	commandList->IASetIndexBuffer(&ibView_);
+	const size_t rangeEnd = lod + 1 < lods_.size() ? lods_[lod + 1].firstRange : ranges_.size();
+	for (size_t i = lods_[lod].firstRange; i < rangeEnd; ++i) {
+		const DrawRange& range = ranges_[i];
+		range.material->SetGraphicsCommand(commandList, static_cast<UINT>(Model::RoomParameter::kMaterial), static_cast<UINT>(Model::RoomParameter::kTexture));
+		commandList->DrawIndexedInstanced(range.indexCount, 1, range.indexOffset, static_cast<INT>(range.vertexOffset), 0);
+	}
+}
+
+size_t CachedModel::SelectLod(const WorldTransform& worldTransform, const Camera& camera) const {
+	return SelectLod(worldTransform.matWorld_, camera.matView, camera.matProjection, camera.nearZ);
+}
+
+size_t CachedModel::SelectLod(const Matrix4x4& world, const Matrix4x4& view, const Matrix4x4& projection, float nearZ) const {
+	if (lods_.size() <= 1) {
+		return 0;
+	}
+	// ワールド行列の軸の長さのうち一番大きいものを拡大率とみなす
+	float scale = 0.0f;
+	for (int row = 0; row < 3; ++row) {
+		scale = std::max(scale, Length({world.m[row][0], world.m[row][1], world.m[row][2]}));
+	}
+	const Vector3 viewCenter = Transform(Transform(center_, world), view);
+	if (viewCenter.z <= nearZ) {
+		return 0;
+	}
+
+	// モデル座標の長さ 1 が画面上で何ピクセルになるか（projection.m[1][1] は 1 / tan(fovY / 2)）
+	const float pixelsPerUnit = scale * projection.m[1][1] * (static_cast<float>(WinApp::kWindowHeight) * 0.5f) / viewCenter.z;
+	// 粗い段ほどずれが大きいので、許せる一番粗い段を探す
+	size_t lod = 0;
+	while (lod + 1 < lods_.size() && lods_[lod + 1].error * pixelsPerUnit <= kLodPixelError) {
+		++lod;
+	}
+	return lod;
+}
@@ -0,0 +1,134 @@
+#pragma once
+#include "KamataEngine.h"
+#include "MeshData.h"
+#include "MeshQuantizer.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace KamataEngine;
+
+// .mesh キャッシュから作るモデル
+// Model::CreateFromOBJ の代わりに使う。Resources/名前/名前.mesh が今の obj / mtl から作ったものなら
+// マップして頂点・インデックスバッファにコピーし、なければ ObjImporter で obj を読んで .mesh を書き出す。
+// 頂点は圧縮した .mesh なら 16 バイトの QuantizedVertex のまま、そうでなければ 32 バイトの MeshVertex で GPU に置く。
+// エンジンの ModelCommon のパイプラインは float の頂点しか読めないので、ルートシグネチャとパイプラインは CachedModel が持つ
+// （頂点の形式ごとに 1 つずつ。圧縮したものは ObjQuantizedVS で戻す。ピクセルシェーダーとルートパラメータの並びは Model と同じ）。
+// Mesh はインデックスが 32 ビット固定でサブメッシュごとにバッファを持つので使わず、
+// モデル1つにつき頂点・インデックスバッファを1本ずつ持って、サブメッシュはオフセットで描き分ける。
+// .mesh に LOD があれば、カメラからの距離と拡大率から LOD のずれが画面上で 1 ピクセルに収まる一番粗い段を描く。
+class CachedModel {
+public:
+	// GPU に送る前の中身（.mesh から読んだもの、なければ obj から作ったもの）
+	struct Source {
+		MeshData mesh;                   // マテリアルのテクスチャ名は読むファイル（変換済みの .dds があればそちら）にしてある
+		std::vector<uint16_t> indices16; // 16 ビットで足りるときのインデックス（このときは mesh.indices は空）
+		// 圧縮して読んだときの頂点と、位置の復元に使う範囲（このときは mesh.vertices は空）
+		std::vector<QuantizedVertex> quantizedVertices;
+		QuantizationBounds bounds;
+		bool loadedFromCache = false;
+	};
+
+	// パイプラインを作る（KamataEngine::Initialize の後、モデルを作る前に 1 回）
+	static void StaticInitialize();
+	static void StaticFinalize();
+
+	// モデルを作る（smoothing は Model::CreateFromOBJ と同じ意味。LoadSource と Create を続けて呼ぶ）
+	// quantize なら頂点を QuantizedVertex に圧縮して .mesh に書き、GPU にもそのまま置く（頂点のメモリは半分。位置・法線・uv に量子化の誤差が乗る）
+	static CachedModel* CreateFromOBJ(const std::string& modelName, bool smoothing = false, bool quantize = true);
+	// .mesh を読む。なければ obj を読んで並べ替えと LOD の作成をし、.mesh を書き出す
+	// エンジンも D3D12 も使わないので、ワーカースレッドで呼んでよい
+	static void LoadSource(const std::string& modelName, Source& out, bool smoothing = false, bool quantize = true);
+	// source からマテリアル・テクスチャ・バッファを作る（描画スレッドがコマンドを積んでいない間に呼ぶ）
+	static CachedModel* Create(const std::string& modelName, const Source& source);
+
+	// Model::PreDraw の後、Draw の前に呼ぶ（CachedModel のルートシグネチャにする）
+	static void PreDraw(ID3D12GraphicsCommandList* commandList);
+
+	// 呼び出し側で書いた定数バッファ（ConstBufferRing のアドレス）
+	struct DrawBuffers {
+		D3D12_GPU_VIRTUAL_ADDRESS worldTransform = 0; // ConstBufferDataWorldTransform
+		D3D12_GPU_VIRTUAL_ADDRESS camera = 0;         // ConstBufferDataCamera
+		D3D12_GPU_VIRTUAL_ADDRESS objectColor = 0;    // ConstBufferDataObjectColor（0 なら既定の色）
+	};
+	// 描画（PreDraw と Model::PostDraw の間で呼ぶ。WorldTransform / Camera / ObjectColor の定数バッファは使わないので、
+	// それらは Initialize しなくてよい。LOD は world・view・projection で選ぶ）
+	void Draw(const DrawBuffers& buffers, const Matrix4x4& world, const Matrix4x4& view, const Matrix4x4& projection, float nearZ);
+
+	void SetLightGroup(const LightGroup* lightGroup) { lightGroup_ = lightGroup; }
+
+	// .mesh から読めたか
+	bool IsLoadedFromCache() const { return loadedFromCache_; }
+	// 頂点を QuantizedVertex のまま GPU に置いているか
+	bool IsQuantized() const { return quantized_; }
+	// GPU に置いた頂点・インデックスのバイト数
+	size_t GetVertexBufferSize() const { return vbView_.SizeInBytes; }
+	size_t GetIndexBufferSize() const { return ibView_.SizeInBytes; }
+	// LOD の段数（LOD0 を含む）
+	size_t GetLodCount() const { return lods_.size(); }
+	// 描くときに使う LOD
+	size_t SelectLod(const WorldTransform& worldTransform, const Camera& camera) const;
+	size_t SelectLod(const Matrix4x4& world, const Matrix4x4& view, const Matrix4x4& projection, float nearZ) const;
+
+private:
+	CachedModel() = default;
+
+	// 描画単位
+	struct DrawRange {
+		Material* material = nullptr;
+		uint32_t vertexOffset = 0;
+		uint32_t indexOffset = 0;
+		uint32_t indexCount = 0;
+	};
+
+	// LOD の段
+	struct Lod {
+		float error = 0.0f;      // 元の形からのずれ（モデル座標）
+		uint32_t firstRange = 0; // ranges_ の何番目から始まるか
+	};
+
+	// ObjQuantizedVS の Quantization（float3 は 16 バイト境界をまたがないので、それぞれ 1 つ詰める）
+	struct QuantizationConstants {
+		float offset[3];
+		float pad0;
+		float scale[3]; // QuantizationBounds::scale の 65535 倍
+		float pad1;
+	};
+	// 位置の復元範囲を渡すルートパラメータ（Model::RoomParameter の後ろ）
+	static inline const UINT kQuantizationRootParameter = static_cast<UINT>(Model::RoomParameter::kObjectColor) + 1;
+
+	// マテリアルとバッファを作って GPU に送る（頂点は vertexStride バイトずつ、indexSize は 2 か 4）
+	void Build(
+	    const void* vertexData, size_t vertexCount, uint32_t vertexStride, const void* indexData, uint32_t indexCount, uint32_t indexSize, const std::vector<SubMesh>& subMeshes,
+	    const std::vector<MeshMaterial>& materials, const std::vector<MeshLod>& lods);
+	// LOD の段のサブメッシュを描く
+	void DrawRanges(ID3D12GraphicsCommandList* commandList, size_t lod) const;
+	// アップロードヒープにバッファを作って data をコピーする
+	static Microsoft::WRL::ComPtr<ID3D12Resource> CreateBuffer(const void* data, size_t size);
+
+	std::string name_;
+	std::vector<std::unique_ptr<Material>> materials_;
+	// マテリアルの指定がないサブメッシュ用
+	std::unique_ptr<Material> defaultMaterial_;
+	std::vector<DrawRange> ranges_;
+	std::vector<Lod> lods_;
+	Vector3 center_ = {};
+
+	Microsoft::WRL::ComPtr<ID3D12Resource> vertexBuffer_;
+	Microsoft::WRL::ComPtr<ID3D12Resource> indexBuffer_;
+	D3D12_VERTEX_BUFFER_VIEW vbView_ = {};
+	D3D12_INDEX_BUFFER_VIEW ibView_ = {};
+
+	// 頂点が QuantizedVertex のとき、ObjQuantizedVS に渡す位置の復元範囲
+	bool quantized_ = false;
+	QuantizationConstants quantization_ = {};
+
+	const LightGroup* lightGroup_ = nullptr;
+	bool loadedFromCache_ = false;
+
+	// どのモデルも共通のルートシグネチャと、頂点の形式ごとのパイプライン（[0] が MeshVertex、[1] が QuantizedVertex）
+	static Microsoft::WRL::ComPtr<ID3D12RootSignature> sRootSignature_;
+	static Microsoft::WRL::ComPtr<ID3D12PipelineState> sPipelineStates_[2];
+	// 描画スレッドが最後に設定したパイプライン（PreDraw で忘れる）
+	static ID3D12PipelineState* sBoundPipelineState_;
+};
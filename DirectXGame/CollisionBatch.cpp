@@ -0,0 +1,143 @@
+#include "CollisionBatch.h"
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+using namespace KamataEngine;
+
+namespace {
+// 空き領域には絶対に重ならない箱（min=+∞, max=-∞）を置いておき、端数処理をなくす
+constexpr float kEmptyMin = std::numeric_limits<float>::infinity();
+constexpr float kEmptyMax = -std::numeric_limits<float>::infinity();
+
+uint32_t RoundUpToLanes(uint32_t n) { return (n + AABBBatch::kLaneCount - 1) / AABBBatch::kLaneCount * AABBBatch::kLaneCount; }
+} // namespace
+
+void AABBBatch::Reserve(uint32_t capacity) {
+	const uint32_t storage = RoundUpToLanes(capacity);
+	for (std::vector<float>* stream : {&minX_, &minY_, &minZ_, &maxX_, &maxY_, &maxZ_}) {
+		stream->reserve(storage);
+	}
+}
+
+void AABBBatch::Clear() {
+	count_ = 0;
+	for (std::vector<float>* stream : {&minX_, &minY_, &minZ_, &maxX_, &maxY_, &maxZ_}) {
+		stream->clear();
+	}
+}
+
+uint32_t AABBBatch::Add(const AABB& aabb) {
+	const uint32_t index = count_++;
+
+	// ブロックの頭に来たら、次の kLaneCount 個ぶんを空の箱で埋めておく
+	if (index % kLaneCount == 0) {
+		minX_.resize(index + kLaneCount, kEmptyMin);
+		minY_.resize(index + kLaneCount, kEmptyMin);
+		minZ_.resize(index + kLaneCount, kEmptyMin);
+		maxX_.resize(index + kLaneCount, kEmptyMax);
+		maxY_.resize(index + kLaneCount, kEmptyMax);
+		maxZ_.resize(index + kLaneCount, kEmptyMax);
+	}
+
+	minX_[index] = aabb.min.x;
+	minY_[index] = aabb.min.y;
+	minZ_[index] = aabb.min.z;
+	maxX_[index] = aabb.max.x;
+	maxY_[index] = aabb.max.y;
+	maxZ_[index] = aabb.max.z;
+	return index;
+}
+
+void AABBBatch::Resize(uint32_t count) {
+	count_ = count;
+	const uint32_t storage = RoundUpToLanes(count);
+	// 末尾のブロックの余りは、前に入っていた値を消して空の箱にしておく
+	for (std::vector<float>* stream : {&minX_, &minY_, &minZ_}) {
+		stream->resize(storage, kEmptyMin);
+		std::fill(stream->begin() + count, stream->end(), kEmptyMin);
+	}
+	for (std::vector<float>* stream : {&maxX_, &maxY_, &maxZ_}) {
+		stream->resize(storage, kEmptyMax);
+		std::fill(stream->begin() + count, stream->end(), kEmptyMax);
+	}
+}
+
+void AABBBatch::Set(uint32_t index, const AABB& aabb) {
+	minX_[index] = aabb.min.x;
+	minY_[index] = aabb.min.y;
+	minZ_[index] = aabb.min.z;
+	maxX_[index] = aabb.max.x;
+	maxY_[index] = aabb.max.y;
+	maxZ_[index] = aabb.max.z;
+}
+
+uint32_t AABBBatch::TestBlock(const AABB& query, Axes axes, uint32_t block) const {
+	const uint32_t base = block * kLaneCount;
+
+#if defined(METHOD_USE_AVX)
+	// 8個同時：query.min <= b.max かつ query.max >= b.min を軸ごとに AND する
+	__m256 hit = _mm256_and_ps(_mm256_cmp_ps(_mm256_set1_ps(query.min.x), _mm256_loadu_ps(&maxX_[base]), _CMP_LE_OQ),
+	                           _mm256_cmp_ps(_mm256_set1_ps(query.max.x), _mm256_loadu_ps(&minX_[base]), _CMP_GE_OQ));
+	hit = _mm256_and_ps(hit, _mm256_cmp_ps(_mm256_set1_ps(query.min.y), _mm256_loadu_ps(&maxY_[base]), _CMP_LE_OQ));
+	hit = _mm256_and_ps(hit, _mm256_cmp_ps(_mm256_set1_ps(query.max.y), _mm256_loadu_ps(&minY_[base]), _CMP_GE_OQ));
+	if (axes == Axes::kXYZ) {
+		hit = _mm256_and_ps(hit, _mm256_cmp_ps(_mm256_set1_ps(query.min.z), _mm256_loadu_ps(&maxZ_[base]), _CMP_LE_OQ));
+		hit = _mm256_and_ps(hit, _mm256_cmp_ps(_mm256_set1_ps(query.max.z), _mm256_loadu_ps(&minZ_[base]), _CMP_GE_OQ));
+	}
+	return static_cast<uint32_t>(_mm256_movemask_ps(hit));
+#elif defined(METHOD_USE_SSE)
+	// 4個ずつ2回
+	uint32_t mask = 0;
+	for (uint32_t half = 0; half < kLaneCount; half += 4) {
+		const uint32_t i = base + half;
+		__m128 hit = _mm_and_ps(_mm_cmple_ps(_mm_set1_ps(query.min.x), _mm_loadu_ps(&maxX_[i])), _mm_cmpge_ps(_mm_set1_ps(query.max.x), _mm_loadu_ps(&minX_[i])));
+		hit = _mm_and_ps(hit, _mm_cmple_ps(_mm_set1_ps(query.min.y), _mm_loadu_ps(&maxY_[i])));
+		hit = _mm_and_ps(hit, _mm_cmpge_ps(_mm_set1_ps(query.max.y), _mm_loadu_ps(&minY_[i])));
+		if (axes == Axes::kXYZ) {
+			hit = _mm_and_ps(hit, _mm_cmple_ps(_mm_set1_ps(query.min.z), _mm_loadu_ps(&maxZ_[i])));
+			hit = _mm_and_ps(hit, _mm_cmpge_ps(_mm_set1_ps(query.max.z), _mm_loadu_ps(&minZ_[i])));
+		}
+		mask |= static_cast<uint32_t>(_mm_movemask_ps(hit)) << half;
+	}
+	return mask;
+#else
+	uint32_t mask = 0;
+	for (uint32_t lane = 0; lane < kLaneCount; ++lane) {
+		const uint32_t i = base + lane;
+		bool hit = query.min.x <= maxX_[i] && query.max.x >= minX_[i] && query.min.y <= maxY_[i] && query.max.y >= minY_[i];
+		if (axes == Axes::kXYZ) {
+			hit = hit && query.min.z <= maxZ_[i] && query.max.z >= minZ_[i];
+		}
+		mask |= static_cast<uint32_t>(hit) << lane;
+	}
+	return mask;
+#endif
+}
+
+uint32_t AABBBatch::Query(const AABB& query, Axes axes, uint32_t* outIndices) const {
+	uint32_t hitCount = 0;
+	const uint32_t blockCount = RoundUpToLanes(count_) / kLaneCount;
+	for (uint32_t block = 0; block < blockCount; ++block) {
+		// 立っているビットを下から順に番号へ直す
+		for (uint32_t mask = TestBlock(query, axes, block); mask != 0; mask &= mask - 1) {
+			outIndices[hitCount++] = block * kLaneCount + static_cast<uint32_t>(std::countr_zero(mask));
+		}
+	}
+	return hitCount;
+}
+
+void AABBBatch::Query(const AABB& query, Axes axes, std::vector<uint32_t>& outIndices) const {
+	outIndices.resize(count_);
+	outIndices.resize(Query(query, axes, outIndices.data()));
+}
+
+void AABBBatch::QueryMask(const AABB& query, Axes axes, std::vector<uint64_t>& outMask) const {
+	outMask.assign((count_ + 63) / 64, 0);
+	const uint32_t blockCount = RoundUpToLanes(count_) / kLaneCount;
+	for (uint32_t block = 0; block < blockCount; ++block) {
+		const uint32_t base = block * kLaneCount;
+		// kLaneCount は 64 の約数なので、1ブロックが2語にまたがることはない
+		outMask[base / 64] |= static_cast<uint64_t>(TestBlock(query, axes, block)) << (base % 64);
+	}
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include "KamataEngine.h"
+#include "Method.h"
+#include <cstdint>
+#include <vector>
+
+using namespace KamataEngine;
+
+// 1つの AABB と多数の AABB の重なりをまとめて調べるための入れ物
+// 各成分を SoA で並べておき、AVX なら8個、SSE なら4個ずつ比較する。
+// 判定の境界条件は IsCollision / IntersectAABB と同じ（接していれば当たり）。
+class AABBBatch {
+public:
+	// 見る軸
+	enum class Axes {
+		kXY,  // IsCollision と同じ（Z は無視）
+		kXYZ, // IntersectAABB と同じ
+	};
+
+	// 1度に比較する個数（確保領域はこの倍数に切り上げる）
+	static inline const uint32_t kLaneCount = 8;
+
+	// 最大数を先に確保しておく（毎フレームの Add で再確保させない）
+	void Reserve(uint32_t capacity);
+
+	// 全消去（確保領域は残す）
+	void Clear();
+
+	// 追加して、追加した番号を返す
+	uint32_t Add(const AABB& aabb);
+
+	// 個数を count にする（中身は Set で埋める。ほかのスレッドから別々の番号を同時に Set してよい）
+	void Resize(uint32_t count);
+	// index 番目を置き換える
+	void Set(uint32_t index, const AABB& aabb);
+
+	uint32_t GetCount() const { return count_; }
+
+	// query と重なっているものの番号を昇順で outIndices に書き、個数を返す
+	// outIndices には GetCount() 個ぶんの領域が必要
+	uint32_t Query(const AABB& query, Axes axes, uint32_t* outIndices) const;
+	// 上と同じ。結果は outIndices を作り直して返す
+	void Query(const AABB& query, Axes axes, std::vector<uint32_t>& outIndices) const;
+
+	// 重なっているものを1ビットずつ立てたマスクを返す（番号 i は outMask[i / 64] の i % 64 ビット目）
+	void QueryMask(const AABB& query, Axes axes, std::vector<uint64_t>& outMask) const;
+
+private:
+	// 先頭 kLaneCount 個ずつのブロック block について、重なっているレーンのビットを返す
+	uint32_t TestBlock(const AABB& query, Axes axes, uint32_t block) const;
+
+	uint32_t count_ = 0;
+
+	// 最小点
+	std::vector<float> minX_, minY_, minZ_;
+	// 最大点
+	std::vector<float> maxX_, maxY_, maxZ_;
+};
@@ -0,0 +1,89 @@
+#include "ConstBufferAllocator.h"
+#include <algorithm>
+#include <assert.h>
+
+void ConstBufferAllocator::Initialize(uint32_t pageSize, uint32_t maxPages) {
+	assert(maxPages > 0);
+	pageSize_ = AlignUp(std::max(pageSize, kAlignment));
+	maxPages_ = maxPages;
+
+	pages_.clear();
+	free_.clear();
+	frame_.clear();
+	inFlight_.clear();
+	hasCurrent_ = false;
+	current_ = 0;
+	cursor_ = 0;
+	frameUsedBytes_ = 0;
+
+	// 毎フレームの push_back で再確保が起きないよう上限分を確保しておく
+	pages_.reserve(maxPages_);
+	free_.reserve(maxPages_);
+	frame_.reserve(maxPages_);
+	inFlight_.reserve(maxPages_);
+}
+
+void ConstBufferAllocator::BeginFrame(uint64_t completedFence) {
+	// GPU が使い終わったページを空きに戻す（inFlight_ はフェンス昇順）
+	size_t retired = 0;
+	while (retired < inFlight_.size() && pages_[inFlight_[retired]].fence <= completedFence) {
+		free_.push_back(inFlight_[retired]);
+		++retired;
+	}
+	inFlight_.erase(inFlight_.begin(), inFlight_.begin() + retired);
+
+	frameUsedBytes_ = 0;
+}
+
+bool ConstBufferAllocator::Allocate(uint32_t size, Allocation& out) {
+	const uint32_t aligned = AlignUp(size);
+	// 1ページに収まらないサイズは扱わない
+	if (aligned == 0 || aligned > pageSize_) {
+		return false;
+	}
+
+	// 今のページに入りきらなければ次のページへ
+	if (!hasCurrent_ || cursor_ + aligned > pageSize_) {
+		if (!AcquirePage()) {
+			return false;
+		}
+	}
+
+	out.page = current_;
+	out.offset = cursor_;
+	out.size = aligned;
+
+	cursor_ += aligned;
+	frameUsedBytes_ += aligned;
+	return true;
+}
+
+void ConstBufferAllocator::EndFrame(uint64_t fence) {
+	// 使ったページ（切り出し途中のページも含む）を返却待ちへ
+	for (uint32_t page : frame_) {
+		pages_[page].fence = fence;
+		inFlight_.push_back(page);
+	}
+	frame_.clear();
+	hasCurrent_ = false;
+	cursor_ = 0;
+}
+
+bool ConstBufferAllocator::AcquirePage() {
+	uint32_t page = 0;
+	if (!free_.empty()) {
+		page = free_.back();
+		free_.pop_back();
+	} else if (pages_.size() < maxPages_) {
+		page = static_cast<uint32_t>(pages_.size());
+		pages_.push_back(Page{});
+	} else {
+		return false;
+	}
+
+	frame_.push_back(page);
+	hasCurrent_ = true;
+	current_ = page;
+	cursor_ = 0;
+	return true;
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// 定数バッファ用の線形（リング）アロケータ
+// 大きなページから256バイト境界のスライスを切り出すだけの割り当て方針クラス。
+// GPUリソースには触らないので、D3D12 側の実体は ConstBufferRing が持つ。
+class ConstBufferAllocator {
+public:
+	// D3D12 の定数バッファビューは 256 バイト境界が必須
+	static inline const uint32_t kAlignment = 256;
+
+	// 割り当て結果
+	struct Allocation {
+		uint32_t page = 0;   // ページ番号
+		uint32_t offset = 0; // ページ先頭からのオフセット[byte]
+		uint32_t size = 0;   // 切り出したサイズ（アライン済み）[byte]
+	};
+
+	// pageSize: 1ページのサイズ[byte]（kAlignment の倍数に切り上げ）
+	// maxPages: 確保してよいページ数の上限
+	void Initialize(uint32_t pageSize, uint32_t maxPages);
+
+	// フレーム開始。completedFence 以下のフェンス値を持つページを再利用可能に戻す
+	void BeginFrame(uint64_t completedFence);
+
+	// size バイトを切り出す。上限に達して確保できなければ false
+	bool Allocate(uint32_t size, Allocation& out);
+
+	// フレーム終了。このフレームで使ったページに fence を記録して返却待ちにする
+	void EndFrame(uint64_t fence);
+
+	// 256 バイト境界に切り上げ
+	static uint32_t AlignUp(uint32_t size) { return (size + kAlignment - 1) & ~(kAlignment - 1); }
+
+	uint32_t GetPageSize() const { return pageSize_; }
+	// これまでに生成されたページ数（＝必要な GPU リソース数）
+	uint32_t GetPageCount() const { return static_cast<uint32_t>(pages_.size()); }
+	// 返却待ち（GPU が使用中）のページ数
+	uint32_t GetInFlightPageCount() const { return static_cast<uint32_t>(inFlight_.size()); }
+	// 今フレームで切り出したバイト数
+	uint64_t GetFrameUsedBytes() const { return frameUsedBytes_; }
+
+private:
+	struct Page {
+		uint64_t fence = 0; // このページを最後に使ったフレームのフェンス値
+	};
+
+	// 空きページを1枚取り出す（なければ新規生成）。失敗時 false
+	bool AcquirePage();
+
+	uint32_t pageSize_ = 0;
+	uint32_t maxPages_ = 0;
+
+	// 全ページ
+	std::vector<Page> pages_;
+	// 再利用可能なページ番号
+	std::vector<uint32_t> free_;
+	// このフレームで使ったページ番号
+	std::vector<uint32_t> frame_;
+	// GPU の完了待ちページ番号（フェンス値の昇順）
+	std::vector<uint32_t> inFlight_;
+
+	// 現在切り出し中のページ
+	bool hasCurrent_ = false;
+	uint32_t current_ = 0;
+	uint32_t cursor_ = 0;
+
+	uint64_t frameUsedBytes_ = 0;
+};
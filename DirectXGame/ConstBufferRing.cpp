@@ -0,0 +1,74 @@
+#include "ConstBufferRing.h"
+#include <assert.h>
+
+using namespace KamataEngine;
+
+ConstBufferRing* ConstBufferRing::GetInstance() {
+	static ConstBufferRing instance;
+	return &instance;
+}
+
+void ConstBufferRing::Initialize(uint32_t pageSize, uint32_t maxPages) {
+	allocator_.Initialize(pageSize, maxPages);
+	pages_.clear();
+	mapped_.clear();
+	pages_.reserve(maxPages);
+	mapped_.reserve(maxPages);
+	frame_ = kFramesInFlight;
+}
+
+void ConstBufferRing::Finalize() {
+	for (Microsoft::WRL::ComPtr<ID3D12Resource>& page : pages_) {
+		page->Unmap(0, nullptr);
+	}
+	pages_.clear();
+	mapped_.clear();
+}
+
+void ConstBufferRing::BeginFrame() {
+	// DirectXCommon::PostDraw はフェンスで GPU 完了を待つので、
+	// kFramesInFlight フレーム前に使ったページは確実に読み終わっている
+	allocator_.BeginFrame(frame_ - kFramesInFlight);
+}
+
+void ConstBufferRing::EndFrame() {
+	allocator_.EndFrame(frame_);
+	++frame_;
+}
+
+bool ConstBufferRing::Allocate(uint32_t size, Slice& out) {
+	ConstBufferAllocator::Allocation allocation;
+	if (!allocator_.Allocate(size, allocation)) {
+		return false;
+	}
+	// アロケータが新しいページ番号を返したら実体を作る
+	while (allocation.page >= pages_.size()) {
+		CreatePage();
+	}
+
+	out.cpu = mapped_[allocation.page] + allocation.offset;
+	out.gpu = pages_[allocation.page]->GetGPUVirtualAddress() + allocation.offset;
+	out.size = allocation.size;
+	return true;
+}
+
+void ConstBufferRing::CreatePage() {
+	ID3D12Device* device = DirectXCommon::GetInstance()->GetDevice();
+
+	// アップロードヒープに1ページ分のバッファを作る
+	CD3DX12_HEAP_PROPERTIES heapProps(D3D12_HEAP_TYPE_UPLOAD);
+	CD3DX12_RESOURCE_DESC resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(allocator_.GetPageSize());
+
+	Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+	HRESULT result = device->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &resourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&resource));
+	assert(SUCCEEDED(result));
+
+	// アップロードヒープは作りっぱなしでマップしておける
+	void* mapped = nullptr;
+	result = resource->Map(0, nullptr, &mapped);
+	assert(SUCCEEDED(result));
+	(void)result;
+
+	pages_.push_back(resource);
+	mapped_.push_back(static_cast<uint8_t*>(mapped));
+}
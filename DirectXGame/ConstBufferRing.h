@@ -0,0 +1,74 @@
+#pragma once
+#include "ConstBufferAllocator.h"
+#include "KamataEngine.h"
+#include <vector>
+
+using namespace KamataEngine;
+
+// フレーム単位の定数バッファリング
+// 大きなアップロードヒープを数枚だけ作って永続マップし、
+// オブジェクトごとの定数データを 256 バイト境界のスライスとして切り出す。
+// 割り当て方針は ConstBufferAllocator に任せ、ここは GPU リソースの実体だけを持つ。
+class ConstBufferRing {
+public:
+	// 切り出したスライス
+	struct Slice {
+		void* cpu = nullptr;               // 書き込み先（永続マップ済み）
+		D3D12_GPU_VIRTUAL_ADDRESS gpu = 0; // SetGraphicsRootConstantBufferView に渡すアドレス
+		uint32_t size = 0;                 // アライン済みサイズ[byte]
+	};
+
+	// 同時に GPU が参照しうるフレーム数
+	static inline const uint32_t kFramesInFlight = 2;
+
+	static ConstBufferRing* GetInstance();
+
+	// pageSize: 1枚のアップロードバッファのサイズ[byte]
+	// maxPages: 作成するアップロードバッファの上限枚数
+	void Initialize(uint32_t pageSize = 64 * 1024, uint32_t maxPages = 32);
+	void Finalize();
+
+	// DirectXCommon::PreDraw の直後に呼ぶ
+	void BeginFrame();
+	// DirectXCommon::PostDraw の直後に呼ぶ
+	void EndFrame();
+
+	// size バイトのスライスを切り出す
+	bool Allocate(uint32_t size, Slice& out);
+
+	// 構造体をそのまま書き込んで GPU アドレスを返す（ページを使い切っていれば 0。呼んだ側は 0 で描かないこと）
+	template<class T> D3D12_GPU_VIRTUAL_ADDRESS Push(const T& data) {
+		Slice slice;
+		if (!Allocate(static_cast<uint32_t>(sizeof(T)), slice)) {
+			return 0;
+		}
+		*static_cast<T*>(slice.cpu) = data;
+		return slice.gpu;
+	}
+
+	// 作成済みのアップロードバッファ数
+	uint32_t GetResourceCount() const { return static_cast<uint32_t>(pages_.size()); }
+	// 作成済みのアップロードバッファの総量[byte]
+	uint64_t GetReservedBytes() const { return static_cast<uint64_t>(pages_.size()) * allocator_.GetPageSize(); }
+	// 今フレームで使った量[byte]
+	uint64_t GetFrameUsedBytes() const { return allocator_.GetFrameUsedBytes(); }
+
+private:
+	ConstBufferRing() = default;
+	~ConstBufferRing() = default;
+	ConstBufferRing(const ConstBufferRing&) = delete;
+	ConstBufferRing& operator=(const ConstBufferRing&) = delete;
+
+	// アップロードバッファを1枚作って永続マップする
+	void CreatePage();
+
+	// 割り当て方針
+	ConstBufferAllocator allocator_;
+	// アップロードバッファ（ページ番号と同じ並び）
+	std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> pages_;
+	// マップ済みアドレス
+	std::vector<uint8_t*> mapped_;
+
+	// 現在のフレーム番号（＝フェンス値として使う）
+	uint64_t frame_ = 0;
+};
@@ -1,84 +1,71 @@
 #include "DeathParticles.h"
-#include <numbers>
-#include <algorithm>
+#include "Profiler.h"
 
 using namespace KamataEngine;
 
-void DeathParticles::Initialize(Model* model, Camera* camera, const Vector3& position) {
+void DeathParticles::Initialize(CachedModel* model) {
 	// 引数として受け取ったデータをメンバ変数に記録
 	model_ = model;
 	// textureHandle_ = textureHandle;
-	camera_ = camera;
 
-	// ワールド変換の初期化
+	// ワールド変換の初期化（描くときは RenderSnapshot が matWorld_ を写すので、定数バッファは作らない）
+	for (WorldTransform& worldTransform : worldTransforms_) {
+		WorldTransformUpdateFast(worldTransform);
+	}
+
+	// 8方向の粒の配列を確保しておく
+	particles_.Initialize(kNumParticles, kNumParticles);
+	isFinished_ = true;
+}
+
+void DeathParticles::Start(const Vector3& position) {
+	// 前の粒を消して、8方向に放射状に放出
+	particles_.Clear();
+	ParticleSystem::EmitParams params;
+	params.position = position;
+	params.count = kNumParticles;
+	params.speed = kSpeed * 60.0f;
+	params.lifetime = kDuration;
+	params.color = {1.0f, 1.0f, 1.0f, 1.0f};
+	particles_.Emit(params);
 	for (WorldTransform& worldTransform : worldTransforms_) {
-		worldTransform.Initialize();
 		worldTransform.translation_ = position;
 	}
 
-	objectColor_.Initialize();
-	color_ = {1.0f, 1.0f, 1.0f, 1.0f};
+	isFinished_ = false;
 }
 
 void DeathParticles::Update() {
+	PROFILE_SCOPE("DeathParticles");
 	// 終了なら何もしない
 	if (isFinished_) {
 		return;
 	}
 
-	// 各パーティクルのワールド変換を更新
-	for (WorldTransform& worldTransform : worldTransforms_) {
-		// 必要なら位置や回転の更新処理をここに書いても良い
-		for (uint32_t i = 0; i < kNumParticles; ++i) {
-			// 基本の速度ベクトル（右方向）
-			Vector3 velocity = {kSpeed, 0.0f, 0.0f};
-
-			// 角度を計算（ラジアン単位）
-			float angleDeg = kAngleUnit * i;
-			float angleRad = angleDeg * (std::numbers::pi_v<float> / 180.0f);
-
-			// Z軸回転行列を作成
-			Matrix4x4 matrixRotation = MakeRotateZMatrix(angleRad);
-
-			// 回転させた速度ベクトルを得る
-			velocity = Transform(velocity, matrixRotation);
+	// 1フレーム分の秒数進める（移動・寿命・α をまとめて計算）
+	particles_.Update(1.0f / 60.0f);
 
-			// 移動処理
-			worldTransforms_[i].translation_.x += velocity.x;
-			worldTransforms_[i].translation_.y += velocity.y;
-			worldTransforms_[i].translation_.z += velocity.z;
-		}
-
-		// アフィン行列の計算と転送（VRAM）
-		WorldTransformUpdate(worldTransform); // 行列の更新
-		worldTransform.TransferMatrix(); // VRAMに転送
-	}
-
-	// カウンターを1フレーム分の秒数進める
-	counter_ += 1.0f / 60.0f;
-
-	// 存続時間の上限に達したら
-	if (counter_ >= kDuration) {
-		counter_ = kDuration;
-		// 終了扱いにする
+	// 全粒の寿命が尽きたら終了扱いにする
+	if (particles_.GetCount() == 0) {
 		isFinished_ = true;
+		return;
 	}
 
-	    // フェードアウト用のアルファ値を計算
-	float t = counter_ / kDuration;
-	color_.w = std::clamp(1.0f - t, 0.0f, 1.0f);
-
-	// 色を GPU に反映
-	objectColor_.SetColor(color_);
+	// 生存している粒を描画スロットへ書き出す
+	for (uint32_t i = 0; i < particles_.GetCount(); ++i) {
+		worldTransforms_[i].translation_ = particles_.GetPosition(i);
+		// アフィン行列の計算
+		WorldTransformUpdateFast(worldTransforms_[i]);
+	}
 }
 
-void DeathParticles::Draw() {
+void DeathParticles::Draw(RenderSnapshot& snapshot) {
 	// 終了なら何もしない
 	if (isFinished_) {
 		return;
 	}
-	for (const WorldTransform& worldTransform : worldTransforms_) {
-		// 第3引数に &objectColor_ を渡すと色変更が反映される
-		model_->Draw(worldTransform, *camera_, &objectColor_);
+	for (uint32_t i = 0; i < particles_.GetCount(); ++i) {
+		// 第3引数に色を渡すと粒ごとの色・αが反映される
+		snapshot.AddModel(model_, worldTransforms_[i], particles_.GetColor(i));
 	}
-}
\ No newline at end of file
+}
@@ -1,6 +1,9 @@
 #pragma once
+#include "CachedModel.h"
 #include "KamataEngine.h"
 #include "Method.h"
+#include "ParticleSystem.h"
+#include "RenderSnapshot.h"
 #include "TransformWorld.h"
 #include <array>
 
@@ -8,35 +11,33 @@ using namespace KamataEngine;
 
 class DeathParticles {
 public:
-	void Initialize(Model* model, Camera* camera, const Vector3& position);
+	// 描画用の資源と粒の配列を用意する（シーンの初期化で 1 回だけ。終了した状態で始まる）
+	void Initialize(CachedModel* model);
+	// position から放出し直す（確保はしないので、プレイ中に何度呼んでもよい）
+	void Start(const Vector3& position);
 	void Update();
-	void Draw();
+	void Draw(RenderSnapshot& snapshot);
 
 	// デスフラグのgetter
 	bool IsFinished() const { return isFinished_; };
 
 private:
 	// モデル
-	KamataEngine::Model* model_ = nullptr;
-	// カメラ
-	KamataEngine::Camera* camera_ = nullptr;
+	CachedModel* model_ = nullptr;
 
 	// パーティクルの個数
 	static inline const uint32_t kNumParticles = 8;
 
 	// 終了フラグ
-	bool isFinished_ = false;
-	// 経過時間カウント
-	float counter_ = 0.0f;
+	bool isFinished_ = true;
 
-	// 色変更オブジェクト
-	ObjectColor objectColor_;
-	// 色の数値
-	Vector4 color_;
+	// 粒の位置・速度・寿命・色（SoA）
+	ParticleSystem particles_;
 
+	// 描画用スロット（生存している粒の数だけ使う。色は particles_ のものをそのまま写す）
 	std::array<WorldTransform, kNumParticles> worldTransforms_;
 
 	static inline const float kDuration = 2.0f;
-	static inline const float kSpeed = 0.01f;
-	static inline const float kAngleUnit = 360.0f / 8.0f;
+	// 1フレームあたりの移動量（旧実装は二重ループで毎フレーム8回ずつ動いていたので、その見た目に合わせた値）
+	static inline const float kSpeed = 0.08f;
 };
@@ -0,0 +1,186 @@
+#pragma once
+#include "FastMath.h"
+#include <cstdint>
+#include <iterator>
+#include <numbers>
+
+// イージング曲線
+// どれも t = 0 で 0、t = 1 で 1 になる（Back と Elastic は途中で範囲をはみ出す）。
+// 引数は 0〜1 に収まっている前提で、範囲外のクランプはしない（Timeline が進み具合を 0〜1 にしてから渡す）。
+// sin/cos を使う曲線は見た目用なので FastMath の近似で求める。速いのは Apply4 の FastSinCos4 で、
+// スカラー版の FastSin/FastCos は速さのためではなく、Timeline が 4 つずつの端数を求めたときに Apply4 と同じ値にするため。
+enum class Ease : uint8_t {
+	kLinear,
+	kInQuad,
+	kOutQuad,
+	kInOutQuad,
+	kInCubic,
+	kOutCubic,
+	kInOutCubic, // Method.h の EaseInOut と同じ
+	kInSine,
+	kOutSine,
+	kInOutSine,
+	kInBack,
+	kOutBack,
+	kOutElastic,
+	kOutBounce,
+	kCount,
+};
+
+namespace Easing {
+
+inline const char* GetName(Ease ease) {
+	static const char* const kNames[] = {
+	    "Linear", "InQuad", "OutQuad", "InOutQuad", "InCubic", "OutCubic", "InOutCubic", "InSine", "OutSine", "InOutSine", "InBack", "OutBack", "OutElastic", "OutBounce",
+	};
+	static_assert(std::size(kNames) == static_cast<size_t>(Ease::kCount));
+	return kNames[static_cast<size_t>(ease)];
+}
+
+constexpr float Linear(float t) { return t; }
+constexpr float InQuad(float t) { return t * t; }
+constexpr float OutQuad(float t) { return 1.0f - (1.0f - t) * (1.0f - t); }
+constexpr float InOutQuad(float t) {
+	const float u = -2.0f * t + 2.0f;
+	return t < 0.5f ? 2.0f * t * t : 1.0f - u * u / 2.0f;
+}
+constexpr float InCubic(float t) { return t * t * t; }
+constexpr float OutCubic(float t) { return 1.0f - (1.0f - t) * (1.0f - t) * (1.0f - t); }
+constexpr float InOutCubic(float t) {
+	const float u = -2.0f * t + 2.0f;
+	return t < 0.5f ? 4.0f * t * t * t : 1.0f - u * u * u / 2.0f;
+}
+inline float InSine(float t) { return 1.0f - FastCos(t * std::numbers::pi_v<float> / 2.0f); }
+inline float OutSine(float t) { return FastSin(t * std::numbers::pi_v<float> / 2.0f); }
+inline float InOutSine(float t) { return 0.5f - 0.5f * FastCos(t * std::numbers::pi_v<float>); }
+// 少し手前に引いてから動き出す / 少し行き過ぎてから戻る
+constexpr float InBack(float t) {
+	const float c1 = 1.70158f;
+	return (c1 + 1.0f) * t * t * t - c1 * t * t;
+}
+constexpr float OutBack(float t) {
+	const float c1 = 1.70158f;
+	const float u = t - 1.0f;
+	return 1.0f + (c1 + 1.0f) * u * u * u + c1 * u * u;
+}
+// 行き過ぎを繰り返しながら収まる（減衰は 2^(-10t) の代わりに (1-t)^4 で近似する）
+inline float OutElastic(float t) {
+	const float u = 1.0f - t;
+	return 1.0f - u * u * u * u * FastCos(t * 6.5f * std::numbers::pi_v<float>);
+}
+// 跳ねながら着地する
+constexpr float OutBounce(float t) {
+	const float n1 = 7.5625f;
+	const float d1 = 2.75f;
+	if (t < 1.0f / d1) {
+		return n1 * t * t;
+	} else if (t < 2.0f / d1) {
+		t -= 1.5f / d1;
+		return n1 * t * t + 0.75f;
+	} else if (t < 2.5f / d1) {
+		t -= 2.25f / d1;
+		return n1 * t * t + 0.9375f;
+	}
+	t -= 2.625f / d1;
+	return n1 * t * t + 0.984375f;
+}
+
+// 曲線をコンパイル時に選ぶ（Timeline はこれで曲線ごとのループを作る）
+template<Ease E> inline float Apply(float t) {
+	if constexpr (E == Ease::kLinear) {
+		return Linear(t);
+	} else if constexpr (E == Ease::kInQuad) {
+		return InQuad(t);
+	} else if constexpr (E == Ease::kOutQuad) {
+		return OutQuad(t);
+	} else if constexpr (E == Ease::kInOutQuad) {
+		return InOutQuad(t);
+	} else if constexpr (E == Ease::kInCubic) {
+		return InCubic(t);
+	} else if constexpr (E == Ease::kOutCubic) {
+		return OutCubic(t);
+	} else if constexpr (E == Ease::kInOutCubic) {
+		return InOutCubic(t);
+	} else if constexpr (E == Ease::kInSine) {
+		return InSine(t);
+	} else if constexpr (E == Ease::kOutSine) {
+		return OutSine(t);
+	} else if constexpr (E == Ease::kInOutSine) {
+		return InOutSine(t);
+	} else if constexpr (E == Ease::kInBack) {
+		return InBack(t);
+	} else if constexpr (E == Ease::kOutBack) {
+		return OutBack(t);
+	} else if constexpr (E == Ease::kOutElastic) {
+		return OutElastic(t);
+	} else {
+		static_assert(E == Ease::kOutBounce);
+		return OutBounce(t);
+	}
+}
+
+#ifdef METHOD_USE_SSE
+// sin/cos を使う曲線か（4 つずつ FastSinCos4 でまとめて求められる）
+template<Ease E> constexpr bool kUsesSinCos = E == Ease::kInSine || E == Ease::kOutSine || E == Ease::kInOutSine || E == Ease::kOutElastic;
+
+// sin/cos を使う曲線を 4 つまとめて求める（値はスカラー版と同じ）
+template<Ease E> inline __m128 Apply4(__m128 t) {
+	static_assert(kUsesSinCos<E>);
+	const __m128 one = _mm_set1_ps(1.0f);
+	__m128 s, c;
+	if constexpr (E == Ease::kInSine) {
+		FastSinCos4(_mm_mul_ps(t, _mm_set1_ps(std::numbers::pi_v<float> / 2.0f)), s, c);
+		return _mm_sub_ps(one, c);
+	} else if constexpr (E == Ease::kOutSine) {
+		FastSinCos4(_mm_mul_ps(t, _mm_set1_ps(std::numbers::pi_v<float> / 2.0f)), s, c);
+		return s;
+	} else if constexpr (E == Ease::kInOutSine) {
+		FastSinCos4(_mm_mul_ps(t, _mm_set1_ps(std::numbers::pi_v<float>)), s, c);
+		const __m128 half = _mm_set1_ps(0.5f);
+		return _mm_sub_ps(half, _mm_mul_ps(half, c));
+	} else {
+		FastSinCos4(_mm_mul_ps(t, _mm_set1_ps(6.5f * std::numbers::pi_v<float>)), s, c);
+		const __m128 u = _mm_sub_ps(one, t);
+		const __m128 u2 = _mm_mul_ps(u, u);
+		return _mm_sub_ps(one, _mm_mul_ps(_mm_mul_ps(u2, u2), c));
+	}
+}
+#endif
+
+// 曲線を実行時に選ぶ
+inline float Apply(Ease ease, float t) {
+	switch (ease) {
+	case Ease::kLinear:
+		return Apply<Ease::kLinear>(t);
+	case Ease::kInQuad:
+		return Apply<Ease::kInQuad>(t);
+	case Ease::kOutQuad:
+		return Apply<Ease::kOutQuad>(t);
+	case Ease::kInOutQuad:
+		return Apply<Ease::kInOutQuad>(t);
+	case Ease::kInCubic:
+		return Apply<Ease::kInCubic>(t);
+	case Ease::kOutCubic:
+		return Apply<Ease::kOutCubic>(t);
+	case Ease::kInOutCubic:
+		return Apply<Ease::kInOutCubic>(t);
+	case Ease::kInSine:
+		return Apply<Ease::kInSine>(t);
+	case Ease::kOutSine:
+		return Apply<Ease::kOutSine>(t);
+	case Ease::kInOutSine:
+		return Apply<Ease::kInOutSine>(t);
+	case Ease::kInBack:
+		return Apply<Ease::kInBack>(t);
+	case Ease::kOutBack:
+		return Apply<Ease::kOutBack>(t);
+	case Ease::kOutElastic:
+		return Apply<Ease::kOutElastic>(t);
+	case Ease::kOutBounce:
+		return Apply<Ease::kOutBounce>(t);
+	default:
+		return t;
+	}
+}
+
+} // namespace Easing
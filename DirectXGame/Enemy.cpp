@@ -1,41 +1,43 @@
 #define NOMINMAX 
 #include "Enemy.h"
+#include "Profiler.h"
 #include <algorithm>
 #include <numbers>
 
 using namespace KamataEngine;
 
-void Enemy::Initialize(Model* model, Camera* camera, const Vector3& position) {
+void Enemy::Initialize(CachedModel* model, Timeline* timeline, const Vector3& position) {
 	model_ = model;
-	camera_ = camera;
 
-	// ワールド変換の初期化
-	worldTransform_.Initialize();
+	// ワールド変換の初期化（描くときは RenderSnapshot が matWorld_ を写すので、定数バッファは作らない）
 	worldTransform_.translation_ = position;
 	worldTransform_.rotation_.y = -std::numbers::pi_v<float> / 2.0f;
 
 	// 移動速度の初期化（左方向）
 	velocity_ = {-kWalkSpeed, 0.0f, 0.0f};
 
-	// タイマー初期化
-	walkTimer_ = 0.0f;
+	// 歩行の揺れ：kWalkMotionAngleStart 〜 (kWalkMotionAngleStart + kWalkMotionAngleEnd) / 2 を sin の形で往復
+	// （片道が周期の半分。周期の 1/4 ぶん進めて、中ほどの角度から始める）
+	timeline_ = timeline;
+	Timeline::Track walk;
+	walk.target = &worldTransform_.rotation_.z;
+	walk.from = kWalkMotionAngleStart * (std::numbers::pi_v<float> / 180.0f);
+	walk.to = (kWalkMotionAngleStart + kWalkMotionAngleEnd) / 2.0f * (std::numbers::pi_v<float> / 180.0f);
+	walk.duration = kWalkMotionTime / 2.0f;
+	walk.delay = -kWalkMotionTime / 4.0f;
+	walk.ease = Ease::kInOutSine;
+	walk.loop = Timeline::Loop::kPingPong;
+	walk.autoPlay = true;
+	walkTrack_ = timeline_->Add(walk);
+	worldTransform_.rotation_.z = (walk.from + walk.to) / 2.0f;
+
+	// 開始時のフェードインの間は動かないので、ここで 1 回だけ行列を作っておく
+	WorldTransformUpdateFast(worldTransform_);
 }
 
 void Enemy::Update() {
-	// 時間経過
-	walkTimer_ += 1.0f / 60.0f;
-
-	// t を [0,1] にループ
-	float t = walkTimer_ / kWalkMotionTime;
-	if (t >= 1.0f) {
-		t -= 1.0f;
-		walkTimer_ = 0.0f;
-	}
-
-	// 角度補間 [degree → radian変換]
-	float param = std::sin((2.0f * std::numbers::pi_v<float>)*(walkTimer_ / kWalkMotionTime));
-	float degree = kWalkMotionAngleStart + kWalkMotionAngleEnd * (param + 1.0f) / 2.0f;
-	float angleRad = degree * (std::numbers::pi_v<float> / 180.0f);
+	PROFILE_SCOPE("Enemies");
+	// 歩行の揺れ（rotation_.z）は walkTrack_ が書き換えている
 
 	// 最後に AABB を更新
 	const Vector3& p = worldTransform_.translation_;
@@ -54,24 +56,14 @@ void Enemy::Update() {
 		worldTransform_.translation_.y -= 0.02f;
 	}
 
-	// Z軸に対して角度反映（例: 足を振るなどに応用できる）
-	worldTransform_.rotation_.z = angleRad;
-
 	// 移動
 	worldTransform_.translation_.x += velocity_.x;
 
 	// 行列更新
-	WorldTransformUpdate(worldTransform_);
-	worldTransform_.TransferMatrix();
-}
-
-void Enemy::UpdateFreeze() {
-	// 歩行タイマーや位置は進めない
-	WorldTransformUpdate(worldTransform_);
-	worldTransform_.TransferMatrix();
+	WorldTransformUpdateFast(worldTransform_);
 }
 
-void Enemy::Draw() { model_->Draw(worldTransform_, *camera_); }
+void Enemy::Draw(RenderSnapshot& snapshot) { snapshot.AddModel(model_, worldTransform_); }
 
 AABB Enemy::GetAABB() {
 	Vector3 pos = {worldTransform_.matWorld_.m[3][0], worldTransform_.matWorld_.m[3][1], worldTransform_.matWorld_.m[3][2]}; // ワールド行列から座標取得
@@ -91,6 +83,8 @@ void Enemy::TakeDamage(int amount) {
 
 	if (hp_ <= 0) {
 		isDead_ = true;
+		// 揺れを止める（リストから外れて更新も描画もされなくなる）
+		timeline_->Stop(walkTrack_);
 		// ここでは「消滅は GameScene 側」で行う
 	}
 }
@@ -1,6 +1,9 @@
 #pragma once
+#include "CachedModel.h"
 #include "KamataEngine.h"
 #include "Method.h"
+#include "RenderSnapshot.h"
+#include "Timeline.h"
 #include "TransformWorld.h"
 
 using namespace KamataEngine;
@@ -9,10 +12,10 @@ class Player;
 
 class Enemy {
 public:
-	void Initialize(Model* model, Camera* camera, const Vector3& position);
+	// timeline … 歩行の揺れを登録する先
+	void Initialize(CachedModel* model, Timeline* timeline, const Vector3& position);
 	void Update();
-	void UpdateFreeze();
-	void Draw();
+	void Draw(RenderSnapshot& snapshot);
 
 	// AABBを取得
 	AABB GetAABB();
@@ -30,15 +33,14 @@ private:
 	// ワールド変換データ
 	WorldTransform worldTransform_;
 	// モデル
-	Model* model_ = nullptr;
-	// カメラ
-	Camera* camera_ = nullptr;
+	CachedModel* model_ = nullptr;
 	// 歩行の速さ
 	static inline const float kWalkSpeed = 0.03f;
 	// 速度
 	Vector3 velocity_ = {};
-	// 経過時間
-	float walkTimer_ = 0.0f;
+	// 歩行の揺れ（Timeline が rotation_.z を書き換える）
+	Timeline* timeline_ = nullptr;
+	Timeline::Handle walkTrack_ = Timeline::kNone;
 	// 最初の角度[度]
 	static inline const float kWalkMotionAngleStart = -30.0f;
 	// 最後の角度[度]
@@ -1,11 +1,18 @@
-#define NOMINMAX 
+#define NOMINMAX
 #include "Fade.h"
 using namespace KamataEngine;
 
-void Fade::Initialize() {
+Fade::~Fade() {
+	delete sprite_;
+	if (sprite_) {
+		AssetCache::GetInstance()->ReleaseTexture(textureHandle_);
+	}
+}
+
+void Fade::Initialize(Timeline* timeline) {
 
 	// 1x1白テクスチャ推奨（色で黒にする）
-	textureHandle_ = TextureManager::Load("black1x1.png");
+	textureHandle_ = AssetCache::GetInstance()->AcquireTexture("black1x1.png");
 
 	// ★重要：sprite_->Create(...) ではなく Sprite::Create(...) で生成
 	sprite_ = Sprite::Create(textureHandle_, {0.0f, 0.0f});
@@ -15,82 +22,50 @@ void Fade::Initialize() {
 	sprite_->SetColor(Vector4(0.0f, 0.0f, 0.0f, 0.0f));
 
 	status_ = Status::None;
-	duration_ = 0.0f;
-	counter_ = 0.0f;
-	finished_ = false;
+
+	// 向きと時間は Start で決める
+	timeline_ = timeline;
+	Timeline::Track track;
+	track.target = &alpha_;
+	alphaTrack_ = timeline_->Add(track);
 }
 
 void Fade::Start(Status status, float durationSec) {
 	status_ = status;
-	duration_ = std::max(0.0001f, durationSec); // 0除算よけ
-	counter_ = 0.0f;
 
 	// 開始直後の表示を整える
 	switch (status_) {
 	case Status::FadeIn: // 黒→透明：開始時は黒
-		sprite_->SetColor(Vector4(0, 0, 0, 1));
+		alpha_ = 1.0f;
+		timeline_->Play(alphaTrack_, 1.0f, 0.0f, durationSec);
 		break;
 	case Status::FadeOut: // 透明→黒：開始時は透明
-		sprite_->SetColor(Vector4(0, 0, 0, 0));
+		alpha_ = 0.0f;
+		timeline_->Play(alphaTrack_, 0.0f, 1.0f, durationSec);
 		break;
 	default:
+		timeline_->Stop(alphaTrack_);
 		break;
 	}
 }
 
-void Fade::Update() {
-	// 教材どおり固定 1/60 秒加算
-	UpdateInternal(1.0f / 60.0f);
-}
-
 void Fade::Stop() {
-    status_ = Status::None;
+	status_ = Status::None;
+	timeline_->Stop(alphaTrack_);
 }
 
 bool Fade::IsFinished() const {
 	if (status_ == Status::None)
 		return true;
-	// FadeIn / FadeOut 共通で「経過時間が満了したら完了」
-	return counter_ >= duration_;
+	// FadeIn / FadeOut 共通で「トラックが終わりまで進んだら完了」
+	return !timeline_->IsPlaying(alphaTrack_);
 }
 
-void Fade::UpdateInternal(float deltaSeconds) {
-	counter_ += deltaSeconds;
-	float t = std::clamp(counter_ / duration_, 0.0f, 1.0f);
-
-	switch (status_) {
-	case Status::None:
-		break;
-	case Status::FadeOut:
-		// 透明(0) → 黒(1) に増加
-		alpha_ = t; // スクショの式：clamp(counter_/duration, 0, 1)
-		break;
-	case Status::FadeIn:
-		// 黒(1) → 透明(0) に減少
-		alpha_ = 1.0f - t;
-		break;
-	default:
-		break;
-	}
-
-	sprite_->SetColor(Vector4(0.0f, 0.0f, 0.0f, alpha_));
-
-	// 打ち止め
-	if (counter_ >= duration_) {
-		finished_ = true;
-		counter_ = duration_;
-		// フェーズ完了後も黒板を残したい時は None にしない
-		// 自動で終了したいなら↓を有効化
-		// status_ = Status::None;
-	}
-}
-
-void Fade::Draw() {
+void Fade::Draw(RenderSnapshot& snapshot) {
+	// フェーズ完了後も黒板を残したい時は None にしない（終わりの値のまま止まる）
 	if (status_==Status::None) {
 		return;
 	}
-	// フェードは最前面に出したいので、単独で PreDraw→Draw→PostDraw
-	Sprite::PreDraw(DirectXCommon::GetInstance()->GetCommandList());
-	sprite_->Draw();
-	Sprite::PostDraw();
-}
\ No newline at end of file
+	// フェードは最前面に出したいので、シーンの描画の最後に積む
+	snapshot.AddSprite(sprite_, Vector4(0.0f, 0.0f, 0.0f, alpha_));
+}
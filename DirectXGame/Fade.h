@@ -1,5 +1,8 @@
 #pragma once
+#include "AssetCache.h"
 #include "KamataEngine.h"
+#include "RenderSnapshot.h"
+#include "Timeline.h"
 #include <algorithm>
 
 using namespace KamataEngine;
@@ -14,19 +17,19 @@ public:
 	};
 
 public:
+	~Fade();
+
 	// 画面サイズはデフォルト 1280x720。必要なら指定してね
-	void Initialize();
+	// timeline … アルファを動かすトラックを登録する先（シーンが毎フレーム Update する）
+	void Initialize(Timeline* timeline);
 
 	// 任意タイミングでフェードを開始
 	// durationSec: 継続時間（秒）
 	void Start(Status status, float durationSec);
 	void Stop();
 
-	// 固定Δt版（教材どおり 1/60 を内部で加算）
-	void Update();
-
-	// 最前面に描画（PreDraw〜PostDraw含む）
-	void Draw();
+	// 最前面に描く（アルファは timeline が進め、色は描くときに渡す）
+	void Draw(RenderSnapshot& snapshot);
 
 	// 便利系
 	bool IsFinished() const;
@@ -34,17 +37,17 @@ public:
 
 	Status GetStatus() const { return status_; }
 	bool IsActive() const { return status_ != Status::None; }
-	void UpdateInternal(float deltaSeconds);
 
 private:
 	Sprite* sprite_ = nullptr;
 	uint32_t textureHandle_ = 0;
 
 	Status status_ = Status::None;
-	float duration_ = 0.0f; // フェード総時間[sec]
-	float counter_ = 0.0f;  // 経過時間[sec]
-	float alpha_ = 0.0f;    // 現在アルファ（0〜1）
-	bool finished_ = false; // そのフェーズを完走したか
+	float alpha_ = 0.0f; // 現在アルファ（0〜1）
+
+	// アルファを 0〜1 で動かすトラック
+	Timeline* timeline_ = nullptr;
+	Timeline::Handle alphaTrack_ = Timeline::kNone;
 
 	// 画面サイズ
 	uint32_t screenW_ = 1280;
@@ -1,4 +1,7 @@
 #include "GameScene.h"
+#include "AllocTracker.h"
+#include "JobSystem.h"
+#include "Profiler.h"
 
 using namespace KamataEngine;
 
@@ -13,64 +16,53 @@ constexpr int kScreenH = 720;
 //}
 
 GameScene::~GameScene() {
-	// 3Dモデルデータの開放
-	delete playerModel_;
-	// 3Dモデルデータの開放
-	delete enemyModel_;
-	// デスパーティクルモデルの開放
-	delete particleModel_;
-	// ブロックモデルデータの開放
-	delete modelBlock_;
-	// 天球モデルデータの開放
-	delete modelSkydome_;
-	// デバッグカメラの開放
-	delete debugCamera_;
-	// 自キャラの開放
-	delete player_;
-	// 天球の開放
-	delete skydome_;
-	// デスパーティクルの開放
-	delete deathParticles_;
-	// フェードの開放
-	delete fade_;
-	// ゴールの開放
-	delete goal_;
-	goal_ = nullptr;
-	// 敵キャラの開放
-	for (Enemy* enemy : enemies_) {
-		delete enemy;
+	// モデル・テクスチャはキャッシュに返す（破棄はキャッシュ側で行う）
+	AssetCache* assetCache = AssetCache::GetInstance();
+	assetCache->ReleaseModel(playerModel_);
+	assetCache->ReleaseModel(enemyModel_);
+	assetCache->ReleaseModel(particleModel_);
+	assetCache->ReleaseModel(modelBlock_);
+	assetCache->ReleaseModel(goalModel_);
+	// 操作説明スプライトの開放
+	if (moveSprite_) {
+		delete moveSprite_;
+		assetCache->ReleaseTexture(textureHandle_);
 	}
-	enemies_.clear();
-	// マップチップフィールドの開放
-	delete mapChipField_;
+	// 自キャラ・敵・ブロックなどシーンのオブジェクトは、このあと arena_ の破棄でまとめて開放される
+}
 
-	for (std::vector<WorldTransform*>& worldTransformBlockLine : worldTransformBlocks_) {
-		for (WorldTransform* worldTransformBlock : worldTransformBlockLine) {
-			delete worldTransformBlock;
-		}
+void GameScene::PrefetchAssets() {
+	AssetLoader* assetLoader = AssetLoader::GetInstance();
+	for (const char* name : {"player", "enemy", "particle", "cube", "sky_sphere", "goal"}) {
+		assetLoader->Request(AssetLoader::Kind::kModel, name);
 	}
-	worldTransformBlocks_.clear();
+	assetLoader->Request(AssetLoader::Kind::kTexture, "scene/move.png");
 }
 
 void GameScene::Initialize() {
 
-	// 3Dモデルデータの生成
-	playerModel_ = Model::CreateFromOBJ("player", true);
-	// 3Dモデルデータの生成
-	enemyModel_ = Model::CreateFromOBJ("enemy", true);
+	// 3Dモデルデータはキャッシュから取得（2回目以降は読み込まない）
+	AssetCache* assetCache = AssetCache::GetInstance();
+	playerModel_ = assetCache->AcquireModel("player");
+	enemyModel_ = assetCache->AcquireModel("enemy");
 	// 敵を複数生成
 	const int enemyCount = 3;
 	for (int32_t i = 0; i < enemyCount; ++i) {
-		Enemy* newEnemy = new Enemy();
+		Enemy* newEnemy = arena_.New<Enemy>();
 		Vector3 enemyPosition = {float(i + 7) * 7.0f, 1.0f, 0.0f}; // 一体ずつX方向にずらす
-		newEnemy->Initialize(enemyModel_, &camera_, enemyPosition);
+		newEnemy->Initialize(enemyModel_, &timeline_, enemyPosition);
 		enemies_.push_back(newEnemy);
 	}
-	particleModel_ = Model::CreateFromOBJ("particle", true);
+	// 当たり判定用の作業領域（敵の数ぶん先に確保）
+	enemyBounds_.Reserve(enemyCount);
+	enemyRefs_.reserve(enemyCount);
+	enemyHits_.reserve(enemyCount);
+	particleModel_ = assetCache->AcquireModel("particle");
+	// デス演出のパーティクル（プレイ中に確保しないよう、ここで作っておいて Start で出す）
+	deathParticles_ = arena_.New<DeathParticles>();
+	deathParticles_->Initialize(particleModel_);
 	// ブロックモデルデータの生成
-	modelBlock_ = Model::CreateFromOBJ("cube", true);
-	// 天球モデルデータの生成
-	modelSkydome_ = Model::CreateFromOBJ("sky_sphere", true);
+	modelBlock_ = assetCache->AcquireModel("cube");
 
 	// カメラのfarZを適度に大きい値に
 	camera_.farZ = 1000.0f;
@@ -79,24 +71,24 @@ void GameScene::Initialize() {
 	camera_.translation_.z = -30.0f;
 
 	// デバッグカメラの生成
-	debugCamera_ = new DebugCamera(1280, 720);
+	debugCamera_ = arena_.New<DebugCamera>(1280, 720);
 
 	// マップチップフィールドの生成
-	mapChipField_ = new MapChipField;
+	mapChipField_ = arena_.New<MapChipField>();
 	// CSVファイルからマップデータを読み込み
 	mapChipField_->LoadMapChipCsv("Resources/block.csv");
 
 	// 自キャラの生成
-	player_ = new Player;
+	player_ = arena_.New<Player>();
 	// 座標をマップチップ番号で指定
 	Vector3 playerPosition = mapChipField_->GetMapChipPositionByIndex(1, 18);
 	// 自キャラの初期化
-	player_->Initialize(playerModel_, &camera_, playerPosition);
+	player_->Initialize(playerModel_, &timeline_, playerPosition);
 	// マップチップデータのセット
 	player_->SetMapChipField(mapChipField_);
 
 	// 天球の生成
-	skydome_ = new Skydome;
+	skydome_ = arena_.New<Skydome>();
 	// 天球の初期化
 	skydome_->Initialize();
 
@@ -105,82 +97,56 @@ void GameScene::Initialize() {
 	// ゲームプレイフェーズから開始
 	phase_ = Phase::kPlay;
 
-	Model* goalModel = Model::CreateFromOBJ("goal", true);
-	; // まずは流用
+	goalModel_ = assetCache->AcquireModel("goal");
 	                                // 配置：固定 or CSVから検索（ここでは軽いCSV検索例：タイルID=9をゴール扱い）
 	Vector3 goalPos = mapChipField_->GetMapChipPositionByIndex(90, 18);
 
-	goal_ = new Goal();
-	goal_->Initialize(goalModel, goalPos);
+	goal_ = arena_.New<Goal>();
+	goal_->Initialize(goalModel_, &timeline_, goalPos);
 
 	// フェード
-	fade_ = new Fade();
-	fade_->Initialize();
+	fade_ = arena_.New<Fade>();
+	fade_->Initialize(&timeline_);
 
 	// ★ゲーム開始時は黒→透明のフェードイン。完了までは動かさない
 	fade_->Start(Fade::Status::FadeIn, kFadeTimeSec);
 	phase_ = Phase::kFadeIn;
 
 	// カメラコントローラーの初期化
-	cameraController_ = new CameraController; // 生成
-	cameraController_->Initialize();          // 初期化
-	cameraController_->SetTarget(player_);    // 追従対象をセット
-	cameraController_->Reset();               // リセット（瞬間合わせ）
+	cameraController_ = arena_.New<CameraController>(); // 生成
+	cameraController_->Initialize();                    // 初期化
+	cameraController_->SetTarget(player_);              // 追従対象をセット
+	cameraController_->Reset();                         // リセット（瞬間合わせ）
 
-	textureHandle_ = TextureManager::Load("scene/move.png");
+	textureHandle_ = assetCache->AcquireTexture("scene/move.png");
 	// ★重要：sprite_->Create(...) ではなく Sprite::Create(...) で生成
 	moveSprite_ = Sprite::Create(textureHandle_, {0.0f, 0.0f});
 	moveSprite_->SetSize(Vector2(1280.0f, 720.0f));
 }
 
-void GameScene::Update() {
+void GameScene::Update(const InputState& input) {
 	ChangePhase();
 
-	switch (phase_) {
-	case Phase::kFadeIn:
+	// アニメーションを進める（このあとの各 Update は書き換わった値で行列を作る）
+	timeline_.Update(1.0f / 60.0f);
 
-		if (isDebugCameraActive_) {
-			debugCamera_->Update();
-			// DebugCamera から Camera を取得し、camera_ にコピー
-			camera_.matView = debugCamera_->GetCamera().matView;
-			camera_.matProjection = debugCamera_->GetCamera().matProjection;
+#ifdef USE_IMGUI
+	// シーンが arena_ に置いているもの
+	ImGui::Begin("Scene memory");
+	ImGui::Text("used %.1f KB / reserved %.1f KB", arena_.GetUsedBytes() / 1024.0, arena_.GetReservedBytes() / 1024.0);
+	ImGui::Text("allocations %zu, objects %zu", arena_.GetAllocationCount(), arena_.GetObjectCount());
+	ImGui::End();
+#endif
 
-			camera_.TransferMatrix();
-		} else {
-			// カメラコントローラーの更新
-			cameraController_->Update();
+	switch (phase_) {
+	case Phase::kFadeIn:
 
-			// カメラを controller から取得して camera_ に反映
-			const Camera& controlledCam = cameraController_->GetCamera();
-			camera_.matView = controlledCam.matView;
-			camera_.matProjection = controlledCam.matProjection;
+		// カメラの更新
+		UpdateCamera();
 
-			// ここで行列転送も必要（たとえば TransferMatrix などが必要なら）
-			camera_.TransferMatrix();
-		}
+		// ブロックの更新（自キャラと敵は止まっているので、Initialize で作った行列のまま）
+		UpdateTransforms();
 
-		// ブロックの更新
-		for (std::vector<WorldTransform*>& worldTransformBlockLine : worldTransformBlocks_) {
-			for (WorldTransform* worldTransformBlock : worldTransformBlockLine) {
-				if (!worldTransformBlock)
-					continue;
-				// アフィン変換行列の作成
-				Matrix4x4 blockAffineMatrix = MakeAffineMatrix(worldTransformBlock->scale_, worldTransformBlock->rotation_, worldTransformBlock->translation_);
-				// ワールド行列に代入
-				worldTransformBlock->matWorld_ = blockAffineMatrix;
-				// 定数バッファの転送
-				worldTransformBlock->TransferMatrix();
-			}
-		}
-
-		if (player_) {
-			player_->UpdateFreeze();
-		}
-		for (auto* e : enemies_) {
-			e->UpdateFreeze();
-		}
-
-		fade_->Update();
 		if (fade_->IsFinished()) {
 			fade_->Stop(); // 完了したら止めて描画コスト削減
 			phase_ = Phase::kPlay;
@@ -188,58 +154,46 @@ void GameScene::Update() {
 		break;
 
 	case Phase::kPlay: {
+		// プレイ中は確保しない（_DEBUG のビルドでは確保したところで止まる）
+		ALLOC_STEADY_STATE_SCOPE();
+
+		// 敵の更新と敵の AABB 集めはほかと独立なので、ワーカーで回しておく
+		// （どれも 1 つずつ別のものを書くだけなので、スレッド数によらず結果は同じ）
+		JobSystem* jobSystem = JobSystem::GetInstance();
+		CollectEnemies();
+		// 敵キャラの更新
+		JobSystem::Counter enemiesUpdated;
+		jobSystem->ParallelForAsync(enemiesUpdated, static_cast<uint32_t>(enemyRefs_.size()), kEnemyGrain, [this](uint32_t begin, uint32_t end) {
+			for (uint32_t i = begin; i < end; ++i) {
+				enemyRefs_[i]->Update();
+			}
+		});
+		// 敵が動き終わったら AABB をまとめておく（以降の判定はこれを使う）
+		JobSystem::Counter boundsGathered;
+		jobSystem->Then(enemiesUpdated, boundsGathered, [this] { GatherEnemyBounds(); });
 
 		//float dt = 1.0f / 60.0f; // 実フレーム時間を持っているなら差し替え
 		if (goal_)
-			goal_->Update(/*dt*/);
+			goal_->Update();
 
 		// 自キャラの更新
-		player_->Update();
+		player_->Update(input);
 		// 天球の更新
 		skydome_->Update();
-		// 敵キャラの更新
-		for (Enemy* enemy : enemies_) {
-			enemy->Update();
-		}
 #ifdef _DEBUG
-		if (Input::GetInstance()->TriggerKey(DIK_1)) { // 例：キー1で切り替え
+		if (input.IsPressed(Action::kDebugCamera)) { // 例：キー1で切り替え
 			isDebugCameraActive_ = !isDebugCameraActive_;
 		}
 #endif
 
-		if (isDebugCameraActive_) {
-			debugCamera_->Update();
-			// DebugCamera から Camera を取得し、camera_ にコピー
-			camera_.matView = debugCamera_->GetCamera().matView;
-			camera_.matProjection = debugCamera_->GetCamera().matProjection;
-
-			camera_.TransferMatrix();
-		} else {
-			// カメラコントローラーの更新
-			cameraController_->Update();
-
-			// カメラを controller から取得して camera_ に反映
-			const Camera& controlledCam = cameraController_->GetCamera();
-			camera_.matView = controlledCam.matView;
-			camera_.matProjection = controlledCam.matProjection;
-
-			// ここで行列転送も必要（たとえば TransferMatrix などが必要なら）
-			camera_.TransferMatrix();
-		}
+		// カメラの更新
+		UpdateCamera();
 
 		// ブロックの更新
-		for (std::vector<WorldTransform*>& worldTransformBlockLine : worldTransformBlocks_) {
-			for (WorldTransform* worldTransformBlock : worldTransformBlockLine) {
-				if (!worldTransformBlock)
-					continue;
-				// アフィン変換行列の作成
-				Matrix4x4 blockAffineMatrix = MakeAffineMatrix(worldTransformBlock->scale_, worldTransformBlock->rotation_, worldTransformBlock->translation_);
-				// ワールド行列に代入
-				worldTransformBlock->matWorld_ = blockAffineMatrix;
-				// 定数バッファの転送
-				worldTransformBlock->TransferMatrix();
-			}
-		}
+		UpdateTransforms();
+
+		// ワーカーに回したものを待つ（待つ間はこのスレッドも手伝う）
+		jobSystem->Wait(boundsGathered);
 
 		// すべての当たり判定を行う
 		CheckAllCollisions();
@@ -249,32 +203,24 @@ void GameScene::Update() {
 			AABB atk = player_->GetAttackAABB();
 			const Vector3 playerForward = {/* あなたの前方向計算に合わせる（+Xなら {1,0,0}） */ 1.0f, 0.0f, 0.0f};
 
-			for (auto it = enemies_.begin(); it != enemies_.end(); /* no ++ here */) {
-				Enemy* e = *it;
-				if (!e) {
-					it = enemies_.erase(it);
-					continue;
-				}
+			// 先に当たった敵だけを拾ってから処理する
+			enemyBounds_.Query(atk, AABBBatch::Axes::kXYZ, enemyHits_);
+			for (uint32_t index : enemyHits_) {
+				Enemy* e = enemyRefs_[index];
+
+				// ダメージ & ノックバック
+				e->TakeDamage(1);
+				e->ApplyKnockback(playerForward, 0.6f);
 
-				if (IntersectAABB(atk, e->GetAABB())) {
-					// ダメージ & ノックバック
-					e->TakeDamage(1);
-					e->ApplyKnockback(playerForward, 0.6f);
-
-					if (e->IsDead()) {
-						// ★敵デス演出：簡易パーティクルを出してから消す
-						if (!deathParticles_) {
-							const Vector3 pos = e->GetAABB().max; // ざっくり上面。厳密には中心が良い
-							deathParticles_ = new DeathParticles;
-							deathParticles_->Initialize(particleModel_, &camera_, pos);
-						}
-						// リストから除去
-						it = enemies_.erase(it);
-						delete e;
-						continue;
+				if (e->IsDead()) {
+					// ★敵デス演出：簡易パーティクルを出してから消す
+					if (deathParticles_->IsFinished()) {
+						const Vector3 pos = e->GetAABB().max; // ざっくり上面。厳密には中心が良い
+						deathParticles_->Start(pos);
 					}
+					// リストから除去（実体は arena_ にあるのでシーンの終わりに破棄される）
+					enemies_.remove(e);
 				}
-				++it;
 			}
 		}
 
@@ -292,8 +238,7 @@ void GameScene::Update() {
 
 			// 生成処理
 			const Vector3& pos = player_->GetWorldPosition();
-			deathParticles_ = new DeathParticles;
-			deathParticles_->Initialize(particleModel_, &camera_, pos);
+			deathParticles_->Start(pos);
 			phase_ = Phase::kDeath;
 			return;
 		}
@@ -304,45 +249,15 @@ void GameScene::Update() {
 	case Phase::kDeath:
 
 		// パーティクルの更新
-		if (deathParticles_) {
-			deathParticles_->Update();
-		}
-
-		if (isDebugCameraActive_) {
-			debugCamera_->Update();
-			// DebugCamera から Camera を取得し、camera_ にコピー
-			camera_.matView = debugCamera_->GetCamera().matView;
-			camera_.matProjection = debugCamera_->GetCamera().matProjection;
+		deathParticles_->Update();
 
-			camera_.TransferMatrix();
-		} else {
-			// カメラコントローラーの更新
-			cameraController_->Update();
-
-			// カメラを controller から取得して camera_ に反映
-			const Camera& controlledCam = cameraController_->GetCamera();
-			camera_.matView = controlledCam.matView;
-			camera_.matProjection = controlledCam.matProjection;
-
-			// ここで行列転送も必要（たとえば TransferMatrix などが必要なら）
-			camera_.TransferMatrix();
-		}
+		// カメラの更新
+		UpdateCamera();
 
 		// ブロックの更新
-		for (std::vector<WorldTransform*>& worldTransformBlockLine : worldTransformBlocks_) {
-			for (WorldTransform* worldTransformBlock : worldTransformBlockLine) {
-				if (!worldTransformBlock)
-					continue;
-				// アフィン変換行列の作成
-				Matrix4x4 blockAffineMatrix = MakeAffineMatrix(worldTransformBlock->scale_, worldTransformBlock->rotation_, worldTransformBlock->translation_);
-				// ワールド行列に代入
-				worldTransformBlock->matWorld_ = blockAffineMatrix;
-				// 定数バッファの転送
-				worldTransformBlock->TransferMatrix();
-			}
-		}
+		UpdateTransforms();
 
-		if (deathParticles_ && deathParticles_->IsFinished()) {
+		if (deathParticles_->IsFinished()) {
 			result_ = Result::kFailed;
 
 			// 画面フェード（透明→黒）
@@ -355,7 +270,6 @@ void GameScene::Update() {
 	case Phase::kFadeOut:
 
 		// ★フェードアウト中は基本停止。必要なら背景だけUpdateしてもOK
-		fade_->Update();
 		if (fade_->IsFinished()) {
 			finished_ = true; // → タイトルへ
 		}
@@ -366,109 +280,121 @@ void GameScene::Update() {
 	}
 }
 
-void GameScene::Draw() {
+void GameScene::UpdateCamera() {
+	PROFILE_SCOPE("Camera");
+	if (isDebugCameraActive_) {
+		debugCamera_->Update();
+		// DebugCamera から Camera を取得し、camera_ にコピー
+		camera_.matView = debugCamera_->GetCamera().matView;
+		camera_.matProjection = debugCamera_->GetCamera().matProjection;
+	} else {
+		// カメラコントローラーの更新
+		cameraController_->Update();
+
+		// カメラを controller から取得して camera_ に反映
+		const Camera& controlledCam = cameraController_->GetCamera();
+		camera_.matView = controlledCam.matView;
+		camera_.matProjection = controlledCam.matProjection;
+	}
+}
+
+void GameScene::UpdateTransforms() { transforms_.Update(); }
+
+void GameScene::Draw(RenderSnapshot& snapshot) {
+	snapshot.SetCamera(camera_);
+
 	switch (phase_) {
 
 	case Phase::kFadeIn:
 		// プレイヤーの描画
-		player_->Draw();
+		player_->Draw(snapshot);
 		// 天球の描画
-		skydome_->Draw(&camera_);
+		skydome_->Draw(snapshot);
 		// 敵キャラの描画
 		for (Enemy* enemy : enemies_) {
-			enemy->Draw();
+			enemy->Draw(snapshot);
 		}
 		// ブロックの描画
-		for (std::vector<WorldTransform*>& worldTransformBlockLine : worldTransformBlocks_) {
+		for (std::pmr::vector<WorldTransform*>& worldTransformBlockLine : worldTransformBlocks_) {
 			for (WorldTransform* worldTransformBlock : worldTransformBlockLine) {
 				if (!worldTransformBlock)
 					continue;
-				modelBlock_->Draw(*worldTransformBlock, camera_);
+				snapshot.AddModel(modelBlock_, *worldTransformBlock);
 			}
 		}
 		if (goal_)
-			goal_->Draw(camera_);
-		Sprite::PreDraw(DirectXCommon::GetInstance()->GetCommandList());
-		moveSprite_->Draw();
-		Sprite::PostDraw();
+			goal_->Draw(snapshot);
+		snapshot.AddSprite(moveSprite_);
 		// フェードは最後に
-		fade_->Draw();
+		fade_->Draw(snapshot);
 		break;
 
 	case Phase::kPlay:
 		// 自キャラの描画
-		player_->Draw();
+		player_->Draw(snapshot);
 		// 天球の描画
-		skydome_->Draw(&camera_);
+		skydome_->Draw(snapshot);
 		// 敵キャラの描画
 		for (Enemy* enemy : enemies_) {
-			enemy->Draw();
+			enemy->Draw(snapshot);
 		}
 		// ブロックの描画
-		for (std::vector<WorldTransform*>& worldTransformBlockLine : worldTransformBlocks_) {
+		for (std::pmr::vector<WorldTransform*>& worldTransformBlockLine : worldTransformBlocks_) {
 			for (WorldTransform* worldTransformBlock : worldTransformBlockLine) {
 				if (!worldTransformBlock)
 					continue;
-				modelBlock_->Draw(*worldTransformBlock, camera_);
+				snapshot.AddModel(modelBlock_, *worldTransformBlock);
 			}
 		}
 		// ★ゴール描画
 		if (goal_)
-			goal_->Draw(camera_);
-		Sprite::PreDraw(DirectXCommon::GetInstance()->GetCommandList());
-		moveSprite_->Draw();
-		Sprite::PostDraw();
+			goal_->Draw(snapshot);
+		snapshot.AddSprite(moveSprite_);
 		break;
 
 	case Phase::kDeath:
 		// 天球の描画
-		skydome_->Draw(&camera_);
+		skydome_->Draw(snapshot);
 		// 敵キャラの描画
 		for (Enemy* enemy : enemies_) {
-			enemy->Draw();
-		}
-		if (deathParticles_) {
-			deathParticles_->Draw();
+			enemy->Draw(snapshot);
 		}
+		deathParticles_->Draw(snapshot);
 		// ブロックの描画
-		for (std::vector<WorldTransform*>& worldTransformBlockLine : worldTransformBlocks_) {
+		for (std::pmr::vector<WorldTransform*>& worldTransformBlockLine : worldTransformBlocks_) {
 			for (WorldTransform* worldTransformBlock : worldTransformBlockLine) {
 				if (!worldTransformBlock)
 					continue;
-				modelBlock_->Draw(*worldTransformBlock, camera_);
+				snapshot.AddModel(modelBlock_, *worldTransformBlock);
 			}
 		}
 		// ★ゴール描画
 		if (goal_)
-			goal_->Draw(camera_);
-		Sprite::PreDraw(DirectXCommon::GetInstance()->GetCommandList());
-		moveSprite_->Draw();
-		Sprite::PostDraw();
+			goal_->Draw(snapshot);
+		snapshot.AddSprite(moveSprite_);
 		break;
 
 	case Phase::kFadeOut:
 		// 天球の描画
-		skydome_->Draw(&camera_);
+		skydome_->Draw(snapshot);
 		// 敵キャラの描画
 		for (Enemy* enemy : enemies_) {
-			enemy->Draw();
+			enemy->Draw(snapshot);
 		}
 		// ブロックの描画
-		for (std::vector<WorldTransform*>& worldTransformBlockLine : worldTransformBlocks_) {
+		for (std::pmr::vector<WorldTransform*>& worldTransformBlockLine : worldTransformBlocks_) {
 			for (WorldTransform* worldTransformBlock : worldTransformBlockLine) {
 				if (!worldTransformBlock)
 					continue;
-				modelBlock_->Draw(*worldTransformBlock, camera_);
+				snapshot.AddModel(modelBlock_, *worldTransformBlock);
 			}
 		}
 		// ★ゴール描画
 		if (goal_)
-			goal_->Draw(camera_);
-		Sprite::PreDraw(DirectXCommon::GetInstance()->GetCommandList());
-		moveSprite_->Draw();
-		Sprite::PostDraw();
+			goal_->Draw(snapshot);
+		snapshot.AddSprite(moveSprite_);
 		// フェードは最後に
-		fade_->Draw();
+		fade_->Draw(snapshot);
 		break;
 	default:
 		break;
@@ -489,45 +415,60 @@ void GameScene::GenetateBlocks() {
 		worldTransformBlocks_[i].resize(kNumBlockHorizontal);
 	}
 
-	// キューブの生成
+	// キューブの生成（変換は transforms_ に登録し、行列は UpdateTransforms で作る。描くだけなので定数バッファは作らない）
+	transforms_.Reserve(kNumBlockVirtical * kNumBlockHorizontal);
 	for (uint32_t i = 0; i < kNumBlockVirtical; ++i) {
 		for (uint32_t j = 0; j < kNumBlockHorizontal; ++j) {
 			if (mapChipField_->GetMapChipTypeByIndex(j, i) == MapChipType::kBlock) {
-				WorldTransform* worldTransform = new WorldTransform();
-				worldTransform->Initialize();
+				WorldTransform* worldTransform = arena_.New<WorldTransform>();
 				worldTransformBlocks_[i][j] = worldTransform;
 				worldTransformBlocks_[i][j]->translation_ = mapChipField_->GetMapChipPositionByIndex(j, i);
+				transforms_.Add(worldTransform);
 			}
 		}
 	}
 }
 
 void GameScene::CheckAllCollisions() {
+	PROFILE_SCOPE("Collisions");
 #pragma region
 	{
-		// 判定対象1と2の座標
-		AABB aabb1, aabb2;
-
 		// 自キャラの座標
-		aabb1 = player_->GetAABB();
-
-		// 自キャラと敵球すべての当たり判定
-		for (Enemy* enemy : enemies_) {
-			// 敵弾の座標
-			aabb2 = enemy->GetAABB();
-
-			if (IsCollision(aabb1, aabb2)) {
-				// 衝突応答処理
-				// 自キャラの衝突時関数を呼び出す
-				player_->OnCollision(enemy);
-				// 敵の衝突時関数を呼び出す
-				enemy->OnCollision(player_);
-			}
+		AABB aabb1 = player_->GetAABB();
+
+		// 自キャラと敵すべての当たり判定（GatherEnemyBounds で集めたものとまとめて比較）
+		enemyBounds_.Query(aabb1, AABBBatch::Axes::kXY, enemyHits_);
+		for (uint32_t index : enemyHits_) {
+			Enemy* enemy = enemyRefs_[index];
+			// 衝突応答処理
+			// 自キャラの衝突時関数を呼び出す
+			player_->OnCollision(enemy);
+			// 敵の衝突時関数を呼び出す
+			enemy->OnCollision(player_);
 		}
 	}
 #pragma endregion
 }
 
+void GameScene::CollectEnemies() {
+	enemyRefs_.clear();
+
+	// 空の要素はここで取り除いておく
+	enemies_.remove(nullptr);
+	for (Enemy* enemy : enemies_) {
+		enemyRefs_.push_back(enemy);
+	}
+}
+
+void GameScene::GatherEnemyBounds() {
+	enemyBounds_.Resize(static_cast<uint32_t>(enemyRefs_.size()));
+	JobSystem::GetInstance()->ParallelFor(static_cast<uint32_t>(enemyRefs_.size()), kEnemyGrain, [this](uint32_t begin, uint32_t end) {
+		for (uint32_t i = begin; i < end; ++i) {
+			enemyBounds_.Set(i, enemyRefs_[i]->GetAABB());
+		}
+	});
+}
+
 void GameScene::ChangePhase() {
 	switch (phase_) {
 	case Phase::kPlay:
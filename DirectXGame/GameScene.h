@@ -1,14 +1,24 @@
 #pragma once
+#include "AssetCache.h"
+#include "AssetLoader.h"
 #include "CameraController.h"
+#include "CollisionBatch.h"
 #include "DeathParticles.h"
 #include "Enemy.h"
+#include "InputState.h"
 #include "KamataEngine.h"
 #include "MapChipField.h"
 #include "Method.h"
 #include "Player.h"
+#include "RenderSnapshot.h"
+#include "SceneArena.h"
+#include "Timeline.h"
+#include "TransformHierarchy.h"
 #include "Skydome.h"
 #include "Fade.h"
 #include "Goal.h"
+#include <list>
+#include <memory_resource>
 #include <vector>
 
 using namespace KamataEngine;
@@ -21,19 +31,32 @@ public:
 	// 初期化
 	void Initialize();
 
-	// 更新
-	void Update();
+	// ゲームで使うアセットの先読みを要求する（タイトル表示中に呼ぶ）
+	static void PrefetchAssets();
 
-	// 描画
-	void Draw();
+	// 更新（input … このティックの入力）
+	void Update(const InputState& input);
+
+	// 描画（描く内容を snapshot に積む）
+	void Draw(RenderSnapshot& snapshot);
 
 	void GenetateBlocks();
 
 	// すべての当たり判定を行う
 	void CheckAllCollisions();
 
+	// 敵の一覧を enemyRefs_ に並べる（空の要素はここで取り除く）
+	void CollectEnemies();
+	// 敵のAABBを enemyBounds_ に集める（enemyRefs_ と同じ並び。JobSystem で分けて回す）
+	void GatherEnemyBounds();
+
 	void ChangePhase();
 
+	// カメラ（デバッグカメラかカメラコントローラー）の行列を camera_ に反映する
+	void UpdateCamera();
+	// transforms_ に登録したもの（ブロックなど）のうち、変わったものだけ行列を作り直す
+	void UpdateTransforms();
+
 	// デスフラグのgetter
 	bool IsFinished() const { return finished_; };
 
@@ -41,18 +64,22 @@ public:
 	enum class Result { kNone, kClear, kFailed };
 	Result GetResult() const { return result_; } // ゲッター
 private:
+	// シーンのオブジェクトとコンテナの置き場（ほかのメンバより後に破棄されるよう先頭に置く）
+	// 自キャラ・敵・ブロックなどはここから作り、1 つずつ delete せずシーンの終わりにまとめて破棄する
+	SceneArena arena_;
+
 	// カメラ
 	KamataEngine::Camera camera_;
 	// 3DPlayerモデルデータ
-	KamataEngine::Model* playerModel_ = nullptr;
+	CachedModel* playerModel_ = nullptr;
 	// 3DEnemyモデルデータ
-	KamataEngine::Model* enemyModel_ = nullptr;
+	CachedModel* enemyModel_ = nullptr;
 	// 3DEnemyモデルデータ
-	KamataEngine::Model* particleModel_ = nullptr;
+	CachedModel* particleModel_ = nullptr;
 	// ブロックモデルデータ
-	KamataEngine::Model* modelBlock_ = nullptr;
-	// 天球モデルデータ
-	KamataEngine::Model* modelSkydome_ = nullptr;
+	CachedModel* modelBlock_ = nullptr;
+	// ゴールモデルデータ
+	CachedModel* goalModel_ = nullptr;
 
 	bool isDebugCameraActive_ = false;
 	// デバッグカメラ
@@ -65,7 +92,21 @@ private:
 	Skydome* skydome_ = nullptr;
 
 	// 敵キャラ
-	std::list<Enemy*> enemies_;
+	std::pmr::list<Enemy*> enemies_{&arena_};
+
+	// ブロックの変換（動かないので、最初の Update で 1 回作ったあとは何もしない）
+	TransformHierarchy transforms_;
+
+	// 自キャラの旋回・攻撃、敵の揺れ、ゴールの回転、フェードのアニメーション（毎フレーム最初に進める）
+	Timeline timeline_;
+
+	// 当たり判定用：敵のAABBをまとめたものと、その並びに対応する敵
+	AABBBatch enemyBounds_;
+	std::pmr::vector<Enemy*> enemyRefs_{&arena_};
+	// 1 ジョブで扱う敵の数
+	static inline const uint32_t kEnemyGrain = 64;
+	// 判定結果（enemyBounds_ の番号）
+	std::vector<uint32_t> enemyHits_;
 
 	// マップチップフィールド
 	MapChipField* mapChipField_;
@@ -88,7 +129,7 @@ private:
 	// 終了フラグ
 	bool finished_ = false;
 
-	std::vector<std::vector<KamataEngine::WorldTransform*>> worldTransformBlocks_;
+	std::pmr::vector<std::pmr::vector<KamataEngine::WorldTransform*>> worldTransformBlocks_{&arena_};
 
 	Fade* fade_ = nullptr;
 
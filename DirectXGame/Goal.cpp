@@ -2,24 +2,33 @@
 #include <algorithm>
 #include <numbers>
 
-void Goal::Initialize(Model* model, const Vector3& pos) {
+void Goal::Initialize(CachedModel* model, Timeline* timeline, const Vector3& pos) {
 	model_ = model;
-	worldTransform_.Initialize();
+	// 描くときは RenderSnapshot が matWorld_ を写すので、定数バッファは作らない（最初の Update の前に描いてもよいよう行列は作っておく）
 	worldTransform_.translation_ = pos;
 	worldTransform_.rotation_.y = -std::numbers::pi_v<float> / 2.0f;
+	worldTransform_.matWorld_ = MakeAffineMatrix(worldTransform_.scale_, worldTransform_.rotation_, worldTransform_.translation_);
 	RebuildAABB_();
 	active_ = true;
+
+	// くるっと 1 周を繰り返す
+	Timeline::Track spin;
+	spin.target = &worldTransform_.rotation_.y;
+	spin.from = worldTransform_.rotation_.y;
+	spin.to = worldTransform_.rotation_.y + 2.0f * std::numbers::pi_v<float>;
+	spin.duration = 2.0f * std::numbers::pi_v<float> / kSpinSpeed;
+	spin.loop = Timeline::Loop::kRepeat;
+	spin.autoPlay = true;
+	spinTrack_ = timeline->Add(spin);
 }
 
-void Goal::Update(/* float dt */) {
-	// お好み演出（例: くるっと回す）
-	// wt_.rotation_.y += dt * 0.8f;
+void Goal::Update() {
+	// 回転は spinTrack_ が書き換えている
 	worldTransform_.matWorld_ = MakeAffineMatrix(worldTransform_.scale_, worldTransform_.rotation_, worldTransform_.translation_);
-	worldTransform_.TransferMatrix();
 }
 
-void Goal::Draw(Camera& camera) {
+void Goal::Draw(RenderSnapshot& snapshot) {
 	if (!active_ || !model_)
 		return;
-	model_->Draw(worldTransform_, camera);
+	snapshot.AddModel(model_, worldTransform_);
 }
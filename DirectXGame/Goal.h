@@ -1,6 +1,9 @@
 #pragma once
+#include "CachedModel.h"
 #include "KamataEngine.h"
 #include "Method.h"
+#include "RenderSnapshot.h"
+#include "Timeline.h"
 #include "TransformWorld.h"
 
 using namespace KamataEngine;
@@ -12,11 +15,12 @@ public:
 	// model … 外から渡す（ブロックモデルなどを流用OK）
 	// pos   … ワールド座標（中心）
 	// scale … 見た目スケール（1.0f 基準）
-	void Initialize(Model* model, const Vector3& pos);
+	// timeline … くるくる回す演出を登録する先
+	void Initialize(CachedModel* model, Timeline* timeline, const Vector3& pos);
 
-	void Update(/* float dt */);
+	void Update();
 
-	void Draw(Camera& camera);
+	void Draw(RenderSnapshot& snapshot);
 
 	const AABB& GetAABB() const { return aabb_; }
 	const Vector3& GetPosition() const { return worldTransform_.translation_; }
@@ -27,13 +31,11 @@ public:
 	void SetPosition(const Vector3& p) {
 		worldTransform_.translation_ = p;
 		worldTransform_.matWorld_ = MakeAffineMatrix(worldTransform_.scale_, worldTransform_.rotation_, worldTransform_.translation_);
-		worldTransform_.TransferMatrix();
 		RebuildAABB_();
 	}
 	void SetScale(const Vector3& s) {
 		worldTransform_.scale_ = s;
 		worldTransform_.matWorld_ = MakeAffineMatrix(worldTransform_.scale_, worldTransform_.rotation_, worldTransform_.translation_);
-		worldTransform_.TransferMatrix();
 		RebuildAABB_();
 	}
 
@@ -48,7 +50,10 @@ private:
 
 private:
 	WorldTransform worldTransform_{};
-	Model* model_ = nullptr; // 非所有（GameSceneが持っているモデルを借用）
+	CachedModel* model_ = nullptr; // 非所有（GameSceneが持っているモデルを借用）
+	// Y軸回転（rotation_.y を Timeline が書き換える）
+	Timeline::Handle spinTrack_ = Timeline::kNone;
+	static inline const float kSpinSpeed = 0.8f; // [rad/sec]
 	AABB aabb_{};
 	bool active_ = true;
 };
\ No newline at end of file
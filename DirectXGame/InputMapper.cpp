@@ -0,0 +1,123 @@
+#define NOMINMAX
+#include "InputMapper.h"
+#include "InputSampler.h"
+#include "Profiler.h"
+#include <algorithm>
+
+using namespace KamataEngine;
+
+InputMapper* InputMapper::GetInstance() {
+	static InputMapper instance;
+	return &instance;
+}
+
+void InputMapper::ResetBindings() {
+	for (size_t i = 0; i < bindings_.size(); ++i) {
+		ClearBindings(static_cast<Action>(i));
+	}
+	BindKey(Action::kMoveLeft, DIK_LEFT);
+	BindPadButtons(Action::kMoveLeft, XINPUT_GAMEPAD_DPAD_LEFT);
+	BindPadStickX(Action::kMoveLeft, -1);
+	BindKey(Action::kMoveRight, DIK_RIGHT);
+	BindPadButtons(Action::kMoveRight, XINPUT_GAMEPAD_DPAD_RIGHT);
+	BindPadStickX(Action::kMoveRight, 1);
+	BindKey(Action::kJump, DIK_UP);
+	BindPadButtons(Action::kJump, XINPUT_GAMEPAD_A);
+	BindKey(Action::kAttack, DIK_SPACE);
+	BindPadButtons(Action::kAttack, XINPUT_GAMEPAD_X);
+	BindKey(Action::kDecide, DIK_SPACE);
+	BindPadButtons(Action::kDecide, XINPUT_GAMEPAD_A | XINPUT_GAMEPAD_START);
+	BindKey(Action::kDebugCamera, DIK_1);
+}
+
+void InputMapper::ClearBindings(Action action) { bindings_[static_cast<size_t>(action)] = Binding{}; }
+
+bool InputMapper::BindKey(Action action, BYTE key) {
+	Binding& binding = bindings_[static_cast<size_t>(action)];
+	if (binding.keyCount >= kMaxKeys) {
+		return false;
+	}
+	// DIK_* はスキャンコード（0x80 が立っているものは E0 付きの拡張キー）
+	const UINT scanCode = (key & 0x80) ? (0xE000u | (key & 0x7Fu)) : key;
+	binding.virtualKeys[binding.keyCount] = MapVirtualKeyW(scanCode, MAPVK_VSC_TO_VK_EX);
+	binding.keys[binding.keyCount++] = key;
+	return true;
+}
+
+void InputMapper::BindPadButtons(Action action, uint16_t buttons) { bindings_[static_cast<size_t>(action)].padButtons |= buttons; }
+
+void InputMapper::BindPadStickX(Action action, int8_t direction) { bindings_[static_cast<size_t>(action)].stickX = direction; }
+
+template<class IsKeyDown> uint32_t InputMapper::ComputeHeld(uint16_t buttons, int16_t stickX, IsKeyDown isKeyDown) const {
+	uint32_t held = 0;
+	for (size_t i = 0; i < bindings_.size(); ++i) {
+		const Binding& binding = bindings_[i];
+		bool pushed = (buttons & binding.padButtons) != 0;
+		pushed = pushed || (binding.stickX < 0 && stickX < -kStickThreshold) || (binding.stickX > 0 && stickX > kStickThreshold);
+		for (uint32_t k = 0; k < binding.keyCount && !pushed; ++k) {
+			pushed = isKeyDown(binding, k);
+		}
+		held |= pushed ? InputState::Bit(static_cast<Action>(i)) : 0u;
+	}
+	return held;
+}
+
+uint32_t InputMapper::Poll() const {
+	// XInputGetState と GetAsyncKeyState はどのスレッドから呼んでもよい
+	XINPUT_STATE pad = {};
+	const bool padConnected = XInputGetState(0, &pad) == ERROR_SUCCESS;
+	const uint16_t buttons = padConnected ? pad.Gamepad.wButtons : 0;
+	const int16_t stickX = padConnected ? pad.Gamepad.sThumbLX : 0;
+	return ComputeHeld(buttons, stickX, [](const Binding& binding, uint32_t k) { return (GetAsyncKeyState(static_cast<int>(binding.virtualKeys[k])) & 0x8000) != 0; });
+}
+
+const InputState& InputMapper::Sample() {
+	if (InputSampler::GetInstance()->IsRunning()) {
+		SampleEvents();
+		return state_;
+	}
+	Input* input = Input::GetInstance();
+
+	// パッドは 1 回だけ読む（つながっていなければボタンもスティックも 0）
+	XINPUT_STATE pad = {};
+	const bool padConnected = input->GetJoystickState(0, pad);
+	const uint16_t buttons = padConnected ? pad.Gamepad.wButtons : 0;
+	const int16_t stickX = padConnected ? pad.Gamepad.sThumbLX : 0;
+	const uint32_t held = ComputeHeld(buttons, stickX, [input](const Binding& binding, uint32_t k) { return input->PushKey(binding.keys[k]); });
+
+	state_ = InputState::FromHeld(held, state_.held);
+	pressTime_ = 0;
+	return state_;
+}
+
+void InputMapper::SampleEvents() {
+	InputSampler* sampler = InputSampler::GetInstance();
+	const uint64_t tickTime = Profiler::Now();
+	const bool measure = sampler->IsMeasuringLatency();
+
+	// ティックを始めた時刻までに起きた変化を順に重ねる（押して離したものも pressed に残る）
+	InputState next = InputState::FromHeld(state_.held, state_.held);
+	pressTime_ = 0;
+	InputSampler::Event event;
+	while (sampler->Pop(tickTime, event)) {
+		const uint32_t down = event.held & ~next.held;
+		const uint32_t up = next.held & ~event.held;
+		// 押した操作ごとに、このティックで最初に押してからの時間
+		const float age = std::min(static_cast<float>(tickTime - event.time) * 1e-9f, kTickSeconds);
+		for (size_t i = 0; i < next.pressedAge.size(); ++i) {
+			if ((down & ~next.pressed) & InputState::Bit(static_cast<Action>(i))) {
+				next.pressedAge[i] = age;
+			}
+		}
+		if (down) {
+			pressTime_ = pressTime_ ? pressTime_ : event.time;
+			if (measure) {
+				Profiler::GetInstance()->Record("Input->Sim", event.time, tickTime);
+			}
+		}
+		next.pressed |= down;
+		next.released |= up;
+		next.held = event.held;
+	}
+	state_ = next;
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include "InputState.h"
+#include "KamataEngine.h"
+#include <array>
+
+using namespace KamataEngine;
+
+// キー・パッドと操作の対応
+// ティックの最初に Sample を 1 回呼ぶと、割り当てたキーとパッド 0 番の状態を読んで InputState を作る。
+// Input を読むのはここだけで、シーンやキャラクターは Sample が返した InputState を受け取って使う。
+// 割り当ては操作ごとにキーを kMaxKeys 個まで、パッドはボタンの組み合わせと左スティックの左右を持てる。
+// InputSampler が動いていれば、Input の代わりにそのイベントをティックを始めた時刻まで取り出して作る。
+class InputMapper {
+public:
+	// 1 つの操作に割り当てられるキーの数
+	static inline const uint32_t kMaxKeys = 4;
+	// 左スティックをこれより倒したら押したとみなす（XInput の既定のデッドゾーン）
+	static inline const int16_t kStickThreshold = 7849;
+	// シミュレーションの 1 ティック[sec]（押してからの時間はこれより長くしない）
+	static inline const float kTickSeconds = 1.0f / 60.0f;
+
+	static InputMapper* GetInstance();
+
+	// 既定の割り当てに戻す
+	void ResetBindings();
+	// 操作の割り当てをすべて外す
+	void ClearBindings(Action action);
+	// キー（DIK_*）を足す。kMaxKeys 個を超えたら false
+	bool BindKey(Action action, BYTE key);
+	// パッドのボタン（XINPUT_GAMEPAD_* の組み合わせ。どれかを押していれば押したとみなす）を足す
+	void BindPadButtons(Action action, uint16_t buttons);
+	// 左スティックを倒す向きを割り当てる（-1 なら左、1 なら右、0 なら使わない）
+	void BindPadStickX(Action action, int8_t direction);
+
+	// ティックの最初に 1 回呼ぶ
+	const InputState& Sample();
+	// 最後に Sample した状態
+	const InputState& GetState() const { return state_; }
+	// 最後の Sample で取り出した押下のうち一番古いものの時刻（Profiler::Now[ns]。なければ 0）
+	uint64_t GetPressTime() const { return pressTime_; }
+
+	// InputSampler のスレッドから呼ぶ。Input を通さずに今押している操作を読む
+	uint32_t Poll() const;
+
+private:
+	InputMapper() { ResetBindings(); }
+	~InputMapper() = default;
+	InputMapper(const InputMapper&) = delete;
+	InputMapper& operator=(const InputMapper&) = delete;
+
+	// パッドの状態と、キーを押しているかを返す関数から押している操作を求める
+	template<class IsKeyDown> uint32_t ComputeHeld(uint16_t buttons, int16_t stickX, IsKeyDown isKeyDown) const;
+	// InputSampler のイベントから作る
+	void SampleEvents();
+
+	struct Binding {
+		std::array<BYTE, kMaxKeys> keys = {};
+		std::array<UINT, kMaxKeys> virtualKeys = {}; // GetAsyncKeyState 用
+		uint32_t keyCount = 0;
+		uint16_t padButtons = 0;
+		int8_t stickX = 0;
+	};
+	std::array<Binding, static_cast<size_t>(Action::kCount)> bindings_;
+
+	InputState state_;
+	uint64_t pressTime_ = 0;
+};
@@ -0,0 +1,80 @@
+#include "InputSampler.h"
+#include "InputMapper.h"
+#include "Profiler.h"
+#include "Trace.h"
+#include <chrono>
+
+using namespace KamataEngine;
+
+InputSampler* InputSampler::GetInstance() {
+	static InputSampler instance;
+	return &instance;
+}
+
+void InputSampler::Initialize() {
+	stop_.store(false, std::memory_order_relaxed);
+	thread_ = std::thread(&InputSampler::ThreadMain, this);
+}
+
+void InputSampler::Finalize() {
+	stop_.store(true, std::memory_order_relaxed);
+	if (thread_.joinable()) {
+		thread_.join();
+	}
+	// 残ったイベントは捨てる
+	Event event;
+	while (queue_.Pop(event)) {
+	}
+}
+
+bool InputSampler::Pop(uint64_t until, Event& out) {
+	const Event* front = queue_.Front();
+	if (!front || front->time > until) {
+		return false;
+	}
+	out = *front;
+	queue_.Pop();
+	return true;
+}
+
+void InputSampler::ThreadMain() {
+	TRACE_THREAD_NAME("Input");
+	SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_ABOVE_NORMAL);
+	const InputMapper* mapper = InputMapper::GetInstance();
+	const HWND window = WinApp::GetInstance()->GetHwnd();
+
+	// Sleep は既定で 15.6ms 刻みなので、使えれば高分解能のタイマーで待つ
+	HANDLE timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+	const uint64_t period = 1'000'000'000ull / kRateHz;
+	uint64_t next = Profiler::Now();
+	uint32_t pushed = 0; // 最後に積んだ状態
+
+	while (!stop_.load(std::memory_order_relaxed)) {
+		const uint64_t now = Profiler::Now();
+		// ウィンドウが裏にいる間は何も押していないとみなす（DirectInput のフォアグラウンド協調と同じ）
+		const uint32_t held = GetForegroundWindow() == window ? mapper->Poll() : 0u;
+		// 満杯で積めなかったら次のサンプリングでもう一度積む
+		if (held != pushed && queue_.Push({now, held})) {
+			pushed = held;
+		}
+
+		// 次のサンプリングの時刻まで待つ（遅れたぶんは取り戻さない）
+		next += period;
+		const uint64_t after = Profiler::Now();
+		if (next <= after) {
+			next = after;
+			continue;
+		}
+		if (timer) {
+			LARGE_INTEGER due;
+			due.QuadPart = -static_cast<LONGLONG>((next - after) / 100); // 100ns 単位、負なら相対時間
+			SetWaitableTimer(timer, &due, 0, nullptr, nullptr, FALSE);
+			WaitForSingleObject(timer, INFINITE);
+		} else {
+			std::this_thread::sleep_for(std::chrono::nanoseconds(next - after));
+		}
+	}
+	if (timer) {
+		CloseHandle(timer);
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "SpscQueue.h"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+// 入力の高頻度のサンプリング
+// 専用のスレッドが 1 秒に kRateHz 回 InputMapper::Poll で割り当てたキー・パッドを読み、
+// 押している操作が変わったときだけ時刻（Profiler::Now）をつけて SpscQueue に積む。
+// InputMapper::Sample はティックを始めた時刻までのイベントを取り出して InputState にするので、
+// 1 ティックより短い押下も落とさず、押してからティックまでの時間（InputState::pressedAge）も分かる。
+// 計測を有効にすると、押してからシミュレーションが受け取るまでの遅れを Profiler に積む（"Input->Sim"）。
+class InputSampler {
+public:
+	// 1 秒あたりのサンプリング回数
+	static inline const uint32_t kRateHz = 1000;
+
+	// 押している操作が変わった時刻と、変わったあとの状態
+	struct Event {
+		uint64_t time = 0; // Profiler::Now[ns]
+		uint32_t held = 0; // InputState::held と同じ並び
+	};
+
+	static InputSampler* GetInstance();
+
+	// サンプリングを始める（InputMapper の割り当てを変えるのは Initialize の前か Finalize のあと）
+	void Initialize();
+	void Finalize();
+	bool IsRunning() const { return thread_.joinable(); }
+
+	// メインスレッドで呼ぶ。時刻 until までに起きたイベントを古い順に 1 つ取り出す
+	bool Pop(uint64_t until, Event& out);
+
+	// 押してからシミュレーションが受け取るまでの遅れを Profiler に積むか
+	void SetMeasureLatency(bool enabled) { measureLatency_ = enabled; }
+	bool IsMeasuringLatency() const { return measureLatency_; }
+
+private:
+	InputSampler() = default;
+	~InputSampler() = default;
+	InputSampler(const InputSampler&) = delete;
+	InputSampler& operator=(const InputSampler&) = delete;
+
+	void ThreadMain();
+
+	// メインスレッドが 1 ティックで取り出すより十分多く（押しっぱなしの間は積まない）
+	SpscQueue<Event, 1024> queue_;
+	std::atomic<bool> stop_{false};
+	std::thread thread_;
+	bool measureLatency_ = false;
+};
@@ -0,0 +1,46 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// ゲームの操作
+// キーやパッドのボタンとの対応は InputMapper が持ち、ゲームのコードは操作の名前だけを見る。
+enum class Action : uint8_t {
+	kMoveLeft,
+	kMoveRight,
+	kJump,
+	kAttack,
+	kDecide,      // タイトル・リザルトを進める
+	kDebugCamera, // デバッグカメラの切り替え（_DEBUG のビルドだけ使う）
+	kCount,
+};
+
+// 1 ティックぶんの入力（操作ごとに 1 ビット）
+// InputMapper::Sample がティックの最初に 1 回だけ作り、ゲームのコードはこれだけを受け取る。
+// 値だけの構造体なので、記録して流し直したり、ベンチマークで作って渡したりできる。
+struct InputState {
+	uint32_t held = 0;     // 押している
+	uint32_t pressed = 0;  // このティックで押した
+	uint32_t released = 0; // このティックで離した
+	// 押してからティックを始めるまでの時間[sec]（InputSampler の時刻から求める。なければ 0）
+	// 押したのがティックの途中なら、猶予のタイマーをそのぶん進めてから使う
+	std::array<float, static_cast<size_t>(Action::kCount)> pressedAge = {};
+
+	static constexpr uint32_t Bit(Action action) { return 1u << static_cast<uint32_t>(action); }
+
+	bool IsHeld(Action action) const { return (held & Bit(action)) != 0; }
+	bool IsPressed(Action action) const { return (pressed & Bit(action)) != 0; }
+	bool IsReleased(Action action) const { return (released & Bit(action)) != 0; }
+	float GetPressedAge(Action action) const { return pressedAge[static_cast<size_t>(action)]; }
+
+	// 前のティックで押していたもの（previousHeld）から、押した・離したを決める
+	static InputState FromHeld(uint32_t held, uint32_t previousHeld) {
+		InputState state;
+		state.held = held;
+		state.pressed = held & ~previousHeld;
+		state.released = previousHeld & ~held;
+		return state;
+	}
+};
+
+static_assert(static_cast<uint32_t>(Action::kCount) <= 32, "InputState holds one bit per action");
@@ -0,0 +1,190 @@
+#include "JobSystem.h"
+#include "AllocTracker.h"
+#include "Trace.h"
+#include <assert.h>
+
+namespace {
+// 登録されていないスレッド
+constexpr uint32_t kNoThread = ~0u;
+// 呼んだスレッドの番号（メインスレッドが 0、ワーカーが 1 から）
+thread_local uint32_t threadIndex = kNoThread;
+} // namespace
+
+JobSystem* JobSystem::GetInstance() {
+	static JobSystem instance;
+	return &instance;
+}
+
+JobSystem::~JobSystem() { Finalize(); }
+
+uint32_t JobSystem::GetDefaultWorkerCount() {
+	const uint32_t cores = std::thread::hardware_concurrency();
+	return cores > 1 ? cores - 1 : 0;
+}
+
+void JobSystem::Initialize(uint32_t workerCount) {
+	assert(threads_.empty());
+	if (workerCount == 0) {
+		return;
+	}
+	// 0 番は呼んだスレッドのぶん（名前はワーカーだけ付ける）
+	for (uint32_t i = 0; i <= workerCount; ++i) {
+		workers_.push_back(std::make_unique<Worker>());
+		if (i > 0) {
+			workers_.back()->name = "Job worker " + std::to_string(i);
+		}
+	}
+	threadIndex = 0;
+	stop_ = false;
+	for (uint32_t i = 1; i <= workerCount; ++i) {
+		threads_.emplace_back(&JobSystem::WorkerMain, this, i);
+	}
+}
+
+void JobSystem::Finalize() {
+	if (threads_.empty()) {
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(wakeMutex_);
+		stop_ = true;
+	}
+	wake_.notify_all();
+	for (std::thread& thread : threads_) {
+		thread.join();
+	}
+	threads_.clear();
+	workers_.clear();
+	threadIndex = kNoThread;
+}
+
+bool JobSystem::CanSchedule() const { return threadIndex != kNoThread && !threads_.empty(); }
+
+JobSystem::Job* JobSystem::AllocateJob(Counter* counter) {
+	Worker& worker = *workers_[threadIndex];
+	Job* job = &worker.jobs[worker.nextJob];
+	// 一周してきた領域のジョブがまだキューにあるか実行中なら上書きしない（呼んだ側がその場で実行する）
+	if (job->inUse_.load(std::memory_order_acquire)) {
+		// 1 フレームに積むジョブを減らすか、kMaxJobsPerThread を増やす
+		assert(false);
+		return nullptr;
+	}
+	job->inUse_.store(true, std::memory_order_relaxed);
+	worker.nextJob = (worker.nextJob + 1) % kMaxJobsPerThread;
+	job->counter_ = counter;
+	job->steadyState_ = AllocTracker::IsInSteadyState();
+	return job;
+}
+
+void JobSystem::Push(Job* job, bool wake) {
+	Worker& worker = *workers_[threadIndex];
+	{
+		std::lock_guard<std::mutex> lock(worker.mutex);
+		if (worker.back - worker.front < kMaxJobsPerThread) {
+			worker.queue[worker.back % kMaxJobsPerThread] = job;
+			++worker.back;
+			job = nullptr;
+		}
+	}
+	if (job) {
+		// キューがいっぱいならその場で実行する
+		Execute(job);
+		return;
+	}
+	queued_.fetch_add(1);
+	if (wake) {
+		WakeWorkers();
+	}
+}
+
+void JobSystem::WakeWorkers() {
+	// 寝る前の判定と入れ違いにならないよう、ロックを通ってから起こす
+	{ std::lock_guard<std::mutex> lock(wakeMutex_); }
+	wake_.notify_all();
+}
+
+JobSystem::Job* JobSystem::TakeJob() {
+	if (queued_.load() == 0) {
+		return nullptr;
+	}
+	// 自分のキューは後ろから（積んだばかりのものほどキャッシュに残っている）
+	Worker& self = *workers_[threadIndex];
+	{
+		std::lock_guard<std::mutex> lock(self.mutex);
+		if (self.back != self.front) {
+			--self.back;
+			queued_.fetch_sub(1);
+			return self.queue[self.back % kMaxJobsPerThread];
+		}
+	}
+	// ほかのキューは前から盗む（隣から順に見る）
+	const uint32_t count = static_cast<uint32_t>(workers_.size());
+	for (uint32_t offset = 1; offset < count; ++offset) {
+		Worker& victim = *workers_[(threadIndex + offset) % count];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if (victim.back != victim.front) {
+			Job* job = victim.queue[victim.front % kMaxJobsPerThread];
+			++victim.front;
+			queued_.fetch_sub(1);
+			return job;
+		}
+	}
+	return nullptr;
+}
+
+void JobSystem::Execute(Job* job) {
+	Counter* counter = job->counter_;
+	const bool steadyState = job->steadyState_;
+	if (steadyState) {
+		AllocTracker::EnterSteadyState();
+	}
+	job->invoke_(job->data_);
+	if (steadyState) {
+		AllocTracker::LeaveSteadyState();
+	}
+	// 関数オブジェクトは invoke_ の中で破棄したので、この領域はもう使ってよい
+	job->inUse_.store(false, std::memory_order_release);
+	if (counter) {
+		Release(*counter);
+	}
+}
+
+void JobSystem::Release(Counter& counter) {
+	// 続きのジョブは残りが 0 になってから取り出す（先に読むと、Then が登録するのと入れ違いになって落とす）。
+	// 続きのないものは 0 にした時点で待っていたスレッドが破棄しうるので、そのあとは触らない
+	const uint32_t previous = counter.pending_.fetch_sub(1, std::memory_order_acq_rel);
+	if (previous != Counter::kHasContinuation + 1) {
+		return;
+	}
+	// 続きを取り出してから印を消す（消すまでは IsDone にならないので counter は残っている）
+	Job* continuation = counter.continuation_.exchange(nullptr, std::memory_order_acquire);
+	counter.pending_.fetch_and(~Counter::kHasContinuation, std::memory_order_release);
+	Push(continuation, true);
+}
+
+void JobSystem::Wait(Counter& counter) {
+	while (!counter.IsDone()) {
+		if (Job* job = CanSchedule() ? TakeJob() : nullptr) {
+			Execute(job);
+		} else {
+			// ほかのスレッドが実行中のジョブの終わりを待つ
+			std::this_thread::yield();
+		}
+	}
+}
+
+void JobSystem::WorkerMain(uint32_t index) {
+	threadIndex = index;
+	TRACE_THREAD_NAME(workers_[index]->name.c_str());
+	for (;;) {
+		if (Job* job = TakeJob()) {
+			Execute(job);
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(wakeMutex_);
+		wake_.wait(lock, [this] { return stop_ || queued_.load() > 0; });
+		if (stop_) {
+			return;
+		}
+	}
+}
@@ -0,0 +1,207 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// フレーム内の仕事を並列に回すジョブシステム
+// スレッド（メインスレッドが 0 番、ワーカーが 1 番から）ごとに両端キューを持ち、積んだスレッドは後ろから、
+// 手の空いたスレッドはほかのキューの前から盗んで実行する。
+// ジョブは終わると Counter を 1 つ減らし、0 になったところで Then で登録しておいた続きのジョブを積む。
+// ジョブの実体と関数オブジェクトはスレッドごとの固定の領域に置くので、積むときにメモリは確保しない。
+// Initialize の前や、登録されていないスレッドから積んだジョブはその場で実行する（結果は同じ）。
+class JobSystem {
+public:
+	// スレッドごとのジョブの数（終わっていないジョブがこれだけ溜まっていたら、デバッグビルドでは assert、
+	// リリースビルドでは新しいジョブを積まずにその場で実行する）
+	static inline const uint32_t kMaxJobsPerThread = 4096;
+	// ジョブに持たせられる関数オブジェクトの大きさ
+	static inline const size_t kJobDataSize = 64;
+
+	class Job;
+
+	// ジョブの終わりを待つためのカウンタ（積んだジョブの数だけ増え、終わるたびに減る）
+	// 続きのジョブを登録したものは使い切り（フレームごとにスタックに置く）
+	class Counter {
+	public:
+		Counter() = default;
+		Counter(const Counter&) = delete;
+		Counter& operator=(const Counter&) = delete;
+
+		bool IsDone() const { return pending_.load(std::memory_order_acquire) == 0; }
+
+	private:
+		friend class JobSystem;
+		// 続きのジョブが登録されている（立っている間は IsDone にならない）
+		static inline const uint32_t kHasContinuation = 1u << 31;
+		std::atomic<uint32_t> pending_{0};
+		// 0 になったら積むジョブ
+		std::atomic<Job*> continuation_{nullptr};
+	};
+
+	class Job {
+	private:
+		friend class JobSystem;
+		void (*invoke_)(void* data) = nullptr;
+		Counter* counter_ = nullptr;
+		// 積んだスレッドが定常状態の区間（ALLOC_STEADY_STATE_SCOPE）にいた。実行するスレッドでも同じ区間にする
+		bool steadyState_ = false;
+		// 積んでから実行し終わるまで立つ（立っている間はこの領域を次のジョブに使わない）
+		std::atomic<bool> inUse_{false};
+		alignas(std::max_align_t) unsigned char data_[kJobDataSize];
+	};
+
+	static JobSystem* GetInstance();
+
+	// ワーカースレッドを立てる（呼んだスレッドが 0 番になる。workerCount が 0 なら全部その場で実行）
+	void Initialize(uint32_t workerCount = GetDefaultWorkerCount());
+	void Finalize();
+	// 論理コア数 - 1（メインスレッドのぶんを引く）
+	static uint32_t GetDefaultWorkerCount();
+
+	uint32_t GetWorkerCount() const { return static_cast<uint32_t>(threads_.size()); }
+
+	// function() を積む
+	template<typename F> void Run(Counter& counter, F&& function);
+	// dependency が 0 になったら function() を積む（1 つの dependency に登録できるのは 1 つだけ。
+	// dependency に積むのは Then より前に済ませておく。ジョブの領域が空いていなければ、dependency の終わりを待ってその場で実行する）
+	template<typename F> void Then(Counter& dependency, Counter& counter, F&& function);
+	// [0, count) を grainSize ずつに分けて function(begin, end) を積む
+	template<typename F> void ParallelForAsync(Counter& counter, uint32_t count, uint32_t grainSize, const F& function);
+	// ParallelForAsync して終わるまで待つ（待っている間は呼んだスレッドも手伝う）
+	template<typename F> void ParallelFor(uint32_t count, uint32_t grainSize, const F& function);
+
+	// counter が 0 になるまで、積まれているジョブを実行しながら待つ
+	void Wait(Counter& counter);
+
+private:
+	JobSystem() = default;
+	~JobSystem();
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	// 1 スレッドぶん（キューはそのスレッドと盗むスレッドが触るのでロックする）
+	struct Worker {
+		std::mutex mutex;
+		Job* queue[kMaxJobsPerThread] = {};
+		uint64_t front = 0; // 盗む側が取る位置
+		uint64_t back = 0;  // 持ち主が積む・取る位置
+		Job jobs[kMaxJobsPerThread];
+		uint32_t nextJob = 0;
+		std::string name;
+	};
+
+	// 呼んだスレッドから積めるか（Initialize 済みで、登録されたスレッド）
+	bool CanSchedule() const;
+	// 呼んだスレッドの領域からジョブを 1 つ取る（空きがなければ nullptr）
+	Job* AllocateJob(Counter* counter);
+	// nullptr なら function には触っていないので、呼んだ側がその場で実行する
+	template<typename F> Job* CreateJob(Counter* counter, F&& function);
+	// 呼んだスレッドのキューに積む（wake なら寝ているワーカーを起こす）
+	void Push(Job* job, bool wake);
+	void WakeWorkers();
+	// 自分のキューの後ろから、なければほかのキューの前から取る
+	Job* TakeJob();
+	// 実行してカウンタを減らす
+	void Execute(Job* job);
+	// counter を 1 つ減らし、最後の 1 つなら続きのジョブを積む（IsDone になったあとは counter に触らない）
+	void Release(Counter& counter);
+	void WorkerMain(uint32_t index);
+
+	std::vector<std::unique_ptr<Worker>> workers_;
+	std::vector<std::thread> threads_;
+	// キューに入っているジョブの数（ワーカーを寝かせるかの判断に使う）
+	std::atomic<uint32_t> queued_{0};
+	std::mutex wakeMutex_;
+	std::condition_variable wake_;
+	bool stop_ = false;
+};
+
+template<typename F> JobSystem::Job* JobSystem::CreateJob(Counter* counter, F&& function) {
+	using Function = std::decay_t<F>;
+	static_assert(sizeof(Function) <= kJobDataSize, "ジョブの関数オブジェクトが大きすぎる（参照でキャプチャする）");
+	static_assert(alignof(Function) <= alignof(std::max_align_t));
+	Job* job = AllocateJob(counter);
+	if (!job) {
+		return nullptr;
+	}
+	::new (static_cast<void*>(job->data_)) Function(std::forward<F>(function));
+	job->invoke_ = [](void* data) {
+		Function& f = *static_cast<Function*>(data);
+		f();
+		f.~Function();
+	};
+	return job;
+}
+
+template<typename F> void JobSystem::Run(Counter& counter, F&& function) {
+	if (!CanSchedule()) {
+		function();
+		return;
+	}
+	Job* job = CreateJob(&counter, std::forward<F>(function));
+	if (!job) {
+		function();
+		return;
+	}
+	counter.pending_.fetch_add(1, std::memory_order_relaxed);
+	Push(job, true);
+}
+
+template<typename F> void JobSystem::Then(Counter& dependency, Counter& counter, F&& function) {
+	if (!CanSchedule()) {
+		// 積んだジョブはその場で終わっているので、dependency も終わっている
+		function();
+		return;
+	}
+	Job* job = CreateJob(&counter, std::forward<F>(function));
+	if (!job) {
+		// 積めなければ dependency の終わりを待ってから実行する
+		Wait(dependency);
+		function();
+		return;
+	}
+	counter.pending_.fetch_add(1, std::memory_order_relaxed);
+	// 続きがあることを示し、登録の間は dependency を 1 つ預かって終わらせない。返したときに最後だったら自分で積む
+	dependency.continuation_.store(job, std::memory_order_relaxed);
+	dependency.pending_.fetch_add(Counter::kHasContinuation + 1, std::memory_order_acq_rel);
+	Release(dependency);
+}
+
+template<typename F> void JobSystem::ParallelForAsync(Counter& counter, uint32_t count, uint32_t grainSize, const F& function) {
+	if (grainSize == 0) {
+		grainSize = 1;
+	}
+	if (!CanSchedule() || count <= grainSize) {
+		if (count > 0) {
+			function(0u, count);
+		}
+		return;
+	}
+	const uint32_t chunks = (count + grainSize - 1) / grainSize;
+	counter.pending_.fetch_add(chunks, std::memory_order_relaxed);
+	for (uint32_t begin = 0; begin < count; begin += grainSize) {
+		const uint32_t end = count - begin > grainSize ? begin + grainSize : count;
+		if (Job* job = CreateJob(&counter, [function, begin, end] { function(begin, end); })) {
+			Push(job, false);
+		} else {
+			function(begin, end);
+			Release(counter);
+		}
+	}
+	WakeWorkers();
+}
+
+template<typename F> void JobSystem::ParallelFor(uint32_t count, uint32_t grainSize, const F& function) {
+	Counter counter;
+	ParallelForAsync(counter, count, grainSize, [&function](uint32_t begin, uint32_t end) { function(begin, end); });
+	Wait(counter);
+}
@@ -59,11 +59,11 @@ void MapChipField::LoadMapChipCsv(const std::string& filePath) {
 }
 
 MapChipType MapChipField::GetMapChipTypeByIndex(uint32_t xIndex, uint32_t yIndex) {
-	if (xIndex < 0 || kNumBlockHorizontal_ - 1 < xIndex) {
+	if (kNumBlockHorizontal_ - 1 < xIndex) {
 		return MapChipType::kBlank;
 	}
 
-	if (yIndex < 0 || kNumBlockVertical_ - 1 < yIndex) {
+	if (kNumBlockVertical_ - 1 < yIndex) {
 		return MapChipType::kBlank;
 	}
 
@@ -0,0 +1,465 @@
+#include "MeshCache.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// ファイル先頭
+struct Header {
+	char magic[4];
+	uint32_t version;
+	uint32_t flags;
+	uint32_t vertexCount;
+	uint32_t indexCount;
+	uint32_t subMeshCount;
+	uint32_t materialCount;
+	uint32_t stringSize;
+	uint64_t sourceStamp;
+	uint64_t fileSize;
+	QuantizationBounds bounds; // kFlagQuantized のときの位置の範囲
+	uint32_t lodCount;
+	uint32_t pad;
+};
+static_assert(sizeof(Header) == 80);
+
+// 文字列は末尾の文字列表へのオフセットと長さで持つ
+struct StringRef {
+	uint32_t offset;
+	uint32_t length;
+};
+
+struct SubMeshRecord {
+	uint32_t vertexOffset;
+	uint32_t vertexCount;
+	uint32_t indexOffset;
+	uint32_t indexCount;
+	int32_t material;
+	uint32_t pad;
+	StringRef name;
+};
+static_assert(sizeof(SubMeshRecord) == 32);
+
+struct MaterialRecord {
+	float ambient[3];
+	float diffuse[3];
+	float specular[3];
+	float alpha;
+	StringRef name;
+	StringRef textureFilename;
+};
+static_assert(sizeof(MaterialRecord) == 56);
+
+// LOD ごとのずれ（後ろにサブメッシュの数だけ LodRange が続く）
+struct LodRecord {
+	float error;
+	uint32_t pad;
+};
+static_assert(sizeof(LodRecord) == 8);
+static_assert(sizeof(LodRange) == 8);
+
+const char kMagic[4] = {'K', 'M', 'S', 'H'};
+
+// 各セクションの位置（ヘッダの件数から決まる）
+struct Layout {
+	uint64_t vertices;
+	uint64_t indices;
+	uint64_t subMeshes;
+	uint64_t materials;
+	uint64_t lods;
+	uint64_t lodRanges;
+	uint64_t strings;
+	uint64_t end;
+};
+
+Layout ComputeLayout(const Header& header) {
+	Layout layout{};
+	layout.vertices = sizeof(Header);
+	const uint64_t vertexSize = (header.flags & MeshCache::kFlagQuantized) ? sizeof(QuantizedVertex) : sizeof(MeshVertex);
+	layout.indices = layout.vertices + uint64_t{header.vertexCount} * vertexSize;
+	// 16 ビットのときは後ろのレコードが 4 バイト境界に来るように詰める
+	const uint64_t indexSize = (header.flags & MeshCache::kFlagIndex16) ? sizeof(uint16_t) : sizeof(uint32_t);
+	layout.subMeshes = layout.indices + (uint64_t{header.indexCount} * indexSize + 3) / 4 * 4;
+	layout.materials = layout.subMeshes + uint64_t{header.subMeshCount} * sizeof(SubMeshRecord);
+	layout.lods = layout.materials + uint64_t{header.materialCount} * sizeof(MaterialRecord);
+	layout.lodRanges = layout.lods + uint64_t{header.lodCount} * sizeof(LodRecord);
+	layout.strings = layout.lodRanges + uint64_t{header.lodCount} * header.subMeshCount * sizeof(LodRange);
+	layout.end = layout.strings + header.stringSize;
+	return layout;
+}
+
+uint64_t HashCombine(uint64_t hash, uint64_t value) {
+	// FNV-1a を 8 バイト単位で
+	for (int i = 0; i < 8; ++i) {
+		hash ^= (value >> (i * 8)) & 0xFF;
+		hash *= 0x100000001B3ull;
+	}
+	return hash;
+}
+
+uint64_t StampFile(uint64_t hash, const std::filesystem::path& path) {
+	std::error_code error;
+	const uintmax_t size = std::filesystem::file_size(path, error);
+	hash = HashCombine(hash, error ? 0 : static_cast<uint64_t>(size));
+	const std::filesystem::file_time_type time = std::filesystem::last_write_time(path, error);
+	hash = HashCombine(hash, error ? 0 : static_cast<uint64_t>(time.time_since_epoch().count()));
+	return hash;
+}
+
+} // namespace
+
+bool MappedFile::Open(const std::filesystem::path& path) {
+	Close();
+#ifdef _WIN32
+	HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	LARGE_INTEGER size{};
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+		CloseHandle(file);
+		return false;
+	}
+	HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping) {
+		CloseHandle(file);
+		return false;
+	}
+	const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!view) {
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+	file_ = file;
+	mapping_ = mapping;
+	data_ = static_cast<const uint8_t*>(view);
+	size_ = static_cast<size_t>(size.QuadPart);
+#else
+	const int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+	struct stat status {};
+	if (fstat(fd, &status) != 0 || status.st_size == 0) {
+		::close(fd);
+		return false;
+	}
+	void* view = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	if (view == MAP_FAILED) {
+		::close(fd);
+		return false;
+	}
+	fd_ = fd;
+	data_ = static_cast<const uint8_t*>(view);
+	size_ = static_cast<size_t>(status.st_size);
+#endif
+	return true;
+}
+
+void MappedFile::Close() {
+#ifdef _WIN32
+	if (data_) {
+		UnmapViewOfFile(data_);
+	}
+	if (mapping_) {
+		CloseHandle(mapping_);
+	}
+	if (file_) {
+		CloseHandle(file_);
+	}
+	file_ = nullptr;
+	mapping_ = nullptr;
+#else
+	if (data_) {
+		munmap(const_cast<uint8_t*>(data_), size_);
+	}
+	if (fd_ >= 0) {
+		::close(fd_);
+	}
+	fd_ = -1;
+#endif
+	data_ = nullptr;
+	size_ = 0;
+}
+
+std::filesystem::path MeshCache::GetCachePath(const std::filesystem::path& objPath) {
+	std::filesystem::path path = objPath;
+	path.replace_extension(".mesh");
+	return path;
+}
+
+uint64_t MeshCache::ComputeSourceStamp(const std::filesystem::path& objPath) {
+	uint64_t hash = 0xCBF29CE484222325ull;
+	hash = StampFile(hash, objPath);
+
+	// mtl はファイル名が obj と違うことがあるので、同じディレクトリのものをすべて見る（名前順）
+	std::vector<std::filesystem::path> materials;
+	std::error_code error;
+	for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(objPath.parent_path(), error)) {
+		if (entry.path().extension() == ".mtl") {
+			materials.push_back(entry.path());
+		}
+	}
+	std::sort(materials.begin(), materials.end());
+	for (const std::filesystem::path& material : materials) {
+		hash = StampFile(hash, material);
+	}
+	return hash;
+}
+
+bool MeshCache::CanUse16BitIndices(const MeshData& mesh) {
+	// インデックスはサブメッシュ内の番号なので、サブメッシュごとの頂点数で決まる
+	for (const SubMesh& subMesh : mesh.subMeshes) {
+		if (subMesh.vertexCount > UINT16_MAX) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool MeshCache::Write(const std::filesystem::path& path, const MeshData& mesh, uint32_t flags, uint64_t sourceStamp) {
+	std::string strings;
+	auto addString = [&strings](const std::string& value) {
+		StringRef ref{static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(value.size())};
+		strings += value;
+		return ref;
+	};
+
+	std::vector<SubMeshRecord> subMeshes;
+	subMeshes.reserve(mesh.subMeshes.size());
+	for (const SubMesh& subMesh : mesh.subMeshes) {
+		SubMeshRecord record{};
+		record.vertexOffset = subMesh.vertexOffset;
+		record.vertexCount = subMesh.vertexCount;
+		record.indexOffset = subMesh.indexOffset;
+		record.indexCount = subMesh.indexCount;
+		record.material = subMesh.material;
+		record.name = addString(subMesh.name);
+		subMeshes.push_back(record);
+	}
+
+	std::vector<MaterialRecord> materials;
+	materials.reserve(mesh.materials.size());
+	for (const MeshMaterial& material : mesh.materials) {
+		MaterialRecord record{};
+		std::memcpy(record.ambient, material.ambient, sizeof(record.ambient));
+		std::memcpy(record.diffuse, material.diffuse, sizeof(record.diffuse));
+		std::memcpy(record.specular, material.specular, sizeof(record.specular));
+		record.alpha = material.alpha;
+		record.name = addString(material.name);
+		record.textureFilename = addString(material.textureFilename);
+		materials.push_back(record);
+	}
+
+	std::vector<LodRecord> lods;
+	std::vector<LodRange> lodRanges;
+	for (const MeshLod& lod : mesh.lods) {
+		lods.push_back({lod.error, 0});
+		lodRanges.insert(lodRanges.end(), lod.ranges.begin(), lod.ranges.end());
+	}
+
+	Header header{};
+	std::memcpy(header.magic, kMagic, sizeof(kMagic));
+	header.version = kVersion;
+	const bool index16 = CanUse16BitIndices(mesh);
+	header.flags = (flags & ~kFlagIndex16) | (index16 ? kFlagIndex16 : 0u);
+	header.vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+	header.indexCount = static_cast<uint32_t>(mesh.indices.size());
+	header.subMeshCount = static_cast<uint32_t>(subMeshes.size());
+	header.materialCount = static_cast<uint32_t>(materials.size());
+	header.stringSize = static_cast<uint32_t>(strings.size());
+	header.lodCount = static_cast<uint32_t>(lods.size());
+	header.sourceStamp = sourceStamp;
+	const Layout layout = ComputeLayout(header);
+	header.fileSize = layout.end;
+
+	// 頂点（圧縮するならメッシュ全体の範囲で量子化する）
+	const char* vertexBytes = reinterpret_cast<const char*>(mesh.vertices.data());
+	std::vector<QuantizedVertex> quantized;
+	if (flags & kFlagQuantized) {
+		header.bounds = MeshQuantizer::ComputeBounds(mesh.vertices.data(), mesh.vertices.size());
+		quantized.resize(mesh.vertices.size());
+		MeshQuantizer::Quantize(mesh.vertices.data(), mesh.vertices.size(), header.bounds, quantized.data());
+		vertexBytes = reinterpret_cast<const char*>(quantized.data());
+	}
+
+	// インデックス（16 ビットなら詰め直す。末尾は 4 バイト境界まで 0 で埋める）
+	std::vector<uint8_t> indexBytes(static_cast<size_t>(layout.subMeshes - layout.indices), 0);
+	if (index16) {
+		uint16_t* indices16 = reinterpret_cast<uint16_t*>(indexBytes.data());
+		for (size_t i = 0; i < mesh.indices.size(); ++i) {
+			indices16[i] = static_cast<uint16_t>(mesh.indices[i]);
+		}
+	} else if (!mesh.indices.empty()) {
+		std::memcpy(indexBytes.data(), mesh.indices.data(), mesh.indices.size() * sizeof(uint32_t));
+	}
+
+	// 途中で落ちても壊れたキャッシュが残らないよう、一時ファイルに書いてから置き換える
+	std::filesystem::path temporary = path;
+	temporary += ".tmp";
+	{
+		std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+		if (!file.is_open()) {
+			return false;
+		}
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(vertexBytes, static_cast<std::streamsize>(layout.indices - layout.vertices));
+		file.write(reinterpret_cast<const char*>(indexBytes.data()), static_cast<std::streamsize>(indexBytes.size()));
+		file.write(reinterpret_cast<const char*>(subMeshes.data()), static_cast<std::streamsize>(subMeshes.size() * sizeof(SubMeshRecord)));
+		file.write(reinterpret_cast<const char*>(materials.data()), static_cast<std::streamsize>(materials.size() * sizeof(MaterialRecord)));
+		file.write(reinterpret_cast<const char*>(lods.data()), static_cast<std::streamsize>(lods.size() * sizeof(LodRecord)));
+		file.write(reinterpret_cast<const char*>(lodRanges.data()), static_cast<std::streamsize>(lodRanges.size() * sizeof(LodRange)));
+		file.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+		if (!file) {
+			return false;
+		}
+	}
+	std::error_code error;
+	std::filesystem::rename(temporary, path, error);
+	return !error;
+}
+
+bool MeshCache::Open(const std::filesystem::path& path, uint32_t flags, uint64_t sourceStamp) {
+	Close();
+	if (!file_.Open(path) || file_.GetSize() < sizeof(Header)) {
+		Close();
+		return false;
+	}
+
+	Header header;
+	std::memcpy(&header, file_.GetData(), sizeof(header));
+	const Layout layout = ComputeLayout(header);
+	if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion || (header.flags & ~kFlagIndex16) != flags || header.sourceStamp != sourceStamp ||
+	    header.fileSize != file_.GetSize() || layout.end != file_.GetSize()) {
+		Close();
+		return false;
+	}
+
+	const uint8_t* data = file_.GetData();
+	vertexData_ = data + layout.vertices;
+	vertexCount_ = header.vertexCount;
+	quantized_ = (header.flags & kFlagQuantized) != 0;
+	bounds_ = header.bounds;
+	indexData_ = data + layout.indices;
+	indexSize_ = (header.flags & kFlagIndex16) ? 2 : 4;
+	indexCount_ = header.indexCount;
+
+	const char* strings = reinterpret_cast<const char*>(data + layout.strings);
+	auto getString = [&](const StringRef& ref, std::string& out) {
+		if (uint64_t{ref.offset} + ref.length > header.stringSize) {
+			return false;
+		}
+		out.assign(strings + ref.offset, ref.length);
+		return true;
+	};
+
+	subMeshes_.resize(header.subMeshCount);
+	for (uint32_t i = 0; i < header.subMeshCount; ++i) {
+		SubMeshRecord record;
+		std::memcpy(&record, data + layout.subMeshes + i * sizeof(SubMeshRecord), sizeof(record));
+		SubMesh& subMesh = subMeshes_[i];
+		subMesh.vertexOffset = record.vertexOffset;
+		subMesh.vertexCount = record.vertexCount;
+		subMesh.indexOffset = record.indexOffset;
+		subMesh.indexCount = record.indexCount;
+		subMesh.material = record.material;
+		// 範囲外を指していたら壊れているとみなす
+		if (uint64_t{record.vertexOffset} + record.vertexCount > header.vertexCount || uint64_t{record.indexOffset} + record.indexCount > header.indexCount ||
+		    record.material >= static_cast<int32_t>(header.materialCount) || !getString(record.name, subMesh.name)) {
+			Close();
+			return false;
+		}
+	}
+
+	materials_.resize(header.materialCount);
+	for (uint32_t i = 0; i < header.materialCount; ++i) {
+		MaterialRecord record;
+		std::memcpy(&record, data + layout.materials + i * sizeof(MaterialRecord), sizeof(record));
+		MeshMaterial& material = materials_[i];
+		std::memcpy(material.ambient, record.ambient, sizeof(material.ambient));
+		std::memcpy(material.diffuse, record.diffuse, sizeof(material.diffuse));
+		std::memcpy(material.specular, record.specular, sizeof(material.specular));
+		material.alpha = record.alpha;
+		if (!getString(record.name, material.name) || !getString(record.textureFilename, material.textureFilename)) {
+			Close();
+			return false;
+		}
+	}
+
+	lods_.resize(header.lodCount);
+	for (uint32_t i = 0; i < header.lodCount; ++i) {
+		LodRecord record;
+		std::memcpy(&record, data + layout.lods + i * sizeof(LodRecord), sizeof(record));
+		MeshLod& lod = lods_[i];
+		lod.error = record.error;
+		lod.ranges.resize(header.subMeshCount);
+		if (header.subMeshCount > 0) {
+			std::memcpy(lod.ranges.data(), data + layout.lodRanges + size_t{i} * header.subMeshCount * sizeof(LodRange), header.subMeshCount * sizeof(LodRange));
+		}
+		for (const LodRange& range : lod.ranges) {
+			if (uint64_t{range.indexOffset} + range.indexCount > header.indexCount) {
+				Close();
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+void MeshCache::Close() {
+	vertexData_ = nullptr;
+	vertexCount_ = 0;
+	quantized_ = false;
+	bounds_ = {};
+	indexData_ = nullptr;
+	indexSize_ = 4;
+	indexCount_ = 0;
+	subMeshes_.clear();
+	materials_.clear();
+	lods_.clear();
+	file_.Close();
+}
+
+void MeshCache::CopyVertices(MeshVertex* out) const {
+	if (quantized_) {
+		MeshQuantizer::Dequantize(static_cast<const QuantizedVertex*>(vertexData_), vertexCount_, bounds_, out);
+	} else if (vertexCount_ > 0) {
+		std::memcpy(out, vertexData_, size_t{vertexCount_} * sizeof(MeshVertex));
+	}
+}
+
+void MeshCache::CopyTo(MeshData& out) const {
+	CopyTopologyTo(out);
+	out.vertices.resize(vertexCount_);
+	CopyVertices(out.vertices.data());
+}
+
+void MeshCache::CopyTopologyTo(MeshData& out) const {
+	out.vertices.clear();
+	out.indices.resize(indexCount_);
+	if (indexSize_ == 2) {
+		const uint16_t* indices16 = static_cast<const uint16_t*>(indexData_);
+		std::copy(indices16, indices16 + indexCount_, out.indices.begin());
+	} else if (indexCount_ > 0) {
+		std::memcpy(out.indices.data(), indexData_, indexCount_ * sizeof(uint32_t));
+	}
+	out.subMeshes = subMeshes_;
+	out.materials = materials_;
+	out.lods = lods_;
+}
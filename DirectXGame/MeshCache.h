@@ -0,0 +1,105 @@
+#pragma once
+#include "MeshData.h"
+#include "MeshQuantizer.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+// 読み取り専用のファイルマッピング
+class MappedFile {
+public:
+	MappedFile() = default;
+	~MappedFile() { Close(); }
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	bool Open(const std::filesystem::path& path);
+	void Close();
+
+	const uint8_t* GetData() const { return data_; }
+	size_t GetSize() const { return size_; }
+
+private:
+	const uint8_t* data_ = nullptr;
+	size_t size_ = 0;
+#ifdef _WIN32
+	void* file_ = nullptr;
+	void* mapping_ = nullptr;
+#else
+	int fd_ = -1;
+#endif
+};
+
+// .mesh ファイル（ObjImporter と MeshOptimizer の結果をそのまま書き出したバイナリ）
+// インデックスは GPU に渡す並びのまま置いてあるので、マップしたメモリから直接使える。
+// どのサブメッシュも頂点が 65535 個以下なら、インデックスは 16 ビットで持つ。
+// kFlagQuantized で作ると頂点は QuantizedVertex（16 バイト）で持つ。CachedModel はそのまま GPU に送り、CopyTo は MeshVertex へ戻す。
+// MeshSimplifier で作った LOD のインデックスも同じインデックスの並びの後ろに置く。
+// 元の obj / mtl のサイズと更新日時をスタンプとして持ち、変わっていたら読み直す。
+// 並びはリトルエンディアン固定（Windows / x64 Linux のみを想定）。
+class MeshCache {
+public:
+	// 形式を変えたら上げる
+	static inline const uint32_t kVersion = 4;
+
+	// 作成時の設定
+	enum Flags : uint32_t {
+		kFlagSmoothing = 1u << 0, // スムージングあり
+		kFlagIndex16 = 1u << 1,   // インデックスが 16 ビット（書き出し時に決まるので Open には渡さない）
+		kFlagQuantized = 1u << 2, // 頂点を圧縮して持つ
+	};
+
+	// obj に対応する .mesh のパス
+	static std::filesystem::path GetCachePath(const std::filesystem::path& objPath);
+	// obj と同じディレクトリの mtl を含めたスタンプ（どれかが変わると値が変わる）
+	static uint64_t ComputeSourceStamp(const std::filesystem::path& objPath);
+
+	// 16 ビットのインデックスで足りるか
+	static bool CanUse16BitIndices(const MeshData& mesh);
+
+	// 書き出す
+	static bool Write(const std::filesystem::path& path, const MeshData& mesh, uint32_t flags, uint64_t sourceStamp);
+
+	// マップして中身を確かめる。形式・設定・スタンプのどれかが合わなければ false
+	bool Open(const std::filesystem::path& path, uint32_t flags, uint64_t sourceStamp);
+	void Close();
+
+	uint32_t GetVertexCount() const { return vertexCount_; }
+	bool IsQuantized() const { return quantized_; }
+	// ファイル上の頂点のバイト数
+	size_t GetVertexDataSize() const { return size_t{vertexCount_} * (quantized_ ? sizeof(QuantizedVertex) : sizeof(MeshVertex)); }
+	// 頂点を GetVertexCount() 個書き出す（圧縮してあれば戻す）
+	void CopyVertices(MeshVertex* out) const;
+	// 圧縮した頂点をそのまま指す（IsQuantized のときだけ。Close するまで有効）と、その復元に使う範囲
+	const QuantizedVertex* GetQuantizedVertices() const { return quantized_ ? static_cast<const QuantizedVertex*>(vertexData_) : nullptr; }
+	const QuantizationBounds& GetQuantizationBounds() const { return bounds_; }
+
+	// マップしたメモリを指す（Close するまで有効）
+	// インデックスは GetIndexSize() バイトずつ並んでいる
+	const void* GetIndexData() const { return indexData_; }
+	uint32_t GetIndexSize() const { return indexSize_; }
+	uint32_t GetIndexCount() const { return indexCount_; }
+	// 小さいので展開して持つ
+	const std::vector<SubMesh>& GetSubMeshes() const { return subMeshes_; }
+	const std::vector<MeshMaterial>& GetMaterials() const { return materials_; }
+	const std::vector<MeshLod>& GetLods() const { return lods_; }
+
+	// MeshData にコピーする（頂点は戻し、インデックスは 32 ビットに広げる）
+	void CopyTo(MeshData& out) const;
+	// 頂点以外（インデックス・サブメッシュ・マテリアル・LOD）だけを MeshData にコピーする（out.vertices は空にする）
+	void CopyTopologyTo(MeshData& out) const;
+
+private:
+	MappedFile file_;
+	const void* vertexData_ = nullptr;
+	uint32_t vertexCount_ = 0;
+	bool quantized_ = false;
+	QuantizationBounds bounds_;
+	const void* indexData_ = nullptr;
+	uint32_t indexSize_ = 4;
+	uint32_t indexCount_ = 0;
+	std::vector<SubMesh> subMeshes_;
+	std::vector<MeshMaterial> materials_;
+	std::vector<MeshLod> lods_;
+};
@@ -0,0 +1,65 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// エンジンに依存しないメッシュデータ
+// ゲーム側（CachedModel）とオフラインツール（Tools/AssetBaker）の両方で使うので、
+// KamataEngine のヘッダは読まない。
+
+// 頂点（Mesh::VertexPosNormalUv と同じ 32 バイトの並び）
+struct MeshVertex {
+	float pos[3];    // xyz座標
+	float normal[3]; // 法線ベクトル
+	float uv[2];     // uv座標
+};
+static_assert(sizeof(MeshVertex) == 32, "MeshVertex must match Mesh::VertexPosNormalUv");
+
+// マテリアル（mtl の内容）
+struct MeshMaterial {
+	std::string name;                            // マテリアル名
+	float ambient[3] = {0.3f, 0.3f, 0.3f};       // アンビエント影響度
+	float diffuse[3] = {0.8f, 0.8f, 0.8f};       // ディフューズ影響度
+	float specular[3] = {0.0f, 0.0f, 0.0f};      // スペキュラー影響度
+	float alpha = 1.0f;                          // アルファ
+	std::string textureFilename;                 // テクスチャファイル名（ディレクトリは含まない）
+};
+
+// サブメッシュ（obj の g 単位）
+struct SubMesh {
+	std::string name;          // グループ名
+	int32_t material = -1;     // MeshData::materials の番号（なければ -1）
+	uint32_t vertexOffset = 0; // 頂点の開始位置
+	uint32_t vertexCount = 0;  // 頂点数
+	uint32_t indexOffset = 0;  // インデックスの開始位置
+	uint32_t indexCount = 0;   // インデックス数（インデックスはサブメッシュ内の頂点番号）
+};
+
+// LOD でのサブメッシュの描画範囲（頂点は SubMesh と同じ範囲を使う）
+struct LodRange {
+	uint32_t indexOffset = 0; // インデックスの開始位置
+	uint32_t indexCount = 0;  // インデックス数
+};
+
+// 簡略化した LOD（LOD0 は subMeshes そのもの）
+struct MeshLod {
+	float error = 0.0f;           // 元の形からのずれ（モデル座標での距離）
+	std::vector<LodRange> ranges; // subMeshes と同じ順
+};
+
+// モデル1つぶん
+struct MeshData {
+	std::vector<MeshVertex> vertices;
+	std::vector<uint32_t> indices; // LOD のインデックスも後ろに続けて入れる
+	std::vector<SubMesh> subMeshes;
+	std::vector<MeshMaterial> materials;
+	std::vector<MeshLod> lods; // 粗くなる順
+
+	void Clear() {
+		vertices.clear();
+		indices.clear();
+		subMeshes.clear();
+		materials.clear();
+		lods.clear();
+	}
+};
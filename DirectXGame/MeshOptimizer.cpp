@@ -0,0 +1,362 @@
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+namespace {
+
+// Forsyth の方法で想定する LRU キャッシュの大きさと点数の係数
+const uint32_t kForsythCacheSize = 32;
+const float kCacheDecayPower = 1.5f;
+const float kLastTriangleScore = 0.75f;
+const float kValenceBoostScale = 2.0f;
+const float kValenceBoostPower = 0.5f;
+const uint32_t kValenceTableSize = 32;
+const uint32_t kNone = UINT32_MAX;
+
+// 点数表（キャッシュ内の位置ごと・残り三角形数ごと）
+struct ScoreTable {
+	float cache[kForsythCacheSize];
+	float valence[kValenceTableSize];
+
+	ScoreTable() {
+		for (uint32_t i = 0; i < kForsythCacheSize; ++i) {
+			// 直前の三角形の3頂点は同点（どの順で使っても同じなので）
+			if (i < 3) {
+				cache[i] = kLastTriangleScore;
+			} else {
+				const float scaler = 1.0f / static_cast<float>(kForsythCacheSize - 3);
+				cache[i] = std::pow(1.0f - static_cast<float>(i - 3) * scaler, kCacheDecayPower);
+			}
+		}
+		valence[0] = 0.0f;
+		for (uint32_t i = 1; i < kValenceTableSize; ++i) {
+			valence[i] = kValenceBoostScale * std::pow(static_cast<float>(i), -kValenceBoostPower);
+		}
+	}
+
+	// cachePosition が kNone ならキャッシュ外
+	float VertexScore(uint32_t cachePosition, uint32_t remaining) const {
+		// 使い切った頂点は選ばれないようにする
+		if (remaining == 0) {
+			return -1.0f;
+		}
+		float score = cachePosition < kForsythCacheSize ? cache[cachePosition] : 0.0f;
+		score += remaining < kValenceTableSize ? valence[remaining] : kValenceBoostScale * std::pow(static_cast<float>(remaining), -kValenceBoostPower);
+		return score;
+	}
+};
+
+// FIFO キャッシュの模擬（タイムスタンプが cacheSize 以内なら入っている）
+// 戻り値は三角形1つでの失敗数
+uint32_t UpdateFifo(const uint32_t* triangle, uint32_t cacheSize, std::vector<uint32_t>& timestamps, uint32_t& timestamp) {
+	uint32_t misses = 0;
+	for (int k = 0; k < 3; ++k) {
+		const uint32_t vertex = triangle[k];
+		if (timestamp - timestamps[vertex] > cacheSize) {
+			timestamps[vertex] = timestamp++;
+			++misses;
+		}
+	}
+	return misses;
+}
+
+struct Float3 {
+	float x, y, z;
+};
+
+Float3 Sub(const float* a, const float* b) { return {a[0] - b[0], a[1] - b[1], a[2] - b[2]}; }
+
+} // namespace
+
+void MeshOptimizer::Optimize(MeshData& mesh) {
+	std::vector<MeshVertex> vertices;
+	vertices.reserve(mesh.vertices.size());
+	for (SubMesh& subMesh : mesh.subMeshes) {
+		uint32_t* indices = mesh.indices.data() + subMesh.indexOffset;
+		MeshVertex* subVertices = mesh.vertices.data() + subMesh.vertexOffset;
+
+		OptimizeVertexCache(indices, subMesh.indexCount, subMesh.vertexCount);
+		OptimizeOverdraw(indices, subMesh.indexCount, subVertices, subMesh.vertexCount);
+		const size_t vertexCount = OptimizeVertexFetch(subVertices, subMesh.vertexCount, indices, subMesh.indexCount);
+
+		// 使われない頂点を捨てた分だけ前に詰める
+		subMesh.vertexOffset = static_cast<uint32_t>(vertices.size());
+		subMesh.vertexCount = static_cast<uint32_t>(vertexCount);
+		vertices.insert(vertices.end(), subVertices, subVertices + vertexCount);
+	}
+	mesh.vertices = std::move(vertices);
+}
+
+void MeshOptimizer::OptimizeVertexCache(uint32_t* indices, size_t indexCount, size_t vertexCount) {
+	static const ScoreTable kScores;
+	const size_t triangleCount = indexCount / 3;
+	if (triangleCount == 0) {
+		return;
+	}
+
+	// 頂点 → 三角形の隣接表（未出力の三角形を頂点ごとに前へ詰めて持つ）
+	std::vector<uint32_t> remaining(vertexCount, 0);
+	for (size_t i = 0; i < indexCount; ++i) {
+		++remaining[indices[i]];
+	}
+	std::vector<uint32_t> offsets(vertexCount + 1, 0);
+	for (size_t v = 0; v < vertexCount; ++v) {
+		offsets[v + 1] = offsets[v] + remaining[v];
+	}
+	std::vector<uint32_t> adjacency(indexCount);
+	{
+		std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+		for (size_t i = 0; i < indexCount; ++i) {
+			adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+		}
+	}
+
+	std::vector<uint32_t> cachePosition(vertexCount, kNone);
+	std::vector<float> vertexScore(vertexCount);
+	for (size_t v = 0; v < vertexCount; ++v) {
+		vertexScore[v] = kScores.VertexScore(kNone, remaining[v]);
+	}
+	std::vector<float> triangleScore(triangleCount);
+	std::vector<uint8_t> emitted(triangleCount, 0);
+	uint32_t best = 0;
+	for (size_t t = 0; t < triangleCount; ++t) {
+		triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+		if (triangleScore[t] > triangleScore[best]) {
+			best = static_cast<uint32_t>(t);
+		}
+	}
+
+	std::vector<uint32_t> output;
+	output.reserve(triangleCount * 3);
+	// 新しく使った3頂点を先頭に積むので、一時的に +3 まであふれる
+	std::array<uint32_t, kForsythCacheSize + 3> cache;
+	std::array<uint32_t, kForsythCacheSize + 3> nextCache;
+	uint32_t cacheCount = 0;
+	// 行き止まりになったときに未出力の三角形を探す位置
+	size_t scanCursor = 0;
+
+	while (output.size() < triangleCount * 3) {
+		if (best == kNone) {
+			while (emitted[scanCursor]) {
+				++scanCursor;
+			}
+			best = static_cast<uint32_t>(scanCursor);
+		}
+
+		// 三角形を出力して、各頂点の隣接表から外す
+		emitted[best] = 1;
+		const uint32_t* triangle = indices + best * 3;
+		for (int k = 0; k < 3; ++k) {
+			const uint32_t vertex = triangle[k];
+			output.push_back(vertex);
+			uint32_t* list = adjacency.data() + offsets[vertex];
+			uint32_t* last = list + remaining[vertex] - 1;
+			*std::find(list, last + 1, best) = *last;
+			--remaining[vertex];
+		}
+
+		// LRU を更新（出力した3頂点を先頭へ）
+		uint32_t nextCount = 0;
+		for (int k = 0; k < 3; ++k) {
+			nextCache[nextCount++] = triangle[k];
+		}
+		for (uint32_t i = 0; i < cacheCount; ++i) {
+			const uint32_t vertex = cache[i];
+			if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2]) {
+				nextCache[nextCount++] = vertex;
+			}
+		}
+		std::swap(cache, nextCache);
+		cacheCount = nextCount;
+
+		// キャッシュ内（あふれて出ていく頂点を含む）の点数を付け直し、その周りから次の三角形を選ぶ
+		for (uint32_t i = 0; i < cacheCount; ++i) {
+			const uint32_t vertex = cache[i];
+			cachePosition[vertex] = i < kForsythCacheSize ? i : kNone;
+			vertexScore[vertex] = kScores.VertexScore(cachePosition[vertex], remaining[vertex]);
+		}
+		best = kNone;
+		float bestScore = -1.0f;
+		for (uint32_t i = 0; i < cacheCount; ++i) {
+			const uint32_t vertex = cache[i];
+			const uint32_t* list = adjacency.data() + offsets[vertex];
+			for (uint32_t j = 0; j < remaining[vertex]; ++j) {
+				const uint32_t t = list[j];
+				const float score = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+				triangleScore[t] = score;
+				if (score > bestScore) {
+					bestScore = score;
+					best = t;
+				}
+			}
+		}
+		cacheCount = std::min(cacheCount, kForsythCacheSize);
+	}
+
+	std::copy(output.begin(), output.end(), indices);
+}
+
+void MeshOptimizer::OptimizeOverdraw(uint32_t* indices, size_t indexCount, const MeshVertex* vertices, size_t vertexCount, float threshold) {
+	const size_t triangleCount = indexCount / 3;
+	if (triangleCount < 2) {
+		return;
+	}
+	const uint32_t cacheSize = kFifoCacheSize;
+	std::vector<uint32_t> timestamps(vertexCount, 0);
+	uint32_t timestamp = cacheSize + 1;
+
+	// 3頂点とも外れる所（キャッシュが途切れる所）で区切る
+	std::vector<uint32_t> hardClusters;
+	for (size_t t = 0; t < triangleCount; ++t) {
+		if (UpdateFifo(indices + t * 3, cacheSize, timestamps, timestamp) == 3 || t == 0) {
+			hardClusters.push_back(static_cast<uint32_t>(t));
+		}
+	}
+
+	// さらに、かたまり単体で描いたときの効率が threshold 倍以内に収まる所で細かく区切る
+	std::vector<uint32_t> clusters;
+	for (size_t c = 0; c < hardClusters.size(); ++c) {
+		const size_t start = hardClusters[c];
+		const size_t end = c + 1 < hardClusters.size() ? hardClusters[c + 1] : triangleCount;
+
+		timestamp += cacheSize + 1;
+		uint32_t clusterMisses = 0;
+		for (size_t t = start; t < end; ++t) {
+			clusterMisses += UpdateFifo(indices + t * 3, cacheSize, timestamps, timestamp);
+		}
+		const float clusterThreshold = threshold * static_cast<float>(clusterMisses) / static_cast<float>(end - start);
+
+		clusters.push_back(static_cast<uint32_t>(start));
+		timestamp += cacheSize + 1;
+		uint32_t runningMisses = 0;
+		uint32_t runningTriangles = 0;
+		for (size_t t = start; t < end; ++t) {
+			runningMisses += UpdateFifo(indices + t * 3, cacheSize, timestamps, timestamp);
+			++runningTriangles;
+			if (static_cast<float>(runningMisses) / static_cast<float>(runningTriangles) <= clusterThreshold) {
+				clusters.push_back(static_cast<uint32_t>(t + 1));
+				timestamp += cacheSize + 1;
+				runningMisses = 0;
+				runningTriangles = 0;
+			}
+		}
+		// 最後の区切りがかたまりの終わりと重なったら取り除く
+		if (clusters.back() == end) {
+			clusters.pop_back();
+		}
+	}
+	if (clusters.size() < 2) {
+		return;
+	}
+
+	// メッシュ全体の重心（面積で重み付け）
+	float meshArea = 0.0f;
+	float meshCenter[3] = {};
+	struct ClusterKey {
+		float center[3];
+		float normal[3];
+		float area;
+	};
+	std::vector<ClusterKey> keys(clusters.size());
+	for (size_t c = 0; c < clusters.size(); ++c) {
+		const size_t start = clusters[c];
+		const size_t end = c + 1 < clusters.size() ? clusters[c + 1] : triangleCount;
+		ClusterKey& key = keys[c];
+		key = ClusterKey{};
+		for (size_t t = start; t < end; ++t) {
+			const float* a = vertices[indices[t * 3]].pos;
+			const float* b = vertices[indices[t * 3 + 1]].pos;
+			const float* d = vertices[indices[t * 3 + 2]].pos;
+			const Float3 ab = Sub(b, a);
+			const Float3 ad = Sub(d, a);
+			const Float3 normal = {ab.y * ad.z - ab.z * ad.y, ab.z * ad.x - ab.x * ad.z, ab.x * ad.y - ab.y * ad.x};
+			const float area = std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+			for (int k = 0; k < 3; ++k) {
+				key.center[k] += (a[k] + b[k] + d[k]) * (area / 3.0f);
+			}
+			key.normal[0] += normal.x;
+			key.normal[1] += normal.y;
+			key.normal[2] += normal.z;
+			key.area += area;
+		}
+		for (int k = 0; k < 3; ++k) {
+			meshCenter[k] += key.center[k];
+		}
+		meshArea += key.area;
+	}
+	if (meshArea <= 0.0f) {
+		return;
+	}
+	for (float& value : meshCenter) {
+		value /= meshArea;
+	}
+
+	// 外側を向いて外側にあるかたまりほど先に描く（後から描く内側の面が深度テストで落ちる）
+	std::vector<float> sortKey(clusters.size());
+	for (size_t c = 0; c < clusters.size(); ++c) {
+		const ClusterKey& key = keys[c];
+		const float inverseArea = key.area > 0.0f ? 1.0f / key.area : 0.0f;
+		const float length = std::sqrt(key.normal[0] * key.normal[0] + key.normal[1] * key.normal[1] + key.normal[2] * key.normal[2]);
+		const float inverseLength = length > 0.0f ? 1.0f / length : 0.0f;
+		float dot = 0.0f;
+		for (int k = 0; k < 3; ++k) {
+			dot += (key.center[k] * inverseArea - meshCenter[k]) * key.normal[k] * inverseLength;
+		}
+		sortKey[c] = dot;
+	}
+	std::vector<uint32_t> order(clusters.size());
+	std::iota(order.begin(), order.end(), 0u);
+	std::stable_sort(order.begin(), order.end(), [&sortKey](uint32_t a, uint32_t b) { return sortKey[a] > sortKey[b]; });
+
+	std::vector<uint32_t> output;
+	output.reserve(indexCount);
+	for (uint32_t c : order) {
+		const size_t start = clusters[c];
+		const size_t end = c + 1 < clusters.size() ? clusters[c + 1] : triangleCount;
+		output.insert(output.end(), indices + start * 3, indices + end * 3);
+	}
+
+	// 区切りを入れた分キャッシュ効率は落ちるので、許容範囲を超えたら元のままにする
+	if (ComputeACMR(output.data(), output.size(), vertexCount) > ComputeACMR(indices, indexCount, vertexCount) * threshold) {
+		return;
+	}
+	std::copy(output.begin(), output.end(), indices);
+}
+
+size_t MeshOptimizer::OptimizeVertexFetch(MeshVertex* vertices, size_t vertexCount, uint32_t* indices, size_t indexCount) {
+	std::vector<uint32_t> remap(vertexCount, kNone);
+	uint32_t next = 0;
+	for (size_t i = 0; i < indexCount; ++i) {
+		uint32_t& mapped = remap[indices[i]];
+		if (mapped == kNone) {
+			mapped = next++;
+		}
+		indices[i] = mapped;
+	}
+
+	std::vector<MeshVertex> reordered(next);
+	for (size_t v = 0; v < vertexCount; ++v) {
+		if (remap[v] != kNone) {
+			reordered[remap[v]] = vertices[v];
+		}
+	}
+	std::copy(reordered.begin(), reordered.end(), vertices);
+	return next;
+}
+
+float MeshOptimizer::ComputeACMR(const uint32_t* indices, size_t indexCount, size_t vertexCount, uint32_t cacheSize) {
+	const size_t triangleCount = indexCount / 3;
+	if (triangleCount == 0) {
+		return 0.0f;
+	}
+	std::vector<uint32_t> timestamps(vertexCount, 0);
+	uint32_t timestamp = cacheSize + 1;
+	size_t misses = 0;
+	for (size_t t = 0; t < triangleCount; ++t) {
+		misses += UpdateFifo(indices + t * 3, cacheSize, timestamps, timestamp);
+	}
+	return static_cast<float>(misses) / static_cast<float>(triangleCount);
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include "MeshData.h"
+#include <cstddef>
+#include <cstdint>
+
+// 頂点キャッシュ・オーバードロー・頂点フェッチ向けのインデックス／頂点の並べ替え
+// どれも三角形の集合は変えず、並び順だけを変える。インデックスはサブメッシュ内の頂点番号。
+class MeshOptimizer {
+public:
+	// 頂点キャッシュの効率を見積もるときの FIFO の大きさ
+	static inline const uint32_t kFifoCacheSize = 16;
+
+	// MeshData の全サブメッシュに下の3つを順にかける
+	static void Optimize(MeshData& mesh);
+
+	// 変換後頂点キャッシュに当たりやすい順に三角形を並べ替える（Forsyth の方法）
+	static void OptimizeVertexCache(uint32_t* indices, size_t indexCount, size_t vertexCount);
+
+	// キャッシュの効率を threshold 倍まで悪くしてよい範囲で、外側を向いた三角形のかたまりを先に描く順に並べ替える
+	// （Sander らの Tipsify と同じく、キャッシュが途切れる所で区切ったかたまりを向きで並べる）
+	static void OptimizeOverdraw(uint32_t* indices, size_t indexCount, const MeshVertex* vertices, size_t vertexCount, float threshold = 1.2f);
+
+	// 頂点を最初に使われる順に並べ替え、インデックスを付け替える。使われない頂点は捨てる。戻り値は残った頂点数
+	static size_t OptimizeVertexFetch(MeshVertex* vertices, size_t vertexCount, uint32_t* indices, size_t indexCount);
+
+	// 1三角形あたりの頂点シェーダー実行数（FIFO キャッシュで数える。0.5 が下限、3 が上限）
+	static float ComputeACMR(const uint32_t* indices, size_t indexCount, size_t vertexCount, uint32_t cacheSize = kFifoCacheSize);
+};
@@ -0,0 +1,161 @@
+#include "MeshQuantizer.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace {
+
+const float kSnorm16Max = 32767.0f;
+const float kUnorm16Max = 65535.0f;
+
+float SignNotZero(float value) { return value >= 0.0f ? 1.0f : -1.0f; }
+
+// 8 面体の下半分を上半分へ折り返す
+void Wrap(float& x, float& y) {
+	const float wrappedX = (1.0f - std::fabs(y)) * SignNotZero(x);
+	const float wrappedY = (1.0f - std::fabs(x)) * SignNotZero(y);
+	x = wrappedX;
+	y = wrappedY;
+}
+
+} // namespace
+
+QuantizationBounds MeshQuantizer::ComputeBounds(const MeshVertex* vertices, size_t count) {
+	QuantizationBounds bounds;
+	if (count == 0) {
+		return bounds;
+	}
+	float minimum[3] = {vertices[0].pos[0], vertices[0].pos[1], vertices[0].pos[2]};
+	float maximum[3] = {minimum[0], minimum[1], minimum[2]};
+	for (size_t i = 1; i < count; ++i) {
+		for (int k = 0; k < 3; ++k) {
+			minimum[k] = std::min(minimum[k], vertices[i].pos[k]);
+			maximum[k] = std::max(maximum[k], vertices[i].pos[k]);
+		}
+	}
+	for (int k = 0; k < 3; ++k) {
+		bounds.offset[k] = minimum[k];
+		bounds.scale[k] = (maximum[k] - minimum[k]) / kUnorm16Max;
+	}
+	return bounds;
+}
+
+void MeshQuantizer::Quantize(const MeshVertex* vertices, size_t count, const QuantizationBounds& bounds, QuantizedVertex* out) {
+	float inverseScale[3];
+	for (int k = 0; k < 3; ++k) {
+		inverseScale[k] = bounds.scale[k] > 0.0f ? 1.0f / bounds.scale[k] : 0.0f;
+	}
+	for (size_t i = 0; i < count; ++i) {
+		const MeshVertex& vertex = vertices[i];
+		QuantizedVertex& quantized = out[i];
+		for (int k = 0; k < 3; ++k) {
+			const float q = std::round((vertex.pos[k] - bounds.offset[k]) * inverseScale[k]);
+			quantized.pos[k] = static_cast<uint16_t>(std::clamp(q, 0.0f, kUnorm16Max));
+		}
+		quantized.pos[3] = 0;
+		EncodeOctahedral(vertex.normal, quantized.normal);
+		quantized.uv[0] = FloatToHalf(vertex.uv[0]);
+		quantized.uv[1] = FloatToHalf(vertex.uv[1]);
+	}
+}
+
+void MeshQuantizer::Dequantize(const QuantizedVertex* vertices, size_t count, const QuantizationBounds& bounds, MeshVertex* out) {
+	for (size_t i = 0; i < count; ++i) {
+		const QuantizedVertex& quantized = vertices[i];
+		MeshVertex& vertex = out[i];
+		for (int k = 0; k < 3; ++k) {
+			vertex.pos[k] = bounds.offset[k] + static_cast<float>(quantized.pos[k]) * bounds.scale[k];
+		}
+		DecodeOctahedral(quantized.normal, vertex.normal);
+		vertex.uv[0] = HalfToFloat(quantized.uv[0]);
+		vertex.uv[1] = HalfToFloat(quantized.uv[1]);
+	}
+}
+
+void MeshQuantizer::EncodeOctahedral(const float normal[3], int16_t out[2]) {
+	const float length = std::fabs(normal[0]) + std::fabs(normal[1]) + std::fabs(normal[2]);
+	if (length == 0.0f) {
+		out[0] = 0;
+		out[1] = static_cast<int16_t>(kSnorm16Max);
+		return;
+	}
+	float x = normal[0] / length;
+	float y = normal[1] / length;
+	if (normal[2] < 0.0f) {
+		Wrap(x, y);
+	}
+
+	// 切り捨て・切り上げの4通りを戻してみて、元の向きに一番近いものを選ぶ
+	const float baseX = std::floor(std::clamp(x, -1.0f, 1.0f) * kSnorm16Max);
+	const float baseY = std::floor(std::clamp(y, -1.0f, 1.0f) * kSnorm16Max);
+	float bestDot = -2.0f;
+	for (int i = 0; i < 4; ++i) {
+		const int16_t candidate[2] = {
+		    static_cast<int16_t>(std::clamp(baseX + static_cast<float>(i & 1), -kSnorm16Max, kSnorm16Max)),
+		    static_cast<int16_t>(std::clamp(baseY + static_cast<float>(i >> 1), -kSnorm16Max, kSnorm16Max)),
+		};
+		float decoded[3];
+		DecodeOctahedral(candidate, decoded);
+		const float dot = decoded[0] * normal[0] + decoded[1] * normal[1] + decoded[2] * normal[2];
+		if (dot > bestDot) {
+			bestDot = dot;
+			out[0] = candidate[0];
+			out[1] = candidate[1];
+		}
+	}
+}
+
+void MeshQuantizer::DecodeOctahedral(const int16_t encoded[2], float out[3]) {
+	float x = std::max(static_cast<float>(encoded[0]) / kSnorm16Max, -1.0f);
+	float y = std::max(static_cast<float>(encoded[1]) / kSnorm16Max, -1.0f);
+	const float z = 1.0f - std::fabs(x) - std::fabs(y);
+	if (z < 0.0f) {
+		Wrap(x, y);
+	}
+	const float length = std::sqrt(x * x + y * y + z * z);
+	out[0] = x / length;
+	out[1] = y / length;
+	out[2] = z / length;
+}
+
+uint16_t MeshQuantizer::FloatToHalf(float value) {
+	const uint32_t bits = std::bit_cast<uint32_t>(value);
+	const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+	const uint32_t absolute = bits & 0x7FFFFFFF;
+
+	// 無限大・NaN
+	if (absolute >= 0x7F800000) {
+		return static_cast<uint16_t>(sign | 0x7C00 | (absolute > 0x7F800000 ? 0x0200 : 0));
+	}
+	// 65520 以上は丸めると無限大
+	if (absolute >= 0x477FF000) {
+		return static_cast<uint16_t>(sign | 0x7C00);
+	}
+	// 2^-14 未満は非正規化数（2^-24 単位に丸める。繰り上がれば最小の正規化数になる）
+	if (absolute < 0x38800000) {
+		const float scaled = std::bit_cast<float>(absolute) * 16777216.0f;
+		return static_cast<uint16_t>(sign | static_cast<uint16_t>(std::nearbyint(scaled)));
+	}
+	// 指数を付け替え、仮数の下 13 ビットを最近接偶数に丸める（繰り上がりは指数へ伝わる）
+	uint32_t half = ((absolute - 0x38000000) >> 13);
+	const uint32_t rest = absolute & 0x1FFF;
+	if (rest > 0x1000 || (rest == 0x1000 && (half & 1))) {
+		++half;
+	}
+	return static_cast<uint16_t>(sign | half);
+}
+
+float MeshQuantizer::HalfToFloat(uint16_t value) {
+	const uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+	const uint32_t exponent = (value >> 10) & 0x1F;
+	const uint32_t mantissa = value & 0x03FF;
+	if (exponent == 0) {
+		// 0 と非正規化数
+		const float magnitude = static_cast<float>(mantissa) * (1.0f / 16777216.0f);
+		return std::bit_cast<float>(std::bit_cast<uint32_t>(magnitude) | sign);
+	}
+	if (exponent == 0x1F) {
+		return std::bit_cast<float>(sign | 0x7F800000 | (mantissa << 13));
+	}
+	return std::bit_cast<float>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+}
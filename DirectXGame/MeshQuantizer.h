@@ -0,0 +1,38 @@
+#pragma once
+#include "MeshData.h"
+#include <cstddef>
+#include <cstdint>
+
+// 16 バイトの圧縮頂点
+// 位置はメッシュの範囲に対する 16 ビット正規化値、法線は 8 面体写像の 16 ビット符号付き正規化値、uv は半精度。
+// GPU では R16G16B16A16_UNORM / R16G16_SNORM / R16G16_FLOAT として読む（CachedModel がそのまま頂点バッファに置き、ObjQuantizedVS で戻す）。
+struct QuantizedVertex {
+	uint16_t pos[4];   // xyz（w は未使用）
+	int16_t normal[2]; // 8 面体写像した法線
+	uint16_t uv[2];    // 半精度の uv
+};
+static_assert(sizeof(QuantizedVertex) == 16, "QuantizedVertex must be 16 bytes");
+
+// 位置の復元に使う範囲（pos = offset + q * scale）
+struct QuantizationBounds {
+	float offset[3] = {};
+	float scale[3] = {};
+};
+
+// MeshVertex と QuantizedVertex の相互変換
+class MeshQuantizer {
+public:
+	// 頂点全体を囲む範囲
+	static QuantizationBounds ComputeBounds(const MeshVertex* vertices, size_t count);
+
+	static void Quantize(const MeshVertex* vertices, size_t count, const QuantizationBounds& bounds, QuantizedVertex* out);
+	static void Dequantize(const QuantizedVertex* vertices, size_t count, const QuantizationBounds& bounds, MeshVertex* out);
+
+	// 8 面体写像（一番近い格子点を4つの候補から選ぶ）
+	static void EncodeOctahedral(const float normal[3], int16_t out[2]);
+	static void DecodeOctahedral(const int16_t encoded[2], float out[3]);
+
+	// 半精度（最近接偶数への丸め）
+	static uint16_t FloatToHalf(float value);
+	static float HalfToFloat(uint16_t value);
+};
@@ -0,0 +1,510 @@
+#include "MeshSimplifier.h"
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace {
+
+const uint32_t kNone = UINT32_MAX;
+// 縁の辺に足す平面の重み（縁が内側へ縮まないように）
+const double kBorderWeight = 10.0;
+// 縮約で面の向きがこれ以上変わるもの（cos で 75 度）は裏返るとみなす
+const double kFlipThreshold = 0.25;
+// 1回の縮約でまとめて縮める候補の誤差の上限（目標の数だけ縮めたときの誤差に対する倍率）
+// 縮めた頂点のまわりは同じ回では動かせないので、その分だけ余裕を持たせる
+const double kPassErrorScale = 1.5;
+// 前の段よりこれ以上三角形が残るなら LOD を作らない
+const float kMinLodReduction = 0.75f;
+
+// 頂点の種類（同じ位置の頂点はすべて同じ種類）
+enum VertexKind : uint8_t {
+	kManifold, // 内側（どこへでも縮められる）
+	kBorder,   // 穴の縁（縁に沿ってだけ縮める）
+	kSeam,     // uv の継ぎ目（同じ位置に頂点が2つ。継ぎ目に沿って両方を縮める）
+	kLocked,   // 動かさない
+};
+
+// 平面までの距離の2乗の和（対称行列 A、ベクトル b、定数 c で p・Ap + 2b・p + c）
+struct Quadric {
+	double a00 = 0.0, a11 = 0.0, a22 = 0.0, a01 = 0.0, a02 = 0.0, a12 = 0.0;
+	double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+	double c = 0.0;
+	double weight = 0.0;
+
+	// 平面 n・p + d = 0 を重み w で足す
+	void AddPlane(const double n[3], double d, double w) {
+		a00 += w * n[0] * n[0];
+		a11 += w * n[1] * n[1];
+		a22 += w * n[2] * n[2];
+		a01 += w * n[0] * n[1];
+		a02 += w * n[0] * n[2];
+		a12 += w * n[1] * n[2];
+		b0 += w * n[0] * d;
+		b1 += w * n[1] * d;
+		b2 += w * n[2] * d;
+		c += w * d * d;
+		weight += w;
+	}
+
+	void Add(const Quadric& other) {
+		a00 += other.a00;
+		a11 += other.a11;
+		a22 += other.a22;
+		a01 += other.a01;
+		a02 += other.a02;
+		a12 += other.a12;
+		b0 += other.b0;
+		b1 += other.b1;
+		b2 += other.b2;
+		c += other.c;
+		weight += other.weight;
+	}
+
+	// p での距離の2乗の重み付き平均
+	double Evaluate(const float p[3]) const {
+		const double x = p[0];
+		const double y = p[1];
+		const double z = p[2];
+		const double value = a00 * x * x + a11 * y * y + a22 * z * z + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z) + 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+		return weight > 0.0 ? std::fabs(value) / weight : 0.0;
+	}
+};
+
+// 縮約の候補
+struct Collapse {
+	uint32_t from;
+	uint32_t to;
+	double error;
+};
+
+// 有向辺の集合
+class EdgeSet {
+public:
+	// remap があれば頂点番号を付け替えてから入れる
+	void Build(const uint32_t* indices, size_t indexCount, const uint32_t* remap) {
+		keys_.resize(indexCount);
+		for (size_t i = 0; i < indexCount; ++i) {
+			const uint32_t a = indices[i];
+			const uint32_t b = indices[i - i % 3 + (i + 1) % 3];
+			keys_[i] = remap ? Key(remap[a], remap[b]) : Key(a, b);
+		}
+		std::sort(keys_.begin(), keys_.end());
+	}
+
+	bool Has(uint32_t a, uint32_t b) const { return std::binary_search(keys_.begin(), keys_.end(), Key(a, b)); }
+
+private:
+	static uint64_t Key(uint32_t a, uint32_t b) { return (uint64_t{a} << 32) | b; }
+
+	std::vector<uint64_t> keys_;
+};
+
+void Subtract(const float* a, const float* b, double out[3]) {
+	out[0] = static_cast<double>(a[0]) - b[0];
+	out[1] = static_cast<double>(a[1]) - b[1];
+	out[2] = static_cast<double>(a[2]) - b[2];
+}
+
+void Cross(const double a[3], const double b[3], double out[3]) {
+	out[0] = a[1] * b[2] - a[2] * b[1];
+	out[1] = a[2] * b[0] - a[0] * b[2];
+	out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+double Dot(const double a[3], const double b[3]) { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; }
+
+// 面積の2倍の長さを持つ法線
+void TriangleNormal(const float* p0, const float* p1, const float* p2, double out[3]) {
+	double e1[3];
+	double e2[3];
+	Subtract(p1, p0, e1);
+	Subtract(p2, p0, e2);
+	Cross(e1, e2, out);
+}
+
+// 相手のいない有向辺（縁か継ぎ目）を頂点ごとに数え、最後に見つけた相手を覚える
+void FindOpenEdges(const uint32_t* indices, size_t indexCount, const EdgeSet& edges, std::vector<uint32_t>& openNext, std::vector<uint32_t>& openPrev, std::vector<uint32_t>& openOut,
+                   std::vector<uint32_t>& openIn) {
+	std::fill(openNext.begin(), openNext.end(), kNone);
+	std::fill(openPrev.begin(), openPrev.end(), kNone);
+	std::fill(openOut.begin(), openOut.end(), 0u);
+	std::fill(openIn.begin(), openIn.end(), 0u);
+	for (size_t i = 0; i < indexCount; ++i) {
+		const uint32_t a = indices[i];
+		const uint32_t b = indices[i - i % 3 + (i + 1) % 3];
+		if (!edges.Has(b, a)) {
+			openNext[a] = b;
+			++openOut[a];
+			openPrev[b] = a;
+			++openIn[b];
+		}
+	}
+}
+
+} // namespace
+
+void MeshSimplifier::GenerateLods(MeshData& mesh, uint32_t lodCount, float maxError) {
+	mesh.lods.clear();
+	if (mesh.vertices.empty()) {
+		return;
+	}
+
+	// ずれの上限はモデルの一番長い辺に対する比で決める
+	float minimum[3] = {INFINITY, INFINITY, INFINITY};
+	float maximum[3] = {-INFINITY, -INFINITY, -INFINITY};
+	for (const MeshVertex& vertex : mesh.vertices) {
+		for (int k = 0; k < 3; ++k) {
+			minimum[k] = std::min(minimum[k], vertex.pos[k]);
+			maximum[k] = std::max(maximum[k], vertex.pos[k]);
+		}
+	}
+	const float extent = std::max({maximum[0] - minimum[0], maximum[1] - minimum[1], maximum[2] - minimum[2]});
+
+	size_t previousTriangles = 0;
+	for (const SubMesh& subMesh : mesh.subMeshes) {
+		previousTriangles += subMesh.indexCount / 3;
+	}
+	float previousError = 0.0f;
+	std::vector<uint32_t> simplified;
+	for (uint32_t level = 1; level <= lodCount; ++level) {
+		const size_t indexEnd = mesh.indices.size();
+		MeshLod lod;
+		size_t triangles = 0;
+		for (const SubMesh& subMesh : mesh.subMeshes) {
+			// 毎回 LOD0 から減らす（ずれを元の形から測るため）
+			const size_t target = static_cast<size_t>(subMesh.indexCount / 3) >> level;
+			simplified.resize(subMesh.indexCount);
+			float error = 0.0f;
+			const size_t count = Simplify(
+			    simplified.data(), mesh.indices.data() + subMesh.indexOffset, subMesh.indexCount, mesh.vertices.data() + subMesh.vertexOffset, subMesh.vertexCount, target * 3, maxError * extent,
+			    &error);
+			MeshOptimizer::OptimizeVertexCache(simplified.data(), count, subMesh.vertexCount);
+
+			LodRange range;
+			range.indexOffset = static_cast<uint32_t>(mesh.indices.size());
+			range.indexCount = static_cast<uint32_t>(count);
+			mesh.indices.insert(mesh.indices.end(), simplified.begin(), simplified.begin() + count);
+			lod.ranges.push_back(range);
+			lod.error = std::max(lod.error, error);
+			triangles += count / 3;
+		}
+
+		// あまり減らなかったら、これより粗い段も作れないので止める
+		if (static_cast<float>(triangles) > static_cast<float>(previousTriangles) * kMinLodReduction) {
+			mesh.indices.resize(indexEnd);
+			break;
+		}
+		// 粗い段ほどずれが大きいようにそろえる（選ぶときに単調であることを使う）
+		lod.error = std::max(lod.error, previousError);
+		previousError = lod.error;
+		previousTriangles = triangles;
+		mesh.lods.push_back(std::move(lod));
+	}
+}
+
+size_t MeshSimplifier::Simplify(
+    uint32_t* destination, const uint32_t* indices, size_t indexCount, const MeshVertex* vertices, size_t vertexCount, size_t targetIndexCount, float maxError, float* error) {
+	std::copy(indices, indices + indexCount, destination);
+	size_t resultCount = indexCount;
+	double resultError = 0.0;
+	if (error) {
+		*error = 0.0f;
+	}
+	if (targetIndexCount >= indexCount || vertexCount == 0) {
+		return resultCount;
+	}
+
+	// 同じ位置の頂点をまとめる（remap は一番小さい番号、wedge は同じ位置の次の頂点で、一周すると戻る）
+	std::vector<uint32_t> order(vertexCount);
+	std::iota(order.begin(), order.end(), 0u);
+	std::sort(order.begin(), order.end(), [vertices](uint32_t a, uint32_t b) {
+		const int compare = std::memcmp(vertices[a].pos, vertices[b].pos, sizeof(vertices[a].pos));
+		return compare != 0 ? compare < 0 : a < b;
+	});
+	std::vector<uint32_t> remap(vertexCount);
+	std::vector<uint32_t> wedge(vertexCount);
+	for (size_t i = 0; i < vertexCount;) {
+		size_t end = i + 1;
+		while (end < vertexCount && std::memcmp(vertices[order[end]].pos, vertices[order[i]].pos, sizeof(vertices[0].pos)) == 0) {
+			++end;
+		}
+		for (size_t k = i; k < end; ++k) {
+			remap[order[k]] = order[i];
+			wedge[order[k]] = order[k + 1 == end ? i : k + 1];
+		}
+		i = end;
+	}
+
+	// 頂点の種類を決める
+	EdgeSet edges;
+	EdgeSet positionEdges;
+	edges.Build(indices, indexCount, nullptr);
+	positionEdges.Build(indices, indexCount, remap.data());
+	std::vector<uint32_t> openNext(vertexCount);
+	std::vector<uint32_t> openPrev(vertexCount);
+	std::vector<uint32_t> openOut(vertexCount);
+	std::vector<uint32_t> openIn(vertexCount);
+	FindOpenEdges(indices, indexCount, edges, openNext, openPrev, openOut, openIn);
+
+	std::vector<uint8_t> kinds(vertexCount, kLocked);
+	for (uint32_t v = 0; v < vertexCount; ++v) {
+		if (remap[v] != v) {
+			continue;
+		}
+		uint8_t kind = kLocked;
+		const uint32_t other = wedge[v];
+		if (other == v) {
+			if (openOut[v] == 0 && openIn[v] == 0) {
+				kind = kManifold;
+			} else if (openOut[v] == 1 && openIn[v] == 1 && !positionEdges.Has(remap[openNext[v]], v) && !positionEdges.Has(v, remap[openPrev[v]])) {
+				// 位置で見ても相手のいない辺なら穴の縁（相手がいれば継ぎ目の端）
+				kind = kBorder;
+			}
+		} else if (wedge[other] == v) {
+			// 2つの頂点の開いた辺が、位置で見て互いに向き合っていれば継ぎ目
+			if (openOut[v] == 1 && openIn[v] == 1 && openOut[other] == 1 && openIn[other] == 1 && remap[openNext[v]] == remap[openPrev[other]] &&
+			    remap[openNext[other]] == remap[openPrev[v]]) {
+				kind = kSeam;
+			}
+		}
+		uint32_t w = v;
+		do {
+			kinds[w] = kind;
+			w = wedge[w];
+		} while (w != v);
+	}
+
+	// 位置ごとの誤差（面の平面を面積で重み付けし、穴の縁には縁に垂直な平面も足す）
+	std::vector<Quadric> quadrics(vertexCount);
+	for (size_t t = 0; t < indexCount / 3; ++t) {
+		const uint32_t* triangle = indices + t * 3;
+		double normal[3];
+		TriangleNormal(vertices[triangle[0]].pos, vertices[triangle[1]].pos, vertices[triangle[2]].pos, normal);
+		const double length = std::sqrt(Dot(normal, normal));
+		if (length == 0.0) {
+			continue;
+		}
+		for (double& value : normal) {
+			value /= length;
+		}
+		const double p0[3] = {vertices[triangle[0]].pos[0], vertices[triangle[0]].pos[1], vertices[triangle[0]].pos[2]};
+		const double d = -Dot(normal, p0);
+		for (int k = 0; k < 3; ++k) {
+			quadrics[remap[triangle[k]]].AddPlane(normal, d, length * 0.5);
+		}
+
+		for (int k = 0; k < 3; ++k) {
+			const uint32_t a = triangle[k];
+			const uint32_t b = triangle[(k + 1) % 3];
+			if (positionEdges.Has(remap[b], remap[a])) {
+				continue;
+			}
+			double edge[3];
+			Subtract(vertices[b].pos, vertices[a].pos, edge);
+			const double edgeLength = std::sqrt(Dot(edge, edge));
+			if (edgeLength == 0.0) {
+				continue;
+			}
+			double side[3];
+			Cross(edge, normal, side);
+			for (double& value : side) {
+				value /= edgeLength;
+			}
+			const double pa[3] = {vertices[a].pos[0], vertices[a].pos[1], vertices[a].pos[2]};
+			const double sideD = -Dot(side, pa);
+			quadrics[remap[a]].AddPlane(side, sideD, edgeLength * edgeLength * kBorderWeight);
+			quadrics[remap[b]].AddPlane(side, sideD, edgeLength * edgeLength * kBorderWeight);
+		}
+	}
+
+	auto canCollapse = [&](uint32_t from, uint32_t to) {
+		switch (kinds[from]) {
+		case kManifold:
+			return true;
+		case kBorder:
+			return (kinds[to] == kBorder || kinds[to] == kLocked) && (openNext[from] == to || openPrev[from] == to);
+		case kSeam:
+			return (kinds[to] == kSeam || kinds[to] == kLocked) && (openNext[from] == to || openPrev[from] == to);
+		default:
+			return false;
+		}
+	};
+
+	std::vector<uint32_t> adjacencyOffsets(vertexCount + 1);
+	std::vector<uint32_t> adjacency;
+	// from を to の位置へ動かしたときに、まわりの三角形が裏返るか
+	auto flips = [&](uint32_t from, uint32_t to) {
+		const uint32_t fromPosition = remap[from];
+		const uint32_t toPosition = remap[to];
+		for (uint32_t i = adjacencyOffsets[fromPosition]; i < adjacencyOffsets[fromPosition + 1]; ++i) {
+			const uint32_t* triangle = destination + size_t{adjacency[i]} * 3;
+			const float* before[3];
+			const float* after[3];
+			bool removed = false;
+			for (int k = 0; k < 3; ++k) {
+				before[k] = vertices[triangle[k]].pos;
+				after[k] = remap[triangle[k]] == fromPosition ? vertices[to].pos : before[k];
+				removed = removed || remap[triangle[k]] == toPosition;
+			}
+			// to を含む三角形はつぶれて消える
+			if (removed) {
+				continue;
+			}
+			double normalBefore[3];
+			double normalAfter[3];
+			TriangleNormal(before[0], before[1], before[2], normalBefore);
+			TriangleNormal(after[0], after[1], after[2], normalAfter);
+			const double lengthBefore = Dot(normalBefore, normalBefore);
+			const double lengthAfter = Dot(normalAfter, normalAfter);
+			if (Dot(normalBefore, normalAfter) < kFlipThreshold * std::sqrt(lengthBefore * lengthAfter)) {
+				return true;
+			}
+			// 面積のあった三角形が一直線につぶれるのも裏返りとみなす（縁に沿った縮約で面積 0 の三角形が残らないように）
+			if (lengthAfter == 0.0 && lengthBefore > 0.0) {
+				return true;
+			}
+		}
+		return false;
+	};
+
+	const double maxErrorSquared = static_cast<double>(maxError) * maxError;
+	std::vector<Collapse> candidates;
+	std::vector<uint32_t> collapseRemap(vertexCount);
+	std::vector<uint8_t> collapseLocked(vertexCount);
+	while (resultCount > targetIndexCount) {
+		const size_t triangleCount = resultCount / 3;
+		edges.Build(destination, resultCount, nullptr);
+		FindOpenEdges(destination, resultCount, edges, openNext, openPrev, openOut, openIn);
+
+		// 位置 → 三角形の表
+		std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0u);
+		for (size_t i = 0; i < resultCount; ++i) {
+			++adjacencyOffsets[remap[destination[i]] + 1];
+		}
+		std::partial_sum(adjacencyOffsets.begin(), adjacencyOffsets.end(), adjacencyOffsets.begin());
+		adjacency.resize(resultCount);
+		{
+			std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+			for (size_t i = 0; i < resultCount; ++i) {
+				adjacency[fill[remap[destination[i]]]++] = static_cast<uint32_t>(i / 3);
+			}
+		}
+
+		// 辺ごとに、誤差の小さいほうの向きで縮約の候補にする
+		candidates.clear();
+		for (size_t i = 0; i < resultCount; ++i) {
+			const uint32_t a = destination[i];
+			const uint32_t b = destination[i - i % 3 + (i + 1) % 3];
+			// 内側の辺は2つの三角形に出てくるので片方だけ見る
+			if (remap[a] == remap[b] || (edges.Has(b, a) && a > b)) {
+				continue;
+			}
+			Collapse best{kNone, kNone, std::numeric_limits<double>::infinity()};
+			const uint32_t ends[2] = {a, b};
+			for (int k = 0; k < 2; ++k) {
+				const uint32_t from = ends[k];
+				const uint32_t to = ends[1 - k];
+				if (!canCollapse(from, to)) {
+					continue;
+				}
+				Quadric quadric = quadrics[remap[from]];
+				quadric.Add(quadrics[remap[to]]);
+				const double collapseError = quadric.Evaluate(vertices[to].pos);
+				if (collapseError < best.error) {
+					best = {from, to, collapseError};
+				}
+			}
+			if (best.from != kNone) {
+				candidates.push_back(best);
+			}
+		}
+		if (candidates.empty()) {
+			break;
+		}
+		std::sort(candidates.begin(), candidates.end(), [](const Collapse& l, const Collapse& r) { return l.error < r.error; });
+
+		// 誤差の小さいものから、同じ三角形の頂点を2つ動かさない範囲でまとめて縮める
+		std::iota(collapseRemap.begin(), collapseRemap.end(), 0u);
+		std::fill(collapseLocked.begin(), collapseLocked.end(), uint8_t{0});
+		const size_t goal = triangleCount - targetIndexCount / 3;
+		const double passError = kPassErrorScale * candidates[std::min(goal / 2, candidates.size() - 1)].error;
+		size_t removedTriangles = 0;
+		size_t collapses = 0;
+		for (const Collapse& collapse : candidates) {
+			// 誤差の大きいものは次の回にまわす（残りが減ってから選び直したほうが小さく済む）
+			if (collapse.error > maxErrorSquared || (collapse.error > passError && removedTriangles > goal / 10)) {
+				break;
+			}
+			const uint32_t fromPosition = remap[collapse.from];
+			const uint32_t toPosition = remap[collapse.to];
+			if (collapseLocked[fromPosition] || collapseLocked[toPosition] || flips(collapse.from, collapse.to)) {
+				continue;
+			}
+			// 継ぎ目は反対側の頂点も、同じ位置のうちで辺がつながっている頂点へ縮める
+			uint32_t sibling = kNone;
+			uint32_t siblingTarget = kNone;
+			if (kinds[collapse.from] == kSeam) {
+				sibling = wedge[collapse.from];
+				uint32_t w = collapse.to;
+				do {
+					w = wedge[w];
+					if (edges.Has(sibling, w) || edges.Has(w, sibling)) {
+						siblingTarget = w;
+						break;
+					}
+				} while (w != collapse.to);
+				if (siblingTarget == kNone) {
+					continue;
+				}
+			}
+
+			collapseRemap[collapse.from] = collapse.to;
+			if (sibling != kNone) {
+				collapseRemap[sibling] = siblingTarget;
+			}
+			quadrics[toPosition].Add(quadrics[fromPosition]);
+			// 動かした頂点のまわりの三角形の頂点は、この回ではもう動かさない
+			// （裏返りは1つずつしか確かめていないので、同じ三角形の2頂点を同じ回に動かすと裏返ったりつぶれたりする）
+			for (uint32_t i = adjacencyOffsets[fromPosition]; i < adjacencyOffsets[fromPosition + 1]; ++i) {
+				const uint32_t* triangle = destination + size_t{adjacency[i]} * 3;
+				for (int k = 0; k < 3; ++k) {
+					collapseLocked[remap[triangle[k]]] = 1;
+				}
+			}
+			resultError = std::max(resultError, collapse.error);
+			++collapses;
+			// 内側と継ぎ目なら三角形が2つ、縁なら1つ消える
+			removedTriangles += kinds[collapse.from] == kBorder ? 1 : 2;
+			if (removedTriangles >= goal) {
+				break;
+			}
+		}
+		if (collapses == 0) {
+			break;
+		}
+
+		// インデックスを付け替えて、つぶれた三角形を捨てる
+		size_t write = 0;
+		for (size_t t = 0; t < triangleCount; ++t) {
+			const uint32_t a = collapseRemap[destination[t * 3]];
+			const uint32_t b = collapseRemap[destination[t * 3 + 1]];
+			const uint32_t c = collapseRemap[destination[t * 3 + 2]];
+			if (remap[a] == remap[b] || remap[b] == remap[c] || remap[c] == remap[a]) {
+				continue;
+			}
+			destination[write++] = a;
+			destination[write++] = b;
+			destination[write++] = c;
+		}
+		resultCount = write;
+	}
+
+	if (error) {
+		*error = static_cast<float>(std::sqrt(resultError));
+	}
+	return resultCount;
+}
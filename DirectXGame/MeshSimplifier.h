@@ -0,0 +1,25 @@
+#pragma once
+#include "MeshData.h"
+#include <cstddef>
+#include <cstdint>
+
+// 二次誤差（Garland と Heckbert の QEM）で辺を縮めてメッシュを粗くする
+// 頂点は増やさず、元の頂点を指すインデックスだけを作り直す。インデックスはサブメッシュ内の頂点番号。
+// 穴の縁は縁に沿ってだけ動かし、同じ位置に uv の違う頂点が重なる継ぎ目は両側をそろえて動かす。
+class MeshSimplifier {
+public:
+	// LOD の段数（1段ごとに三角形を前の段の半分にする）
+	static inline const uint32_t kLodCount = 3;
+	// LOD で許すずれ（モデルの一番長い辺に対する比）
+	static inline const float kLodMaxError = 0.05f;
+
+	// 全サブメッシュの LOD を作って mesh.lods と mesh.indices の後ろに足す
+	// 三角形があまり減らなくなったらそこで止める。頂点の並びを変えるので MeshOptimizer::Optimize の後に呼ぶ
+	static void GenerateLods(MeshData& mesh, uint32_t lodCount = kLodCount, float maxError = kLodMaxError);
+
+	// indexCount を targetIndexCount まで減らしたインデックスを destination（indexCount 個ぶん）に書き、その数を返す
+	// ずれが maxError（モデル座標での距離）を超える縮約はしないので、目標まで減らないこともある
+	// error には実際のずれを返す
+	static size_t Simplify(
+	    uint32_t* destination, const uint32_t* indices, size_t indexCount, const MeshVertex* vertices, size_t vertexCount, size_t targetIndexCount, float maxError, float* error = nullptr);
+};
@@ -1,27 +1,455 @@
 #pragma once
 #include "KamataEngine.h"
+#include <assert.h>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+// SIMD の使い分け（/arch:AVX 以上なら AVX、x64 なら SSE、それ以外はスカラー）
+#if defined(__AVX__)
+#include <immintrin.h>
+#define METHOD_USE_AVX
+#define METHOD_USE_SSE
+#elif defined(_M_X64) || defined(__SSE2__)
+#include <xmmintrin.h>
+#define METHOD_USE_SSE
+#endif
 
 using namespace KamataEngine;
 
+// ゲーム側の数学関数はすべてこのヘッダにまとめる。
+// 呼び出し側で展開できるよう全部 inline で、SIMD を使わないものは constexpr にしてある。
+// エンジンの KamataEngine::MathUtility と同じ名前のものもここで inline で持つので、ゲームのコードは MathUtility を使わない
+// （using namespace KamataEngine::MathUtility をすると演算子などが 2 つずつ見えて呼び分けられなくなる）。
+// 演算子もほかの関数と同じくグローバル名前空間に置き、エンジンの名前空間には足さない。
+
 struct AABB {
 	Vector3 min; // 最小点
 	Vector3 max; // 最大点
 };
 
-Matrix4x4 MakeViewportMatrix(float left, float top, float width, float height, float minDepth, float maxDepth);
-Matrix4x4 MatrixMultiply(const Matrix4x4& m1, const Matrix4x4& m2);
-Matrix4x4 MakeAffineMatrix(Vector3 scale, Vector3 rotate, Vector3 translate);
-Matrix4x4 Inverse(const Matrix4x4& m);
-Matrix4x4 MakePerspectiveFovMatrix(float fovY, float aspectRatio, float nearClip, float farClip);
-Vector3 Lerp(const Vector3& v1, const Vector3& v2, float t);
-float EaseInOut(float t);
-bool IsCollision(const AABB& a, const AABB& b);
-Matrix4x4 MakeRotateXMatrix(float radian);
-Matrix4x4 MakeRotateYMatrix(float radian);
-Matrix4x4 MakeRotateZMatrix(float radian);
-Vector3 Transform(const Vector3& vector, const Matrix4x4& matrix);
-Vector3 TransformNormal(const Vector3& v, const Matrix4x4& m);
-float Length(const Vector3& v);
-Vector3 Normalize(const Vector3& v);
-// ★追加：AABB同士の交差判定
-bool IntersectAABB(const AABB& a, const AABB& b);
\ No newline at end of file
+inline constexpr float PI = 3.141592654f;
+
+//==================
+// ベクトルの演算子
+//==================
+constexpr Vector2 operator+(const Vector2& v) { return v; }
+constexpr Vector2 operator-(const Vector2& v) { return {-v.x, -v.y}; }
+
+constexpr Vector2& operator+=(Vector2& lhv, const Vector2& rhv) { return lhv = {lhv.x + rhv.x, lhv.y + rhv.y}; }
+constexpr Vector2& operator-=(Vector2& lhv, const Vector2& rhv) { return lhv = {lhv.x - rhv.x, lhv.y - rhv.y}; }
+constexpr Vector2& operator*=(Vector2& v, float s) { return v = {v.x * s, v.y * s}; }
+constexpr Vector2& operator/=(Vector2& v, float s) { return v = {v.x / s, v.y / s}; }
+
+constexpr Vector3 operator+(const Vector3& v) { return v; }
+constexpr Vector3 operator-(const Vector3& v) { return {-v.x, -v.y, -v.z}; }
+
+constexpr Vector3 operator+(const Vector3& v1, const Vector3& v2) { return {v1.x + v2.x, v1.y + v2.y, v1.z + v2.z}; }
+constexpr Vector3 operator-(const Vector3& v1, const Vector3& v2) { return {v1.x - v2.x, v1.y - v2.y, v1.z - v2.z}; }
+constexpr Vector3 operator*(const Vector3& v, float s) { return {v.x * s, v.y * s, v.z * s}; }
+constexpr Vector3 operator*(float s, const Vector3& v) { return {s * v.x, s * v.y, s * v.z}; }
+constexpr Vector3 operator/(const Vector3& v, float s) { return {v.x / s, v.y / s, v.z / s}; }
+
+constexpr Vector3& operator+=(Vector3& lhv, const Vector3& rhv) { return lhv = lhv + rhv; }
+constexpr Vector3& operator-=(Vector3& lhv, const Vector3& rhv) { return lhv = lhv - rhv; }
+constexpr Vector3& operator*=(Vector3& v, float s) { return v = v * s; }
+constexpr Vector3& operator/=(Vector3& v, float s) { return v = v / s; }
+
+//==========
+// ベクトル
+//==========
+constexpr Vector2 Vector2Zero() { return {0.0f, 0.0f}; }
+constexpr Vector3 Vector3Zero() { return {0.0f, 0.0f, 0.0f}; }
+constexpr Vector4 Vector4Zero() { return {0.0f, 0.0f, 0.0f, 0.0f}; }
+
+constexpr bool Equal(const Vector3& v1, const Vector3& v2) { return v1.x == v2.x && v1.y == v2.y && v1.z == v2.z; }
+
+inline float Length(const Vector2& v) { return std::sqrt(v.x * v.x + v.y * v.y); }
+
+constexpr float Dot(const Vector3& v1, const Vector3& v2) { return v1.x * v2.x + v1.y * v2.y + v1.z * v2.z; }
+constexpr Vector3 Cross(const Vector3& v1, const Vector3& v2) { return {v1.y * v2.z - v1.z * v2.y, v1.z * v2.x - v1.x * v2.z, v1.x * v2.y - v1.y * v2.x}; }
+
+inline float Length(const Vector3& v) { return std::sqrt(Dot(v, v)); }
+
+// 正規化したものを返す（MathUtility::Normalize と違って v は書き換えない）
+inline Vector3 Normalize(const Vector3& v) {
+	float len = Length(v);
+	return {v.x / len, v.y / len, v.z / len};
+}
+
+// t=0 で a、t=1 で b（MathUtility と同じ）
+constexpr float Lerp(float a, float b, float t) { return a + (b - a) * t; }
+
+// t=1 で v1、t=0 で v2（float の Lerp と向きが逆）
+constexpr Vector3 Lerp(const Vector3& v1, const Vector3& v2, float t) {
+	Vector3 point1 = {t * v1.x, t * v1.y, t * v1.z};
+	Vector3 point2 = {(1.0f - t) * v2.x, (1.0f - t) * v2.y, (1.0f - t) * v2.z};
+	return {point1.x + point2.x, point1.y + point2.y, point1.z + point2.z};
+}
+
+constexpr float EaseInOut(float t) {
+	// 0.0〜1.0の範囲に制限
+	if (t < 0.0f) {
+		t = 0.0f;
+	} else if (t > 1.0f) {
+		t = 1.0f;
+	}
+
+	float result = 0.0f;
+	if (t < 0.5f) {
+		result = 4.0f * t * t * t;
+	} else {
+		float temp = -2.0f * t + 2.0f;
+		result = 1.0f - (temp * temp * temp) / 2.0f;
+	}
+
+	return result;
+}
+
+//======
+// 行列
+//======
+constexpr Matrix4x4 MakeIdentityMatrix() {
+	Matrix4x4 result = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+	return result;
+}
+
+constexpr Matrix4x4 MakeViewportMatrix(float left, float top, float width, float height, float minDepth, float maxDepth) {
+	Matrix4x4 result = {width / 2.0f, 0, 0, 0, 0, -height / 2.0f, 0, 0, 0, 0, maxDepth - minDepth, 0, left + (width / 2.0f), top + (height / 2.0f), minDepth, 1};
+	return result;
+}
+
+constexpr Matrix4x4 MatrixMultiply(const Matrix4x4& m1, const Matrix4x4& m2) {
+	Matrix4x4 result{};
+#if defined(METHOD_USE_AVX)
+	if (!std::is_constant_evaluated()) {
+		// 2行ずつ 256bit で計算（m2 の各行を上下に複製しておく）
+		const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[0]));
+		const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[1]));
+		const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[2]));
+		const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[3]));
+		for (int i = 0; i < 4; i += 2) {
+			const float* a0 = m1.m[i];
+			const float* a1 = m1.m[i + 1];
+			__m256 r = _mm256_mul_ps(_mm256_setr_m128(_mm_set1_ps(a0[0]), _mm_set1_ps(a1[0])), b0);
+			r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_setr_m128(_mm_set1_ps(a0[1]), _mm_set1_ps(a1[1])), b1));
+			r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_setr_m128(_mm_set1_ps(a0[2]), _mm_set1_ps(a1[2])), b2));
+			r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_setr_m128(_mm_set1_ps(a0[3]), _mm_set1_ps(a1[3])), b3));
+			_mm256_storeu_ps(result.m[i], r);
+		}
+		return result;
+	}
+#elif defined(METHOD_USE_SSE)
+	if (!std::is_constant_evaluated()) {
+		// result の i 行 = Σk m1[i][k] * (m2 の k 行)。加算順はスカラー版と同じ
+		const __m128 b0 = _mm_loadu_ps(m2.m[0]);
+		const __m128 b1 = _mm_loadu_ps(m2.m[1]);
+		const __m128 b2 = _mm_loadu_ps(m2.m[2]);
+		const __m128 b3 = _mm_loadu_ps(m2.m[3]);
+		for (int i = 0; i < 4; ++i) {
+			__m128 r = _mm_mul_ps(_mm_set1_ps(m1.m[i][0]), b0);
+			r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(m1.m[i][1]), b1));
+			r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(m1.m[i][2]), b2));
+			r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(m1.m[i][3]), b3));
+			_mm_storeu_ps(result.m[i], r);
+		}
+		return result;
+	}
+#endif
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			result.m[i][j] = m1.m[i][0] * m2.m[0][j] + m1.m[i][1] * m2.m[1][j] + m1.m[i][2] * m2.m[2][j] + m1.m[i][3] * m2.m[3][j];
+		}
+	}
+	return result;
+}
+
+constexpr Matrix4x4 operator*(const Matrix4x4& m1, const Matrix4x4& m2) { return MatrixMultiply(m1, m2); }
+constexpr Matrix4x4& operator*=(Matrix4x4& lhm, const Matrix4x4& rhm) { return lhm = MatrixMultiply(lhm, rhm); }
+
+constexpr Matrix4x4 Transpose(const Matrix4x4& m) {
+	Matrix4x4 result{};
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			result.m[i][j] = m.m[j][i];
+		}
+	}
+	return result;
+}
+
+constexpr Matrix4x4 MakeScaleMatrix(const Vector3& scale) {
+	Matrix4x4 result = {scale.x, 0, 0, 0, 0, scale.y, 0, 0, 0, 0, scale.z, 0, 0, 0, 0, 1};
+	return result;
+}
+
+constexpr Matrix4x4 MakeTranslateMatrix(const Vector3& translate) {
+	Matrix4x4 result = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, translate.x, translate.y, translate.z, 1};
+	return result;
+}
+constexpr Matrix4x4 MakeTranslateMatrix(const Vector2& translate) { return MakeTranslateMatrix(Vector3{translate.x, translate.y, 0.0f}); }
+
+// 回転角の sin/cos を計算済みのときの MakeAffineMatrix
+inline Matrix4x4 MakeAffineMatrixFromSinCos(const Vector3& scale, const Vector3& sinRotate, const Vector3& cosRotate, const Vector3& translate) {
+	// スケール→回転(X→Y→Z)→移動 の順で合成した S * (Rx * Ry * Rz) * T を、
+	// 中間行列や行列積を作らずに直接組み立てる。
+	// 展開すると i 行目は scale[i] * (回転行列の i 行)、4行目は translate になる。
+	const float cosY = cosRotate.y;
+	const float sinY = sinRotate.y;
+	const float cosZ = cosRotate.z;
+	const float sinZ = sinRotate.z;
+
+	// Ry * Rz の3行（X回転がなければこれがそのまま回転行列）
+	float r00 = cosY * cosZ, r01 = cosY * sinZ, r02 = -sinY;
+	float r10 = -sinZ, r11 = cosZ, r12 = 0.0f;
+	float r20 = sinY * cosZ, r21 = sinY * sinZ, r22 = cosY;
+
+	// X回転があるときだけ Rx を左から掛ける（1行目は変わらない）
+	if (sinRotate.x != 0.0f || cosRotate.x != 1.0f) {
+		const float cosX = cosRotate.x;
+		const float sinX = sinRotate.x;
+		const float yz10 = r10, yz11 = r11, yz12 = r12;
+		r10 = cosX * yz10 + sinX * r20;
+		r11 = cosX * yz11 + sinX * r21;
+		r12 = cosX * yz12 + sinX * r22;
+		r20 = -sinX * yz10 + cosX * r20;
+		r21 = -sinX * yz11 + cosX * r21;
+		r22 = -sinX * yz12 + cosX * r22;
+	}
+
+	Matrix4x4 result = {
+	    scale.x * r00, scale.x * r01, scale.x * r02, 0.0f, //
+	    scale.y * r10, scale.y * r11, scale.y * r12, 0.0f, //
+	    scale.z * r20, scale.z * r21, scale.z * r22, 0.0f, //
+	    translate.x,   translate.y,   translate.z,   1.0f,
+	};
+	return result;
+}
+
+inline Matrix4x4 MakeAffineMatrix(Vector3 scale, Vector3 rotate, Vector3 translate) {
+	// 各 sin/cos は1回ずつ。X回転がない（よくある）ときはその分も求めない
+	const bool hasRotateX = rotate.x != 0.0f;
+	const Vector3 sinRotate = {hasRotateX ? std::sin(rotate.x) : 0.0f, std::sin(rotate.y), std::sin(rotate.z)};
+	const Vector3 cosRotate = {hasRotateX ? std::cos(rotate.x) : 1.0f, std::cos(rotate.y), std::cos(rotate.z)};
+	return MakeAffineMatrixFromSinCos(scale, sinRotate, cosRotate, translate);
+}
+
+// まとめて count 個のアフィン行列を作る
+inline void MakeAffineMatrixBatch(const Vector3* scales, const Vector3* rotates, const Vector3* translates, Matrix4x4* out, size_t count) {
+	for (size_t i = 0; i < count; ++i) {
+		out[i] = MakeAffineMatrix(scales[i], rotates[i], translates[i]);
+	}
+}
+
+// det を渡すと行列式を書く
+constexpr Matrix4x4 Inverse(const Matrix4x4& m, float* det = nullptr) {
+	float determinant =
+	    m.m[0][0] * m.m[1][1] * m.m[2][2] * m.m[3][3] + m.m[0][0] * m.m[1][2] * m.m[2][3] * m.m[3][1] + m.m[0][0] * m.m[1][3] * m.m[2][1] * m.m[3][2] - m.m[0][0] * m.m[1][3] * m.m[2][2] * m.m[3][1] -
+	    m.m[0][0] * m.m[1][2] * m.m[2][1] * m.m[3][3] - m.m[0][0] * m.m[1][1] * m.m[2][3] * m.m[3][2] - m.m[0][1] * m.m[1][0] * m.m[2][2] * m.m[3][3] - m.m[0][2] * m.m[1][0] * m.m[2][3] * m.m[3][1] -
+	    m.m[0][3] * m.m[1][0] * m.m[2][1] * m.m[3][2] + m.m[0][3] * m.m[1][0] * m.m[2][2] * m.m[3][1] + m.m[0][2] * m.m[1][0] * m.m[2][1] * m.m[3][3] + m.m[0][1] * m.m[1][0] * m.m[2][3] * m.m[3][2] +
+	    m.m[0][1] * m.m[1][2] * m.m[2][0] * m.m[3][3] + m.m[0][2] * m.m[1][3] * m.m[2][0] * m.m[3][1] + m.m[0][3] * m.m[1][1] * m.m[2][0] * m.m[3][2] - m.m[0][3] * m.m[1][2] * m.m[2][0] * m.m[3][1] -
+	    m.m[0][2] * m.m[1][1] * m.m[2][0] * m.m[3][3] - m.m[0][1] * m.m[1][3] * m.m[2][0] * m.m[3][2] - m.m[0][1] * m.m[1][2] * m.m[2][3] * m.m[3][0] - m.m[0][2] * m.m[1][3] * m.m[2][1] * m.m[3][0] -
+	    m.m[0][3] * m.m[1][1] * m.m[2][2] * m.m[3][0] + m.m[0][3] * m.m[1][2] * m.m[2][1] * m.m[3][0] + m.m[0][2] * m.m[1][1] * m.m[2][3] * m.m[3][0] + m.m[0][1] * m.m[1][3] * m.m[2][2] * m.m[3][0];
+	if (det) {
+		*det = determinant;
+	}
+	Matrix4x4 result = {
+	    (m.m[1][1] * m.m[2][2] * m.m[3][3] + m.m[1][2] * m.m[2][3] * m.m[3][1] + m.m[1][3] * m.m[2][1] * m.m[3][2] - m.m[1][3] * m.m[2][2] * m.m[3][1] - m.m[1][2] * m.m[2][1] * m.m[3][3] -
+	     m.m[1][1] * m.m[2][3] * m.m[3][2]) /
+	        determinant,
+	    (-m.m[0][1] * m.m[2][2] * m.m[3][3] - m.m[0][2] * m.m[2][3] * m.m[3][1] - m.m[0][3] * m.m[2][1] * m.m[3][2] + m.m[0][3] * m.m[2][2] * m.m[3][1] + m.m[0][2] * m.m[2][1] * m.m[3][3] +
+	     m.m[0][1] * m.m[2][3] * m.m[3][2]) /
+	        determinant,
+	    (m.m[0][1] * m.m[1][2] * m.m[3][3] + m.m[0][2] * m.m[1][3] * m.m[3][1] + m.m[0][3] * m.m[1][1] * m.m[3][2] - m.m[0][3] * m.m[1][2] * m.m[3][1] - m.m[0][2] * m.m[1][1] * m.m[3][3] -
+	     m.m[0][1] * m.m[1][3] * m.m[3][2]) /
+	        determinant,
+	    (-m.m[0][1] * m.m[1][2] * m.m[2][3] - m.m[0][2] * m.m[1][3] * m.m[2][1] - m.m[0][3] * m.m[1][1] * m.m[2][2] + m.m[0][3] * m.m[1][2] * m.m[2][1] + m.m[0][2] * m.m[1][1] * m.m[2][3] +
+	     m.m[0][1] * m.m[1][3] * m.m[2][2]) /
+	        determinant,
+	    (-m.m[1][0] * m.m[2][2] * m.m[3][3] - m.m[1][2] * m.m[2][3] * m.m[3][0] - m.m[1][3] * m.m[2][0] * m.m[3][2] + m.m[1][3] * m.m[2][2] * m.m[3][0] + m.m[1][2] * m.m[2][0] * m.m[3][3] +
+	     m.m[1][0] * m.m[2][3] * m.m[3][2]) /
+	        determinant,
+	    (m.m[0][0] * m.m[2][2] * m.m[3][3] + m.m[0][2] * m.m[2][3] * m.m[3][0] + m.m[0][3] * m.m[2][0] * m.m[3][2] - m.m[0][3] * m.m[2][2] * m.m[3][0] - m.m[0][2] * m.m[2][0] * m.m[3][3] -
+	     m.m[0][0] * m.m[2][3] * m.m[3][2]) /
+	        determinant,
+	    (-m.m[0][0] * m.m[1][2] * m.m[3][3] - m.m[0][2] * m.m[1][3] * m.m[3][0] - m.m[0][3] * m.m[1][0] * m.m[3][2] + m.m[0][3] * m.m[1][2] * m.m[3][0] + m.m[0][2] * m.m[1][0] * m.m[3][3] +
+	     m.m[0][0] * m.m[1][3] * m.m[3][2]) /
+	        determinant,
+	    (m.m[0][0] * m.m[1][2] * m.m[2][3] + m.m[0][2] * m.m[1][3] * m.m[2][0] + m.m[0][3] * m.m[1][0] * m.m[2][2] - m.m[0][3] * m.m[1][2] * m.m[2][0] - m.m[0][2] * m.m[1][0] * m.m[2][3] -
+	     m.m[0][0] * m.m[1][3] * m.m[2][2]) /
+	        determinant,
+	    (m.m[1][0] * m.m[2][1] * m.m[3][3] + m.m[1][1] * m.m[2][3] * m.m[3][0] + m.m[1][3] * m.m[2][0] * m.m[3][1] - m.m[1][3] * m.m[2][1] * m.m[3][0] - m.m[1][1] * m.m[2][0] * m.m[3][3] -
+	     m.m[1][0] * m.m[2][3] * m.m[3][1]) /
+	        determinant,
+	    (-m.m[0][0] * m.m[2][1] * m.m[3][3] - m.m[0][1] * m.m[2][3] * m.m[3][0] - m.m[0][3] * m.m[2][0] * m.m[3][1] + m.m[0][3] * m.m[2][1] * m.m[3][0] + m.m[0][1] * m.m[2][0] * m.m[3][3] +
+	     m.m[0][0] * m.m[2][3] * m.m[3][1]) /
+	        determinant,
+	    (m.m[0][0] * m.m[1][1] * m.m[3][3] + m.m[0][1] * m.m[1][3] * m.m[3][0] + m.m[0][3] * m.m[1][0] * m.m[3][1] - m.m[0][3] * m.m[1][1] * m.m[3][0] - m.m[0][1] * m.m[1][0] * m.m[3][3] -
+	     m.m[0][0] * m.m[1][3] * m.m[3][1]) /
+	        determinant,
+	    (-m.m[0][0] * m.m[1][1] * m.m[2][3] - m.m[0][1] * m.m[1][3] * m.m[2][0] - m.m[0][3] * m.m[1][0] * m.m[2][1] + m.m[0][3] * m.m[1][1] * m.m[2][0] + m.m[0][1] * m.m[1][0] * m.m[2][3] +
+	     m.m[0][0] * m.m[1][3] * m.m[2][1]) /
+	        determinant,
+	    (-m.m[1][0] * m.m[2][1] * m.m[3][2] - m.m[1][1] * m.m[2][2] * m.m[3][0] - m.m[1][2] * m.m[2][0] * m.m[3][1] + m.m[1][2] * m.m[2][1] * m.m[3][0] + m.m[1][1] * m.m[2][0] * m.m[3][2] +
+	     m.m[1][0] * m.m[2][2] * m.m[3][1]) /
+	        determinant,
+	    (m.m[0][0] * m.m[2][1] * m.m[3][2] + m.m[0][1] * m.m[2][2] * m.m[3][0] + m.m[0][2] * m.m[2][0] * m.m[3][1] - m.m[0][2] * m.m[2][1] * m.m[3][0] - m.m[0][1] * m.m[2][0] * m.m[3][2] -
+	     m.m[0][0] * m.m[2][2] * m.m[3][1]) /
+	        determinant,
+	    (-m.m[0][0] * m.m[1][1] * m.m[3][2] - m.m[0][1] * m.m[1][2] * m.m[3][0] - m.m[0][2] * m.m[1][0] * m.m[3][1] + m.m[0][2] * m.m[1][1] * m.m[3][0] + m.m[0][1] * m.m[1][0] * m.m[3][2] +
+	     m.m[0][0] * m.m[1][2] * m.m[3][1]) /
+	        determinant,
+	    (m.m[0][0] * m.m[1][1] * m.m[2][2] + m.m[0][1] * m.m[1][2] * m.m[2][0] + m.m[0][2] * m.m[1][0] * m.m[2][1] - m.m[0][2] * m.m[1][1] * m.m[2][0] - m.m[0][1] * m.m[1][0] * m.m[2][2] -
+	     m.m[0][0] * m.m[1][2] * m.m[2][1]) /
+	        determinant};
+	return result;
+}
+
+inline Matrix4x4 MakePerspectiveFovMatrix(float fovY, float aspectRatio, float nearClip, float farClip) {
+	const float cot = 1.0f / std::tan(fovY / 2.0f);
+	Matrix4x4 result = {(1.0f / aspectRatio) * cot, 0, 0, 0, 0, cot, 0, 0, 0, 0, farClip / (farClip - nearClip), 1, 0, 0, (-nearClip * farClip) / (farClip - nearClip), 0};
+	return result;
+}
+
+constexpr Matrix4x4 MakeOrthographicMatrix(float left, float top, float right, float bottom, float nearClip, float farClip) {
+	Matrix4x4 result = {
+	    2.0f / (right - left), 0, 0, 0, 0, 2.0f / (top - bottom), 0, 0, 0, 0, 1.0f / (farClip - nearClip), 0, (left + right) / (left - right), (top + bottom) / (bottom - top), nearClip / (nearClip - farClip), 1,
+	};
+	return result;
+}
+
+// 左手系のビュー行列（eye から target を見る）
+inline Matrix4x4 Matrix4LookAtLH(const Vector3& eye, const Vector3& target, const Vector3& up) {
+	const Vector3 zAxis = Normalize(target - eye);
+	const Vector3 xAxis = Normalize(Cross(up, zAxis));
+	const Vector3 yAxis = Cross(zAxis, xAxis);
+	Matrix4x4 result = {
+	    xAxis.x, yAxis.x, zAxis.x, 0, xAxis.y, yAxis.y, zAxis.y, 0, xAxis.z, yAxis.z, zAxis.z, 0, -Dot(xAxis, eye), -Dot(yAxis, eye), -Dot(zAxis, eye), 1,
+	};
+	return result;
+}
+
+inline Matrix4x4 MakeRotateXMatrix(float radian) {
+	const float c = std::cos(radian);
+	const float s = std::sin(radian);
+	Matrix4x4 result = {1, 0, 0, 0, 0, c, s, 0, 0, -s, c, 0, 0, 0, 0, 1};
+	return result;
+}
+
+inline Matrix4x4 MakeRotateYMatrix(float radian) {
+	const float c = std::cos(radian);
+	const float s = std::sin(radian);
+	Matrix4x4 result = {c, 0, -s, 0, 0, 1, 0, 0, s, 0, c, 0, 0, 0, 0, 1};
+	return result;
+}
+
+inline Matrix4x4 MakeRotateZMatrix(float radian) {
+	const float c = std::cos(radian);
+	const float s = std::sin(radian);
+	Matrix4x4 result = {c, s, 0, 0, -s, c, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+	return result;
+}
+
+//==========
+// 座標変換
+//==========
+// 座標変換（w除算あり。MathUtility::Transform と違って w で割る。MathUtility の名前では TransformCoord）
+constexpr Vector3 Transform(const Vector3& vector, const Matrix4x4& matrix) {
+	Vector3 result{};
+	float w = 0.0f;
+#ifdef METHOD_USE_SSE
+	if (!std::is_constant_evaluated()) {
+		// x*row0 + y*row1 + z*row2 + 1*row3 を一度に計算（加算順はスカラー版と同じ）
+		__m128 r = _mm_mul_ps(_mm_set1_ps(vector.x), _mm_loadu_ps(matrix.m[0]));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(vector.y), _mm_loadu_ps(matrix.m[1])));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(vector.z), _mm_loadu_ps(matrix.m[2])));
+		r = _mm_add_ps(r, _mm_loadu_ps(matrix.m[3]));
+		alignas(16) float v[4];
+		_mm_store_ps(v, r);
+		result = {v[0], v[1], v[2]};
+		w = v[3];
+	} else
+#endif
+	{
+		result.x = vector.x * matrix.m[0][0] + vector.y * matrix.m[1][0] + vector.z * matrix.m[2][0] + 1.0f * matrix.m[3][0];
+		result.y = vector.x * matrix.m[0][1] + vector.y * matrix.m[1][1] + vector.z * matrix.m[2][1] + 1.0f * matrix.m[3][1];
+		result.z = vector.x * matrix.m[0][2] + vector.y * matrix.m[1][2] + vector.z * matrix.m[2][2] + 1.0f * matrix.m[3][2];
+		w = vector.x * matrix.m[0][3] + vector.y * matrix.m[1][3] + vector.z * matrix.m[2][3] + 1.0f * matrix.m[3][3];
+	}
+	assert(w != 0.0f);
+	result.x /= w;
+	result.y /= w;
+	result.z /= w;
+	return result;
+}
+
+// ベクトル変換（平行移動なし）
+constexpr Vector3 TransformNormal(const Vector3& v, const Matrix4x4& m) {
+#ifdef METHOD_USE_SSE
+	if (!std::is_constant_evaluated()) {
+		__m128 r = _mm_mul_ps(_mm_set1_ps(v.x), _mm_loadu_ps(m.m[0]));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(v.y), _mm_loadu_ps(m.m[1])));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(v.z), _mm_loadu_ps(m.m[2])));
+		alignas(16) float out[4];
+		_mm_store_ps(out, r);
+		return {out[0], out[1], out[2]};
+	}
+#endif
+	return {
+	    v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0],
+	    v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1],
+	    v.x * m.m[0][2] + v.y * m.m[1][2] + v.z * m.m[2][2],
+	};
+}
+
+constexpr Vector3 TransformCoord(const Vector3& v, const Matrix4x4& m) { return Transform(v, m); }
+
+// 行ベクトル × 行列（w除算なし。平行移動は入る）
+constexpr Vector3 operator*(const Vector3& v, const Matrix4x4& m) { return TransformNormal(v, m) + Vector3{m.m[3][0], m.m[3][1], m.m[3][2]}; }
+
+// まとめて count 個の座標を変換（w除算あり）
+inline void TransformPoints(const Vector3* points, Vector3* out, size_t count, const Matrix4x4& matrix) {
+#ifdef METHOD_USE_SSE
+	// 行列の4行はループの外で1回だけ読む
+	const __m128 r0 = _mm_loadu_ps(matrix.m[0]);
+	const __m128 r1 = _mm_loadu_ps(matrix.m[1]);
+	const __m128 r2 = _mm_loadu_ps(matrix.m[2]);
+	const __m128 r3 = _mm_loadu_ps(matrix.m[3]);
+	alignas(16) float v[4];
+	for (size_t i = 0; i < count; ++i) {
+		__m128 r = _mm_mul_ps(_mm_set1_ps(points[i].x), r0);
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(points[i].y), r1));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(points[i].z), r2));
+		r = _mm_add_ps(r, r3);
+		_mm_store_ps(v, r);
+		assert(v[3] != 0.0f);
+		out[i] = {v[0] / v[3], v[1] / v[3], v[2] / v[3]};
+	}
+#else
+	for (size_t i = 0; i < count; ++i) {
+		out[i] = Transform(points[i], matrix);
+	}
+#endif
+}
+
+//======
+// AABB
+//======
+// 中心と半径（各軸の半分の大きさ）から作る
+constexpr AABB MakeAABB(const Vector3& center, const Vector3& halfExtent) { return {center - halfExtent, center + halfExtent}; }
+
+constexpr Vector3 GetCenter(const AABB& aabb) { return (aabb.min + aabb.max) * 0.5f; }
+
+// XY平面だけで見た重なり判定
+constexpr bool IsCollision(const AABB& a, const AABB& b) { return (a.min.x <= b.max.x && a.max.x >= b.min.x) && (a.min.y <= b.max.y && a.max.y >= b.min.y); }
+
+// AABB同士の交差判定（XYZ）
+constexpr bool IntersectAABB(const AABB& a, const AABB& b) {
+	// 1軸でも重なっていなければfalse
+	if (a.max.x < b.min.x || a.min.x > b.max.x)
+		return false;
+	if (a.max.y < b.min.y || a.min.y > b.max.y)
+		return false;
+	if (a.max.z < b.min.z || a.min.z > b.max.z)
+		return false;
+	return true;
+}
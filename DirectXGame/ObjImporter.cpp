@@ -0,0 +1,437 @@
+#include "ObjImporter.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+struct Float3 {
+	float x, y, z;
+};
+struct Float2 {
+	float x, y;
+};
+
+// 1行ずつ切り出すカーソル
+class LineReader {
+public:
+	explicit LineReader(std::string_view text) : cursor_(text.data()), end_(text.data() + text.size()) {}
+
+	bool Next(std::string_view& line) {
+		if (cursor_ >= end_) {
+			return false;
+		}
+		const char* begin = cursor_;
+		const char* newline = static_cast<const char*>(std::memchr(begin, '\n', static_cast<size_t>(end_ - begin)));
+		const char* lineEnd = newline ? newline : end_;
+		cursor_ = newline ? newline + 1 : end_;
+		// CRLF の CR を落とす
+		if (lineEnd > begin && lineEnd[-1] == '\r') {
+			--lineEnd;
+		}
+		line = std::string_view(begin, static_cast<size_t>(lineEnd - begin));
+		return true;
+	}
+
+private:
+	const char* cursor_;
+	const char* end_;
+};
+
+bool IsSpace(char c) { return c == ' ' || c == '\t'; }
+
+void SkipSpaces(const char*& p, const char* end) {
+	while (p < end && IsSpace(*p)) {
+		++p;
+	}
+}
+
+// 空白までを1語として切り出す
+std::string_view NextToken(const char*& p, const char* end) {
+	SkipSpaces(p, end);
+	const char* begin = p;
+	while (p < end && !IsSpace(*p)) {
+		++p;
+	}
+	return std::string_view(begin, static_cast<size_t>(p - begin));
+}
+
+// 残りを前後の空白を除いて返す（ファイル名・マテリアル名用）
+std::string_view Rest(const char* p, const char* end) {
+	SkipSpaces(p, end);
+	while (end > p && IsSpace(end[-1])) {
+		--end;
+	}
+	return std::string_view(p, static_cast<size_t>(end - p));
+}
+
+bool ParseFloat(const char*& p, const char* end, float& value) {
+	SkipSpaces(p, end);
+	// from_chars は先頭の '+' を受け付けない
+	if (p < end && *p == '+') {
+		++p;
+	}
+	const std::from_chars_result result = std::from_chars(p, end, value);
+	if (result.ec != std::errc()) {
+		return false;
+	}
+	p = result.ptr;
+	return true;
+}
+
+bool ParseInt(const char*& p, const char* end, int32_t& value) {
+	const std::from_chars_result result = std::from_chars(p, end, value);
+	if (result.ec != std::errc()) {
+		return false;
+	}
+	p = result.ptr;
+	return true;
+}
+
+// obj の番号（1始まり・負数は末尾から）を 0 始まりに直す
+bool ResolveIndex(int32_t index, size_t count, uint32_t& out) {
+	const int64_t resolved = index > 0 ? static_cast<int64_t>(index) - 1 : static_cast<int64_t>(count) + index;
+	if (index == 0 || resolved < 0 || resolved >= static_cast<int64_t>(count)) {
+		return false;
+	}
+	out = static_cast<uint32_t>(resolved);
+	return true;
+}
+
+int32_t FindMaterial(const std::vector<MeshMaterial>& materials, std::string_view name) {
+	for (size_t i = 0; i < materials.size(); ++i) {
+		if (materials[i].name == name) {
+			return static_cast<int32_t>(i);
+		}
+	}
+	return -1;
+}
+
+uint32_t HashVertex(const MeshVertex& vertex) {
+	uint32_t words[8];
+	std::memcpy(words, &vertex, sizeof(words));
+	uint64_t hash = 0x9E3779B97F4A7C15ull;
+	for (uint32_t word : words) {
+		hash = (hash ^ word) * 0xFF51AFD7ED558CCDull;
+		hash ^= hash >> 32;
+	}
+	return static_cast<uint32_t>(hash);
+}
+
+// 組み立て中のサブメッシュ
+struct Builder {
+	SubMesh subMesh;
+	std::vector<MeshVertex> vertices;
+	std::vector<uint32_t> positionIndices;
+	std::vector<uint32_t> indices;
+};
+
+// 組み立てたサブメッシュを MeshData に移す
+void Flush(Builder& builder, bool smoothing, MeshData& out) {
+	if (builder.vertices.empty()) {
+		return;
+	}
+	if (smoothing) {
+		ObjImporter::SmoothNormals(builder.vertices, builder.positionIndices);
+	}
+	ObjImporter::WeldVertices(builder.vertices, builder.indices);
+
+	SubMesh subMesh = builder.subMesh;
+	subMesh.vertexOffset = static_cast<uint32_t>(out.vertices.size());
+	subMesh.vertexCount = static_cast<uint32_t>(builder.vertices.size());
+	subMesh.indexOffset = static_cast<uint32_t>(out.indices.size());
+	subMesh.indexCount = static_cast<uint32_t>(builder.indices.size());
+	out.vertices.insert(out.vertices.end(), builder.vertices.begin(), builder.vertices.end());
+	out.indices.insert(out.indices.end(), builder.indices.begin(), builder.indices.end());
+	out.subMeshes.push_back(std::move(subMesh));
+
+	builder.subMesh = SubMesh{};
+	builder.vertices.clear();
+	builder.positionIndices.clear();
+	builder.indices.clear();
+}
+
+} // namespace
+
+bool ObjImporter::Import(const std::filesystem::path& objPath, bool smoothing, MeshData& out, std::string* error) {
+	std::string text;
+	if (!ReadFile(objPath, text)) {
+		if (error) {
+			*error = "cannot open " + objPath.string();
+		}
+		return false;
+	}
+	return Parse(text, objPath.parent_path(), smoothing, out, error);
+}
+
+bool ObjImporter::Parse(std::string_view text, const std::filesystem::path& directory, bool smoothing, MeshData& out, std::string* error) {
+	out.Clear();
+
+	std::vector<Float3> positions;
+	std::vector<Float2> texcoords;
+	std::vector<Float3> normals;
+	Builder builder;
+	// 1面ぶんの頂点番号（多角形の分割用）
+	std::vector<uint32_t> face;
+
+	auto fail = [&](const char* message, size_t lineNumber) {
+		if (error) {
+			*error = std::string(message) + " at line " + std::to_string(lineNumber);
+		}
+		return false;
+	};
+
+	LineReader reader(text);
+	std::string_view line;
+	size_t lineNumber = 0;
+	while (reader.Next(line)) {
+		++lineNumber;
+		const char* p = line.data();
+		const char* end = p + line.size();
+		const std::string_view key = NextToken(p, end);
+		if (key.empty() || key[0] == '#') {
+			continue;
+		}
+
+		if (key == "v") {
+			Float3 position{};
+			if (!ParseFloat(p, end, position.x) || !ParseFloat(p, end, position.y) || !ParseFloat(p, end, position.z)) {
+				return fail("bad v", lineNumber);
+			}
+			positions.push_back(position);
+		} else if (key == "vt") {
+			Float2 texcoord{};
+			if (!ParseFloat(p, end, texcoord.x) || !ParseFloat(p, end, texcoord.y)) {
+				return fail("bad vt", lineNumber);
+			}
+			// エンジンと同じく v 方向を反転
+			texcoord.y = 1.0f - texcoord.y;
+			texcoords.push_back(texcoord);
+		} else if (key == "vn") {
+			Float3 normal{};
+			if (!ParseFloat(p, end, normal.x) || !ParseFloat(p, end, normal.y) || !ParseFloat(p, end, normal.z)) {
+				return fail("bad vn", lineNumber);
+			}
+			normals.push_back(normal);
+		} else if (key == "f") {
+			face.clear();
+			while (true) {
+				std::string_view corner = NextToken(p, end);
+				if (corner.empty()) {
+					break;
+				}
+				const char* c = corner.data();
+				const char* cornerEnd = c + corner.size();
+
+				// v, v/vt, v//vn, v/vt/vn
+				int32_t positionIndex = 0;
+				int32_t texcoordIndex = 0;
+				int32_t normalIndex = 0;
+				if (!ParseInt(c, cornerEnd, positionIndex)) {
+					return fail("bad f", lineNumber);
+				}
+				if (c < cornerEnd && *c == '/') {
+					++c;
+					if (c < cornerEnd && *c != '/' && !ParseInt(c, cornerEnd, texcoordIndex)) {
+						return fail("bad f", lineNumber);
+					}
+					if (c < cornerEnd && *c == '/') {
+						++c;
+						if (!ParseInt(c, cornerEnd, normalIndex)) {
+							return fail("bad f", lineNumber);
+						}
+					}
+				}
+
+				MeshVertex vertex{};
+				uint32_t position = 0;
+				if (!ResolveIndex(positionIndex, positions.size(), position)) {
+					return fail("f index out of range", lineNumber);
+				}
+				std::memcpy(vertex.pos, &positions[position], sizeof(vertex.pos));
+				// 省略時はエンジンと同じ値にする
+				vertex.normal[2] = 1.0f;
+				if (texcoordIndex != 0) {
+					uint32_t texcoord = 0;
+					if (!ResolveIndex(texcoordIndex, texcoords.size(), texcoord)) {
+						return fail("f index out of range", lineNumber);
+					}
+					std::memcpy(vertex.uv, &texcoords[texcoord], sizeof(vertex.uv));
+				}
+				if (normalIndex != 0) {
+					uint32_t normal = 0;
+					if (!ResolveIndex(normalIndex, normals.size(), normal)) {
+						return fail("f index out of range", lineNumber);
+					}
+					std::memcpy(vertex.normal, &normals[normal], sizeof(vertex.normal));
+				}
+
+				face.push_back(static_cast<uint32_t>(builder.vertices.size()));
+				builder.vertices.push_back(vertex);
+				builder.positionIndices.push_back(position);
+			}
+			// 扇形に分割する（四角形の2枚目はエンジンの 2,3,0 と同じ三角形になる）
+			for (size_t i = 2; i < face.size(); ++i) {
+				builder.indices.push_back(face[0]);
+				builder.indices.push_back(face[i - 1]);
+				builder.indices.push_back(face[i]);
+			}
+		} else if (key == "g") {
+			// エンジンと同じく、名前と頂点がそろっているときだけ区切る
+			if (!builder.subMesh.name.empty() && !builder.vertices.empty()) {
+				Flush(builder, smoothing, out);
+			}
+			builder.subMesh.name = std::string(NextToken(p, end));
+		} else if (key == "usemtl") {
+			// エンジンと同じく、最初に見つかったマテリアルだけを使う
+			if (builder.subMesh.material < 0) {
+				builder.subMesh.material = FindMaterial(out.materials, Rest(p, end));
+			}
+		} else if (key == "mtllib") {
+			// obj は UTF-8 で書かれている
+			const std::string_view fileName = Rest(p, end);
+			const std::filesystem::path mtlPath = directory / std::u8string(reinterpret_cast<const char8_t*>(fileName.data()), fileName.size());
+			std::string mtl;
+			if (ReadFile(mtlPath, mtl)) {
+				ParseMaterials(mtl, out.materials);
+			}
+		}
+	}
+	Flush(builder, smoothing, out);
+
+	if (out.subMeshes.empty()) {
+		if (error) {
+			*error = "no faces";
+		}
+		return false;
+	}
+	return true;
+}
+
+void ObjImporter::ParseMaterials(std::string_view text, std::vector<MeshMaterial>& materials) {
+	MeshMaterial* material = nullptr;
+
+	auto parse3 = [](const char* p, const char* end, float (&value)[3]) {
+		float parsed[3];
+		if (ParseFloat(p, end, parsed[0]) && ParseFloat(p, end, parsed[1]) && ParseFloat(p, end, parsed[2])) {
+			std::memcpy(value, parsed, sizeof(parsed));
+		}
+	};
+
+	LineReader reader(text);
+	std::string_view line;
+	while (reader.Next(line)) {
+		const char* p = line.data();
+		const char* end = p + line.size();
+		const std::string_view key = NextToken(p, end);
+		if (key == "newmtl") {
+			materials.emplace_back();
+			material = &materials.back();
+			material->name = std::string(Rest(p, end));
+			continue;
+		}
+		if (!material) {
+			continue;
+		}
+		if (key == "Ka") {
+			parse3(p, end, material->ambient);
+		} else if (key == "Kd") {
+			parse3(p, end, material->diffuse);
+		} else if (key == "Ks") {
+			parse3(p, end, material->specular);
+		} else if (key == "d") {
+			ParseFloat(p, end, material->alpha);
+		} else if (key == "map_Kd") {
+			// フルパスで書かれていることがあるので、ファイル名だけを取り出す（obj と同じディレクトリから読む）
+			std::string_view path = Rest(p, end);
+			const size_t separator = path.find_last_of("/\\");
+			if (separator != std::string_view::npos) {
+				path.remove_prefix(separator + 1);
+			}
+			material->textureFilename = std::string(path);
+		}
+	}
+}
+
+void ObjImporter::SmoothNormals(std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& positionIndices) {
+	// (位置番号, 頂点番号) を1つの整数にしてソートすると、同じ位置の頂点が頂点番号順に並ぶ
+	std::vector<uint64_t> keys(vertices.size());
+	for (size_t i = 0; i < vertices.size(); ++i) {
+		keys[i] = (static_cast<uint64_t>(positionIndices[i]) << 32) | static_cast<uint32_t>(i);
+	}
+	std::sort(keys.begin(), keys.end());
+
+	size_t begin = 0;
+	while (begin < keys.size()) {
+		const uint64_t position = keys[begin] >> 32;
+		size_t end = begin;
+		float sum[3] = {};
+		while (end < keys.size() && (keys[end] >> 32) == position) {
+			const MeshVertex& vertex = vertices[static_cast<uint32_t>(keys[end])];
+			sum[0] += vertex.normal[0];
+			sum[1] += vertex.normal[1];
+			sum[2] += vertex.normal[2];
+			++end;
+		}
+
+		// 平均して正規化
+		const float count = static_cast<float>(end - begin);
+		float normal[3] = {sum[0] / count, sum[1] / count, sum[2] / count};
+		const float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+		if (length != 0.0f) {
+			normal[0] /= length;
+			normal[1] /= length;
+			normal[2] /= length;
+		}
+		for (size_t i = begin; i < end; ++i) {
+			std::memcpy(vertices[static_cast<uint32_t>(keys[i])].normal, normal, sizeof(normal));
+		}
+		begin = end;
+	}
+}
+
+void ObjImporter::WeldVertices(std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices) {
+	const uint32_t kEmpty = UINT32_MAX;
+	// 開番地法のハッシュ表（埋まり具合が半分以下になる大きさ）
+	size_t capacity = 16;
+	while (capacity < vertices.size() * 2) {
+		capacity *= 2;
+	}
+	const size_t mask = capacity - 1;
+	std::vector<uint32_t> table(capacity, kEmpty);
+	std::vector<uint32_t> remap(vertices.size());
+
+	// 最初に出てきた順に前へ詰める（詰めた先は常に自分以下の位置なので上書きしても壊れない）
+	uint32_t unique = 0;
+	for (size_t i = 0; i < vertices.size(); ++i) {
+		size_t slot = HashVertex(vertices[i]) & mask;
+		while (table[slot] != kEmpty && std::memcmp(&vertices[table[slot]], &vertices[i], sizeof(MeshVertex)) != 0) {
+			slot = (slot + 1) & mask;
+		}
+		if (table[slot] == kEmpty) {
+			table[slot] = unique;
+			vertices[unique] = vertices[i];
+			remap[i] = unique++;
+		} else {
+			remap[i] = table[slot];
+		}
+	}
+	vertices.resize(unique);
+
+	for (uint32_t& index : indices) {
+		index = remap[index];
+	}
+}
+
+bool ObjImporter::ReadFile(const std::filesystem::path& path, std::string& out) {
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file.is_open()) {
+		return false;
+	}
+	const std::streamsize size = file.tellg();
+	file.seekg(0, std::ios::beg);
+	out.resize(static_cast<size_t>(size));
+	return size == 0 || static_cast<bool>(file.read(out.data(), size));
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include "MeshData.h"
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// OBJ / MTL の読み込み
+// 面・uv の上下反転・四角形の分割・マテリアルとテクスチャ名の扱いは Model::CreateFromOBJ に合わせる。
+// istringstream を使わず1行ずつポインタで切り出し、数値は from_chars で読む。
+// スムージングは位置番号でソートして同じ位置の法線をまとめて平均し、最後に同一頂点をハッシュでまとめる。
+class ObjImporter {
+public:
+	// objPath の obj と、その中の mtllib を読む
+	static bool Import(const std::filesystem::path& objPath, bool smoothing, MeshData& out, std::string* error = nullptr);
+
+	// メモリ上の obj テキストを読む（mtllib は directory から読む）
+	static bool Parse(std::string_view text, const std::filesystem::path& directory, bool smoothing, MeshData& out, std::string* error = nullptr);
+
+	// メモリ上の mtl テキストを読んで materials に追加する
+	static void ParseMaterials(std::string_view text, std::vector<MeshMaterial>& materials);
+
+	// 同じ位置番号を持つ頂点の法線を平均する（Mesh::CalculateSmoothedVertexNormals 相当）
+	// positionIndices[i] は vertices[i] の元の位置番号
+	static void SmoothNormals(std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& positionIndices);
+
+	// 内容がまったく同じ頂点を1つにまとめ、indices を付け替える
+	static void WeldVertices(std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices);
+
+	// ファイルを丸ごと読む
+	static bool ReadFile(const std::filesystem::path& path, std::string& out);
+};
@@ -0,0 +1,125 @@
+#include "ParticleSystem.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <xmmintrin.h>
+#define PARTICLE_USE_SSE
+#endif
+
+using namespace KamataEngine;
+
+void ParticleSystem::Initialize(uint32_t capacity, uint32_t directionCount) {
+	capacity_ = capacity;
+	count_ = 0;
+
+	// SIMD で末尾まで4粒単位で読み書きできるよう、4の倍数に切り上げて確保
+	const size_t storage = (static_cast<size_t>(capacity) + 3) & ~size_t(3);
+	for (Stream* stream : {&posX_, &posY_, &posZ_, &velX_, &velY_, &velZ_, &age_, &invLifetime_, &colorR_, &colorG_, &colorB_, &alpha0_, &alpha_}) {
+		stream->assign(storage, 0.0f);
+	}
+
+	// 放出方向のテーブル（360度を directionCount 等分）
+	directionCount = std::max(directionCount, 1u);
+	dirX_.resize(directionCount);
+	dirY_.resize(directionCount);
+	const float angleUnit = 2.0f * std::numbers::pi_v<float> / static_cast<float>(directionCount);
+	for (uint32_t i = 0; i < directionCount; ++i) {
+		dirX_[i] = std::cos(angleUnit * static_cast<float>(i));
+		dirY_[i] = std::sin(angleUnit * static_cast<float>(i));
+	}
+}
+
+void ParticleSystem::Emit(const EmitParams& params) {
+	const uint32_t directionCount = static_cast<uint32_t>(dirX_.size());
+	const uint32_t emitCount = std::min(params.count, capacity_ - count_);
+	const float invLifetime = 1.0f / std::max(params.lifetime, 1e-6f);
+
+	for (uint32_t i = 0; i < emitCount; ++i) {
+		// 放出数がテーブル以下なら均等に間引き、超えたら一周させる
+		const uint32_t d = (params.count <= directionCount) ? (i * directionCount / params.count) : (i % directionCount);
+		const uint32_t n = count_++;
+
+		posX_[n] = params.position.x;
+		posY_[n] = params.position.y;
+		posZ_[n] = params.position.z;
+		velX_[n] = dirX_[d] * params.speed;
+		velY_[n] = dirY_[d] * params.speed;
+		velZ_[n] = 0.0f;
+		age_[n] = 0.0f;
+		invLifetime_[n] = invLifetime;
+		colorR_[n] = params.color.x;
+		colorG_[n] = params.color.y;
+		colorB_[n] = params.color.z;
+		alpha0_[n] = params.color.w;
+		alpha_[n] = params.color.w;
+	}
+}
+
+void ParticleSystem::Update(float dt) {
+	// 積分は粒ごとに独立なので分けて回す（少なければその場で 1 回）
+	JobSystem::GetInstance()->ParallelFor(count_, kParallelGrain, [this, dt](uint32_t begin, uint32_t end) { Integrate(begin, end, dt); });
+
+	// 寿命切れを詰める（末尾から持ってきた粒も同じ判定をし直す）
+	for (uint32_t i = 0; i < count_;) {
+		if (age_[i] * invLifetime_[i] >= 1.0f) {
+			Kill(i);
+		} else {
+			++i;
+		}
+	}
+}
+
+void ParticleSystem::Integrate(uint32_t begin, uint32_t end, float dt) {
+	uint32_t i = begin;
+
+#ifdef PARTICLE_USE_SSE
+	// 4粒ずつ積分（確保領域は4の倍数なので末尾の端数もはみ出さない）
+	const __m128 vdt = _mm_set1_ps(dt);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	for (; i < end; i += 4) {
+		// 位置 += 速度 * dt
+		_mm_storeu_ps(&posX_[i], _mm_add_ps(_mm_loadu_ps(&posX_[i]), _mm_mul_ps(_mm_loadu_ps(&velX_[i]), vdt)));
+		_mm_storeu_ps(&posY_[i], _mm_add_ps(_mm_loadu_ps(&posY_[i]), _mm_mul_ps(_mm_loadu_ps(&velY_[i]), vdt)));
+		_mm_storeu_ps(&posZ_[i], _mm_add_ps(_mm_loadu_ps(&posZ_[i]), _mm_mul_ps(_mm_loadu_ps(&velZ_[i]), vdt)));
+
+		// 経過時間を進めて α = α0 * clamp(1 - age / lifetime, 0, 1)
+		const __m128 age = _mm_add_ps(_mm_loadu_ps(&age_[i]), vdt);
+		_mm_storeu_ps(&age_[i], age);
+		__m128 t = _mm_sub_ps(one, _mm_mul_ps(age, _mm_loadu_ps(&invLifetime_[i])));
+		t = _mm_min_ps(_mm_max_ps(t, zero), one);
+		_mm_storeu_ps(&alpha_[i], _mm_mul_ps(_mm_loadu_ps(&alpha0_[i]), t));
+	}
+#else
+	for (; i < end; ++i) {
+		posX_[i] += velX_[i] * dt;
+		posY_[i] += velY_[i] * dt;
+		posZ_[i] += velZ_[i] * dt;
+		age_[i] += dt;
+		alpha_[i] = alpha0_[i] * std::clamp(1.0f - age_[i] * invLifetime_[i], 0.0f, 1.0f);
+	}
+#endif
+}
+
+void ParticleSystem::Kill(uint32_t i) {
+	const uint32_t last = --count_;
+	if (i == last) {
+		return;
+	}
+	posX_[i] = posX_[last];
+	posY_[i] = posY_[last];
+	posZ_[i] = posZ_[last];
+	velX_[i] = velX_[last];
+	velY_[i] = velY_[last];
+	velZ_[i] = velZ_[last];
+	age_[i] = age_[last];
+	invLifetime_[i] = invLifetime_[last];
+	colorR_[i] = colorR_[last];
+	colorG_[i] = colorG_[last];
+	colorB_[i] = colorB_[last];
+	alpha0_[i] = alpha0_[last];
+	alpha_[i] = alpha_[last];
+}
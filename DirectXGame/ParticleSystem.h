@@ -0,0 +1,70 @@
+#pragma once
+#include "AllocTracker.h"
+#include "KamataEngine.h"
+#include <cstdint>
+#include <vector>
+
+using namespace KamataEngine;
+
+// 構造体配列ではなく配列構造体（SoA）で持つパーティクル群
+// 各成分を連続した float 配列に置くことで、積分を4粒ずつ SIMD で回せる。
+// 寿命が尽きた粒は末尾と入れ替えて詰めるので、生存数ぶんだけ走査すればよい。
+class ParticleSystem {
+public:
+	// 放出パラメータ
+	struct EmitParams {
+		Vector3 position = {0.0f, 0.0f, 0.0f};    // 放出位置
+		uint32_t count = 0;                       // 放出数
+		float speed = 1.0f;                       // 初速[単位/秒]
+		float lifetime = 1.0f;                    // 寿命[秒]
+		Vector4 color = {1.0f, 1.0f, 1.0f, 1.0f}; // 初期色（α は寿命に合わせて 0 へ）
+	};
+
+	// capacity: 同時に生存できる最大数
+	// directionCount: 方向テーブルの分割数（XY平面を等分）
+	void Initialize(uint32_t capacity, uint32_t directionCount);
+
+	// 方向テーブルから均等に選んで放射状に放出する。入りきらない分は捨てる
+	void Emit(const EmitParams& params);
+
+	// dt 秒ぶん進めて、寿命が尽きた粒を取り除く
+	// 積分は kParallelGrain 粒ずつ JobSystem で並列に回す（粒ごとに独立なので、スレッド数によらず結果は同じ）
+	void Update(float dt);
+
+	// 1 ジョブで積分する粒の数（4 の倍数にして、ジョブどうしで同じ 4 粒を書かないようにする）
+	static inline const uint32_t kParallelGrain = 4096;
+
+	// 全消去
+	void Clear() { count_ = 0; }
+
+	uint32_t GetCount() const { return count_; }
+	uint32_t GetCapacity() const { return capacity_; }
+
+	// 描画用の読み出し
+	Vector3 GetPosition(uint32_t i) const { return {posX_[i], posY_[i], posZ_[i]}; }
+	Vector4 GetColor(uint32_t i) const { return {colorR_[i], colorG_[i], colorB_[i], alpha_[i]}; }
+
+private:
+	// [begin, end) の粒を dt 秒ぶん積分する（begin は 4 の倍数）
+	void Integrate(uint32_t begin, uint32_t end, float dt);
+	// i 番目を末尾の粒で上書きして詰める
+	void Kill(uint32_t i);
+
+	// 成分ごとの配列（確保はパーティクルとして数える）
+	using Stream = std::vector<float, TaggedAllocator<float, AllocTag::kParticles>>;
+
+	uint32_t capacity_ = 0;
+	uint32_t count_ = 0;
+
+	// 位置
+	Stream posX_, posY_, posZ_;
+	// 速度
+	Stream velX_, velY_, velZ_;
+	// 経過時間と寿命の逆数
+	Stream age_, invLifetime_;
+	// 色（α は初期値 alpha0_ から寿命に合わせて減衰させた値を alpha_ に書く）
+	Stream colorR_, colorG_, colorB_, alpha0_, alpha_;
+
+	// 事前計算した放出方向（単位ベクトル）
+	Stream dirX_, dirY_;
+};
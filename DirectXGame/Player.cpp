@@ -1,25 +1,51 @@
 #define NOMINMAX
 #include "Player.h"
 #include "MapChipField.h"
+#include "Profiler.h"
+#include "Trace.h"
 #include <algorithm>
 #include <numbers>
 #include <assert.h>
 
 using namespace KamataEngine;
 
-void Player::Initialize(Model* model, Camera* camera, const Vector3& position) {
+void Player::Initialize(CachedModel* model, Timeline* timeline, const Vector3& position) {
 	// NULLポインタチェック
 	assert(model);
+	assert(timeline);
 
 	// 引数として受け取ったデータをメンバ変数に記録
 	model_ = model;
 	// textureHandle_ = textureHandle;
-	camera_ = camera;
 
-	// ワールド変換の初期化
-	worldTransform_.Initialize();
+	// ワールド変換の初期化（描くときは RenderSnapshot が matWorld_ を写すので、定数バッファは作らない）
 	worldTransform_.translation_ = position;
 	worldTransform_.rotation_.y = std::numbers::pi_v<float> / 2.0f;
+	// 開始時のフェードインの間は動かないので、ここで 1 回だけ行列を作っておく
+	WorldTransformUpdate(worldTransform_);
+
+	// アニメーションの登録（再生は旋回・攻撃を始めたとき）
+	timeline_ = timeline;
+	Timeline::Track turn;
+	turn.target = &worldTransform_.rotation_.y;
+	turn.duration = kTimeTurn;
+	turn.ease = Ease::kInOutCubic;
+	turnTrack_ = timeline_->Add(turn);
+
+	Timeline::Track windup;
+	windup.target = &worldTransform_.scale_.z;
+	windup.from = atk_.widthMax;
+	windup.to = atk_.widthMin;
+	windup.duration = atk_.windup;
+	attackWindupTrack_ = timeline_->Add(windup);
+
+	Timeline::Track active;
+	active.target = &worldTransform_.scale_.z;
+	active.from = atk_.widthMin;
+	active.to = atk_.widthMax;
+	active.duration = atk_.active;
+	active.delay = atk_.windup; // 溜めが終わってから
+	attackActiveTrack_ = timeline_->Add(active);
 }
 
 void Player::StartAttack() {
@@ -35,9 +61,14 @@ void Player::StartAttack() {
 	attackHitboxActive_ = false;
 
 	attackCooldownLeft_ = attackCooldownSec_; // ← クールタイムセット
+
+	// 幅(Z)の伸び縮み（溜め → 発生中）
+	timeline_->Play(attackWindupTrack_);
+	timeline_->Play(attackActiveTrack_);
 }
 
-void Player::Update() {
+void Player::Update(const InputState& input) {
+	PROFILE_SCOPE("Player");
 	float dt = 1.0f / 60.0f;
 
 	// ← 毎フレームでクールタイムを減らす
@@ -47,12 +78,15 @@ void Player::Update() {
 
 	switch (state_) {
 	case ActionState::Move: {
-		// 1) 押した瞬間をバッファに記録
-		if (Input::GetInstance()->TriggerKey(DIK_UP)) {
-			jumpBufferLeft_ = jumpBufferTime_;
+		TRACE_SCOPE("Player::Move");
+		// 1) 押した瞬間をバッファに記録（ティックより前に押していたら、そのぶん猶予は減っている）
+		float jumpPressAge = 0.0f;
+		if (input.IsPressed(Action::kJump)) {
+			jumpPressAge = input.GetPressedAge(Action::kJump);
+			jumpBufferLeft_ = jumpBufferTime_ - jumpPressAge;
 		}
 
-		Move();
+		Move(input);
 		// 衝突情報を初期化
 		CollisionMapInfo collisionMapInfo{};
 		// 移動量に速度の値をコピー
@@ -66,15 +100,15 @@ void Player::Update() {
 		HandleGroundCollision(collisionMapInfo);
 		HandleWallCollision(collisionMapInfo);
 
-		// 2) コヨーテタイマー更新
+		// 2) コヨーテタイマー更新（0 で止めず、切れてからの時間も負の値で残す）
 		if (onGround_) {
 			coyoteLeft_ = coyoteTime_; // 接地中はリフィル
 		} else {
-			coyoteLeft_ = std::max(0.0f, coyoteLeft_ - dt);
+			coyoteLeft_ -= dt;
 		}
 
-		// 3) バッファ × 接地 or コヨーテ でジャンプ成立
-		if (jumpBufferLeft_ > 0.0f && (onGround_ || coyoteLeft_ > 0.0f) && !collisionMapInfo.onWallCollision_) { // ← 追加
+		// 3) バッファ × 接地 or コヨーテ でジャンプ成立（コヨーテは押した時点の残りで判定する）
+		if (jumpBufferLeft_ > 0.0f && (onGround_ || coyoteLeft_ + jumpPressAge > 0.0f) && !collisionMapInfo.onWallCollision_) { // ← 追加
 			velocity_.y = kJumpAcceleration;
 			onGround_ = false;
 			jumpBufferLeft_ = 0.0f;
@@ -84,38 +118,19 @@ void Player::Update() {
 		// バッファ残量を減衰
 		jumpBufferLeft_ = std::max(0.0f, jumpBufferLeft_ - dt);
 
-		// 旋回制御
-		if (turnTimer_ > 0.0f) {
-			// 旋回タイマーをカウントダウン
-			turnTimer_ -= 1.0f / 60.0f;
-
-			// 左右の自キャラ角度テーブル
-			float destinationRotationYTable[] = {std::numbers::pi_v<float> / 2.0f, std::numbers::pi_v<float> * 3.0f / 2.0f};
-
-			// 目標角度を取得
-			float destinationRotationY = destinationRotationYTable[static_cast<uint32_t>(lrDirection_)];
-
-			// t: 進行割合（0.0 ～ 1.0）
-			float t = 1.0f - std::clamp(turnTimer_ / kTimeTurn, 0.0f, 1.0f);
-			float easedT = EaseInOut(t);
-
-			// 補間
-			worldTransform_.rotation_.y = std::lerp(turnFirstRotationY_, destinationRotationY, easedT);
-		}
 		// 攻撃開始入力は「押した瞬間」
-		if ((Input::GetInstance()->TriggerKey(DIK_SPACE)) && attackCooldownLeft_ <= 0.0f) { // ← クールタイムチェック
+		if (input.IsPressed(Action::kAttack) && attackCooldownLeft_ <= 0.0f) { // ← クールタイムチェック
 			StartAttack();
 			break;
 		}
 		// 行列更新
 		WorldTransformUpdate(worldTransform_);
-		worldTransform_.TransferMatrix();
 		break;
 	}
 	case ActionState::AttackWindup: {
+		TRACE_SCOPE("Player::AttackWindup");
 		attackTimer_ += dt;
-		// 溜め中は幅(Z)を狭める
-		worldTransform_.scale_.z = std::lerp(atk_.widthMax, atk_.widthMin, std::clamp(attackTimer_ / atk_.windup, 0.0f, 1.0f));
+		// 溜め中は幅(Z)を狭める（attackWindupTrack_）
 
 		CollisionMapInfo info{};
 		info.moveAmount_ = {0.0f, velocity_.y, 0.0f};
@@ -130,22 +145,17 @@ void Player::Update() {
 			attackHitboxActive_ = true;
 		}
 		WorldTransformUpdate(worldTransform_);
-		worldTransform_.TransferMatrix();
 		break;
 	}
 
 	case ActionState::AttackActive: {
+		TRACE_SCOPE("Player::AttackActive");
 		attackTimer_ += dt;
-
-		// 幅(Z)を伸ばし戻す（widthMin → widthMax）
-		{
-			float tA = std::clamp(attackTimer_ / atk_.active, 0.0f, 1.0f);
-			worldTransform_.scale_.z = std::lerp(atk_.widthMin, atk_.widthMax, tA);
-		}
+		// 幅(Z)を伸ばし戻す（attackActiveTrack_）
 
 		// ★落下しない：Yは固定。Xだけ突進しつつ、壁衝突は解く
 		float tA = std::clamp(attackTimer_ / std::max(atk_.active, 1e-6f), 0.0f, 1.0f);
-		float k = EaseOutCubic(tA);
+		float k = Easing::OutCubic(tA);
 		float perSec = atk_.lungeDistance / std::max(atk_.active, 1e-6f);
 		float step = perSec * (0.7f + 0.6f * k) * dt;
 		float dir = (lrDirection_ == LRDirection::kRight) ? +1.0f : -1.0f;
@@ -166,14 +176,13 @@ void Player::Update() {
 			attackHitboxActive_ = false;
 		}
 		WorldTransformUpdate(worldTransform_);
-		worldTransform_.TransferMatrix();
 		break;
 	}
 	case ActionState::AttackRecovery: {
+		TRACE_SCOPE("Player::AttackRecovery");
 		attackTimer_ += dt;
 
-		// 余韻では通常幅に戻しつつ……
-		worldTransform_.scale_.z = std::lerp(worldTransform_.scale_.z, atk_.widthMax, 0.25f);
+		// 幅(Z)は attackActiveTrack_ で通常幅まで戻っている
 
 		// ★ここから重力を再開（通常の縦物理）
 		if (!onGround_) {
@@ -192,11 +201,9 @@ void Player::Update() {
 		if (attackTimer_ >= atk_.recovery) {
 			state_ = ActionState::Move;
 			attackTimer_ = 0.0f;
-			worldTransform_.scale_.z = atk_.widthMax;
 		}
 
 		WorldTransformUpdate(worldTransform_);
-		worldTransform_.TransferMatrix();
 		break;
 	}
 	
@@ -206,13 +213,13 @@ void Player::Update() {
 	}
 }
 
-// void Player::Update() {
+// void Player::Update(const InputState& input) {
 //	float dt = 1.0f / 60.0f; // 固定更新の想定（あなたのループに合わせて）
 //	switch (state_) {
 //	case ActionState::Idle:
 //	case ActionState::Move: {
 //		// 移動処理
-//		Move();
+//		Move(input);
 //
 //		// 衝突情報を初期化
 //		CollisionMapInfo collisionMapInfo;
@@ -252,7 +259,6 @@ void Player::Update() {
 //		}
 //		// 行列更新
 //		WorldTransformUpdate(worldTransform_);
-//		worldTransform_.TransferMatrix();
 //		break;
 //	}
 //	case ActionState::Attack:
@@ -265,44 +271,33 @@ void Player::Update() {
 //	}
 // }
 
-void Player::UpdateFreeze() {
-	// 入力・移動・当たり判定・タイマーは進めない
-	// 位置/回転/拡縮からワールド行列を作って転送だけ行う
-	WorldTransformUpdate(worldTransform_);
-	worldTransform_.TransferMatrix();
-}
-
-void Player::Draw() {
+void Player::Draw(RenderSnapshot& snapshot) {
 	// 3Dモデルを描画
-	model_->Draw(worldTransform_, *camera_);
+	snapshot.AddModel(model_, worldTransform_);
 }
 
-void Player::Move() {
+void Player::Move(const InputState& input) {
 	// 地上状態
 	if (onGround_) {
 		// 左右移動
-		if (Input::GetInstance()->PushKey(DIK_RIGHT) || Input::GetInstance()->PushKey(DIK_LEFT)) {
+		if (input.IsHeld(Action::kMoveRight) || input.IsHeld(Action::kMoveLeft)) {
 			Vector3 acceleration = {};
 
-			if (Input::GetInstance()->PushKey(DIK_RIGHT)) {
+			if (input.IsHeld(Action::kMoveRight)) {
 				if (velocity_.x < 0.0f) {
 					velocity_.x *= (1.0f - kAttenuation);
 				}
 				acceleration.x += kAcceleration;
 				if (lrDirection_ != LRDirection::kRight) {
-					lrDirection_ = LRDirection::kRight;
-					turnFirstRotationY_ = worldTransform_.rotation_.y;
-					turnTimer_ = kTimeTurn;
+					StartTurn(LRDirection::kRight);
 				}
-			} else if (Input::GetInstance()->PushKey(DIK_LEFT)) {
+			} else if (input.IsHeld(Action::kMoveLeft)) {
 				if (velocity_.x > 0.0f) {
 					velocity_.x *= (1.0f - kAttenuation);
 				}
 				acceleration.x -= kAcceleration;
 				if (lrDirection_ != LRDirection::kLeft) {
-					lrDirection_ = LRDirection::kLeft;
-					turnFirstRotationY_ = worldTransform_.rotation_.y;
-					turnTimer_ = kTimeTurn;
+					StartTurn(LRDirection::kLeft);
 				}
 			}
 
@@ -313,7 +308,7 @@ void Player::Move() {
 		}
 
 		// ジャンプ入力
-		if (Input::GetInstance()->TriggerKey(DIK_UP)) {
+		if (input.IsPressed(Action::kJump)) {
 			velocity_.y = kJumpAcceleration;
 		}
 	}
@@ -325,11 +320,22 @@ void Player::Move() {
 	}
 }
 
+void Player::StartTurn(LRDirection direction) {
+	lrDirection_ = direction;
+
+	// 左右の自キャラ角度テーブル
+	const float destinationRotationYTable[] = {std::numbers::pi_v<float> / 2.0f, std::numbers::pi_v<float> * 3.0f / 2.0f};
+
+	// 今の角度から目標角度へ
+	timeline_->Play(turnTrack_, worldTransform_.rotation_.y, destinationRotationYTable[static_cast<uint32_t>(direction)], kTimeTurn);
+}
+
 const KamataEngine::WorldTransform& Player::GetWorldTransform() const { return worldTransform_; }
 
 void Player::SetMapChipField(MapChipField* mapChipField) { mapChipField_ = mapChipField; };
 
 void Player::MapCollisionDetection(CollisionMapInfo& info) {
+	TRACE_SCOPE("Player::MapCollisionDetection");
 	MapCollisionDetectionUp(info);
 	MapCollisionDetectionDown(info);
 	MapCollisionDetectionRight(info);
@@ -640,7 +646,7 @@ void Player::UpdateAttack(float dt) {
 	// ========== 2) Active：判定あり＋横幅を戻しつつ前進 ==========
 	else if (attackTimer_ < T_w + T_a) {
 		float tA = (attackTimer_ - T_w) / T_a; // 0→1
-		float k = EaseOutCubic(tA);            // 0→1（前半強め）
+		float k = Easing::OutCubic(tA);        // 0→1（前半強め）
 
 		// 横幅を Min→Max へ戻す（見た目で“伸びる”）
 		float sx = std::lerp(atk_.widthMin / atk_.widthMax, 1.0f, k);
@@ -678,7 +684,6 @@ void Player::UpdateAttack(float dt) {
 
 	// 行列確定
 	WorldTransformUpdate(worldTransform_);
-	worldTransform_.TransferMatrix();
 }
 
 void Player::BuildAttackAABB() {
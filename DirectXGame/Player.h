@@ -1,6 +1,10 @@
 #pragma once
+#include "CachedModel.h"
+#include "InputState.h"
 #include "KamataEngine.h"
 #include "Method.h"
+#include "RenderSnapshot.h"
+#include "Timeline.h"
 #include "TransformWorld.h"
 
 using namespace KamataEngine;
@@ -39,16 +43,15 @@ public:
 	/// </summary>
 	/// <param name="model">モデル</param>
 	/// <param name="textureHandle">テクスチャハンドル</param>
-	/// <param name="camera">カメラ</param>
-	void Initialize(Model* model, Camera* camera, const Vector3& position);
+	/// <param name="timeline">旋回と攻撃の見た目のアニメーションを登録する先</param>
+	void Initialize(CachedModel* model, Timeline* timeline, const Vector3& position);
 
-	void Update();
+	// input … このティックの入力（InputMapper::Sample が作ったもの）
+	void Update(const InputState& input);
 
-	void UpdateFreeze();
+	void Draw(RenderSnapshot& snapshot);
 
-	void Draw();
-
-	void Move();
+	void Move(const InputState& input);
 
 	void StartAttack();                                                      // ★追加
 	bool IsAttacking() const { return state_ == ActionState::AttackActive; } // ★追加
@@ -122,23 +125,26 @@ private:
 	// ★追加：攻撃用メソッド
 	void UpdateAttack(float dt);
 	void BuildAttackAABB(); // 当たり判定の計算
-	float EaseOutCubic(float t) const { return 1.0f - (1.0f - t) * (1.0f - t) * (1.0f - t); }
+
+	// 向きを変えて、旋回のアニメーションを始める
+	void StartTurn(LRDirection direction);
 
 	// ワールド変換データ
 	KamataEngine::WorldTransform worldTransform_;
 	// モデル
-	KamataEngine::Model* model_ = nullptr;
-	// カメラ
-	KamataEngine::Camera* camera_ = nullptr;
+	CachedModel* model_ = nullptr;
 
 	Vector3 velocity_ = {};
 
 	LRDirection lrDirection_ = LRDirection::kRight;
 
-	// 旋回開始時の角度
-	float turnFirstRotationY_ = 0.0f;
-	// 旋回タイマー
-	float turnTimer_ = 0.0f;
+	// アニメーション（Timeline が worldTransform_ の値を書き換える）
+	Timeline* timeline_ = nullptr;
+	// 旋回（今の角度 → 向く方向の角度）
+	Timeline::Handle turnTrack_ = Timeline::kNone;
+	// 攻撃の幅(Z)：溜めで widthMax → widthMin、続けて発生中に widthMin → widthMax
+	Timeline::Handle attackWindupTrack_ = Timeline::kNone;
+	Timeline::Handle attackActiveTrack_ = Timeline::kNone;
 
 	// 接地状態フラグ
 	bool onGround_ = true;
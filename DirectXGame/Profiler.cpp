@@ -0,0 +1,214 @@
+#include "Profiler.h"
+#include "AllocTracker.h"
+#include "KamataEngine.h"
+#include "Trace.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+
+Profiler* Profiler::GetInstance() {
+	static Profiler instance;
+	return &instance;
+}
+
+uint64_t Profiler::Now() { return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()); }
+
+Profiler::ThreadBuffer* Profiler::RegisterThread() {
+	ALLOC_TAG_SCOPE(AllocTag::kProfiler);
+	std::lock_guard<std::mutex> lock(mutex_);
+	buffers_.push_back(std::make_unique<ThreadBuffer>());
+	return buffers_.back().get();
+}
+
+void Profiler::Record(const char* name, uint64_t begin, uint64_t end) {
+	thread_local ThreadBuffer* buffer = nullptr;
+	if (!buffer) {
+		buffer = RegisterThread();
+	}
+	const uint64_t head = buffer->head.load(std::memory_order_relaxed);
+	Sample& sample = buffer->samples[head % kRingCapacity];
+	sample.name.store(name, std::memory_order_relaxed);
+	sample.begin.store(begin, std::memory_order_relaxed);
+	sample.end.store(end, std::memory_order_relaxed);
+	// 中身を書き終えてから数を進める（読む側は数を見てから中身を読む）
+	buffer->head.store(head + 1, std::memory_order_release);
+
+	// トレースを記録中ならそちらにも同じ区間を積む
+	TRACE_COMPLETE(name, begin, end);
+}
+
+void Profiler::EndFrame() {
+	ALLOC_TAG_SCOPE(AllocTag::kProfiler);
+	const uint64_t now = Now();
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		for (const std::unique_ptr<ThreadBuffer>& buffer : buffers_) {
+			const uint64_t head = buffer->head.load(std::memory_order_acquire);
+			if (head - buffer->tail > kRingCapacity) {
+				dropped_ += head - buffer->tail - kRingCapacity;
+				buffer->tail = head - kRingCapacity;
+			}
+			for (; buffer->tail < head; ++buffer->tail) {
+				const Sample& sample = buffer->samples[buffer->tail % kRingCapacity];
+				const char* name = sample.name.load(std::memory_order_relaxed);
+				const uint64_t begin = sample.begin.load(std::memory_order_relaxed);
+				const uint64_t end = sample.end.load(std::memory_order_relaxed);
+				// 読んでいる間に書くほうが一周して同じ場所を上書きしていたら捨てる
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if (buffer->head.load(std::memory_order_relaxed) - buffer->tail >= kRingCapacity) {
+					++dropped_;
+					continue;
+				}
+
+				auto it = systemIndices_.find(name);
+				if (it == systemIndices_.end()) {
+					it = systemIndices_.emplace(name, systems_.size()).first;
+					systems_.push_back(System{name});
+				}
+				System& system = systems_[it->second];
+				system.currentMs += static_cast<double>(end - begin) / 1e6;
+				system.recorded = true;
+			}
+		}
+	}
+
+	// 最初のフレームは前回がないので記録なし
+	frameMs_[historyIndex_] = lastFrameEnd_ ? static_cast<float>(static_cast<double>(now - lastFrameEnd_) / 1e6) : -1.0f;
+	for (System& system : systems_) {
+		system.history[historyIndex_] = system.recorded ? static_cast<float>(system.currentMs) : -1.0f;
+		system.currentMs = 0.0;
+		system.recorded = false;
+	}
+	historyIndex_ = (historyIndex_ + 1) % kHistoryFrames;
+	++frameCount_;
+	lastFrameEnd_ = now;
+
+	// メモリ確保の数もフレームで区切る
+	AllocTracker::EndFrame();
+}
+
+Profiler::Stats Profiler::ComputeStats(const std::vector<float>& history) {
+	std::vector<float> values;
+	values.reserve(history.size());
+	for (float value : history) {
+		if (value >= 0.0f) {
+			values.push_back(value);
+		}
+	}
+	Stats stats;
+	if (values.empty()) {
+		return stats;
+	}
+	std::sort(values.begin(), values.end());
+	double sum = 0.0;
+	for (float value : values) {
+		sum += value;
+	}
+	stats.minimum = values.front();
+	stats.average = static_cast<float>(sum / values.size());
+	const size_t rank = static_cast<size_t>(std::ceil(values.size() * 0.99));
+	stats.p99 = values[std::clamp<size_t>(rank, 1, values.size()) - 1];
+	return stats;
+}
+
+void Profiler::DrawOverlay() {
+#ifdef USE_IMGUI
+	const uint32_t count = static_cast<uint32_t>(std::min<uint64_t>(frameCount_, kHistoryFrames));
+	if (count == 0) {
+		return;
+	}
+	// グラフは古い順に並べ直して渡す（記録のないフレームは 0）
+	std::vector<float> frames(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		frames[i] = std::max(0.0f, frameMs_[(historyIndex_ + kHistoryFrames - count + i) % kHistoryFrames]);
+	}
+	const Stats frame = ComputeStats(frameMs_);
+
+	ImGui::SetNextWindowBgAlpha(0.7f);
+	ImGui::Begin("Profiler", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
+	ImGui::Text("frame %.2f ms  avg %.2f  p99 %.2f  (%.0f fps)", frames.back(), frame.average, frame.p99, frame.average > 0.0f ? 1000.0f / frame.average : 0.0f);
+	ImGui::PlotLines("##frame", frames.data(), static_cast<int>(count), 0, nullptr, 0.0f, 33.4f, ImVec2(360.0f, 80.0f));
+	if (ImGui::BeginTable("systems", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+		ImGui::TableSetupColumn("system");
+		ImGui::TableSetupColumn("min ms");
+		ImGui::TableSetupColumn("avg ms");
+		ImGui::TableSetupColumn("p99 ms");
+		ImGui::TableHeadersRow();
+		for (const System& system : systems_) {
+			const Stats stats = ComputeStats(system.history);
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(system.name.data(), system.name.data() + system.name.size());
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", stats.minimum);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", stats.average);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", stats.p99);
+		}
+		ImGui::EndTable();
+	}
+	ImGui::Text("last %u frames, dropped %llu  [F3] hide  [F4] dump CSV", count, static_cast<unsigned long long>(dropped_));
+#ifdef ALLOC_TRACKING_ENABLED
+	// 前のフレームのメモリ確保（分類ごと）
+	if (ImGui::BeginTable("allocations", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+		ImGui::TableSetupColumn("tag");
+		ImGui::TableSetupColumn("allocs");
+		ImGui::TableSetupColumn("KB");
+		ImGui::TableSetupColumn("live KB");
+		ImGui::TableSetupColumn("peak KB");
+		ImGui::TableHeadersRow();
+		for (size_t i = 0; i < static_cast<size_t>(AllocTag::kCount); ++i) {
+			const AllocTag tag = static_cast<AllocTag>(i);
+			const AllocTracker::TagStats stats = AllocTracker::GetStats(tag);
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(AllocTracker::GetTagName(tag));
+			ImGui::TableNextColumn();
+			ImGui::Text("%llu", static_cast<unsigned long long>(stats.frameAllocations));
+			ImGui::TableNextColumn();
+			ImGui::Text("%.1f", stats.frameBytes / 1024.0);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.1f", stats.liveBytes / 1024.0);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.1f", stats.peakBytes / 1024.0);
+		}
+		ImGui::EndTable();
+	}
+	ImGui::Text("steady-state violations %llu", static_cast<unsigned long long>(AllocTracker::GetSteadyStateViolationCount()));
+#endif
+	ImGui::End();
+#endif
+}
+
+bool Profiler::DumpCsv(const std::filesystem::path& path) const {
+	std::ofstream file(path, std::ios::trunc);
+	if (!file.is_open()) {
+		return false;
+	}
+	file << "frame,frame_ms";
+	for (const System& system : systems_) {
+		file << ',' << system.name;
+	}
+	file << '\n';
+
+	// 記録のない欄は空にする
+	auto write = [&file](float value) {
+		file << ',';
+		if (value >= 0.0f) {
+			file << value;
+		}
+	};
+	const uint32_t count = static_cast<uint32_t>(std::min<uint64_t>(frameCount_, kHistoryFrames));
+	for (uint32_t i = 0; i < count; ++i) {
+		const uint32_t index = (historyIndex_ + kHistoryFrames - count + i) % kHistoryFrames;
+		file << frameCount_ - count + i;
+		write(frameMs_[index]);
+		for (const System& system : systems_) {
+			write(system.history[index]);
+		}
+		file << '\n';
+	}
+	return static_cast<bool>(file);
+}
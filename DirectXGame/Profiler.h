@@ -0,0 +1,106 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// フレームの CPU 時間の計測
+// PROFILE_SCOPE("名前") を置いたスコープの開始と終了の時刻[ns]を、呼んだスレッドごとのリングバッファに積む。
+// 積むのはそのスレッドだけ、読むのは EndFrame を呼ぶメインスレッドだけなので、ロックは使わない。
+// EndFrame で 1 フレームぶんを名前ごとに足し合わせ、直近 kHistoryFrames フレームの履歴から min / avg / p99 を出す。
+class Profiler {
+public:
+	// 履歴を残すフレーム数
+	static inline const uint32_t kHistoryFrames = 240;
+	// スレッドごとのリングバッファの大きさ（EndFrame までに積める数）
+	static inline const uint32_t kRingCapacity = 4096;
+
+	static Profiler* GetInstance();
+
+	// 時刻[ns]
+	static uint64_t Now();
+
+	// 呼んだスレッドのリングバッファに 1 区間を積む（name は文字列リテラルなど、ずっと残るもの）
+	void Record(const char* name, uint64_t begin, uint64_t end);
+
+	// メインスレッドで毎フレーム最後に呼ぶ。全スレッドの記録を集め、前回からの時間をフレーム時間とする
+	void EndFrame();
+
+	// 名前ごとの min / avg / p99[ms]（ImGui があるときだけ）
+	void DrawOverlay();
+	// 直近のフレームを 1 行 1 フレームで書き出す（列はフレーム時間と名前ごとの時間[ms]）
+	bool DumpCsv(const std::filesystem::path& path) const;
+
+	struct Stats {
+		float minimum = 0.0f;
+		float average = 0.0f;
+		float p99 = 0.0f;
+	};
+	// 履歴の中で記録のあったフレームだけから求める
+	static Stats ComputeStats(const std::vector<float>& history);
+
+	// EndFrame を呼んだ回数
+	uint64_t GetFrameCount() const { return frameCount_; }
+	// 記録を落とした数（EndFrame までにリングバッファがあふれた）
+	uint64_t GetDroppedCount() const { return dropped_; }
+
+private:
+	Profiler() = default;
+	~Profiler() = default;
+	Profiler(const Profiler&) = delete;
+	Profiler& operator=(const Profiler&) = delete;
+
+	// 1 スレッドぶんの記録（書くのは持ち主のスレッド、読むのはメインスレッド）
+	struct Sample {
+		std::atomic<const char*> name{nullptr};
+		std::atomic<uint64_t> begin{0};
+		std::atomic<uint64_t> end{0};
+	};
+	struct ThreadBuffer {
+		Sample samples[kRingCapacity];
+		std::atomic<uint64_t> head{0}; // 書いた数
+		uint64_t tail = 0;             // 読んだ数（メインスレッドだけが触る）
+	};
+	ThreadBuffer* RegisterThread();
+
+	// 名前ごとの履歴（記録のないフレームは負の値）
+	struct System {
+		std::string_view name;
+		std::vector<float> history = std::vector<float>(kHistoryFrames, -1.0f);
+		double currentMs = 0.0;
+		bool recorded = false;
+	};
+
+	// スレッドの登録だけはロックする（バッファはスレッドが終わっても最後まで残す）
+	std::mutex mutex_;
+	std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+
+	std::vector<System> systems_;
+	std::unordered_map<std::string_view, size_t> systemIndices_;
+	std::vector<float> frameMs_ = std::vector<float>(kHistoryFrames, -1.0f);
+	uint32_t historyIndex_ = 0; // 次に書く位置
+	uint64_t frameCount_ = 0;
+	uint64_t lastFrameEnd_ = 0;
+	uint64_t dropped_ = 0;
+};
+
+// スコープの開始から終了までを Profiler に積む
+class ProfileScope {
+public:
+	explicit ProfileScope(const char* name) : name_(name), begin_(Profiler::Now()) {}
+	~ProfileScope() { Profiler::GetInstance()->Record(name_, begin_, Profiler::Now()); }
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+	const char* name_;
+	uint64_t begin_;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
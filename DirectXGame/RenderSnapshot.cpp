@@ -0,0 +1,53 @@
+#include "RenderSnapshot.h"
+#include "ConstBufferRing.h"
+#include "Profiler.h"
+#include "Trace.h"
+#include <assert.h>
+#include <cstdio>
+
+using namespace KamataEngine;
+
+void RenderSnapshot::Record() const {
+	PROFILE_SCOPE("RenderSnapshot::Record");
+	ID3D12GraphicsCommandList* commandList = DirectXCommon::GetInstance()->GetCommandList();
+	ConstBufferRing* ring = ConstBufferRing::GetInstance();
+
+	// 3D モデル
+	Model::PreDraw(commandList);
+	CachedModel::PreDraw(commandList);
+	CachedModel::DrawBuffers buffers;
+	buffers.camera = ring->Push(ConstBufferDataCamera{camera_.view, camera_.projection, camera_.position});
+	// リングが埋まると Push は 0 を返す。0 のアドレスで描かないよう、そこから先のモデルは積まない
+	size_t recorded = 0;
+	if (buffers.camera) {
+		for (const ModelItem& item : models_) {
+			buffers.worldTransform = ring->Push(ConstBufferDataWorldTransform{item.world});
+			buffers.objectColor = item.hasColor ? ring->Push(ConstBufferDataObjectColor{item.color}) : 0;
+			if (!buffers.worldTransform || (item.hasColor && !buffers.objectColor)) {
+				break;
+			}
+			item.model->Draw(buffers, item.world, camera_.view, camera_.projection, camera_.nearZ);
+			++recorded;
+		}
+	}
+	Model::PostDraw();
+	if (recorded < models_.size()) {
+		// ConstBufferRing::Initialize の maxPages を増やす
+		char message[128];
+		std::snprintf(message, sizeof(message), "RenderSnapshot: ConstBufferRing is full, skipped %zu of %zu models\n", models_.size() - recorded, models_.size());
+		OutputDebugStringA(message);
+		TRACE_INSTANT("RenderSnapshot: ConstBufferRing full");
+		assert(false);
+	}
+
+	// スプライト（モデルより手前）
+	if (sprites_.empty()) {
+		return;
+	}
+	Sprite::PreDraw(commandList);
+	for (const SpriteItem& item : sprites_) {
+		item.sprite->SetColor(item.color);
+		item.sprite->Draw();
+	}
+	Sprite::PostDraw();
+}
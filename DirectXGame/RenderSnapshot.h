@@ -0,0 +1,69 @@
+#pragma once
+#include "CachedModel.h"
+#include "KamataEngine.h"
+#include <cstdint>
+#include <vector>
+
+using namespace KamataEngine;
+
+// 1 フレームぶんの描画内容
+// シーンの Draw は描くものの行列・色を値でここに書き写すだけで、コマンドは RenderThread が Record で積む。
+// 書き写したあとはゲームのオブジェクトを見ないので、次のフレームの Update と描画を同時に進められる。
+// モデル・スプライトはポインタで持つだけなので、シーンを破棄する前に RenderThread::WaitIdle で描き終わりを待つ。
+// 行列・色は WorldTransform / Camera / ObjectColor の定数バッファを使わず、Record のときに ConstBufferRing に書く。
+class RenderSnapshot {
+public:
+	// 中身を空にする（確保した領域は次のフレームに使い回す）
+	void Clear() {
+		models_.clear();
+		sprites_.clear();
+	}
+
+	// 今の行列を写す（ビュー行列からカメラの位置を求めるので、matView だけ書き換えたカメラでもよい）
+	void SetCamera(const Camera& camera) {
+		camera_.view = camera.matView;
+		camera_.projection = camera.matProjection;
+		camera_.nearZ = camera.nearZ;
+		// ビュー行列は回転と平行移動だけなので、逆行列の平行移動は -t * R^T
+		const Matrix4x4& v = camera.matView;
+		camera_.position = {
+		    -(v.m[3][0] * v.m[0][0] + v.m[3][1] * v.m[0][1] + v.m[3][2] * v.m[0][2]),
+		    -(v.m[3][0] * v.m[1][0] + v.m[3][1] * v.m[1][1] + v.m[3][2] * v.m[1][2]),
+		    -(v.m[3][0] * v.m[2][0] + v.m[3][1] * v.m[2][1] + v.m[3][2] * v.m[2][2]),
+		};
+	}
+	// 今の matWorld_ を写す（既定の色で描く）
+	void AddModel(CachedModel* model, const WorldTransform& worldTransform) { models_.push_back({model, worldTransform.matWorld_, {1.0f, 1.0f, 1.0f, 1.0f}, false}); }
+	// 今の matWorld_ と color を写す
+	void AddModel(CachedModel* model, const WorldTransform& worldTransform, const Vector4& color) { models_.push_back({model, worldTransform.matWorld_, color, true}); }
+	// スプライトはモデルのあとに、積んだ順に描く
+	void AddSprite(Sprite* sprite, const Vector4& color = {1.0f, 1.0f, 1.0f, 1.0f}) { sprites_.push_back({sprite, color}); }
+
+	// 描画スレッドで、DirectXCommon::PreDraw と PostDraw の間に呼ぶ
+	void Record() const;
+
+	uint32_t GetModelCount() const { return static_cast<uint32_t>(models_.size()); }
+	uint32_t GetSpriteCount() const { return static_cast<uint32_t>(sprites_.size()); }
+
+private:
+	struct CameraData {
+		Matrix4x4 view;
+		Matrix4x4 projection;
+		Vector3 position;
+		float nearZ;
+	};
+	struct ModelItem {
+		CachedModel* model;
+		Matrix4x4 world;
+		Vector4 color;
+		bool hasColor;
+	};
+	struct SpriteItem {
+		Sprite* sprite;
+		Vector4 color;
+	};
+
+	CameraData camera_ = {};
+	std::vector<ModelItem> models_;
+	std::vector<SpriteItem> sprites_;
+};
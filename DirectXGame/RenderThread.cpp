@@ -0,0 +1,88 @@
+#include "RenderThread.h"
+#include "ConstBufferRing.h"
+#include "Profiler.h"
+#include "Trace.h"
+
+using namespace KamataEngine;
+
+RenderThread* RenderThread::GetInstance() {
+	static RenderThread instance;
+	return &instance;
+}
+
+void RenderThread::Initialize() {
+	stop_ = false;
+	pending_ = false;
+	writeIndex_ = 0;
+	snapshots_[0].Clear();
+	snapshots_[1].Clear();
+	thread_ = std::thread(&RenderThread::ThreadMain, this);
+}
+
+void RenderThread::Finalize() {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stop_ = true;
+	}
+	submitted_.notify_one();
+	if (thread_.joinable()) {
+		thread_.join();
+	}
+}
+
+void RenderThread::Submit() {
+	{
+		// 前のフレームを描き終えるまで待つ（描画中のフレームは 1 つまで）
+		PROFILE_SCOPE("RenderThread::Wait");
+		std::unique_lock<std::mutex> lock(mutex_);
+		rendered_.wait(lock, [this] { return !pending_; });
+		readIndex_ = writeIndex_;
+		pending_ = true;
+	}
+	submitted_.notify_one();
+
+	// 次のフレームはもう一方に書く（こちらは描き終えているので中身を捨ててよい）
+	writeIndex_ ^= 1;
+	snapshots_[writeIndex_].Clear();
+
+#ifdef USE_IMGUI
+	// ImGui の次のフレームを始める前に描き終える
+	WaitIdle();
+#endif
+}
+
+void RenderThread::WaitIdle() {
+	std::unique_lock<std::mutex> lock(mutex_);
+	rendered_.wait(lock, [this] { return !pending_; });
+}
+
+void RenderThread::ThreadMain() {
+	TRACE_THREAD_NAME("Render");
+	std::unique_lock<std::mutex> lock(mutex_);
+	while (true) {
+		submitted_.wait(lock, [this] { return pending_ || stop_; });
+		if (!pending_) {
+			return;
+		}
+		// 描いている間はメインスレッドがもう一方のスナップショットに書く
+		const RenderSnapshot& snapshot = snapshots_[readIndex_];
+		lock.unlock();
+		Render(snapshot);
+		lock.lock();
+		pending_ = false;
+		rendered_.notify_all();
+	}
+}
+
+void RenderThread::Render(const RenderSnapshot& snapshot) {
+	TRACE_SCOPE("Render");
+	DirectXCommon* dxCommon = DirectXCommon::GetInstance();
+	ConstBufferRing* constBufferRing = ConstBufferRing::GetInstance();
+
+	dxCommon->PreDraw();
+	constBufferRing->BeginFrame();
+	snapshot.Record();
+	// PostDraw は GPU の完了を待つので、戻ったらこのフレームの定数バッファは使い回せる
+	dxCommon->PostDraw();
+	constBufferRing->EndFrame();
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "RenderSnapshot.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// 描画スレッド
+// メインスレッドはフレーム N の Update のあと、描く内容を RenderSnapshot に書いて Submit で渡し、
+// すぐにフレーム N+1 の Update に進む。描画スレッドは受け取ったスナップショットからコマンドリストを積んで
+// Present まで行う（DirectXCommon::PreDraw から PostDraw、ConstBufferRing の BeginFrame / EndFrame もこちら）。
+// スナップショットは書く側と描く側の 2 つを入れ替えて使い、描画中のフレームは 1 つまで。
+// Submit は前のフレームの描画が終わるまで待つので、入力から画面までの遅れは 1 フレームぶんしか増えない。
+//
+// ImGui はスレッドをまたいで使えず、フレームの開始と描画はエンジンの中にあるので、
+// USE_IMGUI のビルドでは Submit の中で描き終わりまで待つ（描画スレッドは使うが重ならない）。
+class RenderThread {
+public:
+	static RenderThread* GetInstance();
+
+	void Initialize();
+	// 描画中のフレームを描き終えてから止める
+	void Finalize();
+
+	// 今のフレームで書き込むスナップショット（Submit のあとは空になった別のものを返す）
+	RenderSnapshot& GetSnapshot() { return snapshots_[writeIndex_]; }
+	// 書き終えたスナップショットを描画スレッドに渡す
+	void Submit();
+	// 渡したフレームを描き終わるまで待つ（スナップショットが指すモデル・スプライトを破棄する前や、テクスチャ・モデルを作る前に呼ぶ）
+	void WaitIdle();
+
+private:
+	RenderThread() = default;
+	~RenderThread() = default;
+	RenderThread(const RenderThread&) = delete;
+	RenderThread& operator=(const RenderThread&) = delete;
+
+	void ThreadMain();
+	// 1 フレームぶんのコマンドを積んで Present する
+	static void Render(const RenderSnapshot& snapshot);
+
+	RenderSnapshot snapshots_[2];
+	uint32_t writeIndex_ = 0; // メインスレッドだけが触る
+	uint32_t readIndex_ = 0;  // 以下は mutex_ で守る
+
+	std::mutex mutex_;
+	std::condition_variable submitted_; // メイン → 描画
+	std::condition_variable rendered_;  // 描画 → メイン
+	bool pending_ = false;              // 渡したフレームを描き終えていない
+	bool stop_ = false;
+	std::thread thread_;
+};
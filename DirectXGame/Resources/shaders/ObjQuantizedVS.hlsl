@@ -0,0 +1,38 @@
+#include "Obj.hlsli"
+
+// QuantizedVertex の位置を戻す範囲（pos = offset + q * scale。q は UNORM で 0〜1 に読めるので scale は 65535 倍してある）
+cbuffer Quantization : register(b5) {
+	float3 q_offset : packoffset(c0);
+	float3 q_scale : packoffset(c1);
+};
+
+// 8 面体写像した法線を戻す（MeshQuantizer::DecodeOctahedral と同じ）
+float3 DecodeOctahedral(float2 encoded) {
+	float3 n = float3(encoded, 1.0f - abs(encoded.x) - abs(encoded.y));
+	if (n.z < 0.0f) {
+		// 下半分は折り返してある
+		n.xy = (1.0f - abs(n.yx)) * float2(n.x >= 0.0f ? 1.0f : -1.0f, n.y >= 0.0f ? 1.0f : -1.0f);
+	}
+	return normalize(n);
+}
+
+// 位置 R16G16B16A16_UNORM、法線 R16G16_SNORM、uv R16G16_FLOAT の頂点を読む ObjVS
+VSOutput main(float4 quantizedPos : POSITION, float2 encodedNormal : NORMAL, float2 uv : TEXCOORD) {
+	float4 pos = float4(q_offset + quantizedPos.xyz * q_scale, 1.0f);
+	float3 normal = DecodeOctahedral(encodedNormal);
+
+	// ここから先は ObjVS と同じ
+	// 法線にワールド行列によるスケーリング・回転を適用
+	// ※スケーリングが一様な場合のみ正しい
+	float4 worldNormal = normalize(mul(float4(normal, 0), world));
+	float4 worldPos = mul(pos, world);
+
+	VSOutput output; // ピクセルシェーダーに渡す値
+	output.svpos = mul(pos, mul(world, mul(view, projection)));
+
+	output.worldpos = worldPos;
+	output.normal = worldNormal.xyz;
+	output.uv = uv;
+
+	return output;
+}
@@ -1,16 +1,25 @@
 #include "ResultScene.h"
 
+ResultScene::~ResultScene() {
+	if (clearSprite_) {
+		delete clearSprite_;
+		delete failedSprite_;
+		AssetCache::GetInstance()->ReleaseTexture(texClear_);
+		AssetCache::GetInstance()->ReleaseTexture(texFailed_);
+	}
+}
+
 void ResultScene::Initialize() {
 	finished_ = false;
-	fade_ = new Fade();
-	fade_->Initialize();
+	fade_ = arena_.New<Fade>();
+	fade_->Initialize(&timeline_);
 	// 入場は黒→透明
 	fade_->Start(Fade::Status::FadeIn, kFadeTimeSec_);
 	phase_ = Phase::kFadeIn;
 
 	// ★画像ロード
-	texClear_ = TextureManager::Load("scene/clear.png");
-	texFailed_ = TextureManager::Load("scene/failed.png");
+	texClear_ = AssetCache::GetInstance()->AcquireTexture("scene/clear.png");
+	texFailed_ = AssetCache::GetInstance()->AcquireTexture("scene/failed.png");
 
 	// ★スプライト生成（画面中央に配置）
 	// 画面サイズは 1280x720 を想定。違う場合は数値を変えてね。
@@ -27,25 +36,24 @@ void ResultScene::Initialize() {
 	failedSprite_->SetSize(size);
 }
 
-void ResultScene::Update() {
+void ResultScene::Update(const InputState& input) {
+	timeline_.Update(1.0f / 60.0f);
+
 	switch (phase_) {
 	case Phase::kFadeIn:
-		fade_->Update();
 		if (fade_->IsFinished()) {
 			fade_->Stop();
 			phase_ = Phase::kMain;
 		}
 		break;
 	case Phase::kMain: {
-		auto* in = Input::GetInstance();
-		if (in->TriggerKey(DIK_SPACE) || in->PushKey(DIK_SPACE)) {
+		if (input.IsHeld(Action::kDecide)) {
 			fade_->Start(Fade::Status::FadeOut, kFadeTimeSec_);
 			blackHoldFrames_ = 0;                 
 			phase_ = Phase::kFadeOut;
 		}
 	} break;
 	case Phase::kFadeOut:
-		fade_->Update();
 		if (fade_->IsFinished()) {
 			if (blackHoldFrames_ < 2) { // 1〜2フレームで十分に見える
 				++blackHoldFrames_;
@@ -58,22 +66,20 @@ void ResultScene::Update() {
 	}
 }
 
-void ResultScene::Draw() {
+void ResultScene::Draw(RenderSnapshot& snapshot) {
 	// ① 結果スプライト（CLEAR or FAILED）を描く
-	Sprite::PreDraw(DirectXCommon::GetInstance()->GetCommandList());
 	if (kind_ == Kind::kClear) {
 		if (clearSprite_) {
-			clearSprite_->Draw();
+			snapshot.AddSprite(clearSprite_);
 		}
 	} else {
 		if (failedSprite_) {
-			failedSprite_->Draw();
+			snapshot.AddSprite(failedSprite_);
 		}
 	}
-	Sprite::PostDraw();
 
 	// ② その上にフェード（最前面）
 	if (fade_) {
-		fade_->Draw();
+		fade_->Draw(snapshot);
 	}
 }
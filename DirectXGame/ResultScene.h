@@ -1,6 +1,11 @@
 #pragma once
+#include "AssetCache.h"
 #include "Fade.h"
+#include "InputState.h"
 #include "KamataEngine.h"
+#include "RenderSnapshot.h"
+#include "SceneArena.h"
+#include "Timeline.h"
 using namespace KamataEngine;
 
 class ResultScene {
@@ -8,21 +13,21 @@ public:
 	enum class Kind { kClear, kFailed };
 
 	explicit ResultScene(Kind kind) : kind_(kind) {}
-	~ResultScene() {
-		delete fade_;
-		fade_ = nullptr;
-	}
+	~ResultScene();
 
 	void Initialize();
 
-	void Update();
+	void Update(const InputState& input);
 
-	void Draw();
+	void Draw(RenderSnapshot& snapshot);
 
 	bool IsFinished() const { return finished_; }
 	Kind GetKind() const { return kind_; }
 
 private:
+	// シーンのオブジェクトの置き場（フェードだけなので小さく）
+	SceneArena arena_{1024};
+
 	enum class Phase { kFadeIn, kMain, kFadeOut };
 	Phase phase_ = Phase::kFadeIn;
 	const float kFadeTimeSec_ = 1.0f;
@@ -30,6 +35,8 @@ private:
 	Kind kind_;
 	bool finished_ = false;
 	Fade* fade_ = nullptr;
+	// フェードのアニメーション
+	Timeline timeline_;
 
 	uint32_t texClear_ = 0;
 	uint32_t texFailed_ = 0;
@@ -0,0 +1,64 @@
+#include "SceneArena.h"
+#include "AllocTracker.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+SceneArena::SceneArena(size_t blockSize) : nextBlockSize_(std::max<size_t>(blockSize, 256)) {}
+
+SceneArena::~SceneArena() { DestroyObjects(); }
+
+void SceneArena::AddBlock(size_t minimumSize) {
+	ALLOC_TAG_SCOPE(AllocTag::kScene);
+	const size_t size = std::max(nextBlockSize_, minimumSize);
+	Block block;
+	block.memory = std::make_unique_for_overwrite<std::byte[]>(size);
+	block.size = size;
+	cursor_ = block.memory.get();
+	end_ = cursor_ + size;
+	blocks_.push_back(std::move(block));
+	reservedBytes_ += size;
+	nextBlockSize_ = size * 2;
+}
+
+void* SceneArena::Allocate(size_t size, size_t alignment) {
+	assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+	// 今のブロックの残りに収まらなければ、境界合わせの分も見込んで次のブロックを足す
+	uintptr_t address = (reinterpret_cast<uintptr_t>(cursor_) + alignment - 1) & ~(alignment - 1);
+	if (!cursor_ || address + size > reinterpret_cast<uintptr_t>(end_)) {
+		AddBlock(size + alignment);
+		address = (reinterpret_cast<uintptr_t>(cursor_) + alignment - 1) & ~(alignment - 1);
+	}
+	std::byte* result = reinterpret_cast<std::byte*>(address);
+	usedBytes_ += static_cast<size_t>(result + size - cursor_);
+	cursor_ = result + size;
+	++allocationCount_;
+	return result;
+}
+
+void SceneArena::DestroyObjects() {
+	while (finalizers_) {
+		Finalizer* finalizer = finalizers_;
+		finalizers_ = finalizer->next;
+		finalizer->destroy(finalizer->object);
+	}
+	objectCount_ = 0;
+}
+
+void SceneArena::Reset() {
+	DestroyObjects();
+	if (blocks_.size() > 1) {
+		const size_t total = reservedBytes_;
+		blocks_.clear();
+		reservedBytes_ = 0;
+		nextBlockSize_ = total;
+		AddBlock(total);
+	}
+	if (!blocks_.empty()) {
+		cursor_ = blocks_.front().memory.get();
+		end_ = cursor_ + blocks_.front().size;
+		nextBlockSize_ = blocks_.front().size * 2;
+	}
+	usedBytes_ = 0;
+	allocationCount_ = 0;
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// シーンの寿命で使う単調（積むだけ）のアロケータ
+// ブロックの先頭からポインタを進めて切り出すだけで、1 つずつの解放はしない。
+// New で作ったオブジェクトはデストラクタを登録しておき、Reset（とデストラクタ）で作った順の逆にまとめて呼ぶ。
+// std::pmr::memory_resource でもあるので、シーンが持つ std::pmr のコンテナもここから確保できる。
+// シーンのメンバにするときは最初に宣言する（コンテナやオブジェクトより後に破棄されるように）。
+class SceneArena : public std::pmr::memory_resource {
+public:
+	// 最初のブロックの大きさ（足りなくなるたびに倍にして足す）
+	static inline const size_t kDefaultBlockSize = 64 * 1024;
+
+	explicit SceneArena(size_t blockSize = kDefaultBlockSize);
+	~SceneArena() override;
+	SceneArena(const SceneArena&) = delete;
+	SceneArena& operator=(const SceneArena&) = delete;
+
+	// size バイトを alignment 境界で切り出す
+	void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+	// T を作る（破棄は Reset に任せ、delete しない）
+	template<typename T, typename... Args> T* New(Args&&... args) {
+		T* object = new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			Finalizer* finalizer = new (Allocate(sizeof(Finalizer), alignof(Finalizer))) Finalizer;
+			finalizer->destroy = [](void* p) { static_cast<T*>(p)->~T(); };
+			finalizer->object = object;
+			finalizer->next = finalizers_;
+			finalizers_ = finalizer;
+			++objectCount_;
+		}
+		return object;
+	}
+
+	// 作ったオブジェクトをすべて破棄して空に戻す
+	// 複数のブロックを使っていたら、次も同じだけ使うとみて合計の大きさの 1 ブロックに作り直す
+	void Reset();
+
+	// 切り出したバイト数（境界合わせの詰め物を含む）
+	size_t GetUsedBytes() const { return usedBytes_; }
+	// 確保しているブロックの合計
+	size_t GetReservedBytes() const { return reservedBytes_; }
+	// 切り出した回数
+	size_t GetAllocationCount() const { return allocationCount_; }
+	// 作ったオブジェクトのうちデストラクタを登録したものの数
+	size_t GetObjectCount() const { return objectCount_; }
+
+private:
+	// std::pmr のコンテナ向け（解放は何もしない）
+	void* do_allocate(size_t bytes, size_t alignment) override { return Allocate(bytes, alignment); }
+	void do_deallocate(void*, size_t, size_t) override {}
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+	// 破棄するオブジェクトの連結リスト（これもアリーナの中に置く）
+	struct Finalizer {
+		void (*destroy)(void*) = nullptr;
+		void* object = nullptr;
+		Finalizer* next = nullptr;
+	};
+
+	struct Block {
+		std::unique_ptr<std::byte[]> memory;
+		size_t size = 0;
+	};
+	// minimumSize 以上のブロックを足して切り出し先にする
+	void AddBlock(size_t minimumSize);
+	// 登録したデストラクタを逆順に呼ぶ
+	void DestroyObjects();
+
+	std::vector<Block> blocks_;
+	size_t nextBlockSize_;
+	std::byte* cursor_ = nullptr;
+	std::byte* end_ = nullptr;
+	Finalizer* finalizers_ = nullptr;
+
+	size_t usedBytes_ = 0;
+	size_t reservedBytes_ = 0;
+	size_t allocationCount_ = 0;
+	size_t objectCount_ = 0;
+};
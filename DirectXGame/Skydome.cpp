@@ -2,12 +2,14 @@
 
 using namespace KamataEngine;
 
+Skydome::~Skydome() { AssetCache::GetInstance()->ReleaseModel(model_); }
+
 void Skydome::Initialize() {
-	// ワールド変換の初期化
-	worldTransform_.Initialize();
-	model_ = Model::CreateFromOBJ("sky_sphere", true); // ここでモデルを読み込む
+	// 動かないので行列は 1 回だけ作る（描くときは RenderSnapshot が matWorld_ を写すので、定数バッファは作らない）
+	WorldTransformUpdate(worldTransform_);
+	model_ = AssetCache::GetInstance()->AcquireModel("sky_sphere"); // キャッシュから取得
 }
 
 void Skydome::Update() {}
 
-void Skydome::Draw(KamataEngine::Camera *camera_) { model_->Draw(worldTransform_, *camera_); }
+void Skydome::Draw(RenderSnapshot& snapshot) { snapshot.AddModel(model_, worldTransform_); }
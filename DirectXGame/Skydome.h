@@ -1,17 +1,21 @@
 #pragma once
+#include "AssetCache.h"
 #include "KamataEngine.h"
+#include "RenderSnapshot.h"
+#include "TransformWorld.h"
 
 using namespace KamataEngine;
 
 class Skydome {
 public:
+	~Skydome();
 	void Initialize();
 	void Update();
-	void Draw(KamataEngine::Camera *camera_);
+	void Draw(RenderSnapshot& snapshot);
 
 	private:
 		// ワールド変換データ
 	    KamataEngine::WorldTransform worldTransform_;
 		// モデル
-	    Model* model_ = nullptr;
+	    CachedModel* model_ = nullptr;
 };
@@ -0,0 +1,63 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// 書くスレッドと読むスレッドが 1 つずつのキュー（ロックなし）
+// 大きさ固定のリングバッファで、書く側は tail_、読む側は head_ だけを進める。
+// 相手の位置はキャッシュしておき、満杯・空に見えたときだけ読み直すので、ふだんは相手のキャッシュラインに触らない。
+// 要素は読み終えるまで上書きされないので、Front で覗いてから Pop してよい。
+template<class T, uint32_t Capacity> class SpscQueue {
+	static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+	// 書く側：満杯なら false（値は入れない）
+	bool Push(const T& value) {
+		const uint32_t tail = tail_.load(std::memory_order_relaxed);
+		if (tail - cachedHead_ == Capacity) {
+			cachedHead_ = head_.load(std::memory_order_acquire);
+			if (tail - cachedHead_ == Capacity) {
+				return false;
+			}
+		}
+		items_[tail & (Capacity - 1)] = value;
+		tail_.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	// 読む側：先頭の要素（空なら nullptr）
+	const T* Front() {
+		const uint32_t head = head_.load(std::memory_order_relaxed);
+		if (head == cachedTail_) {
+			cachedTail_ = tail_.load(std::memory_order_acquire);
+			if (head == cachedTail_) {
+				return nullptr;
+			}
+		}
+		return &items_[head & (Capacity - 1)];
+	}
+	// 読む側：先頭の要素を捨てる（Front が nullptr でないときだけ呼ぶ）
+	void Pop() { head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+	// 読む側：取り出せたら true
+	bool Pop(T& out) {
+		const T* front = Front();
+		if (!front) {
+			return false;
+		}
+		out = *front;
+		Pop();
+		return true;
+	}
+
+private:
+	// 書く側と読む側が触るものを別のキャッシュラインに置く
+	static inline const size_t kCacheLine = 64;
+
+	alignas(kCacheLine) std::atomic<uint32_t> head_{0}; // 読む側が進める
+	uint32_t cachedTail_ = 0;                           // 読む側が最後に見た tail_
+	alignas(kCacheLine) std::atomic<uint32_t> tail_{0}; // 書く側が進める
+	uint32_t cachedHead_ = 0;                           // 書く側が最後に見た head_
+	alignas(kCacheLine) std::array<T, Capacity> items_{};
+};
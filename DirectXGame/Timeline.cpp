@@ -0,0 +1,244 @@
+#include "Timeline.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <assert.h>
+#include <numeric>
+#include <utility>
+
+void Timeline::Reserve(uint32_t capacity) {
+	indices_.reserve(capacity);
+	handles_.reserve(capacity);
+	targets_.reserve(capacity);
+	from_.reserve(capacity);
+	delta_.reserve(capacity);
+	duration_.reserve(capacity);
+	invDuration_.reserve(capacity);
+	delay_.reserve(capacity);
+	time_.reserve(capacity);
+	playing_.reserve(capacity);
+	progress_.reserve(capacity);
+	loops_.reserve(capacity);
+	eases_.reserve(capacity);
+}
+
+void Timeline::Clear() {
+	indices_.clear();
+	handles_.clear();
+	freeHandles_.clear();
+	targets_.clear();
+	from_.clear();
+	delta_.clear();
+	duration_.clear();
+	invDuration_.clear();
+	delay_.clear();
+	time_.clear();
+	playing_.clear();
+	progress_.clear();
+	loops_.clear();
+	eases_.clear();
+	ranges_.fill(0);
+	playingCount_ = 0;
+	needsSort_ = false;
+}
+
+Timeline::Handle Timeline::Add(const Track& track) {
+	assert(track.target);
+	assert(track.ease < Ease::kCount);
+	const uint32_t index = GetCount();
+	Handle handle = kNone;
+	if (freeHandles_.empty()) {
+		handle = static_cast<Handle>(indices_.size());
+		indices_.push_back(index);
+	} else {
+		handle = freeHandles_.back();
+		freeHandles_.pop_back();
+		indices_[handle] = index;
+	}
+	const float duration = std::max(track.duration, 1e-6f); // 0除算よけ
+	handles_.push_back(handle);
+	targets_.push_back(track.target);
+	from_.push_back(track.from);
+	delta_.push_back(track.to - track.from);
+	duration_.push_back(duration);
+	invDuration_.push_back(1.0f / duration);
+	delay_.push_back(track.delay);
+	time_.push_back(-track.delay);
+	playing_.push_back(0.0f);
+	progress_.push_back(0.0f);
+	loops_.push_back(track.loop);
+	eases_.push_back(track.ease);
+	// 曲線ごとの範囲は次の Update の前に作り直す
+	needsSort_ = true;
+	if (track.autoPlay) {
+		Play(handle);
+	}
+	return handle;
+}
+
+void Timeline::Remove(Handle handle) {
+	Stop(handle);
+	// 末尾のトラックを空いた位置に移す（曲線ごとの並びが崩れるので並べ直す）
+	const uint32_t index = indices_[handle];
+	const uint32_t last = GetCount() - 1;
+	auto move = [index, last](auto& values) {
+		values[index] = values[last];
+		values.pop_back();
+	};
+	move(handles_);
+	move(targets_);
+	move(from_);
+	move(delta_);
+	move(duration_);
+	move(invDuration_);
+	move(delay_);
+	move(time_);
+	move(playing_);
+	move(progress_);
+	move(loops_);
+	move(eases_);
+	if (index != last) {
+		indices_[handles_[index]] = index;
+	}
+	indices_[handle] = kNone;
+	freeHandles_.push_back(handle);
+	needsSort_ = true;
+}
+
+void Timeline::Play(Handle handle) {
+	const uint32_t index = indices_[handle];
+	time_[index] = -delay_[index];
+	if (playing_[index] == 0.0f) {
+		playing_[index] = 1.0f;
+		++playingCount_;
+	}
+}
+
+void Timeline::Play(Handle handle, float from, float to, float duration) {
+	const uint32_t index = indices_[handle];
+	duration = std::max(duration, 1e-6f);
+	from_[index] = from;
+	delta_[index] = to - from;
+	duration_[index] = duration;
+	invDuration_[index] = 1.0f / duration;
+	Play(handle);
+}
+
+void Timeline::Stop(Handle handle) {
+	const uint32_t index = indices_[handle];
+	if (playing_[index] != 0.0f) {
+		playing_[index] = 0.0f;
+		--playingCount_;
+	}
+}
+
+template<Ease E> void Timeline::ApplyEase(uint32_t begin, uint32_t end) {
+	float* progress = progress_.data();
+	uint32_t i = begin;
+#ifdef METHOD_USE_SSE
+	// sin/cos の近似はコンパイラがベクトル化できないので、4 つずつ手で回す
+	if constexpr (Easing::kUsesSinCos<E>) {
+		for (; i + 4 <= end; i += 4) {
+			_mm_storeu_ps(progress + i, Easing::Apply4<E>(_mm_loadu_ps(progress + i)));
+		}
+	}
+#endif
+	for (; i < end; ++i) {
+		progress[i] = Easing::Apply<E>(progress[i]);
+	}
+}
+
+uint32_t Timeline::Update(float dt) {
+	if (playingCount_ == 0) {
+		return 0;
+	}
+	PROFILE_SCOPE("Timeline");
+	if (needsSort_) {
+		Sort();
+	}
+	const uint32_t count = GetCount();
+
+	// 1) 時間を進めて、繰り返しを畳んだ進み具合（0〜1）にする
+	// 止まっているトラックも同じ式で回す（playing_ が 0 なので時間は進まず、あとで書き込まない）
+	{
+		const float* duration = duration_.data();
+		const float* invDuration = invDuration_.data();
+		const float* playing = playing_.data();
+		const Loop* loops = loops_.data();
+		float* time = time_.data();
+		float* progress = progress_.data();
+		for (uint32_t i = 0; i < count; ++i) {
+			const float t = time[i] + dt * playing[i];
+			const float u = std::max(t, 0.0f) * invDuration[i];
+			// 繰り返すものは過ぎた周期ぶん時間を戻す（時間が伸び続けて精度が落ちないように）
+			// u は毎フレーム畳んでいるので小さく、整数への切り捨てで floor の代わりになる
+			const float repeats = static_cast<float>(static_cast<int32_t>(u));
+			const float pingPongs = 2.0f * static_cast<float>(static_cast<int32_t>(u * 0.5f));
+			const float cycles = loops[i] == Loop::kNone ? 0.0f : (loops[i] == Loop::kRepeat ? repeats : pingPongs);
+			time[i] = t - cycles * duration[i];
+			// kNone は 0〜1 で止め、kRepeat は [0, 1)、kPingPong は [0, 2) を折り返す
+			const float v = u - cycles;
+			progress[i] = loops[i] == Loop::kNone ? std::min(v, 1.0f) : (v <= 1.0f ? v : 2.0f - v);
+		}
+	}
+
+	// 2) 曲線を通す（曲線ごとに並んでいるので、分岐は曲線の種類ぶんだけ）
+	[this]<size_t... E>(std::index_sequence<E...>) {
+		(ApplyEase<static_cast<Ease>(E)>(ranges_[E], ranges_[E + 1]), ...);
+	}(std::make_index_sequence<static_cast<size_t>(Ease::kCount)>());
+
+	// 3) 動いているものだけ書き込み、終わりまで進んだ Loop::kNone を止める
+	uint32_t written = 0;
+	for (uint32_t i = 0; i < count; ++i) {
+		if (playing_[i] == 0.0f || time_[i] < 0.0f) {
+			continue;
+		}
+		*targets_[i] = from_[i] + delta_[i] * progress_[i];
+		++written;
+		if (loops_[i] == Loop::kNone && time_[i] >= duration_[i]) {
+			playing_[i] = 0.0f;
+			--playingCount_;
+		}
+	}
+	return written;
+}
+
+void Timeline::Sort() {
+	const uint32_t count = GetCount();
+	std::vector<uint32_t> order(count);
+	std::iota(order.begin(), order.end(), 0u);
+	std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) { return eases_[a] < eases_[b]; });
+
+	auto reorder = [&order](auto& values) {
+		std::remove_reference_t<decltype(values)> sorted;
+		sorted.reserve(values.size());
+		for (uint32_t from : order) {
+			sorted.push_back(values[from]);
+		}
+		values.swap(sorted);
+	};
+	reorder(handles_);
+	reorder(targets_);
+	reorder(from_);
+	reorder(delta_);
+	reorder(duration_);
+	reorder(invDuration_);
+	reorder(delay_);
+	reorder(time_);
+	reorder(playing_);
+	reorder(progress_);
+	reorder(loops_);
+	reorder(eases_);
+	for (uint32_t i = 0; i < count; ++i) {
+		indices_[handles_[i]] = i;
+	}
+
+	// 曲線ごとの範囲
+	ranges_.fill(0);
+	for (Ease ease : eases_) {
+		++ranges_[static_cast<size_t>(ease) + 1];
+	}
+	for (size_t e = 1; e < ranges_.size(); ++e) {
+		ranges_[e] += ranges_[e - 1];
+	}
+	needsSort_ = false;
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include "Easing.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// float の値を時間で動かすトラックをまとめて進める
+// アニメーションは「どの値を・どの曲線で・何秒かけて・繰り返すか」をデータ（Track）で登録しておき、
+// Update で登録されているトラックを一度に進めて対象に書き込む。
+// トラックは成分ごとの配列（SoA）で持ち、曲線の種類ごとにまとめて並べておく。
+// 進み具合の計算は全トラック同じ式、曲線は種類ごとに分岐なしのループになるので、コンパイラがベクトル化しやすい。
+// 開始の遅れ（delay）をずらした複数のトラックを同時に Play すれば、順に動く一連の演出になる。
+//
+// 対象のポインタを持つだけなので、対象はこの Timeline より長く生きていること（シーンのメンバにしてシーンの物に使う）。
+class Timeline {
+public:
+	// 登録したトラックを指す番号（並べ替えても変わらない）
+	using Handle = uint32_t;
+	static inline const Handle kNone = ~0u;
+
+	// 終わりまで進んだあとの扱い
+	enum class Loop : uint8_t {
+		kNone,     // 終わりの値で止まる
+		kRepeat,   // 最初に戻って繰り返す
+		kPingPong, // 行って戻ってを繰り返す（片道が duration）
+	};
+
+	// トラックの定義
+	struct Track {
+		float* target = nullptr; // 書き込む先
+		float from = 0.0f;
+		float to = 1.0f;
+		float duration = 1.0f; // [sec]
+		float delay = 0.0f;    // Play してから動き出すまで[sec]（負なら途中から始める）
+		Ease ease = Ease::kLinear;
+		Loop loop = Loop::kNone;
+		bool autoPlay = false; // 登録したらすぐ再生する
+	};
+
+	void Reserve(uint32_t capacity);
+	void Clear();
+
+	Handle Add(const Track& track);
+	void Remove(Handle handle);
+
+	// 最初から再生する（動き出すまでは書き込まない）
+	void Play(Handle handle);
+	// 始まりと終わりの値・時間を変えて最初から再生する
+	void Play(Handle handle, float from, float to, float duration);
+	// その場で止める（対象の値はそのまま）
+	void Stop(Handle handle);
+	// Loop::kNone は終わりまで進むと止まる
+	bool IsPlaying(Handle handle) const { return playing_[indices_[handle]] != 0.0f; }
+
+	// 再生中のトラックを dt 秒進めて対象に書き込む。書き込んだ数を返す
+	uint32_t Update(float dt);
+
+	uint32_t GetCount() const { return static_cast<uint32_t>(handles_.size()); }
+	uint32_t GetPlayingCount() const { return playingCount_; }
+
+private:
+	// 曲線の種類ごとにまとめて並べ直す（同じ曲線の中では今の順を保つ）
+	void Sort();
+	template<Ease E> void ApplyEase(uint32_t begin, uint32_t end);
+
+	// 番号 → 並びの位置と、その逆
+	std::vector<uint32_t> indices_;
+	std::vector<Handle> handles_;
+	std::vector<Handle> freeHandles_;
+
+	// 以下は並びの位置ごと
+	std::vector<float*> targets_;
+	std::vector<float> from_;
+	std::vector<float> delta_; // to - from
+	std::vector<float> duration_;
+	std::vector<float> invDuration_;
+	std::vector<float> delay_;
+	std::vector<float> time_;     // 動き出してからの時間（遅れの間は負）
+	std::vector<float> playing_;  // 再生中なら 1（時間の進みに掛ける）
+	std::vector<float> progress_; // Update の途中の値（進み具合 → 曲線を通した値）
+	std::vector<Loop> loops_;
+	std::vector<Ease> eases_;
+
+	// 曲線ごとの並びの範囲 [ranges_[e], ranges_[e + 1])
+	std::array<uint32_t, static_cast<size_t>(Ease::kCount) + 1> ranges_{};
+
+	uint32_t playingCount_ = 0;
+	bool needsSort_ = false;
+};
@@ -1,4 +1,5 @@
 #include "TitleScene.h"
+#include "GameScene.h"
 
 using namespace KamataEngine;
 
@@ -7,17 +8,18 @@ constexpr float kFadeTimeSec = 1.0f;
 }
 
 TitleScene::~TitleScene() {
-	delete fade_;
-	fade_ = nullptr;
-	delete titleSprite_;
-	titleSprite_ = nullptr;
+	if (titleSprite_) {
+		delete titleSprite_;
+		titleSprite_ = nullptr;
+		AssetCache::GetInstance()->ReleaseTexture(textureHandle_);
+	}
 }
 
 void TitleScene::Initialize(bool returningFromGame) {
 	finished_ = false;
 
-	fade_ = new Fade();
-	fade_->Initialize();
+	fade_ = arena_.New<Fade>();
+	fade_->Initialize(&timeline_);
 
 	if (returningFromGame) {
 		// ★ゲームから戻った直後は黒→透明のフェードイン
@@ -28,16 +30,20 @@ void TitleScene::Initialize(bool returningFromGame) {
 		phase_ = Phase::kMain;
 	}
 
-	textureHandle_ = TextureManager::Load("scene/title.png");
+	textureHandle_ = AssetCache::GetInstance()->AcquireTexture("scene/title.png");
+
+	// タイトルを出している間にゲームのアセットを読んでおく
+	GameScene::PrefetchAssets();
 	// ★重要：sprite_->Create(...) ではなく Sprite::Create(...) で生成
 	titleSprite_ = Sprite::Create(textureHandle_, {0.0f, 0.0f});
 	titleSprite_->SetSize(Vector2(1280.0f, 720.0f));
 }
 
-void TitleScene::Update() {
+void TitleScene::Update(const InputState& input) {
+	timeline_.Update(1.0f / 60.0f);
+
 	switch (phase_) {
 	case Phase::kFadeIn:
-		fade_->Update();
 		if (fade_->IsFinished()) {
 			fade_->Stop(); // 描画コスト削減
 			phase_ = Phase::kMain;
@@ -45,17 +51,15 @@ void TitleScene::Update() {
 		break;
 
 	case Phase::kMain: {
-		auto* input = Input::GetInstance();
-		const bool pressedSpace = input->TriggerKey(DIK_SPACE) || input->PushKey(DIK_SPACE);
-		if (pressedSpace) {
+		if (input.IsHeld(Action::kDecide)) {
 			fade_->Start(Fade::Status::FadeOut, kFadeTimeSec);
 			phase_ = Phase::kFadeOut;
 		}
 	} break;
 
 	case Phase::kFadeOut:
-		fade_->Update();
-		if (fade_->IsFinished()) {
+		// 先読みが終わっていなければ黒のまま待つ（GameScene::Initialize で読み込ませない）
+		if (fade_->IsFinished() && AssetLoader::GetInstance()->IsAllReady()) {
 			// ★真っ黒になったので遷移OK
 			finished_ = true;
 			// 停止しない：このフレームは黒を保ったまま、次フレーム先頭でシーン切替
@@ -64,12 +68,10 @@ void TitleScene::Update() {
 	}
 }
 
-void TitleScene::Draw() {
-	Sprite::PreDraw(DirectXCommon::GetInstance()->GetCommandList());
-	titleSprite_->Draw();
-	Sprite::PostDraw();
+void TitleScene::Draw(RenderSnapshot& snapshot) {
+	snapshot.AddSprite(titleSprite_);
 	// タイトル本体の描画があればここに…
 	if (fade_) {
-		fade_->Draw();
+		fade_->Draw(snapshot);
 	}
 }
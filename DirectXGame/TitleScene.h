@@ -1,6 +1,12 @@
 #pragma once
+#include "AssetCache.h"
+#include "AssetLoader.h"
 #include "Fade.h"
+#include "InputState.h"
 #include "KamataEngine.h"
+#include "RenderSnapshot.h"
+#include "SceneArena.h"
+#include "Timeline.h"
 
 using namespace KamataEngine;
 
@@ -8,12 +14,15 @@ class TitleScene {
 public:
 	~TitleScene();
 	void Initialize(bool returningFromGame = false); // ★引数追加
-	void Update();
-	void Draw();
+	void Update(const InputState& input);
+	void Draw(RenderSnapshot& snapshot);
 
 	bool IsFinished() const { return finished_; }
 
 private:
+	// シーンのオブジェクトの置き場（フェードだけなので小さく）
+	SceneArena arena_{1024};
+
 	enum class Phase {
 		kFadeIn,  // ★ゲームから戻った直後の黒→透明
 		kMain,    // 入力待ち（透明）
@@ -23,6 +32,8 @@ private:
 
 	bool finished_ = false;
 	Fade* fade_ = nullptr;
+	// フェードのアニメーション
+	Timeline timeline_;
 
 	Sprite* titleSprite_ = nullptr;
 	uint32_t textureHandle_ = 0;
@@ -0,0 +1,199 @@
+#include "Trace.h"
+#include "AllocTracker.h"
+#include <cstdio>
+
+#ifdef TRACE_ENABLED
+
+namespace {
+
+// JSON の文字列の中身として足す
+void AppendEscaped(std::string& text, const char* value) {
+	for (const char* c = value; *c; ++c) {
+		if (*c == '"' || *c == '\\') {
+			text += '\\';
+			text += *c;
+		} else if (static_cast<unsigned char>(*c) < 0x20) {
+			char escaped[8];
+			std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(*c));
+			text += escaped;
+		} else {
+			text += *c;
+		}
+	}
+}
+
+} // namespace
+
+Tracer* Tracer::GetInstance() {
+	static Tracer instance;
+	return &instance;
+}
+
+Tracer::~Tracer() { Stop(); }
+
+Tracer::ThreadBuffer* Tracer::GetThreadBuffer() {
+	thread_local ThreadBuffer* buffer = nullptr;
+	if (!buffer) {
+		ALLOC_TAG_SCOPE(AllocTag::kProfiler);
+		std::lock_guard<std::mutex> lock(mutex_);
+		buffers_.push_back(std::make_unique<ThreadBuffer>());
+		buffer = buffers_.back().get();
+		buffer->id = static_cast<uint32_t>(buffers_.size());
+	}
+	return buffer;
+}
+
+void Tracer::Push(const char* name, uint64_t begin, uint64_t end) {
+	ThreadBuffer* buffer = GetThreadBuffer();
+	const uint64_t head = buffer->head.load(std::memory_order_relaxed);
+	Event& event = buffer->events[head % kRingCapacity];
+	event.name.store(name, std::memory_order_relaxed);
+	event.begin.store(begin, std::memory_order_relaxed);
+	event.end.store(end, std::memory_order_relaxed);
+	// 中身を書き終えてから数を進める（読む側は数を見てから中身を読む）
+	buffer->head.store(head + 1, std::memory_order_release);
+}
+
+void Tracer::Complete(const char* name, uint64_t begin, uint64_t end) {
+	if (!IsRunning()) {
+		return;
+	}
+	Push(name, begin, end);
+}
+
+void Tracer::Instant(const char* name) {
+	if (!IsRunning()) {
+		return;
+	}
+	Push(name, Profiler::Now(), kInstant);
+}
+
+void Tracer::SetThreadName(const char* name) { GetThreadBuffer()->name.store(name, std::memory_order_release); }
+
+bool Tracer::Start(const std::filesystem::path& path) {
+	if (IsRunning()) {
+		return false;
+	}
+	file_.open(path, std::ios::binary | std::ios::trunc);
+	if (!file_.is_open()) {
+		return false;
+	}
+	file_ << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	firstEvent_ = true;
+	stop_ = false;
+	dropped_.store(0, std::memory_order_relaxed);
+	startTime_ = Profiler::Now();
+	{
+		// 前の記録の残りは捨てる
+		std::lock_guard<std::mutex> lock(mutex_);
+		for (const std::unique_ptr<ThreadBuffer>& buffer : buffers_) {
+			buffer->tail = buffer->head.load(std::memory_order_acquire);
+			buffer->nameWritten = false;
+		}
+	}
+	running_.store(true, std::memory_order_relaxed);
+	writer_ = std::thread(&Tracer::WriterMain, this);
+	return true;
+}
+
+void Tracer::Stop() {
+	if (!IsRunning()) {
+		return;
+	}
+	running_.store(false, std::memory_order_relaxed);
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stop_ = true;
+	}
+	wake_.notify_one();
+	writer_.join();
+	file_ << "\n]}\n";
+	file_.close();
+}
+
+void Tracer::WriterMain() {
+	TRACE_THREAD_NAME("Trace writer");
+	ALLOC_TAG_SCOPE(AllocTag::kProfiler);
+	for (;;) {
+		bool stopping = false;
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			stopping = wake_.wait_for(lock, kFlushInterval, [this] { return stop_; });
+		}
+		// 止めるときも最後に 1 回書き出す
+		Flush();
+		if (stopping) {
+			break;
+		}
+	}
+}
+
+void Tracer::Flush() {
+	std::vector<ThreadBuffer*> buffers;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		buffers.reserve(buffers_.size());
+		for (const std::unique_ptr<ThreadBuffer>& buffer : buffers_) {
+			buffers.push_back(buffer.get());
+		}
+	}
+
+	text_.clear();
+	char number[96];
+	auto beginEvent = [this](const char* name) {
+		text_ += firstEvent_ ? "{\"name\":\"" : ",\n{\"name\":\"";
+		firstEvent_ = false;
+		AppendEscaped(text_, name);
+		text_ += '"';
+	};
+	for (ThreadBuffer* buffer : buffers) {
+		if (!buffer->nameWritten) {
+			if (const char* threadName = buffer->name.load(std::memory_order_acquire)) {
+				beginEvent("thread_name");
+				std::snprintf(number, sizeof(number), ",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"", buffer->id);
+				text_ += number;
+				AppendEscaped(text_, threadName);
+				text_ += "\"}}";
+				buffer->nameWritten = true;
+			}
+		}
+
+		const uint64_t head = buffer->head.load(std::memory_order_acquire);
+		if (head - buffer->tail > kRingCapacity) {
+			dropped_.fetch_add(head - buffer->tail - kRingCapacity, std::memory_order_relaxed);
+			buffer->tail = head - kRingCapacity;
+		}
+		for (; buffer->tail < head; ++buffer->tail) {
+			const Event& event = buffer->events[buffer->tail % kRingCapacity];
+			const char* name = event.name.load(std::memory_order_relaxed);
+			const uint64_t begin = event.begin.load(std::memory_order_relaxed);
+			const uint64_t end = event.end.load(std::memory_order_relaxed);
+			// 読んでいる間に書くほうが一周して同じ場所を上書きしていたら捨てる
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (buffer->head.load(std::memory_order_relaxed) - buffer->tail >= kRingCapacity) {
+				dropped_.fetch_add(1, std::memory_order_relaxed);
+				continue;
+			}
+			// 記録を始める前に始まった区間は載せない
+			if (begin < startTime_) {
+				continue;
+			}
+
+			// 時刻はμs（小数で ns まで）
+			const double ts = static_cast<double>(begin - startTime_) / 1e3;
+			beginEvent(name);
+			if (end == kInstant) {
+				std::snprintf(number, sizeof(number), ",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}", ts, buffer->id);
+			} else {
+				std::snprintf(number, sizeof(number), ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}", ts, static_cast<double>(end - begin) / 1e3, buffer->id);
+			}
+			text_ += number;
+		}
+	}
+	if (!text_.empty()) {
+		file_.write(text_.data(), static_cast<std::streamsize>(text_.size()));
+		file_.flush();
+	}
+}
+
+#endif
@@ -0,0 +1,127 @@
+#pragma once
+
+// _DEBUG のビルドだけ有効（ほかのビルドでも使うときは TRACE_ENABLED を定義する）
+#if !defined(TRACE_ENABLED) && defined(_DEBUG)
+#define TRACE_ENABLED
+#endif
+
+#ifdef TRACE_ENABLED
+#include "Profiler.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Chrome のトレース形式（chrome://tracing や ui.perfetto.dev で開ける JSON）での記録
+// TRACE_SCOPE を置いたスコープを 1 区間として、呼んだスレッドごとのリングバッファに積む（記録中でなければ時刻も取らない）。
+// PROFILE_SCOPE の区間も Profiler からここに回ってくる。
+// JSON にしてファイルに書くのはバックグラウンドのスレッドで、kFlushInterval ごとに全スレッドのリングバッファから取り出す。
+class Tracer {
+public:
+	// スレッドごとのリングバッファの大きさ（書き出しの間隔の間に積める数）
+	static inline const uint32_t kRingCapacity = 16384;
+	// 書き出しの間隔
+	static inline const std::chrono::milliseconds kFlushInterval{10};
+
+	static Tracer* GetInstance();
+
+	// path に記録を始める（すでに記録中か、開けなければ false）
+	bool Start(const std::filesystem::path& path);
+	// 残りを書き出してファイルを閉じる
+	void Stop();
+	bool IsRunning() const { return running_.load(std::memory_order_relaxed); }
+
+	// 区間を積む（時刻は Profiler::Now の ns。name は文字列リテラルなど、ずっと残るもの）
+	void Complete(const char* name, uint64_t begin, uint64_t end);
+	// 瞬間の出来事を積む
+	void Instant(const char* name);
+	// 呼んだスレッドの名前（ビューアの行の見出しになる）
+	void SetThreadName(const char* name);
+
+	// 記録を落とした数（書き出しが追いつかずリングバッファがあふれた）
+	uint64_t GetDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+	Tracer() = default;
+	// 記録中のまま終わったときも閉じる
+	~Tracer();
+	Tracer(const Tracer&) = delete;
+	Tracer& operator=(const Tracer&) = delete;
+
+	// 瞬間の出来事は end をこの値にする
+	static inline const uint64_t kInstant = ~uint64_t{0};
+
+	struct Event {
+		std::atomic<const char*> name{nullptr};
+		std::atomic<uint64_t> begin{0};
+		std::atomic<uint64_t> end{0};
+	};
+	// 1 スレッドぶん（書くのは持ち主のスレッド、読むのは書き出しのスレッド）
+	struct ThreadBuffer {
+		Event events[kRingCapacity];
+		std::atomic<uint64_t> head{0}; // 書いた数
+		uint64_t tail = 0;             // 読んだ数
+		uint32_t id = 0;
+		std::atomic<const char*> name{nullptr};
+		bool nameWritten = false;
+	};
+	ThreadBuffer* GetThreadBuffer();
+	void Push(const char* name, uint64_t begin, uint64_t end);
+
+	void WriterMain();
+	// 積まれた分を JSON にして file_ に書く
+	void Flush();
+
+	std::atomic<bool> running_{false};
+	std::atomic<uint64_t> dropped_{0};
+
+	// スレッドの登録だけはロックする（バッファはスレッドが終わっても最後まで残す）
+	std::mutex mutex_;
+	std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+
+	// 書き出し（Start と Stop の間は書き出しのスレッドだけが触る）
+	std::thread writer_;
+	std::condition_variable wake_;
+	bool stop_ = false;
+	std::ofstream file_;
+	std::string text_;
+	bool firstEvent_ = true;
+	uint64_t startTime_ = 0;
+};
+
+// スコープの開始から終了までを Tracer に積む
+class TraceScope {
+public:
+	explicit TraceScope(const char* name) : name_(name), begin_(Tracer::GetInstance()->IsRunning() ? Profiler::Now() : 0) {}
+	~TraceScope() {
+		if (begin_) {
+			Tracer::GetInstance()->Complete(name_, begin_, Profiler::Now());
+		}
+	}
+	TraceScope(const TraceScope&) = delete;
+	TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+	const char* name_;
+	uint64_t begin_;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope, __LINE__)(name)
+#define TRACE_INSTANT(name) Tracer::GetInstance()->Instant(name)
+#define TRACE_THREAD_NAME(name) Tracer::GetInstance()->SetThreadName(name)
+#define TRACE_COMPLETE(name, begin, end) Tracer::GetInstance()->Complete(name, begin, end)
+#else
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_INSTANT(name) ((void)0)
+#define TRACE_THREAD_NAME(name) ((void)0)
+#define TRACE_COMPLETE(name, begin, end) ((void)0)
+#endif
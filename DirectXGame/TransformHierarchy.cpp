@@ -0,0 +1,184 @@
+#include "TransformHierarchy.h"
+#include "Method.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <assert.h>
+#include <numeric>
+
+using namespace KamataEngine;
+
+void TransformHierarchy::Reserve(uint32_t capacity) {
+	indices_.reserve(capacity);
+	handles_.reserve(capacity);
+	parents_.reserve(capacity);
+	scale_.reserve(capacity);
+	rotation_.reserve(capacity);
+	translation_.reserve(capacity);
+	world_.reserve(capacity);
+	targets_.reserve(capacity);
+	dirty_.reserve(capacity);
+}
+
+void TransformHierarchy::Clear() {
+	indices_.clear();
+	handles_.clear();
+	parents_.clear();
+	scale_.clear();
+	rotation_.clear();
+	translation_.clear();
+	world_.clear();
+	targets_.clear();
+	dirty_.clear();
+	anyDirty_ = false;
+	needsSort_ = false;
+}
+
+TransformHierarchy::Handle TransformHierarchy::Add(WorldTransform* target, Handle parent) {
+	assert(target);
+	return Push(target->scale_, target->rotation_, target->translation_, target, parent);
+}
+
+TransformHierarchy::Handle TransformHierarchy::Add(const Vector3& scale, const Vector3& rotation, const Vector3& translation, Handle parent) {
+	return Push(scale, rotation, translation, nullptr, parent);
+}
+
+TransformHierarchy::Handle TransformHierarchy::Push(const Vector3& scale, const Vector3& rotation, const Vector3& translation, WorldTransform* target, Handle parent) {
+	// 親は登録済みなので、末尾に足せば親より後ろになる
+	const Handle handle = static_cast<Handle>(indices_.size());
+	const uint32_t index = static_cast<uint32_t>(handles_.size());
+	indices_.push_back(index);
+	handles_.push_back(handle);
+	parents_.push_back(parent == kNone ? kNone : indices_[parent]);
+	scale_.push_back(scale);
+	rotation_.push_back(rotation);
+	translation_.push_back(translation);
+	world_.push_back(MakeIdentityMatrix());
+	targets_.push_back(target);
+	dirty_.push_back(0);
+	MarkDirty(index);
+	return handle;
+}
+
+void TransformHierarchy::SetParent(Handle handle, Handle parent) {
+	const uint32_t index = indices_[handle];
+	const uint32_t parentIndex = parent == kNone ? kNone : indices_[parent];
+#ifdef _DEBUG
+	// 自分の子孫を親にはできない
+	for (uint32_t p = parentIndex; p != kNone; p = parents_[p]) {
+		assert(p != index);
+	}
+#endif
+	parents_[index] = parentIndex;
+	if (parentIndex != kNone && parentIndex > index) {
+		needsSort_ = true;
+	}
+	MarkDirty(index);
+}
+
+void TransformHierarchy::SetScale(Handle handle, const Vector3& scale) {
+	const uint32_t index = indices_[handle];
+	scale_[index] = scale;
+	MarkDirty(index);
+}
+
+void TransformHierarchy::SetRotation(Handle handle, const Vector3& rotation) {
+	const uint32_t index = indices_[handle];
+	rotation_[index] = rotation;
+	MarkDirty(index);
+}
+
+void TransformHierarchy::SetTranslation(Handle handle, const Vector3& translation) {
+	const uint32_t index = indices_[handle];
+	translation_[index] = translation;
+	MarkDirty(index);
+}
+
+Vector3 TransformHierarchy::GetWorldPosition(Handle handle) const {
+	const Matrix4x4& m = world_[indices_[handle]];
+	return {m.m[3][0], m.m[3][1], m.m[3][2]};
+}
+
+void TransformHierarchy::MarkDirty(uint32_t index) {
+	dirty_[index] = 1;
+	anyDirty_ = true;
+}
+
+uint32_t TransformHierarchy::Update() {
+	if (!anyDirty_) {
+		return 0;
+	}
+	PROFILE_SCOPE("TransformHierarchy");
+	if (needsSort_) {
+		Sort();
+	}
+
+	// 親は前にあるので、親の印はこの時点で確定している（親が作り直されたら子も作り直す）
+	uint32_t updated = 0;
+	const uint32_t count = GetCount();
+	for (uint32_t i = 0; i < count; ++i) {
+		const uint32_t parent = parents_[i];
+		if (parent != kNone && dirty_[parent]) {
+			dirty_[i] = 1;
+		}
+		if (!dirty_[i]) {
+			continue;
+		}
+		const Matrix4x4 local = MakeAffineMatrix(scale_[i], rotation_[i], translation_[i]);
+		world_[i] = parent == kNone ? local : local * world_[parent];
+		if (WorldTransform* target = targets_[i]) {
+			target->matWorld_ = world_[i];
+		}
+		++updated;
+	}
+	std::fill(dirty_.begin(), dirty_.end(), uint8_t(0));
+	anyDirty_ = false;
+	return updated;
+}
+
+void TransformHierarchy::Sort() {
+	const uint32_t count = GetCount();
+
+	// 根からの深さ
+	std::vector<uint32_t> depths(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		uint32_t depth = 0;
+		for (uint32_t p = parents_[i]; p != kNone; p = parents_[p]) {
+			++depth;
+		}
+		depths[i] = depth;
+	}
+	std::vector<uint32_t> order(count);
+	std::iota(order.begin(), order.end(), 0u);
+	std::stable_sort(order.begin(), order.end(), [&depths](uint32_t a, uint32_t b) { return depths[a] < depths[b]; });
+
+	// 古い位置 → 新しい位置
+	std::vector<uint32_t> moved(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		moved[order[i]] = i;
+	}
+	auto reorder = [&order](auto& values) {
+		std::remove_reference_t<decltype(values)> sorted;
+		sorted.reserve(values.size());
+		for (uint32_t from : order) {
+			sorted.push_back(values[from]);
+		}
+		values.swap(sorted);
+	};
+	reorder(handles_);
+	reorder(parents_);
+	reorder(scale_);
+	reorder(rotation_);
+	reorder(translation_);
+	reorder(world_);
+	reorder(targets_);
+	reorder(dirty_);
+	for (uint32_t& parent : parents_) {
+		if (parent != kNone) {
+			parent = moved[parent];
+		}
+	}
+	for (uint32_t i = 0; i < count; ++i) {
+		indices_[handles_[i]] = i;
+	}
+	needsSort_ = false;
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include "KamataEngine.h"
+#include <cstdint>
+#include <vector>
+
+using namespace KamataEngine;
+
+// 親子関係のある変換をまとめて更新する
+// ローカルのスケール・回転・平行移動を成分ごとの配列（SoA）で持ち、親が必ず子より前に来るよう並べておく。
+// 値を変えたものに印を付けておき、Update で前から 1 回なめて、印のあるものとその子孫だけワールド行列を作り直す。
+// 何も変わっていないフレームは何もしないので、動かない物体（ブロックなど）はいくつ登録しても負担にならない。
+// 武器やエフェクトの取り付け位置は、WorldTransform なしの子として足せば親の行列が変わったときだけ計算される。
+class TransformHierarchy {
+public:
+	// 登録したものを指す番号（並べ替えても変わらない）
+	using Handle = uint32_t;
+	static inline const Handle kNone = ~0u;
+
+	void Reserve(uint32_t capacity);
+	void Clear();
+
+	// target の今のスケール・回転・平行移動で登録する。Update で target の matWorld_ に行列を書く
+	Handle Add(WorldTransform* target, Handle parent = kNone);
+	// 行列だけを持つ節（取り付け位置など）を登録する
+	Handle Add(const Vector3& scale, const Vector3& rotation, const Vector3& translation, Handle parent = kNone);
+
+	// 親を付け替える（親が後ろにあれば次の Update の前に並べ直す）
+	void SetParent(Handle handle, Handle parent);
+
+	void SetScale(Handle handle, const Vector3& scale);
+	void SetRotation(Handle handle, const Vector3& rotation);
+	void SetTranslation(Handle handle, const Vector3& translation);
+	const Vector3& GetScale(Handle handle) const { return scale_[indices_[handle]]; }
+	const Vector3& GetRotation(Handle handle) const { return rotation_[indices_[handle]]; }
+	const Vector3& GetTranslation(Handle handle) const { return translation_[indices_[handle]]; }
+
+	// 前回の Update で求めたワールド行列
+	const Matrix4x4& GetWorldMatrix(Handle handle) const { return world_[indices_[handle]]; }
+	Vector3 GetWorldPosition(Handle handle) const;
+
+	// 変わったものと、その子孫のワールド行列を作り直す。作り直した数を返す
+	uint32_t Update();
+
+	uint32_t GetCount() const { return static_cast<uint32_t>(handles_.size()); }
+
+private:
+	Handle Push(const Vector3& scale, const Vector3& rotation, const Vector3& translation, WorldTransform* target, Handle parent);
+	void MarkDirty(uint32_t index);
+	// 親が子より前に来るよう、深さの順に並べ直す（同じ深さの中では今の順を保つ）
+	void Sort();
+
+	// 番号 → 並びの位置と、その逆
+	std::vector<uint32_t> indices_;
+	std::vector<Handle> handles_;
+
+	// 以下は並びの位置ごと
+	std::vector<uint32_t> parents_; // 親の位置（なければ kNone）
+	std::vector<Vector3> scale_;
+	std::vector<Vector3> rotation_;
+	std::vector<Vector3> translation_;
+	std::vector<Matrix4x4> world_;
+	std::vector<WorldTransform*> targets_;
+	std::vector<uint8_t> dirty_;
+
+	// 印が 1 つでもあるか（なければ Update はすぐ返る）
+	bool anyDirty_ = false;
+	bool needsSort_ = false;
+};
@@ -1,10 +1,19 @@
 #include "TransformWorld.h"
+#include "FastMath.h"
 
 using namespace KamataEngine;
 
 void WorldTransformUpdate(KamataEngine::WorldTransform& worldTransform) {
-	// スケール、回転、平行移動を合成して行列を計算する
+	// スケール、回転、平行移動を合成して行列を計算する（親があれば親の行列を掛ける。親は先に更新しておく）
 	worldTransform.matWorld_ = MakeAffineMatrix(worldTransform.scale_, worldTransform.rotation_, worldTransform.translation_);
-	// 定数バッファへの書き込み
-	worldTransform.TransferMatrix();
+	if (worldTransform.parent_) {
+		worldTransform.matWorld_ = worldTransform.matWorld_ * worldTransform.parent_->matWorld_;
+	}
+}
+
+void WorldTransformUpdateFast(KamataEngine::WorldTransform& worldTransform) {
+	worldTransform.matWorld_ = MakeAffineMatrixFast(worldTransform.scale_, worldTransform.rotation_, worldTransform.translation_);
+	if (worldTransform.parent_) {
+		worldTransform.matWorld_ = worldTransform.matWorld_ * worldTransform.parent_->matWorld_;
+	}
 }
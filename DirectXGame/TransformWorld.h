@@ -4,6 +4,10 @@
 
 using namespace KamataEngine;
 
+// 1 つだけ matWorld_ を作り直す（parent_ があれば掛ける）。まとめて親子で扱うものは TransformHierarchy を使う
+// 定数バッファには書かない（描くときに RenderSnapshot が ConstBufferRing に写す）
 void WorldTransformUpdate(KamataEngine::WorldTransform& worldTransform);
+// 回転の sin/cos に近似（FastSinCos）を使う版。見た目だけの物体向け
+void WorldTransformUpdateFast(KamataEngine::WorldTransform& worldTransform);
 
 class TransformWorld {};
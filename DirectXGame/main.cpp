@@ -1,5 +1,15 @@
+#include "AssetCache.h"
+#include "AssetLoader.h"
+#include "CachedModel.h"
+#include "ConstBufferRing.h"
 #include "GameScene.h"
+#include "InputMapper.h"
+#include "InputSampler.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "RenderThread.h"
 #include "TitleScene.h"
+#include "Trace.h"
 #include "ResultScene.h"
 #include <KamataEngine.h>
 #include <Windows.h>
@@ -14,12 +24,44 @@ enum class Scene { kUnknown = 0, kTitle, kGame, kResult };
 Scene scene = Scene::kUnknown;
 
 void ChangeScene();
-void UpdateScene();
-void DrawScene();
+void UpdateScene(const InputState& input);
+void DrawScene(RenderSnapshot& snapshot);
 
 int WINAPI WinMain(_In_ HINSTANCE, _In_opt_ HINSTANCE, _In_ LPSTR, _In_ int) {
 	KamataEngine::Initialize(L"LE2B_10_コバヤシ_ハヤト_棘走");
-	DirectXCommon* dxCommon = DirectXCommon::GetInstance();
+
+	// フレーム単位の定数バッファリング
+	ConstBufferRing* constBufferRing = ConstBufferRing::GetInstance();
+	constBufferRing->Initialize();
+
+	// .mesh のモデル用のパイプライン（圧縮した頂点を読むもの）
+	CachedModel::StaticInitialize();
+
+	// 描画スレッド（フレーム N を描いている間にフレーム N+1 を更新する）
+	RenderThread* renderThread = RenderThread::GetInstance();
+	renderThread->Initialize();
+
+	// アセットの先読み（読み込みと変換はワーカースレッド）
+	AssetLoader* assetLoader = AssetLoader::GetInstance();
+	assetLoader->Initialize();
+
+	// フレーム内の並列処理（ワーカーは論理コア数 - 1）
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	jobSystem->Initialize();
+
+	// キー・パッドと操作の対応（ゲームのコードは Input を直接読まない）
+	InputMapper* inputMapper = InputMapper::GetInstance();
+	// 入力は専用のスレッドで 1ms ごとに読み、ティックの開始時刻までのものを取り出す
+	// （F6 で押してからシミュレーションが受け取るまで・描画スレッドに渡すまでの遅れを Profiler に積む。F3 の表示と F4 の CSV に出る）
+	InputSampler* inputSampler = InputSampler::GetInstance();
+	inputSampler->Initialize();
+
+	// フレームの CPU 時間の計測（F3 で表示の切り替え、F4 で直近のフレームを CSV に書き出す）
+	Profiler* profiler = Profiler::GetInstance();
+	Input* input = Input::GetInstance();
+	bool showProfiler = true;
+	// トレースの記録（F5 で開始と終了。_DEBUG のビルドだけ）
+	TRACE_THREAD_NAME("Main");
 
 	scene = Scene::kTitle;
 	titleScene = new TitleScene;
@@ -30,29 +72,80 @@ int WINAPI WinMain(_In_ HINSTANCE, _In_opt_ HINSTANCE, _In_ LPSTR, _In_ int) {
 			break;
 		}
 
-		dxCommon->PreDraw();
-		KamataEngine::Model::PreDraw(dxCommon->GetCommandList());
+		// 先読みが済んだアセットを少しずつキャッシュに登録
+		// 生成は描画スレッドが前のフレームを描き終えてから行う（TextureManager の転送やデスクリプタの確保は描画と重ねられない）
+		// 待つのは生成するものがあるフレームだけ
+		if (assetLoader->HasPrepared()) {
+			renderThread->WaitIdle();
+			assetLoader->Update();
+		}
 
 		ChangeScene();
-		UpdateScene();
-		DrawScene();
+		// 入力はここで 1 回だけ読み、シーンには InputState だけを渡す
+		UpdateScene(inputMapper->Sample());
+		DrawScene(renderThread->GetSnapshot());
 
-		KamataEngine::Model::PostDraw();
-		dxCommon->PostDraw();
+		if (input->TriggerKey(DIK_F3)) {
+			showProfiler = !showProfiler;
+		}
+		if (input->TriggerKey(DIK_F4)) {
+			profiler->DumpCsv("profile_" + std::to_string(profiler->GetFrameCount()) + ".csv");
+		}
+		if (input->TriggerKey(DIK_F6)) {
+			inputSampler->SetMeasureLatency(!inputSampler->IsMeasuringLatency());
+		}
+		if (showProfiler) {
+			profiler->DrawOverlay();
+		}
+#ifdef TRACE_ENABLED
+		if (input->TriggerKey(DIK_F5)) {
+			Tracer* tracer = Tracer::GetInstance();
+			if (tracer->IsRunning()) {
+				tracer->Stop();
+			} else {
+				tracer->Start("trace_" + std::to_string(profiler->GetFrameCount()) + ".json");
+			}
+		}
+#endif
+
+		// 描く内容を描画スレッドに渡して、すぐ次のフレームの更新に進む
+		renderThread->Submit();
+		if (inputSampler->IsMeasuringLatency() && inputMapper->GetPressTime() != 0) {
+			profiler->Record("Input->Submit", inputMapper->GetPressTime(), Profiler::Now());
+		}
+		profiler->EndFrame();
 	}
+	// シーンのモデル・スプライトを破棄する前に描き終える
+	renderThread->Finalize();
+	inputSampler->Finalize();
 	delete titleScene;
 	delete gameScene;
 	delete resultScene;
+	jobSystem->Finalize();
+#ifdef TRACE_ENABLED
+	Tracer::GetInstance()->Stop();
+#endif
+
+	// キャッシュしていたモデル・テクスチャを破棄
+	assetLoader->Finalize();
+	AssetCache::GetInstance()->Clear();
+	CachedModel::StaticFinalize();
+	constBufferRing->Finalize();
 
 	KamataEngine::Finalize();
 	return 0;
 }
 
 void ChangeScene() {
+	PROFILE_SCOPE("ChangeScene");
 	switch (scene) {
 	case Scene::kTitle:
 		if (titleScene && titleScene->IsFinished()) {
+			TRACE_INSTANT("Title -> Game");
+			TRACE_SCOPE("GameScene::Initialize");
 			scene = Scene::kGame;
+			// 描画スレッドがまだタイトルのスプライトを描いているかもしれない
+			RenderThread::GetInstance()->WaitIdle();
 			delete titleScene;
 			titleScene = nullptr;
 			gameScene = new GameScene;
@@ -62,8 +155,11 @@ void ChangeScene() {
 
 	case Scene::kGame:
 		if (gameScene && gameScene->IsFinished()) {
+			TRACE_INSTANT("Game -> Result");
+			TRACE_SCOPE("ResultScene::Initialize");
 			// ★GameSceneの結果でResultSceneへ
 			auto res = gameScene->GetResult(); // ← 追加したゲッター
+			RenderThread::GetInstance()->WaitIdle();
 			delete gameScene;
 			gameScene = nullptr;
 
@@ -81,7 +177,10 @@ void ChangeScene() {
 
 	case Scene::kResult:
 		if (resultScene && resultScene->IsFinished()) {
+			TRACE_INSTANT("Result -> Title");
+			TRACE_SCOPE("TitleScene::Initialize");
 			scene = Scene::kTitle;
+			RenderThread::GetInstance()->WaitIdle();
 			delete resultScene;
 			resultScene = nullptr;
 
@@ -95,38 +194,40 @@ void ChangeScene() {
 	}
 }
 
-void UpdateScene() {
+void UpdateScene(const InputState& input) {
+	PROFILE_SCOPE("UpdateScene");
 	switch (scene) {
 	case Scene::kTitle:
 		if (titleScene)
-			titleScene->Update();
+			titleScene->Update(input);
 		break;
 	case Scene::kGame:
 		if (gameScene)
-			gameScene->Update();
+			gameScene->Update(input);
 		break;
 	case Scene::kResult:
 		if (resultScene)
-			resultScene->Update();
+			resultScene->Update(input);
 		break;
 	default:
 		break;
 	}
 }
 
-void DrawScene() {
+void DrawScene(RenderSnapshot& snapshot) {
+	PROFILE_SCOPE("DrawScene");
 	switch (scene) {
 	case Scene::kTitle:
 		if (titleScene)
-			titleScene->Draw();
+			titleScene->Draw(snapshot);
 		break;
 	case Scene::kGame:
 		if (gameScene)
-			gameScene->Draw();
+			gameScene->Draw(snapshot);
 		break;
 	case Scene::kResult:
 		if (resultScene)
-			resultScene->Draw();
+			resultScene->Draw(snapshot);
 		break;
 	default:
 		break;
@@ -0,0 +1,370 @@
+#include "MeshReport.h"
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+bool MeshReport::ReferenceImport(const std::filesystem::path& objPath, bool smoothing, MeshData& out) {
+	out.Clear();
+	std::ifstream file(objPath);
+	if (!file.is_open()) {
+		return false;
+	}
+
+	struct Float3 {
+		float x, y, z;
+	};
+	std::vector<Float3> positions;
+	std::vector<Float3> normals;
+	std::vector<std::pair<float, float>> texcoords;
+	std::unordered_map<uint32_t, std::vector<uint32_t>> smoothData;
+
+	SubMesh subMesh;
+	auto flush = [&]() {
+		if (smoothing) {
+			for (auto& [position, list] : smoothData) {
+				float normal[3] = {};
+				for (uint32_t index : list) {
+					for (int k = 0; k < 3; ++k) {
+						normal[k] += out.vertices[index].normal[k];
+					}
+				}
+				for (int k = 0; k < 3; ++k) {
+					normal[k] /= static_cast<float>(list.size());
+				}
+				const float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+				for (uint32_t index : list) {
+					for (int k = 0; k < 3; ++k) {
+						out.vertices[index].normal[k] = length != 0.0f ? normal[k] / length : normal[k];
+					}
+				}
+			}
+			smoothData.clear();
+		}
+		subMesh.vertexCount = static_cast<uint32_t>(out.vertices.size()) - subMesh.vertexOffset;
+		subMesh.indexCount = static_cast<uint32_t>(out.indices.size()) - subMesh.indexOffset;
+		if (subMesh.vertexCount > 0) {
+			out.subMeshes.push_back(subMesh);
+		}
+		subMesh = SubMesh{};
+		subMesh.vertexOffset = static_cast<uint32_t>(out.vertices.size());
+		subMesh.indexOffset = static_cast<uint32_t>(out.indices.size());
+	};
+
+	std::string line;
+	while (std::getline(file, line)) {
+		std::istringstream lineStream(line);
+		std::string key;
+		std::getline(lineStream, key, ' ');
+		if (key == "v") {
+			Float3 position{};
+			lineStream >> position.x >> position.y >> position.z;
+			positions.push_back(position);
+		} else if (key == "vt") {
+			float u = 0.0f, v = 0.0f;
+			lineStream >> u >> v;
+			texcoords.emplace_back(u, 1.0f - v);
+		} else if (key == "vn") {
+			Float3 normal{};
+			lineStream >> normal.x >> normal.y >> normal.z;
+			normals.push_back(normal);
+		} else if (key == "g") {
+			if (!subMesh.name.empty() && out.vertices.size() > subMesh.vertexOffset) {
+				flush();
+			}
+			lineStream >> subMesh.name;
+		} else if (key == "f") {
+			// 比較しやすいよう三角形の分割は ObjImporter と同じ扇形にする
+			std::vector<uint32_t> face;
+			std::string corner;
+			while (std::getline(lineStream, corner, ' ')) {
+				if (corner.empty()) {
+					continue;
+				}
+				std::istringstream cornerStream(corner);
+				uint32_t positionIndex = 0, texcoordIndex = 0, normalIndex = 0;
+				cornerStream >> positionIndex;
+				cornerStream.seekg(1, std::ios_base::cur);
+				cornerStream >> texcoordIndex;
+				cornerStream.seekg(1, std::ios_base::cur);
+				cornerStream >> normalIndex;
+
+				MeshVertex vertex{};
+				std::memcpy(vertex.pos, &positions[positionIndex - 1], sizeof(vertex.pos));
+				std::memcpy(vertex.normal, &normals[normalIndex - 1], sizeof(vertex.normal));
+				vertex.uv[0] = texcoords[texcoordIndex - 1].first;
+				vertex.uv[1] = texcoords[texcoordIndex - 1].second;
+				const uint32_t local = static_cast<uint32_t>(out.vertices.size()) - subMesh.vertexOffset;
+				out.vertices.push_back(vertex);
+				if (smoothing) {
+					smoothData[positionIndex].push_back(static_cast<uint32_t>(out.vertices.size() - 1));
+				}
+				face.push_back(local);
+			}
+			for (size_t i = 2; i < face.size(); ++i) {
+				out.indices.push_back(face[0]);
+				out.indices.push_back(face[i - 1]);
+				out.indices.push_back(face[i]);
+			}
+		}
+	}
+	flush();
+	return true;
+}
+
+float MeshReport::CompareTriangles(const MeshData& a, const MeshData& b) {
+	if (a.subMeshes.size() != b.subMeshes.size()) {
+		return INFINITY;
+	}
+	float maxDiff = 0.0f;
+	for (size_t s = 0; s < a.subMeshes.size(); ++s) {
+		const SubMesh& subA = a.subMeshes[s];
+		const SubMesh& subB = b.subMeshes[s];
+		if (subA.indexCount != subB.indexCount) {
+			return INFINITY;
+		}
+		for (uint32_t i = 0; i < subA.indexCount; ++i) {
+			const float* vertexA = &a.vertices[subA.vertexOffset + a.indices[subA.indexOffset + i]].pos[0];
+			const float* vertexB = &b.vertices[subB.vertexOffset + b.indices[subB.indexOffset + i]].pos[0];
+			for (int k = 0; k < 8; ++k) {
+				maxDiff = std::max(maxDiff, std::fabs(vertexA[k] - vertexB[k]));
+			}
+		}
+	}
+	return maxDiff;
+}
+
+bool MeshReport::SameTriangleSet(const MeshData& a, const MeshData& b) {
+	if (a.subMeshes.size() != b.subMeshes.size()) {
+		return false;
+	}
+	// 三角形を頂点3つぶんのバイト列にし、巻き順を保ったまま一番小さい頂点が先頭に来るよう回してから並べて比べる
+	using Triangle = std::array<MeshVertex, 3>;
+	auto collect = [](const MeshData& mesh, const SubMesh& subMesh) {
+		std::vector<Triangle> triangles(subMesh.indexCount / 3);
+		for (size_t t = 0; t < triangles.size(); ++t) {
+			Triangle& triangle = triangles[t];
+			for (int k = 0; k < 3; ++k) {
+				triangle[k] = mesh.vertices[subMesh.vertexOffset + mesh.indices[subMesh.indexOffset + t * 3 + k]];
+			}
+			int first = 0;
+			for (int k = 1; k < 3; ++k) {
+				if (std::memcmp(&triangle[k], &triangle[first], sizeof(MeshVertex)) < 0) {
+					first = k;
+				}
+			}
+			std::rotate(triangle.begin(), triangle.begin() + first, triangle.end());
+		}
+		std::sort(triangles.begin(), triangles.end(), [](const Triangle& l, const Triangle& r) { return std::memcmp(&l, &r, sizeof(Triangle)) < 0; });
+		return triangles;
+	};
+	for (size_t s = 0; s < a.subMeshes.size(); ++s) {
+		const std::vector<Triangle> left = collect(a, a.subMeshes[s]);
+		const std::vector<Triangle> right = collect(b, b.subMeshes[s]);
+		if (left.size() != right.size() || (!left.empty() && std::memcmp(left.data(), right.data(), left.size() * sizeof(Triangle)) != 0)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+float MeshReport::ComputeACMR(const MeshData& mesh) {
+	double misses = 0.0;
+	size_t triangles = 0;
+	for (const SubMesh& subMesh : mesh.subMeshes) {
+		const float acmr = MeshOptimizer::ComputeACMR(mesh.indices.data() + subMesh.indexOffset, subMesh.indexCount, subMesh.vertexCount);
+		misses += static_cast<double>(acmr) * (subMesh.indexCount / 3);
+		triangles += subMesh.indexCount / 3;
+	}
+	return triangles > 0 ? static_cast<float>(misses / static_cast<double>(triangles)) : 0.0f;
+}
+
+float MeshReport::MeasureOverdraw(const MeshData& mesh, int resolution) {
+	if (mesh.vertices.empty()) {
+		return 0.0f;
+	}
+	float boundsMin[3] = {INFINITY, INFINITY, INFINITY};
+	float boundsMax[3] = {-INFINITY, -INFINITY, -INFINITY};
+	for (const MeshVertex& vertex : mesh.vertices) {
+		for (int k = 0; k < 3; ++k) {
+			boundsMin[k] = std::min(boundsMin[k], vertex.pos[k]);
+			boundsMax[k] = std::max(boundsMax[k], vertex.pos[k]);
+		}
+	}
+	const float extent = std::max({boundsMax[0] - boundsMin[0], boundsMax[1] - boundsMin[1], boundsMax[2] - boundsMin[2], 1e-6f});
+	const float scale = static_cast<float>(resolution - 1) / extent;
+
+	// 巻き順の向きを頂点法線と比べて決める（obj の巻き順の流儀によらず表を判定するため）
+	auto faceNormal = [](const float* a, const float* b, const float* c, float* n) {
+		const float ab[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+		const float ac[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+		n[0] = ab[1] * ac[2] - ab[2] * ac[1];
+		n[1] = ab[2] * ac[0] - ab[0] * ac[2];
+		n[2] = ab[0] * ac[1] - ab[1] * ac[0];
+	};
+	double agreement = 0.0;
+	for (const SubMesh& subMesh : mesh.subMeshes) {
+		for (uint32_t i = 0; i + 2 < subMesh.indexCount; i += 3) {
+			const MeshVertex* v[3];
+			for (int k = 0; k < 3; ++k) {
+				v[k] = &mesh.vertices[subMesh.vertexOffset + mesh.indices[subMesh.indexOffset + i + k]];
+			}
+			float n[3];
+			faceNormal(v[0]->pos, v[1]->pos, v[2]->pos, n);
+			for (int k = 0; k < 3; ++k) {
+				agreement += n[k] * (v[0]->normal[k] + v[1]->normal[k] + v[2]->normal[k]);
+			}
+		}
+	}
+	const float orientation = agreement >= 0.0 ? 1.0f : -1.0f;
+
+	std::vector<float> depth(static_cast<size_t>(resolution) * resolution);
+	uint64_t shaded = 0;
+	uint64_t covered = 0;
+	for (int view = 0; view < 6; ++view) {
+		// view / 2 の軸に沿って、偶数ならプラス向き・奇数ならマイナス向きに見る
+		const int axis = view / 2;
+		const float direction = (view % 2 == 0) ? 1.0f : -1.0f;
+		const int axisU = (axis + 1) % 3;
+		const int axisV = (axis + 2) % 3;
+		std::fill(depth.begin(), depth.end(), std::numeric_limits<float>::infinity());
+
+		for (const SubMesh& subMesh : mesh.subMeshes) {
+			for (uint32_t i = 0; i + 2 < subMesh.indexCount; i += 3) {
+				const MeshVertex* v[3];
+				for (int k = 0; k < 3; ++k) {
+					v[k] = &mesh.vertices[subMesh.vertexOffset + mesh.indices[subMesh.indexOffset + i + k]];
+				}
+				float n[3];
+				faceNormal(v[0]->pos, v[1]->pos, v[2]->pos, n);
+				// 視線と同じ向きの面は裏
+				if (n[axis] * orientation * direction >= 0.0f) {
+					continue;
+				}
+
+				float x[3], y[3], z[3];
+				for (int k = 0; k < 3; ++k) {
+					x[k] = (v[k]->pos[axisU] - boundsMin[axisU]) * scale;
+					y[k] = (v[k]->pos[axisV] - boundsMin[axisV]) * scale;
+					z[k] = v[k]->pos[axis] * direction;
+				}
+				const float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+				if (area == 0.0f) {
+					continue;
+				}
+				const int minX = std::max(0, static_cast<int>(std::floor(std::min({x[0], x[1], x[2]}))));
+				const int maxX = std::min(resolution - 1, static_cast<int>(std::ceil(std::max({x[0], x[1], x[2]}))));
+				const int minY = std::max(0, static_cast<int>(std::floor(std::min({y[0], y[1], y[2]}))));
+				const int maxY = std::min(resolution - 1, static_cast<int>(std::ceil(std::max({y[0], y[1], y[2]}))));
+				for (int py = minY; py <= maxY; ++py) {
+					for (int px = minX; px <= maxX; ++px) {
+						// ピクセル中心での重心座標
+						const float sx = static_cast<float>(px) + 0.5f;
+						const float sy = static_cast<float>(py) + 0.5f;
+						const float w0 = ((x[1] - sx) * (y[2] - sy) - (x[2] - sx) * (y[1] - sy)) / area;
+						const float w1 = ((x[2] - sx) * (y[0] - sy) - (x[0] - sx) * (y[2] - sy)) / area;
+						const float w2 = 1.0f - w0 - w1;
+						if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f) {
+							continue;
+						}
+						const float z0 = w0 * z[0] + w1 * z[1] + w2 * z[2];
+						float& stored = depth[static_cast<size_t>(py) * resolution + px];
+						if (z0 < stored) {
+							stored = z0;
+							++shaded;
+						}
+					}
+				}
+			}
+		}
+		for (float value : depth) {
+			covered += value != std::numeric_limits<float>::infinity() ? 1 : 0;
+		}
+	}
+	return covered > 0 ? static_cast<float>(static_cast<double>(shaded) / static_cast<double>(covered)) : 0.0f;
+}
+
+MeshReport::QuantizationError MeshReport::MeasureQuantizationError(const MeshData& original, const MeshData& decoded) {
+	QuantizationError error;
+	if (original.vertices.empty() || original.vertices.size() != decoded.vertices.size()) {
+		return error;
+	}
+	float minimum[3] = {INFINITY, INFINITY, INFINITY};
+	float maximum[3] = {-INFINITY, -INFINITY, -INFINITY};
+	double maxCos = 1.0;
+	for (size_t i = 0; i < original.vertices.size(); ++i) {
+		const MeshVertex& a = original.vertices[i];
+		const MeshVertex& b = decoded.vertices[i];
+		double dot = 0.0;
+		double lengthA = 0.0;
+		for (int k = 0; k < 3; ++k) {
+			minimum[k] = std::min(minimum[k], a.pos[k]);
+			maximum[k] = std::max(maximum[k], a.pos[k]);
+			error.position = std::max(error.position, std::fabs(a.pos[k] - b.pos[k]));
+			dot += static_cast<double>(a.normal[k]) * b.normal[k];
+			lengthA += static_cast<double>(a.normal[k]) * a.normal[k];
+		}
+		for (int k = 0; k < 2; ++k) {
+			error.uv = std::max(error.uv, std::fabs(a.uv[k] - b.uv[k]));
+		}
+		// 戻した法線は長さ 1 なので、元の長さで割れば cos になる（長さ 0 の法線は比べない）
+		if (lengthA > 0.0) {
+			maxCos = std::min(maxCos, dot / std::sqrt(lengthA));
+		}
+	}
+	const float extent = std::max({maximum[0] - minimum[0], maximum[1] - minimum[1], maximum[2] - minimum[2]});
+	error.positionRelative = extent > 0.0f ? error.position / extent : 0.0f;
+	error.normalDegrees = static_cast<float>(std::acos(std::clamp(maxCos, -1.0, 1.0)) * 180.0 / 3.14159265358979323846);
+	return error;
+}
+
+size_t MeshReport::CountTriangles(const MeshData& mesh, size_t level) {
+	size_t triangles = 0;
+	for (size_t s = 0; s < mesh.subMeshes.size(); ++s) {
+		triangles += (level == 0 ? mesh.subMeshes[s].indexCount : mesh.lods[level - 1].ranges[s].indexCount) / 3;
+	}
+	return triangles;
+}
+
+bool MeshReport::ValidLods(const MeshData& mesh) {
+	for (size_t level = 1; level <= mesh.lods.size(); ++level) {
+		const MeshLod& lod = mesh.lods[level - 1];
+		if (lod.ranges.size() != mesh.subMeshes.size() || CountTriangles(mesh, level) >= CountTriangles(mesh, level - 1)) {
+			return false;
+		}
+		for (size_t s = 0; s < mesh.subMeshes.size(); ++s) {
+			const LodRange& range = lod.ranges[s];
+			if (range.indexCount % 3 != 0 || size_t{range.indexOffset} + range.indexCount > mesh.indices.size()) {
+				return false;
+			}
+			for (uint32_t i = 0; i < range.indexCount; ++i) {
+				if (mesh.indices[range.indexOffset + i] >= mesh.subMeshes[s].vertexCount) {
+					return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+float MeshReport::ComputeExtent(const MeshData& mesh) {
+	if (mesh.vertices.empty()) {
+		return 0.0f;
+	}
+	float minimum[3] = {INFINITY, INFINITY, INFINITY};
+	float maximum[3] = {-INFINITY, -INFINITY, -INFINITY};
+	for (const MeshVertex& vertex : mesh.vertices) {
+		for (int k = 0; k < 3; ++k) {
+			minimum[k] = std::min(minimum[k], vertex.pos[k]);
+			maximum[k] = std::max(maximum[k], vertex.pos[k]);
+		}
+	}
+	return std::max({maximum[0] - minimum[0], maximum[1] - minimum[1], maximum[2] - minimum[2]});
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include "MeshData.h"
+#include <filesystem>
+
+// AssetBaker の確認・計測用
+namespace MeshReport {
+
+// 比較用：Model::LoadModel と同じやり方で読む（istringstream、1角ごとに1頂点、位置番号 → 頂点番号の表でスムージング）
+bool ReferenceImport(const std::filesystem::path& objPath, bool smoothing, MeshData& out);
+
+// 同じ順の三角形どうしで頂点を比べて、最大の差を返す（三角形の数が違えば無限大）
+float CompareTriangles(const MeshData& a, const MeshData& b);
+
+// 並び順を無視して、サブメッシュごとの三角形（巻き順を含む）の集合が同じか
+bool SameTriangleSet(const MeshData& a, const MeshData& b);
+
+// メッシュ全体の ACMR（サブメッシュの三角形数で重み付け）
+float ComputeACMR(const MeshData& mesh);
+
+// 6方向からの正射影でソフトウェアラスタライズしたときの、塗った回数 / 覆ったピクセル数
+// （裏面は捨てる。1.0 が下限で、描く順が良いほど小さい）
+float MeasureOverdraw(const MeshData& mesh, int resolution = 256);
+
+// LOD の三角形数（level 0 は元のメッシュ）
+size_t CountTriangles(const MeshData& mesh, size_t level);
+
+// LOD が段ごとに減っていて、インデックスがサブメッシュの頂点の範囲に収まっているか
+bool ValidLods(const MeshData& mesh);
+
+// 頂点を囲む箱の一番長い辺
+float ComputeExtent(const MeshData& mesh);
+
+// 量子化で頂点がどれだけずれたか（どれも最大値）
+struct QuantizationError {
+	float position = 0.0f;         // 位置の差
+	float positionRelative = 0.0f; // 位置の差 / メッシュの一番長い辺
+	float normalDegrees = 0.0f;    // 法線の角度の差[度]
+	float uv = 0.0f;               // uv の差
+};
+
+// 同じ並びの頂点どうしを比べる
+QuantizationError MeasureQuantizationError(const MeshData& original, const MeshData& decoded);
+
+} // namespace MeshReport
@@ -0,0 +1,207 @@
+// アセットの事前変換ツール
+// Resources/名前/名前.obj を ObjImporter で読み、MeshOptimizer で並べ替え、MeshSimplifier で LOD を足して、ゲームが使う .mesh を書き出す。
+// モデルごとに頂点キャッシュ効率（ACMR）・オーバードロー・頂点とインデックスのサイズ（どちらも GPU に置くバイト数）を変換の前後で表示する。
+// 頂点は既定で QuantizedVertex に圧縮するので、そのときは量子化で生じた誤差も表示する。
+// LOD は段ごとの三角形数と、元の形からのずれ（モデルの一番長い辺に対する比）を表示する。
+// --bench をつけると、エンジン相当の読み込み（istringstream + unordered_map のスムージング）と比べた時間も計る。
+//
+// 使い方: AssetBaker <Resourcesディレクトリ> [--bench] [--iterations N] [--no-smoothing] [--no-quantize]
+#include "MeshCache.h"
+#include "MeshOptimizer.h"
+#include "MeshQuantizer.h"
+#include "MeshReport.h"
+#include "MeshSimplifier.h"
+#include "ObjImporter.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// iterations 回計って中央値を返す[ms]
+template<typename Function> double MeasureMedian(int iterations, Function&& function) {
+	std::vector<double> samples;
+	samples.reserve(iterations);
+	for (int i = 0; i < iterations; ++i) {
+		const Clock::time_point start = Clock::now();
+		function();
+		samples.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+	}
+	std::sort(samples.begin(), samples.end());
+	return samples[samples.size() / 2];
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	if (argc < 2) {
+		std::fprintf(stderr, "usage: %s <Resources directory> [--bench] [--iterations N] [--no-smoothing] [--no-quantize]\n", argv[0]);
+		return 1;
+	}
+	const std::filesystem::path resourceDirectory = argv[1];
+	bool bench = false;
+	int iterations = 20;
+	bool smoothing = true; // ゲームはすべて smoothing = true で読む
+	bool quantize = true;  // CachedModel::CreateFromOBJ の既定に合わせる
+	for (int i = 2; i < argc; ++i) {
+		if (std::strcmp(argv[i], "--bench") == 0) {
+			bench = true;
+		} else if (std::strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+			iterations = std::max(1, std::atoi(argv[++i]));
+		} else if (std::strcmp(argv[i], "--no-smoothing") == 0) {
+			smoothing = false;
+		} else if (std::strcmp(argv[i], "--no-quantize") == 0) {
+			quantize = false;
+		}
+	}
+	const uint32_t flags = (smoothing ? MeshCache::kFlagSmoothing : 0u) | (quantize ? MeshCache::kFlagQuantized : 0u);
+
+	// Resources/名前/名前.obj を名前順に集める
+	std::vector<std::filesystem::path> objPaths;
+	std::error_code error;
+	for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(resourceDirectory, error)) {
+		const std::filesystem::path objPath = entry.path() / (entry.path().filename().string() + ".obj");
+		if (entry.is_directory() && std::filesystem::exists(objPath)) {
+			objPaths.push_back(objPath);
+		}
+	}
+	std::sort(objPaths.begin(), objPaths.end());
+	if (objPaths.empty()) {
+		std::fprintf(stderr, "no models under %s\n", resourceDirectory.string().c_str());
+		return 1;
+	}
+
+	std::printf("%-12s %8s %8s %8s %15s %15s %17s %15s\n", "model", "corners", "vertices", "tris", "ACMR(fifo16)", "overdraw", "vertex bytes", "index bytes");
+	std::vector<std::string> errorLines;
+	std::vector<std::string> lodLines;
+	std::vector<std::string> benchLines;
+	int failures = 0;
+	for (const std::filesystem::path& objPath : objPaths) {
+		const std::string name = objPath.stem().string();
+
+		MeshData reference;
+		MeshData imported;
+		std::string message;
+		if (!MeshReport::ReferenceImport(objPath, smoothing, reference) || !ObjImporter::Import(objPath, smoothing, imported, &message)) {
+			std::fprintf(stderr, "%s: import failed %s\n", name.c_str(), message.c_str());
+			++failures;
+			continue;
+		}
+		MeshData optimized = imported;
+		MeshOptimizer::Optimize(optimized);
+		MeshSimplifier::GenerateLods(optimized);
+
+		// ゲームが次回から読むキャッシュを書く
+		const std::filesystem::path cachePath = MeshCache::GetCachePath(objPath);
+		if (!MeshCache::Write(cachePath, optimized, flags, MeshCache::ComputeSourceStamp(objPath))) {
+			std::fprintf(stderr, "%s: cannot write %s\n", name.c_str(), cachePath.string().c_str());
+			++failures;
+			continue;
+		}
+		MeshCache cache;
+		MeshData loaded;
+		if (!cache.Open(cachePath, flags, MeshCache::ComputeSourceStamp(objPath))) {
+			std::fprintf(stderr, "%s: cache miss right after writing\n", name.c_str());
+			++failures;
+			continue;
+		}
+		cache.CopyTo(loaded);
+
+		// キャッシュから戻るはずの頂点（圧縮するなら量子化して戻したもの）
+		MeshData expected = optimized;
+		if (quantize) {
+			const QuantizationBounds bounds = MeshQuantizer::ComputeBounds(optimized.vertices.data(), optimized.vertices.size());
+			std::vector<QuantizedVertex> quantized(optimized.vertices.size());
+			MeshQuantizer::Quantize(optimized.vertices.data(), optimized.vertices.size(), bounds, quantized.data());
+			MeshQuantizer::Dequantize(quantized.data(), quantized.size(), bounds, expected.vertices.data());
+
+			const MeshReport::QuantizationError quantizationError = MeshReport::MeasureQuantizationError(optimized, loaded);
+			// uv の誤差は 1024 ピクセル四方のテクスチャで何テクセルになるかも出す
+			char line[160];
+			std::snprintf(line, sizeof(line), "%-12s %12.6f %12.6f %12.4f %12.6f %12.3f", name.c_str(), quantizationError.position, quantizationError.positionRelative, quantizationError.normalDegrees,
+			              quantizationError.uv, quantizationError.uv * 1024.0f);
+			errorLines.push_back(line);
+		}
+
+		// 溶接してもエンジンと同じ三角形が並び、並べ替えても三角形の集合は変わらず、キャッシュからは同じものが戻ること
+		if (MeshReport::CompareTriangles(reference, imported) != 0.0f || !MeshReport::SameTriangleSet(imported, optimized) || MeshReport::CompareTriangles(expected, loaded) != 0.0f) {
+			std::fprintf(stderr, "%s: triangles changed\n", name.c_str());
+			++failures;
+		}
+		// LOD は段ごとに三角形が減り、サブメッシュの頂点だけを指し、キャッシュからそのまま戻ること
+		if (!MeshReport::ValidLods(optimized) || loaded.indices != optimized.indices || loaded.lods.size() != optimized.lods.size()) {
+			std::fprintf(stderr, "%s: invalid LOD\n", name.c_str());
+			++failures;
+		}
+		const size_t triangles = MeshReport::CountTriangles(optimized, 0);
+		{
+			const float extent = MeshReport::ComputeExtent(optimized);
+			std::string line(name);
+			line.resize(12, ' ');
+			for (size_t level = 0; level <= optimized.lods.size(); ++level) {
+				char cell[48];
+				const float error = level == 0 ? 0.0f : optimized.lods[level - 1].error;
+				std::snprintf(cell, sizeof(cell), " %7zu (%.2f%%)", MeshReport::CountTriangles(optimized, level), extent > 0.0f ? error / extent * 100.0f : 0.0f);
+				line += cell;
+			}
+			lodLines.push_back(line);
+		}
+
+		char acmr[32];
+		char overdraw[32];
+		char vertexBytes[32];
+		char indexBytes[32];
+		std::snprintf(acmr, sizeof(acmr), "%.3f -> %.3f", MeshReport::ComputeACMR(imported), MeshReport::ComputeACMR(optimized));
+		std::snprintf(overdraw, sizeof(overdraw), "%.3f -> %.3f", MeshReport::MeasureOverdraw(imported), MeshReport::MeasureOverdraw(optimized));
+		std::snprintf(vertexBytes, sizeof(vertexBytes), "%zu -> %zu", imported.vertices.size() * sizeof(MeshVertex), cache.GetVertexDataSize());
+		std::snprintf(indexBytes, sizeof(indexBytes), "%zu -> %zu", imported.indices.size() * sizeof(uint32_t), size_t{cache.GetIndexCount()} * cache.GetIndexSize());
+		std::printf("%-12s %8zu %8zu %8zu %15s %15s %17s %15s\n", name.c_str(), reference.vertices.size(), optimized.vertices.size(), triangles, acmr, overdraw, vertexBytes, indexBytes);
+
+		if (bench) {
+			MeshData scratch;
+			const double engineMs = MeasureMedian(iterations, [&] { MeshReport::ReferenceImport(objPath, smoothing, scratch); });
+			const double importMs = MeasureMedian(iterations, [&] {
+				ObjImporter::Import(objPath, smoothing, scratch);
+				MeshOptimizer::Optimize(scratch);
+				MeshSimplifier::GenerateLods(scratch);
+			});
+			// ゲームと同じくスタンプを計算してからマップし、中身を取り出すまで
+			const double cacheMs = MeasureMedian(iterations, [&] {
+				MeshCache hit;
+				hit.Open(cachePath, flags, MeshCache::ComputeSourceStamp(objPath));
+				hit.CopyTo(scratch);
+			});
+			char line[160];
+			std::snprintf(line, sizeof(line), "%-12s %12.3f %12.3f %12.3f %9.1f %9.1f", name.c_str(), engineMs, importMs, cacheMs, engineMs / importMs, engineMs / cacheMs);
+			benchLines.push_back(line);
+		}
+	}
+
+	std::printf("\nLOD triangles (error / extent)\n");
+	for (const std::string& line : lodLines) {
+		std::printf("%s\n", line.c_str());
+	}
+
+	if (!errorLines.empty()) {
+		std::printf("\nquantization error (max)\n");
+		std::printf("%-12s %12s %12s %12s %12s %12s\n", "model", "position", "/ extent", "normal[deg]", "uv", "texels@1024");
+		for (const std::string& line : errorLines) {
+			std::printf("%s\n", line.c_str());
+		}
+	}
+
+	if (bench) {
+		std::printf("\nmedian of %d runs\n", iterations);
+		std::printf("%-12s %12s %12s %12s %9s %9s\n", "model", "engine[ms]", "import[ms]", "cache[ms]", "x import", "x cache");
+		for (const std::string& line : benchLines) {
+			std::printf("%s\n", line.c_str());
+		}
+	}
+	return failures == 0 ? 0 : 1;
+}
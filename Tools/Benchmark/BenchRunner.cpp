@@ -0,0 +1,174 @@
+#include "BenchRunner.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double MeasureNs(const BenchRunner::Function& function, uint64_t iterations) {
+	const Clock::time_point start = Clock::now();
+	function(iterations);
+	return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+// 計った環境（比べるときに違っていたら数字をそのまま比べられない）
+const char* SimdName() {
+#if defined(__AVX__)
+	return "avx";
+#elif defined(_M_X64) || defined(__SSE2__)
+	return "sse";
+#else
+	return "scalar";
+#endif
+}
+
+const char* CompilerName() {
+#if defined(__clang__)
+	return "clang " __clang_version__;
+#elif defined(__GNUC__)
+	return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+	return "msvc";
+#else
+	return "unknown";
+#endif
+}
+
+} // namespace
+
+void BenchRunner::Add(std::string name, uint64_t itemsPerIteration, Function function) { entries_.push_back({std::move(name), itemsPerIteration, std::move(function)}); }
+
+double BenchRunner::Median(std::vector<double> values) {
+	if (values.empty()) {
+		return 0.0;
+	}
+	const size_t middle = values.size() / 2;
+	std::nth_element(values.begin(), values.begin() + middle, values.end());
+	double median = values[middle];
+	if (values.size() % 2 == 0) {
+		median = (median + *std::max_element(values.begin(), values.begin() + middle)) * 0.5;
+	}
+	return median;
+}
+
+void BenchRunner::Run(const Options& options) {
+	std::printf("%-44s %12s %9s %12s %12s\n", "benchmark", "ns/op", "MAD", "ns/item", "Mitems/s");
+	for (const Entry& entry : entries_) {
+		if (!options.filter.empty() && entry.name.find(options.filter) == std::string::npos) {
+			continue;
+		}
+
+		// 1 サンプルが minSampleMs を超えるまで回数を増やす（これも予熱を兼ねる）
+		const double minSampleNs = options.minSampleMs * 1e6;
+		uint64_t iterations = 1;
+		for (;;) {
+			const double elapsed = MeasureNs(entry.function, iterations);
+			if (elapsed >= minSampleNs || iterations >= (uint64_t{1} << 40)) {
+				break;
+			}
+			const double scale = elapsed > 0.0 ? minSampleNs * 1.2 / elapsed : 100.0;
+			iterations = static_cast<uint64_t>(static_cast<double>(iterations) * std::clamp(scale, 2.0, 100.0));
+		}
+		for (int i = 0; i < options.warmup; ++i) {
+			MeasureNs(entry.function, iterations);
+		}
+
+		std::vector<double> samples;
+		samples.reserve(options.repetitions);
+		for (int i = 0; i < options.repetitions; ++i) {
+			samples.push_back(MeasureNs(entry.function, iterations) / static_cast<double>(iterations));
+		}
+
+		Result result;
+		result.name = entry.name;
+		result.iterations = iterations;
+		result.items = entry.items;
+		result.samples = static_cast<int>(samples.size());
+		result.medianNs = Median(samples);
+		std::vector<double> deviations;
+		deviations.reserve(samples.size());
+		for (double sample : samples) {
+			deviations.push_back(std::abs(sample - result.medianNs));
+		}
+		result.madNs = Median(deviations);
+		result.minNs = *std::min_element(samples.begin(), samples.end());
+		results_.push_back(result);
+
+		const double nsPerItem = result.medianNs / static_cast<double>(std::max<uint64_t>(result.items, 1));
+		std::printf(
+		    "%-44s %12.1f %8.1f%% %12.2f %12.1f\n", result.name.c_str(), result.medianNs, result.medianNs > 0.0 ? 100.0 * result.madNs / result.medianNs : 0.0, nsPerItem, 1e3 / nsPerItem);
+		std::fflush(stdout);
+	}
+}
+
+bool BenchRunner::WriteJson(const std::filesystem::path& path) const {
+	std::ofstream file(path, std::ios::trunc);
+	if (!file.is_open()) {
+		return false;
+	}
+	char line[512];
+	file << "{\n";
+	file << "  \"context\": {\"compiler\": \"" << CompilerName() << "\", \"simd\": \"" << SimdName() << "\"},\n";
+	file << "  \"benchmarks\": [\n";
+	for (size_t i = 0; i < results_.size(); ++i) {
+		const Result& result = results_[i];
+		std::snprintf(
+		    line, sizeof(line), "    {\"name\": \"%s\", \"median_ns\": %.3f, \"mad_ns\": %.3f, \"min_ns\": %.3f, \"iterations\": %llu, \"items\": %llu, \"samples\": %d}%s\n", result.name.c_str(),
+		    result.medianNs, result.madNs, result.minNs, static_cast<unsigned long long>(result.iterations), static_cast<unsigned long long>(result.items), result.samples,
+		    i + 1 < results_.size() ? "," : "");
+		file << line;
+	}
+	file << "  ]\n}\n";
+	return static_cast<bool>(file);
+}
+
+int BenchRunner::CompareBaseline(const std::filesystem::path& path, double threshold) const {
+	std::ifstream file(path);
+	if (!file.is_open()) {
+		return -1;
+	}
+	std::stringstream stream;
+	stream << file.rdbuf();
+	const std::string text = stream.str();
+
+	// WriteJson が書いた形だけを読む（"name" のあとの最初の "median_ns" がその値）
+	std::map<std::string, double> baseline;
+	const std::string nameKey = "\"name\": \"";
+	const std::string medianKey = "\"median_ns\": ";
+	for (size_t position = text.find(nameKey); position != std::string::npos; position = text.find(nameKey, position)) {
+		position += nameKey.size();
+		const size_t nameEnd = text.find('"', position);
+		const size_t median = text.find(medianKey, nameEnd);
+		if (nameEnd == std::string::npos || median == std::string::npos) {
+			break;
+		}
+		baseline[text.substr(position, nameEnd - position)] = std::strtod(text.c_str() + median + medianKey.size(), nullptr);
+	}
+
+	std::printf("\n%-44s %12s %12s %8s\n", "benchmark", "baseline", "now", "ratio");
+	int slower = 0;
+	for (const Result& result : results_) {
+		auto it = baseline.find(result.name);
+		if (it == baseline.end()) {
+			std::printf("%-44s %12s %12.1f %8s\n", result.name.c_str(), "-", result.medianNs, "new");
+			continue;
+		}
+		const double ratio = it->second > 0.0 ? result.medianNs / it->second : 1.0;
+		const char* mark = "";
+		if (ratio > 1.0 + threshold && result.medianNs - it->second > 3.0 * result.madNs) {
+			mark = "  SLOWER";
+			++slower;
+		} else if (ratio < 1.0 - threshold && it->second - result.medianNs > 3.0 * result.madNs) {
+			mark = "  faster";
+		}
+		std::printf("%-44s %12.1f %12.1f %8.3f%s\n", result.name.c_str(), it->second, result.medianNs, ratio, mark);
+	}
+	return slower;
+}
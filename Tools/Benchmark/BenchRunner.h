@@ -0,0 +1,68 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+// 計った処理の結果が最適化で消されないようにする
+template<typename T> inline void DoNotOptimize(const T& value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+	static const void* volatile sink;
+	sink = &value;
+	std::atomic_signal_fence(std::memory_order_seq_cst);
+#else
+	asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+// マイクロベンチマークの実行と集計
+// 1 回の計測（サンプル）が minSampleMs 以上になるよう繰り返し回数を決め、warmup 回ぶん捨ててから repetitions 回計る。
+// 結果は 1 回あたりの時間[ns]の中央値と MAD（中央値からの絶対偏差の中央値）。平均と標準偏差と違って、
+// ほかのプロセスに割り込まれたサンプルが混じってもほとんど動かない。
+class BenchRunner {
+public:
+	struct Options {
+		std::string filter; // 名前にこれを含むものだけ（空なら全部）
+		int warmup = 3;
+		int repetitions = 15;
+		double minSampleMs = 5.0;
+	};
+
+	struct Result {
+		std::string name;
+		uint64_t iterations = 0; // 1 サンプルでの繰り返し回数
+		uint64_t items = 0;      // 1 回で処理する個数
+		double medianNs = 0.0;   // 1 回あたり
+		double madNs = 0.0;
+		double minNs = 0.0;
+		int samples = 0;
+	};
+
+	// function(iterations) は計る処理を iterations 回行う（準備は function の外で済ませておく）
+	// itemsPerIteration は 1 回で処理する個数（1 個あたりの時間の表示に使う）
+	using Function = std::function<void(uint64_t iterations)>;
+	void Add(std::string name, uint64_t itemsPerIteration, Function function);
+
+	// 登録順に計って、1 つ終わるたびに 1 行表示する
+	void Run(const Options& options);
+	const std::vector<Result>& GetResults() const { return results_; }
+
+	// 結果を JSON で書き出す（CompareBaseline で読める形）
+	bool WriteJson(const std::filesystem::path& path) const;
+	// baseline の JSON と中央値を比べて表示する
+	// threshold（比）以上遅く、その差が MAD の 3 倍より大きいものを遅くなったとみなして、その数を返す（読めなければ -1）
+	int CompareBaseline(const std::filesystem::path& path, double threshold) const;
+
+	static double Median(std::vector<double> values);
+
+private:
+	struct Entry {
+		std::string name;
+		uint64_t items;
+		Function function;
+	};
+	std::vector<Entry> entries_;
+	std::vector<Result> results_;
+};
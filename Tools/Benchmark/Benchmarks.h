@@ -0,0 +1,18 @@
+#pragma once
+#include "BenchRunner.h"
+#include <cstdint>
+#include <filesystem>
+
+// ベンチマークの登録（名前は「分類/対象/条件」）
+// resourceDirectory は DirectXGame/Resources（block.csv を読む）
+void RegisterMapBenchmarks(BenchRunner& runner, const std::filesystem::path& resourceDirectory);
+void RegisterMathBenchmarks(BenchRunner& runner);
+// Method.h の関数を inline で呼んだものと、別の翻訳単位から呼んだものの比較
+void RegisterInlineBenchmarks(BenchRunner& runner);
+void RegisterCollisionBenchmarks(BenchRunner& runner);
+void RegisterParticleBenchmarks(BenchRunner& runner);
+void RegisterTransformBenchmarks(BenchRunner& runner);
+void RegisterTimelineBenchmarks(BenchRunner& runner);
+void RegisterInputBenchmarks(BenchRunner& runner);
+// スレッド数を 1 から maxThreads まで変えて JobSystem で回す。1 スレッドと maxThreads で結果が違うか、Then の続きが正しく動かなければ false
+bool RegisterJobBenchmarks(BenchRunner& runner, uint32_t maxThreads);
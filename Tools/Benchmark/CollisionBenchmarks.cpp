@@ -0,0 +1,84 @@
+// 敵の集まりとの AABB 判定（GameScene::CheckAllCollisions と同じ 1 対多）
+#include "Benchmarks.h"
+#include "CollisionBatch.h"
+#include "Enemy.h"
+#include <memory>
+#include <random>
+#include <string>
+
+namespace {
+
+// count 体の敵をマップの幅に散らして置き、1 フレーム動かしておく
+struct EnemySet {
+	std::unique_ptr<CachedModel> model;
+	Timeline timeline;
+	std::vector<std::unique_ptr<Enemy>> enemies;
+	std::vector<AABB> bounds;
+	AABBBatch batch;
+	AABB player = MakeAABB({50.0f, 2.0f, 0.0f}, {0.4f, 0.4f, 0.0f});
+	std::vector<uint32_t> hits;
+
+	explicit EnemySet(uint32_t count) {
+		model.reset(CachedModel::CreateFromOBJ("enemy", true));
+		std::mt19937 random(4);
+		std::uniform_real_distribution<float> x(0.0f, 100.0f);
+		std::uniform_real_distribution<float> y(1.0f, 18.0f);
+		for (uint32_t i = 0; i < count; ++i) {
+			enemies.push_back(std::make_unique<Enemy>());
+			enemies.back()->Initialize(model.get(), &timeline, {x(random), y(random), 0.0f});
+			enemies.back()->Update();
+			bounds.push_back(enemies.back()->GetAABB());
+		}
+		batch.Reserve(count);
+		for (const AABB& aabb : bounds) {
+			batch.Add(aabb);
+		}
+		hits.reserve(count);
+	}
+};
+
+} // namespace
+
+void RegisterCollisionBenchmarks(BenchRunner& runner) {
+	for (uint32_t count : {10u, 1000u, 100000u}) {
+		auto set = std::make_shared<EnemySet>(count);
+		const std::string suffix = std::to_string(count);
+
+		// IsCollision を 1 つずつ（以前の CheckAllCollisions）
+		runner.Add("aabb/IsCollision/" + suffix, count, [set](uint64_t iterations) {
+			for (uint64_t i = 0; i < iterations; ++i) {
+				uint32_t hits = 0;
+				for (const AABB& aabb : set->bounds) {
+					hits += IsCollision(set->player, aabb);
+				}
+				DoNotOptimize(hits);
+			}
+		});
+		runner.Add("aabb/AABBBatch::Query/" + suffix, count, [set](uint64_t iterations) {
+			for (uint64_t i = 0; i < iterations; ++i) {
+				set->batch.Query(set->player, AABBBatch::Axes::kXY, set->hits);
+				DoNotOptimize(set->hits.data());
+			}
+		});
+		// 毎フレームの詰め直しも含めたもの（GatherEnemyBounds + Query）
+		runner.Add("aabb/Gather+Query/" + suffix, count, [set](uint64_t iterations) {
+			for (uint64_t i = 0; i < iterations; ++i) {
+				set->batch.Clear();
+				for (const std::unique_ptr<Enemy>& enemy : set->enemies) {
+					set->batch.Add(enemy->GetAABB());
+				}
+				set->batch.Query(set->player, AABBBatch::Axes::kXY, set->hits);
+				DoNotOptimize(set->hits.data());
+			}
+		});
+		if (count <= 1000) {
+			runner.Add("enemy/Update/" + suffix, count, [set](uint64_t iterations) {
+				for (uint64_t i = 0; i < iterations; ++i) {
+					for (const std::unique_ptr<Enemy>& enemy : set->enemies) {
+						enemy->Update();
+					}
+				}
+			});
+		}
+	}
+}
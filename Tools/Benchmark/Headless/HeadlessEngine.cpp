@@ -0,0 +1,12 @@
+// ゲームのコードがリンクするエンジン側・描画側の関数のうち、headless で中身のいらないもの
+#include "CachedModel.h"
+
+using namespace KamataEngine;
+
+// 頂点もマテリアルも持たないモデル（描画しないので Initialize に渡すためだけのもの）
+CachedModel* CachedModel::CreateFromOBJ(const std::string& modelName, bool, bool) {
+	CachedModel* model = new CachedModel;
+	model->name_ = modelName;
+	return model;
+}
+
@@ -0,0 +1,102 @@
+#pragma once
+// ベンチマーク用の KamataEngine.h の代わり（ウィンドウも GPU も使わない）
+// 数学の型はエンジンのヘッダをそのまま使い、ゲームのコードが使う WorldTransform / Camera / ObjectColor などは
+// 同じ名前・同じメンバで中身のないものを置く。定数バッファへの転送や描画は何もしない。
+// 入力はゲームのコードが InputState で受け取るので、ベンチマークが直接作って渡す（Input は置かない）。
+#include <math/Matrix4x4.h>
+#include <math/Vector2.h>
+#include <math/Vector3.h>
+#include <math/Vector4.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using UINT = unsigned int;
+
+struct ID3D12Resource;
+struct ID3D12GraphicsCommandList;
+struct ID3D12RootSignature;
+struct ID3D12PipelineState;
+using D3D12_GPU_VIRTUAL_ADDRESS = uint64_t;
+struct D3D12_VERTEX_BUFFER_VIEW {
+	uint64_t BufferLocation;
+	UINT SizeInBytes;
+	UINT StrideInBytes;
+};
+struct D3D12_INDEX_BUFFER_VIEW {
+	uint64_t BufferLocation;
+	UINT SizeInBytes;
+	UINT Format;
+};
+
+namespace Microsoft::WRL {
+// 何も持たない（headless では GPU のリソースを作らない）
+template<typename T> class ComPtr {
+public:
+	T* Get() const { return nullptr; }
+	T* operator->() const { return nullptr; }
+};
+} // namespace Microsoft::WRL
+
+namespace KamataEngine {
+
+class WorldTransform {
+public:
+	Vector3 scale_ = {1, 1, 1};
+	Vector3 rotation_ = {0, 0, 0};
+	Vector3 translation_ = {0, 0, 0};
+	Matrix4x4 matWorld_ = {};
+	const WorldTransform* parent_ = nullptr;
+
+	WorldTransform() = default;
+	WorldTransform(const WorldTransform&) = delete;
+	WorldTransform& operator=(const WorldTransform&) = delete;
+
+	void Initialize() {}
+	void TransferMatrix() {}
+};
+
+class Camera {
+public:
+	Vector3 rotation_ = {0, 0, 0};
+	Vector3 translation_ = {0, 0, -50};
+	float fovAngleY = 45.0f * 3.141592654f / 180.0f;
+	float aspectRatio = (float)16 / 9;
+	float nearZ = 0.1f;
+	float farZ = 1000.0f;
+	Matrix4x4 matView = {};
+	Matrix4x4 matProjection = {};
+
+	void Initialize() {}
+	void UpdateMatrix() {}
+	void TransferMatrix() {}
+};
+
+class ObjectColor {
+public:
+	void Initialize() {}
+	void SetColor(const Vector4& color) { color_ = color; }
+	const Vector4& GetColor() const { return color_; }
+
+private:
+	Vector4 color_ = {1, 1, 1, 1};
+};
+
+class LightGroup {};
+class Material {};
+
+// CachedModel がルートパラメータの並びを合わせるのに使うものだけ
+class Model {
+public:
+	enum class RoomParameter {
+		kWorldTransform,
+		kCamera,
+		kMaterial,
+		kTexture,
+		kLight,
+		kObjectColor,
+	};
+};
+class Sprite;
+
+} // namespace KamataEngine
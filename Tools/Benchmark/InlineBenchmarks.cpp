@@ -0,0 +1,96 @@
+// Method.h を inline にした効果（同じ処理を、別の翻訳単位に置いた OutOfLine の関数で回したものと比べる）
+// 当たり判定（位置から AABB を作って自キャラと比べる）、変換（アフィン行列 × 親 → 位置）、移動（位置 += 速度 * dt）の 3 つ。
+#include "Benchmarks.h"
+#include "OutOfLineMath.h"
+#include <memory>
+#include <random>
+
+namespace {
+
+// 1 回で処理する個数（敵や足場の数くらい）
+const uint32_t kCount = 1024;
+
+struct CallData {
+	std::vector<Vector3> positions, velocities, scales, rotates;
+	std::vector<Matrix4x4> worlds;
+	std::vector<Vector3> worldPositions;
+	Matrix4x4 parent = MakeAffineMatrix({1.0f, 1.0f, 1.0f}, {0.0f, 0.3f, 0.0f}, {2.0f, 0.0f, 0.0f});
+	AABB player = MakeAABB({50.0f, 2.0f, 0.0f}, {0.4f, 0.4f, 0.0f});
+	Vector3 halfExtent = {0.5f, 0.5f, 0.5f};
+
+	CallData() {
+		std::mt19937 random(5);
+		std::uniform_real_distribution<float> x(0.0f, 100.0f);
+		std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+		for (uint32_t i = 0; i < kCount; ++i) {
+			positions.push_back({x(random), 20.0f * (0.5f + 0.5f * unit(random)), 0.0f});
+			velocities.push_back({unit(random), unit(random), 0.0f});
+			scales.push_back({1.0f, 1.0f, 1.0f});
+			rotates.push_back({0.0f, unit(random), 0.0f});
+		}
+		worlds.resize(kCount);
+		worldPositions.resize(kCount);
+	}
+};
+
+} // namespace
+
+void RegisterInlineBenchmarks(BenchRunner& runner) {
+	auto data = std::make_shared<CallData>();
+
+	runner.Add("call/collision/inline", kCount, [data](uint64_t iterations) {
+		for (uint64_t i = 0; i < iterations; ++i) {
+			uint32_t hits = 0;
+			for (const Vector3& position : data->positions) {
+				hits += IsCollision(data->player, MakeAABB(position, data->halfExtent));
+			}
+			DoNotOptimize(hits);
+		}
+	});
+	runner.Add("call/collision/out-of-line", kCount, [data](uint64_t iterations) {
+		for (uint64_t i = 0; i < iterations; ++i) {
+			uint32_t hits = 0;
+			for (const Vector3& position : data->positions) {
+				hits += OutOfLine::IsCollision(data->player, OutOfLine::MakeAABB(position, data->halfExtent));
+			}
+			DoNotOptimize(hits);
+		}
+	});
+
+	runner.Add("call/transform/inline", kCount, [data](uint64_t iterations) {
+		for (uint64_t i = 0; i < iterations; ++i) {
+			for (uint32_t j = 0; j < kCount; ++j) {
+				data->worlds[j] = MatrixMultiply(MakeAffineMatrix(data->scales[j], data->rotates[j], data->positions[j]), data->parent);
+				data->worldPositions[j] = Transform({0.0f, 0.0f, 0.0f}, data->worlds[j]);
+			}
+			DoNotOptimize(data->worldPositions[0]);
+		}
+	});
+	runner.Add("call/transform/out-of-line", kCount, [data](uint64_t iterations) {
+		for (uint64_t i = 0; i < iterations; ++i) {
+			for (uint32_t j = 0; j < kCount; ++j) {
+				data->worlds[j] = OutOfLine::MatrixMultiply(OutOfLine::MakeAffineMatrix(data->scales[j], data->rotates[j], data->positions[j]), data->parent);
+				data->worldPositions[j] = OutOfLine::Transform({0.0f, 0.0f, 0.0f}, data->worlds[j]);
+			}
+			DoNotOptimize(data->worldPositions[0]);
+		}
+	});
+
+	// 動かしたぶんは次の回に持ち越さないよう、書く先は別にする
+	runner.Add("call/move/inline", kCount, [data](uint64_t iterations) {
+		for (uint64_t i = 0; i < iterations; ++i) {
+			for (uint32_t j = 0; j < kCount; ++j) {
+				data->worldPositions[j] = data->positions[j] + data->velocities[j] * (1.0f / 60.0f);
+			}
+			DoNotOptimize(data->worldPositions[0]);
+		}
+	});
+	runner.Add("call/move/out-of-line", kCount, [data](uint64_t iterations) {
+		for (uint64_t i = 0; i < iterations; ++i) {
+			for (uint32_t j = 0; j < kCount; ++j) {
+				data->worldPositions[j] = OutOfLine::Add(data->positions[j], OutOfLine::Multiply(data->velocities[j], 1.0f / 60.0f));
+			}
+			DoNotOptimize(data->worldPositions[0]);
+		}
+	});
+}
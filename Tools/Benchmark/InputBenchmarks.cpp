@@ -0,0 +1,84 @@
+// 入力スレッドからメインスレッドへのイベントの受け渡し（SpscQueue と、ロックするキューとの比較）
+#include "Benchmarks.h"
+#include "InputSampler.h"
+#include "SpscQueue.h"
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+// 1 回の計測で受け渡すイベントの数
+const uint32_t kEventCount = 100000;
+
+using Event = InputSampler::Event;
+
+// producer スレッドが count 個積み、呼んだスレッドがすべて取り出すまで（push / pop は満杯・空なら false で、そのときは譲る）
+template<class PushFn, class PopFn> uint64_t Transfer(uint32_t count, PushFn push, PopFn pop) {
+	std::thread producer([count, &push] {
+		for (uint32_t i = 0; i < count; ++i) {
+			while (!push(Event{i, i})) {
+				std::this_thread::yield();
+			}
+		}
+	});
+	uint64_t sum = 0;
+	Event event;
+	for (uint32_t received = 0; received < count;) {
+		if (!pop(event)) {
+			std::this_thread::yield();
+			continue;
+		}
+		sum += event.held;
+		++received;
+	}
+	producer.join();
+	return sum;
+}
+
+} // namespace
+
+void RegisterInputBenchmarks(BenchRunner& runner) {
+	// 同じスレッドで積んですぐ取り出す（1 組の手間）
+	auto queue = std::make_shared<SpscQueue<Event, 1024>>();
+	runner.Add("input/SpscQueue/push+pop", 1, [queue](uint64_t iterations) {
+		Event event;
+		for (uint64_t i = 0; i < iterations; ++i) {
+			queue->Push(Event{i, static_cast<uint32_t>(i)});
+			queue->Pop(event);
+			DoNotOptimize(event);
+		}
+	});
+
+	// 別のスレッドから受け取る
+	runner.Add("input/SpscQueue/cross-thread", kEventCount, [](uint64_t iterations) {
+		auto crossQueue = std::make_unique<SpscQueue<Event, 1024>>();
+		for (uint64_t i = 0; i < iterations; ++i) {
+			DoNotOptimize(Transfer(kEventCount, [&](const Event& e) { return crossQueue->Push(e); }, [&](Event& e) { return crossQueue->Pop(e); }));
+		}
+	});
+
+	// mutex で守った deque（AssetLoader の受け渡しと同じやり方）
+	runner.Add("input/mutex deque/cross-thread", kEventCount, [](uint64_t iterations) {
+		std::mutex mutex;
+		std::deque<Event> events;
+		auto push = [&](const Event& e) {
+			std::lock_guard<std::mutex> lock(mutex);
+			events.push_back(e);
+			return true;
+		};
+		auto pop = [&](Event& e) {
+			std::lock_guard<std::mutex> lock(mutex);
+			if (events.empty()) {
+				return false;
+			}
+			e = events.front();
+			events.pop_front();
+			return true;
+		};
+		for (uint64_t i = 0; i < iterations; ++i) {
+			DoNotOptimize(Transfer(kEventCount, push, pop));
+		}
+	});
+}
@@ -0,0 +1,273 @@
+// JobSystem で分けて回す処理の、スレッド数ごとの時間（1 から maxThreads まで）
+// GameScene の kPlay と同じく、敵の更新・AABB 集め・ブロックの行列・パーティクルの積分を並列に回す。
+#include "Benchmarks.h"
+#include "CollisionBatch.h"
+#include "Enemy.h"
+#include "JobSystem.h"
+#include "ParticleSystem.h"
+#include "TransformWorld.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+
+namespace {
+
+// JobSystem を threads スレッド（呼んだスレッド + ワーカー）にする。同じなら何もしない
+void UseThreads(uint32_t threads) {
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	if (jobSystem->GetWorkerCount() + 1 == threads) {
+		return;
+	}
+	jobSystem->Finalize();
+	jobSystem->Initialize(threads - 1);
+}
+
+const uint32_t kEnemyCount = 100000;
+const uint32_t kEnemyGrain = 64;
+const uint32_t kBlockRows = 256;
+const uint32_t kBlockColumns = 256;
+const uint32_t kParticleCount = 262144;
+
+struct World {
+	std::unique_ptr<CachedModel> model;
+	Timeline timeline;
+	std::vector<std::unique_ptr<Enemy>> enemies;
+	AABBBatch bounds;
+	std::unique_ptr<WorldTransform[]> blocks = std::make_unique<WorldTransform[]>(kBlockRows * kBlockColumns);
+	ParticleSystem particles;
+
+	World() {
+		model.reset(CachedModel::CreateFromOBJ("enemy", true));
+		std::mt19937 random(7);
+		std::uniform_real_distribution<float> x(0.0f, 100.0f);
+		std::uniform_real_distribution<float> y(1.0f, 18.0f);
+		for (uint32_t i = 0; i < kEnemyCount; ++i) {
+			enemies.push_back(std::make_unique<Enemy>());
+			enemies.back()->Initialize(model.get(), &timeline, {x(random), y(random), 0.0f});
+		}
+		bounds.Reserve(kEnemyCount);
+
+		for (uint32_t i = 0; i < kBlockRows * kBlockColumns; ++i) {
+			blocks[i].translation_ = {static_cast<float>(i % kBlockColumns), static_cast<float>(i / kBlockColumns), 0.0f};
+		}
+
+		// 計っている間に寿命が尽きないようにする
+		particles.Initialize(kParticleCount, 64);
+		ParticleSystem::EmitParams params;
+		params.count = kParticleCount;
+		params.lifetime = 1e9f;
+		particles.Emit(params);
+	}
+
+	void UpdateEnemies(JobSystem::Counter& counter) {
+		JobSystem::GetInstance()->ParallelForAsync(counter, kEnemyCount, kEnemyGrain, [this](uint32_t begin, uint32_t end) {
+			for (uint32_t i = begin; i < end; ++i) {
+				enemies[i]->Update();
+			}
+		});
+	}
+	void GatherBounds() {
+		bounds.Resize(kEnemyCount);
+		JobSystem::GetInstance()->ParallelFor(kEnemyCount, kEnemyGrain, [this](uint32_t begin, uint32_t end) {
+			for (uint32_t i = begin; i < end; ++i) {
+				bounds.Set(i, enemies[i]->GetAABB());
+			}
+		});
+	}
+	void UpdateBlocks(JobSystem::Counter& counter) {
+		JobSystem::GetInstance()->ParallelForAsync(counter, kBlockRows, 1, [this](uint32_t begin, uint32_t end) {
+			for (uint32_t i = begin * kBlockColumns; i < end * kBlockColumns; ++i) {
+				WorldTransformUpdate(blocks[i]);
+			}
+		});
+	}
+
+	// GameScene の kPlay と同じ並び（アニメーション → 敵 → AABB は続き、ブロックとパーティクルはその間に）
+	void Frame() {
+		timeline.Update(1.0f / 60.0f);
+		JobSystem* jobSystem = JobSystem::GetInstance();
+		JobSystem::Counter enemiesUpdated;
+		UpdateEnemies(enemiesUpdated);
+		JobSystem::Counter boundsGathered;
+		jobSystem->Then(enemiesUpdated, boundsGathered, [this] { GatherBounds(); });
+		JobSystem::Counter blocksUpdated;
+		UpdateBlocks(blocksUpdated);
+		particles.Update(1.0f / 60.0f);
+		jobSystem->Wait(boundsGathered);
+		jobSystem->Wait(blocksUpdated);
+	}
+};
+
+// 同じ数フレームを 1 スレッドと threads スレッドで回して、結果がビット単位で同じか
+bool CheckDeterminism(uint32_t threads) {
+	World single;
+	World parallel;
+	const int frames = 4;
+	UseThreads(1);
+	for (int i = 0; i < frames; ++i) {
+		single.Frame();
+	}
+	UseThreads(threads);
+	for (int i = 0; i < frames; ++i) {
+		parallel.Frame();
+	}
+	for (uint32_t i = 0; i < kEnemyCount; ++i) {
+		const AABB a = single.enemies[i]->GetAABB();
+		const AABB b = parallel.enemies[i]->GetAABB();
+		if (std::memcmp(&a, &b, sizeof(AABB)) != 0) {
+			return false;
+		}
+	}
+	for (uint32_t i = 0; i < kBlockRows * kBlockColumns; ++i) {
+		if (std::memcmp(&single.blocks[i].matWorld_, &parallel.blocks[i].matWorld_, sizeof(Matrix4x4)) != 0) {
+			return false;
+		}
+	}
+	for (uint32_t i = 0; i < kParticleCount; ++i) {
+		const Vector3 a = single.particles.GetPosition(i);
+		const Vector3 b = parallel.particles.GetPosition(i);
+		if (std::memcmp(&a, &b, sizeof(Vector3)) != 0) {
+			return false;
+		}
+	}
+	std::vector<uint32_t> singleHits;
+	std::vector<uint32_t> parallelHits;
+	const AABB query = MakeAABB({50.0f, 10.0f, 0.0f}, {20.0f, 5.0f, 0.0f});
+	single.bounds.Query(query, AABBBatch::Axes::kXY, singleHits);
+	parallel.bounds.Query(query, AABBBatch::Axes::kXY, parallelHits);
+	return singleHits == parallelHits;
+}
+
+// 小さな ParallelForAsync に Then で続きをつけて待つのを繰り返す（最後のジョブが終わるのと Then の登録が重なっても、
+// 続きは 1 回だけ、前のジョブがすべて終わってから実行される。落とせば Wait から戻らない）
+bool CheckContinuations(uint32_t threads) {
+	UseThreads(threads);
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	const int rounds = 20000;
+	const uint32_t count = 8;
+	for (int round = 0; round < rounds; ++round) {
+		std::atomic<uint32_t> finished{0};
+		std::atomic<uint32_t> continued{0};
+		uint32_t finishedBeforeContinuation = 0;
+		JobSystem::Counter work;
+		jobSystem->ParallelForAsync(work, count, 1, [&finished](uint32_t begin, uint32_t end) { finished.fetch_add(end - begin); });
+		JobSystem::Counter after;
+		jobSystem->Then(work, after, [&] {
+			finishedBeforeContinuation = finished.load();
+			continued.fetch_add(1);
+		});
+		jobSystem->Wait(after);
+		if (continued.load() != 1 || finishedBeforeContinuation != count || !work.IsDone()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// ワーカーを止めたまま kMaxJobsPerThread の 2 倍のジョブを積む（キューにあるものや実行中のものの領域は使い回さず、
+// 積めないぶんはその場で実行するので、どのジョブも自分の値で 1 回だけ実行される）
+// デバッグビルドでは領域が足りなくなったところで assert するので、リリースビルドだけで確かめる
+bool CheckJobSlots(uint32_t threads) {
+#ifdef NDEBUG
+	UseThreads(threads);
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	const uint32_t workers = jobSystem->GetWorkerCount();
+	std::atomic<bool> released{false};
+	std::atomic<uint32_t> started{0};
+	std::atomic<uint64_t> sum{0};
+	std::atomic<uint32_t> executed{0};
+	JobSystem::Counter counter;
+	// ワーカーはそれぞれ 1 つ取って、放されるまで戻らない
+	for (uint32_t i = 0; i < workers; ++i) {
+		jobSystem->Run(counter, [&] {
+			started.fetch_add(1);
+			while (!released.load()) {
+				std::this_thread::yield();
+			}
+		});
+	}
+	while (started.load() < workers) {
+		std::this_thread::yield();
+	}
+	const uint64_t jobCount = JobSystem::kMaxJobsPerThread * 2;
+	for (uint64_t i = 1; i <= jobCount; ++i) {
+		jobSystem->Run(counter, [&sum, &executed, i] {
+			sum.fetch_add(i);
+			executed.fetch_add(1);
+		});
+	}
+	released.store(true);
+	jobSystem->Wait(counter);
+	return executed.load() == jobCount && sum.load() == jobCount * (jobCount + 1) / 2;
+#else
+	(void)threads;
+	return true;
+#endif
+}
+
+} // namespace
+
+bool RegisterJobBenchmarks(BenchRunner& runner, uint32_t maxThreads) {
+	// 作るのに時間がかかるので、1 つを全スレッド数で使い回す
+	auto world = std::make_shared<World>();
+	for (uint32_t threads = 1; threads <= maxThreads; ++threads) {
+		const std::string suffix = "/threads=" + std::to_string(threads);
+		runner.Add("jobs/enemy::Update" + suffix, kEnemyCount, [world, threads](uint64_t iterations) {
+			UseThreads(threads);
+			for (uint64_t i = 0; i < iterations; ++i) {
+				JobSystem::Counter counter;
+				world->UpdateEnemies(counter);
+				JobSystem::GetInstance()->Wait(counter);
+			}
+		});
+		runner.Add("jobs/GatherBounds" + suffix, kEnemyCount, [world, threads](uint64_t iterations) {
+			UseThreads(threads);
+			for (uint64_t i = 0; i < iterations; ++i) {
+				world->GatherBounds();
+				DoNotOptimize(world->bounds);
+			}
+		});
+		runner.Add("jobs/WorldTransformUpdate" + suffix, kBlockRows * kBlockColumns, [world, threads](uint64_t iterations) {
+			UseThreads(threads);
+			for (uint64_t i = 0; i < iterations; ++i) {
+				JobSystem::Counter counter;
+				world->UpdateBlocks(counter);
+				JobSystem::GetInstance()->Wait(counter);
+			}
+		});
+		runner.Add("jobs/ParticleSystem::Update" + suffix, kParticleCount, [world, threads](uint64_t iterations) {
+			UseThreads(threads);
+			for (uint64_t i = 0; i < iterations; ++i) {
+				world->particles.Update(1.0f / 60.0f);
+				DoNotOptimize(world->particles);
+			}
+		});
+		runner.Add("jobs/Frame" + suffix, 1, [world, threads](uint64_t iterations) {
+			UseThreads(threads);
+			for (uint64_t i = 0; i < iterations; ++i) {
+				world->Frame();
+			}
+		});
+	}
+
+	const bool deterministic = CheckDeterminism(maxThreads);
+	if (!deterministic) {
+		std::fprintf(stderr, "jobs: results with %u threads differ from 1 thread\n", maxThreads);
+	}
+	// 1 コアでは重ならないので、少なくとも 2 スレッドで回す
+	const bool continuations = CheckContinuations(std::max(maxThreads, 2u));
+	if (!continuations) {
+		std::fprintf(stderr, "jobs: a continuation registered with Then was lost or ran early\n");
+	}
+	const bool slots = CheckJobSlots(std::max(maxThreads, 2u));
+	if (!slots) {
+		std::fprintf(stderr, "jobs: a job slot was reused while its job was still queued or running\n");
+	}
+	UseThreads(1);
+	return deterministic && continuations && slots;
+}
@@ -0,0 +1,120 @@
+// マップの読み込み・問い合わせと、自キャラのマップとの当たり判定
+#include "Benchmarks.h"
+#include "MapChipField.h"
+#include "Player.h"
+#include <fstream>
+#include <memory>
+#include <random>
+
+namespace {
+
+// 大きなマップの CSV を書く
+// LoadMapChipCsv が取り出すのは先頭の 20 行 100 列だけだが、ファイル全体を文字列ストリームに読み込むので、時間はファイルの大きさで決まる
+std::filesystem::path WriteMapCsv(const std::filesystem::path& path, uint32_t width, uint32_t height) {
+	std::mt19937 random(1);
+	std::ofstream file(path, std::ios::trunc);
+	for (uint32_t y = 0; y < height; ++y) {
+		for (uint32_t x = 0; x < width; ++x) {
+			file << ((random() % 4 == 0) ? '1' : '0') << (x + 1 < width ? "," : "\n");
+		}
+	}
+	return path;
+}
+
+// ゲームと同じ配置の自キャラ（マップは block.csv、開始位置は GameScene と同じ）
+struct PlayerScene {
+	MapChipField mapChipField;
+	std::unique_ptr<CachedModel> model;
+	Timeline timeline;
+	Player player;
+	uint64_t frame = 0;
+	uint32_t held = 0; // 前のフレームで押していた操作
+
+	explicit PlayerScene(const std::string& csvPath) {
+		mapChipField.LoadMapChipCsv(csvPath);
+		model.reset(CachedModel::CreateFromOBJ("player", true));
+		player.Initialize(model.get(), &timeline, mapChipField.GetMapChipPositionByIndex(1, 18));
+		player.SetMapChipField(&mapChipField);
+	}
+};
+
+} // namespace
+
+void RegisterMapBenchmarks(BenchRunner& runner, const std::filesystem::path& resourceDirectory) {
+	const std::string smallCsv = (resourceDirectory / "block.csv").string();
+	const std::string hugeCsv = WriteMapCsv(std::filesystem::temp_directory_path() / "al3_bench_map_2048.csv", 2048, 2048).string();
+
+	runner.Add("map/LoadMapChipCsv/block.csv", 1, [smallCsv](uint64_t iterations) {
+		MapChipField mapChipField;
+		for (uint64_t i = 0; i < iterations; ++i) {
+			mapChipField.LoadMapChipCsv(smallCsv);
+			DoNotOptimize(mapChipField);
+		}
+	});
+	runner.Add("map/LoadMapChipCsv/2048x2048", 1, [hugeCsv](uint64_t iterations) {
+		MapChipField mapChipField;
+		for (uint64_t i = 0; i < iterations; ++i) {
+			mapChipField.LoadMapChipCsv(hugeCsv);
+			DoNotOptimize(mapChipField);
+		}
+	});
+
+	// 当たり判定と同じく、位置からマップチップの番号を出してその種類を引く
+	{
+		static const uint32_t kQueryCount = 4096;
+		auto mapChipField = std::make_shared<MapChipField>();
+		mapChipField->LoadMapChipCsv(smallCsv);
+		auto positions = std::make_shared<std::vector<Vector3>>();
+		std::mt19937 random(2);
+		std::uniform_real_distribution<float> x(0.0f, 99.0f);
+		std::uniform_real_distribution<float> y(0.0f, 19.0f);
+		for (uint32_t i = 0; i < kQueryCount; ++i) {
+			positions->push_back({x(random), y(random), 0.0f});
+		}
+		runner.Add("map/IndexSetByPosition+TypeByIndex", kQueryCount, [mapChipField, positions](uint64_t iterations) {
+			for (uint64_t i = 0; i < iterations; ++i) {
+				uint32_t blocks = 0;
+				for (const Vector3& position : *positions) {
+					const IndexSet indexSet = mapChipField->GetMapChipIndexSetByPosition(position);
+					blocks += mapChipField->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex) == MapChipType::kBlock;
+				}
+				DoNotOptimize(blocks);
+			}
+		});
+	}
+
+	// 4 方向の当たり判定 1 回（移動量は走る・跳ぶ・落ちるの組み合わせを順に使う）
+	{
+		auto scene = std::make_shared<PlayerScene>(smallCsv);
+		runner.Add("player/MapCollisionDetection", 1, [scene](uint64_t iterations) {
+			static const Vector3 kMoves[] = {
+			    {0.15f, 0.0f, 0.0f}, {-0.15f, 0.0f, 0.0f}, {0.1f, 0.4f, 0.0f}, {-0.1f, -0.3f, 0.0f}, {0.0f, -0.3f, 0.0f}, {0.15f, -0.02f, 0.0f},
+			};
+			for (uint64_t i = 0; i < iterations; ++i) {
+				CollisionMapInfo info{};
+				info.moveAmount_ = kMoves[i % std::size(kMoves)];
+				scene->player.MapCollisionDetection(info);
+				DoNotOptimize(info);
+			}
+		});
+	}
+
+	// Player::Update 1 フレーム（旋回と攻撃のアニメーション・入力・移動・当たり判定・行列）
+	// 右と左を 2 秒ずつ押し続け、0.75 秒ごとにジャンプ、1.5 秒ごとに攻撃する（マップの外には出ない）
+	{
+		auto scene = std::make_shared<PlayerScene>(smallCsv);
+		runner.Add("player/Update", 1, [scene](uint64_t iterations) {
+			for (uint64_t i = 0; i < iterations; ++i) {
+				const uint64_t frame = scene->frame++;
+				uint32_t held = InputState::Bit((frame / 120) % 2 == 0 ? Action::kMoveRight : Action::kMoveLeft);
+				held |= frame % 45 == 0 ? InputState::Bit(Action::kJump) : 0u;
+				held |= frame % 90 == 30 ? InputState::Bit(Action::kAttack) : 0u;
+				const InputState input = InputState::FromHeld(held, scene->held);
+				scene->held = held;
+				scene->timeline.Update(1.0f / 60.0f);
+				scene->player.Update(input);
+				DoNotOptimize(scene->player.GetWorldTransform().matWorld_);
+			}
+		});
+	}
+}
@@ -0,0 +1,140 @@
+// Method.h の行列と FastMath.h の sin/cos
+#include "Benchmarks.h"
+#include "FastMath.h"
+#include "Method.h"
+#include <cmath>
+#include <memory>
+#include <random>
+
+namespace {
+
+// 1 回で処理する個数（L1 に収まる大きさ）
+const uint32_t kCount = 256;
+
+struct MathData {
+	std::vector<Matrix4x4> matrices;
+	std::vector<Matrix4x4> results;
+	std::vector<Vector3> scales, rotates, translates, points, transformed;
+	std::vector<float> angles;
+
+	MathData() {
+		std::mt19937 random(3);
+		std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> angle(-6.3f, 6.3f);
+		for (uint32_t i = 0; i < kCount; ++i) {
+			const Vector3 scale = {1.0f + 0.5f * unit(random), 1.0f + 0.5f * unit(random), 1.0f + 0.5f * unit(random)};
+			const Vector3 rotate = {angle(random), angle(random), angle(random)};
+			const Vector3 translate = {10.0f * unit(random), 10.0f * unit(random), 10.0f * unit(random)};
+			scales.push_back(scale);
+			rotates.push_back(rotate);
+			translates.push_back(translate);
+			matrices.push_back(MakeAffineMatrix(scale, rotate, translate));
+			points.push_back({10.0f * unit(random), 10.0f * unit(random), 10.0f * unit(random)});
+			angles.push_back(angle(random));
+		}
+		results.resize(kCount);
+		transformed.resize(kCount);
+	}
+};
+
+} // namespace
+
+void RegisterMathBenchmarks(BenchRunner& runner) {
+	auto data = std::make_shared<MathData>();
+
+	runner.Add("math/MatrixMultiply", kCount, [data](uint64_t iterations) {
+		for (uint64_t i = 0; i < iterations; ++i) {
+			for (uint32_t j = 0; j < kCount; ++j) {
+				data->results[j] = MatrixMultiply(data->matrices[j], data->matrices[(j + 1) % kCount]);
+			}
+			DoNotOptimize(data->results[0]);
+		}
+	});
+	runner.Add("math/Inverse", kCount, [data](uint64_t iterations) {
+		for (uint64_t i = 0; i < iterations; ++i) {
+			for (uint32_t j = 0; j < kCount; ++j) {
+				data->results[j] = Inverse(data->matrices[j]);
+			}
+			DoNotOptimize(data->results[0]);
+		}
+	});
+	runner.Add("math/MakeAffineMatrix", kCount, [data](uint64_t iterations) {
+		for (uint64_t i = 0; i < iterations; ++i) {
+			for (uint32_t j = 0; j < kCount; ++j) {
+				data->results[j] = MakeAffineMatrix(data->scales[j], data->rotates[j], data->translates[j]);
+			}
+			DoNotOptimize(data->results[0]);
+		}
+	});
+	runner.Add("math/MakeAffineMatrixBatch", kCount, [data](uint64_t iterations) {
+		for (uint64_t i = 0; i < iterations; ++i) {
+			MakeAffineMatrixBatch(data->scales.data(), data->rotates.data(), data->translates.data(), data->results.data(), kCount);
+			DoNotOptimize(data->results[0]);
+		}
+	});
+	runner.Add("math/MakeAffineMatrixFast", kCount, [data](uint64_t iterations) {
+		for (uint64_t i = 0; i < iterations; ++i) {
+			for (uint32_t j = 0; j < kCount; ++j) {
+				data->results[j] = MakeAffineMatrixFast(data->scales[j], data->rotates[j], data->translates[j]);
+			}
+			DoNotOptimize(data->results[0]);
+		}
+	});
+	runner.Add("math/Transform", kCount, [data](uint64_t iterations) {
+		for (uint64_t i = 0; i < iterations; ++i) {
+			for (uint32_t j = 0; j < kCount; ++j) {
+				data->transformed[j] = Transform(data->points[j], data->matrices[0]);
+			}
+			DoNotOptimize(data->transformed[0]);
+		}
+	});
+	runner.Add("math/TransformNormal", kCount, [data](uint64_t iterations) {
+		for (uint64_t i = 0; i < iterations; ++i) {
+			for (uint32_t j = 0; j < kCount; ++j) {
+				data->transformed[j] = TransformNormal(data->points[j], data->matrices[0]);
+			}
+			DoNotOptimize(data->transformed[0]);
+		}
+	});
+	runner.Add("math/TransformPoints", kCount, [data](uint64_t iterations) {
+		for (uint64_t i = 0; i < iterations; ++i) {
+			TransformPoints(data->points.data(), data->transformed.data(), kCount, data->matrices[0]);
+			DoNotOptimize(data->transformed[0]);
+		}
+	});
+
+	// sin と cos の組（FastSinCos と標準ライブラリの比較）
+	runner.Add("math/sincos/std", kCount, [data](uint64_t iterations) {
+		for (uint64_t i = 0; i < iterations; ++i) {
+			float sum = 0.0f;
+			for (float angle : data->angles) {
+				sum += std::sin(angle) + std::cos(angle);
+			}
+			DoNotOptimize(sum);
+		}
+	});
+	runner.Add("math/sincos/FastSinCos", kCount, [data](uint64_t iterations) {
+		for (uint64_t i = 0; i < iterations; ++i) {
+			float sum = 0.0f;
+			for (float angle : data->angles) {
+				float s, c;
+				FastSinCos(angle, s, c);
+				sum += s + c;
+			}
+			DoNotOptimize(sum);
+		}
+	});
+#ifdef METHOD_USE_SSE
+	runner.Add("math/sincos/FastSinCos4", kCount, [data](uint64_t iterations) {
+		for (uint64_t i = 0; i < iterations; ++i) {
+			__m128 sum = _mm_setzero_ps();
+			for (uint32_t j = 0; j < kCount; j += 4) {
+				__m128 s, c;
+				FastSinCos4(_mm_loadu_ps(&data->angles[j]), s, c);
+				sum = _mm_add_ps(sum, _mm_add_ps(s, c));
+			}
+			DoNotOptimize(sum);
+		}
+	});
+#endif
+}
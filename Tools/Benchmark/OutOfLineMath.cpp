@@ -0,0 +1,13 @@
+#include "OutOfLineMath.h"
+
+namespace OutOfLine {
+
+Vector3 Add(const Vector3& v1, const Vector3& v2) { return v1 + v2; }
+Vector3 Multiply(const Vector3& v, float s) { return v * s; }
+AABB MakeAABB(const Vector3& center, const Vector3& halfExtent) { return ::MakeAABB(center, halfExtent); }
+bool IsCollision(const AABB& a, const AABB& b) { return ::IsCollision(a, b); }
+Matrix4x4 MatrixMultiply(const Matrix4x4& m1, const Matrix4x4& m2) { return ::MatrixMultiply(m1, m2); }
+Matrix4x4 MakeAffineMatrix(Vector3 scale, Vector3 rotate, Vector3 translate) { return ::MakeAffineMatrix(scale, rotate, translate); }
+Vector3 Transform(const Vector3& vector, const Matrix4x4& matrix) { return ::Transform(vector, matrix); }
+
+} // namespace OutOfLine
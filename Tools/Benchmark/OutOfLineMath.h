@@ -0,0 +1,16 @@
+#pragma once
+#include "Method.h"
+
+// Method.h の関数を、呼び出し側で展開できない別の翻訳単位に置いたもの（Method.cpp に実体があった頃の呼ばれ方）
+// 中身は Method.h をそのまま呼ぶので、inline 版との差は関数呼び出しと、呼び出し側のループで最適化できないぶんだけになる。
+namespace OutOfLine {
+
+Vector3 Add(const Vector3& v1, const Vector3& v2);
+Vector3 Multiply(const Vector3& v, float s);
+AABB MakeAABB(const Vector3& center, const Vector3& halfExtent);
+bool IsCollision(const AABB& a, const AABB& b);
+Matrix4x4 MatrixMultiply(const Matrix4x4& m1, const Matrix4x4& m2);
+Matrix4x4 MakeAffineMatrix(Vector3 scale, Vector3 rotate, Vector3 translate);
+Vector3 Transform(const Vector3& vector, const Matrix4x4& matrix);
+
+} // namespace OutOfLine
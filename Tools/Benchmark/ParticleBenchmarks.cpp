@@ -0,0 +1,46 @@
+// 死亡演出のパーティクル
+#include "Benchmarks.h"
+#include "DeathParticles.h"
+#include "ParticleSystem.h"
+#include <memory>
+#include <string>
+
+void RegisterParticleBenchmarks(BenchRunner& runner) {
+	// DeathParticles 1 つぶんの 1 フレーム（寿命が尽きたら同じ場所で出し直す）
+	{
+		struct State {
+			std::unique_ptr<CachedModel> model;
+			DeathParticles particles;
+		};
+		auto state = std::make_shared<State>();
+		state->model.reset(CachedModel::CreateFromOBJ("particle", true));
+		state->particles.Initialize(state->model.get());
+		state->particles.Start({10.0f, 5.0f, 0.0f});
+		runner.Add("particles/DeathParticles::Update", 1, [state](uint64_t iterations) {
+			for (uint64_t i = 0; i < iterations; ++i) {
+				if (state->particles.IsFinished()) {
+					state->particles.Start({10.0f, 5.0f, 0.0f});
+				}
+				state->particles.Update();
+				DoNotOptimize(state->particles);
+			}
+		});
+	}
+
+	// 積分だけ（寿命は十分長くして数を保つ）
+	for (uint32_t count : {8u, 1024u, 65536u}) {
+		auto particles = std::make_shared<ParticleSystem>();
+		particles->Initialize(count, 64);
+		ParticleSystem::EmitParams params;
+		params.count = count;
+		params.speed = 4.8f;
+		params.lifetime = 1e6f;
+		particles->Emit(params);
+		runner.Add("particles/ParticleSystem::Update/" + std::to_string(count), count, [particles](uint64_t iterations) {
+			for (uint64_t i = 0; i < iterations; ++i) {
+				particles->Update(1.0f / 60.0f);
+				DoNotOptimize(*particles);
+			}
+		});
+	}
+}
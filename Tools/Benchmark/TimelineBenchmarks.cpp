@@ -0,0 +1,73 @@
+// Timeline でまとめて進めるアニメーションと、物体ごとに手書きで求める以前のやり方の比較
+#include "Benchmarks.h"
+#include "Timeline.h"
+#include <cmath>
+#include <memory>
+#include <numbers>
+
+namespace {
+
+// 敵の歩行の揺れの数
+const uint32_t kTrackCount = 100000;
+const float kWalkMotionTime = 2.0f;
+const float kAngleStart = -30.0f * (std::numbers::pi_v<float> / 180.0f);
+const float kAngleEnd = 0.0f;
+
+struct SwaySet {
+	std::unique_ptr<float[]> timers = std::make_unique<float[]>(kTrackCount);
+	std::unique_ptr<float[]> angles = std::make_unique<float[]>(kTrackCount);
+	Timeline timeline;
+
+	// ease … Timeline のトラックの曲線（kCount なら全種類を順に割り当てる）
+	explicit SwaySet(Ease ease) {
+		timeline.Reserve(kTrackCount);
+		for (uint32_t i = 0; i < kTrackCount; ++i) {
+			Timeline::Track track;
+			track.target = &angles[i];
+			track.from = kAngleStart;
+			track.to = kAngleEnd;
+			track.duration = kWalkMotionTime / 2.0f;
+			track.delay = -kWalkMotionTime / 4.0f;
+			track.ease = ease == Ease::kCount ? static_cast<Ease>(i % static_cast<uint32_t>(Ease::kCount)) : ease;
+			track.loop = Timeline::Loop::kPingPong;
+			track.autoPlay = true;
+			timeline.Add(track);
+		}
+		// 並べ替えは計測の外で済ませておく
+		timeline.Update(0.0f);
+	}
+};
+
+} // namespace
+
+void RegisterTimelineBenchmarks(BenchRunner& runner) {
+	// 以前の Enemy::Update（1 体ずつタイマーを進めて sin で角度を求める）
+	auto sway = std::make_shared<SwaySet>(Ease::kInOutSine);
+	runner.Add("timeline/hand-written sway", kTrackCount, [sway](uint64_t iterations) {
+		for (uint64_t i = 0; i < iterations; ++i) {
+			for (uint32_t e = 0; e < kTrackCount; ++e) {
+				float& timer = sway->timers[e];
+				timer += 1.0f / 60.0f;
+				if (timer >= kWalkMotionTime) {
+					timer = 0.0f;
+				}
+				const float param = std::sin(2.0f * std::numbers::pi_v<float> * (timer / kWalkMotionTime));
+				sway->angles[e] = kAngleStart + (kAngleEnd - kAngleStart) * (param + 1.0f) / 2.0f;
+			}
+			DoNotOptimize(sway->angles[0]);
+		}
+	});
+	runner.Add("timeline/Timeline::Update/InOutSine", kTrackCount, [sway](uint64_t iterations) {
+		for (uint64_t i = 0; i < iterations; ++i) {
+			DoNotOptimize(sway->timeline.Update(1.0f / 60.0f));
+		}
+	});
+
+	// 曲線が混ざっている場合（曲線ごとに並べ直してあるので、分岐は種類の数だけ）
+	auto mixed = std::make_shared<SwaySet>(Ease::kCount);
+	runner.Add("timeline/Timeline::Update/all curves", kTrackCount, [mixed](uint64_t iterations) {
+		for (uint64_t i = 0; i < iterations; ++i) {
+			DoNotOptimize(mixed->timeline.Update(1.0f / 60.0f));
+		}
+	});
+}
@@ -0,0 +1,80 @@
+// TransformHierarchy の更新と、毎フレームすべて作り直す WorldTransformUpdate の比較
+#include "Benchmarks.h"
+#include "TransformHierarchy.h"
+#include "TransformWorld.h"
+#include <memory>
+#include <string>
+
+namespace {
+
+// マップのブロック（動かない）の数
+const uint32_t kBlockCount = 65536;
+// 取り付け位置つきの物体（親 1 つに子 kSocketsPerBody 個）
+const uint32_t kBodyCount = 1024;
+const uint32_t kSocketsPerBody = 4;
+
+struct TransformSet {
+	std::unique_ptr<WorldTransform[]> blocks = std::make_unique<WorldTransform[]>(kBlockCount);
+	std::unique_ptr<WorldTransform[]> bodies = std::make_unique<WorldTransform[]>(kBodyCount);
+	TransformHierarchy hierarchy;
+	std::vector<TransformHierarchy::Handle> blockHandles;
+	std::vector<TransformHierarchy::Handle> bodyHandles;
+	float time = 0.0f;
+
+	TransformSet() {
+		hierarchy.Reserve(kBlockCount + kBodyCount * (1 + kSocketsPerBody));
+		for (uint32_t i = 0; i < kBlockCount; ++i) {
+			blocks[i].translation_ = {static_cast<float>(i % 256), static_cast<float>(i / 256), 0.0f};
+			blockHandles.push_back(hierarchy.Add(&blocks[i]));
+		}
+		for (uint32_t i = 0; i < kBodyCount; ++i) {
+			bodies[i].translation_ = {static_cast<float>(i), 2.0f, 0.0f};
+			bodyHandles.push_back(hierarchy.Add(&bodies[i]));
+			for (uint32_t s = 0; s < kSocketsPerBody; ++s) {
+				hierarchy.Add({1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 0.0f}, {0.5f * static_cast<float>(s), 0.5f, 0.0f}, bodyHandles.back());
+			}
+		}
+		hierarchy.Update();
+	}
+};
+
+} // namespace
+
+void RegisterTransformBenchmarks(BenchRunner& runner) {
+	auto set = std::make_shared<TransformSet>();
+
+	// 以前の UpdateBlocks（動かなくても毎フレーム全部作り直す）
+	runner.Add("transform/WorldTransformUpdate/blocks", kBlockCount, [set](uint64_t iterations) {
+		for (uint64_t i = 0; i < iterations; ++i) {
+			for (uint32_t b = 0; b < kBlockCount; ++b) {
+				WorldTransformUpdate(set->blocks[b]);
+			}
+		}
+	});
+	// 何も変わっていないフレーム
+	runner.Add("transform/TransformHierarchy::Update/static", kBlockCount, [set](uint64_t iterations) {
+		for (uint64_t i = 0; i < iterations; ++i) {
+			DoNotOptimize(set->hierarchy.Update());
+		}
+	});
+	// ブロックの 1% を動かしたフレーム
+	runner.Add("transform/TransformHierarchy::Update/1%", kBlockCount, [set](uint64_t iterations) {
+		for (uint64_t i = 0; i < iterations; ++i) {
+			set->time += 1.0f / 60.0f;
+			for (uint32_t b = 0; b < kBlockCount; b += 100) {
+				set->hierarchy.SetRotation(set->blockHandles[b], {0.0f, 0.0f, set->time});
+			}
+			DoNotOptimize(set->hierarchy.Update());
+		}
+	});
+	// 親を全部動かして、取り付け位置（子）も作り直すフレーム
+	runner.Add("transform/TransformHierarchy::Update/sockets", kBodyCount * (1 + kSocketsPerBody), [set](uint64_t iterations) {
+		for (uint64_t i = 0; i < iterations; ++i) {
+			set->time += 1.0f / 60.0f;
+			for (TransformHierarchy::Handle handle : set->bodyHandles) {
+				set->hierarchy.SetRotation(handle, {0.0f, set->time, 0.0f});
+			}
+			DoNotOptimize(set->hierarchy.Update());
+		}
+	});
+}
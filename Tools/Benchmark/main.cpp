@@ -0,0 +1,86 @@
+// ゲームのコードを Windows なしで計るベンチマーク
+// マップの読み込みと問い合わせ、自キャラの当たり判定と更新、行列と sin/cos（call/ は inline にした効果）、敵との AABB 判定、パーティクルの更新、親子の変換の更新を計る。
+// jobs/ は JobSystem で分けて回す処理を 1 から --threads（既定は論理コア数）スレッドまで計る。
+// エンジンは Headless/KamataEngine.h の中身のないものに差し替えてあり、描画と定数バッファの転送は計らない。
+//
+// 使い方: Benchmark [--filter 文字列] [--repetitions N] [--warmup N] [--min-time ms] [--resources ディレクトリ]
+//                   [--threads N] [--json 出力.json] [--baseline 比較する.json] [--threshold 比]
+// --baseline を渡すと、threshold（既定 0.1）以上遅くなったものがあれば終了コード 1 を返す。
+#include "Benchmarks.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+int main(int argc, char** argv) {
+	BenchRunner::Options options;
+	std::filesystem::path resourceDirectory = BENCHMARK_RESOURCE_DIR;
+	std::filesystem::path jsonPath;
+	std::filesystem::path baselinePath;
+	double threshold = 0.1;
+	uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+	for (int i = 1; i < argc; ++i) {
+		const bool hasValue = i + 1 < argc;
+		if (std::strcmp(argv[i], "--filter") == 0 && hasValue) {
+			options.filter = argv[++i];
+		} else if (std::strcmp(argv[i], "--repetitions") == 0 && hasValue) {
+			options.repetitions = std::max(1, std::atoi(argv[++i]));
+		} else if (std::strcmp(argv[i], "--warmup") == 0 && hasValue) {
+			options.warmup = std::max(0, std::atoi(argv[++i]));
+		} else if (std::strcmp(argv[i], "--min-time") == 0 && hasValue) {
+			options.minSampleMs = std::max(0.1, std::atof(argv[++i]));
+		} else if (std::strcmp(argv[i], "--resources") == 0 && hasValue) {
+			resourceDirectory = argv[++i];
+		} else if (std::strcmp(argv[i], "--threads") == 0 && hasValue) {
+			maxThreads = static_cast<uint32_t>(std::max(1, std::atoi(argv[++i])));
+		} else if (std::strcmp(argv[i], "--json") == 0 && hasValue) {
+			jsonPath = argv[++i];
+		} else if (std::strcmp(argv[i], "--baseline") == 0 && hasValue) {
+			baselinePath = argv[++i];
+		} else if (std::strcmp(argv[i], "--threshold") == 0 && hasValue) {
+			threshold = std::atof(argv[++i]);
+		} else {
+			std::fprintf(
+			    stderr, "usage: %s [--filter text] [--repetitions N] [--warmup N] [--min-time ms] [--resources dir] [--threads N] [--json out.json] [--baseline base.json] [--threshold ratio]\n",
+			    argv[0]);
+			return 2;
+		}
+	}
+	if (!std::filesystem::exists(resourceDirectory / "block.csv")) {
+		std::fprintf(stderr, "block.csv not found in %s (use --resources)\n", resourceDirectory.string().c_str());
+		return 2;
+	}
+
+	BenchRunner runner;
+	RegisterMapBenchmarks(runner, resourceDirectory);
+	RegisterMathBenchmarks(runner);
+	RegisterInlineBenchmarks(runner);
+	RegisterCollisionBenchmarks(runner);
+	RegisterParticleBenchmarks(runner);
+	RegisterTransformBenchmarks(runner);
+	RegisterTimelineBenchmarks(runner);
+	RegisterInputBenchmarks(runner);
+	if (!RegisterJobBenchmarks(runner, maxThreads)) {
+		return 1;
+	}
+	runner.Run(options);
+
+	if (!jsonPath.empty() && !runner.WriteJson(jsonPath)) {
+		std::fprintf(stderr, "failed to write %s\n", jsonPath.string().c_str());
+		return 2;
+	}
+	if (!baselinePath.empty()) {
+		const int slower = runner.CompareBaseline(baselinePath, threshold);
+		if (slower < 0) {
+			std::fprintf(stderr, "failed to read %s\n", baselinePath.string().c_str());
+			return 2;
+		}
+		if (slower > 0) {
+			std::printf("%d benchmark(s) slower than baseline by more than %.0f%%\n", slower, threshold * 100.0);
+			return 1;
+		}
+	}
+	return 0;
+}
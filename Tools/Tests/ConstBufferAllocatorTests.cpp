@@ -0,0 +1,124 @@
+// ConstBufferAllocator の割り当て方針（256 バイト境界、フェンスを過ぎてからのページの再利用、上限、フレームの回し方）
+#include "ConstBufferAllocator.h"
+#include "Tests.h"
+#include <vector>
+
+namespace {
+
+// ConstBufferRing::kFramesInFlight と同じ（ConstBufferRing は D3D12 を使うのでここでは読めない）
+const uint32_t kFramesInFlight = 2;
+
+// 1 ページを使い切るまで切り出し、使ったページ番号を返す
+uint32_t FillPage(ConstBufferAllocator& allocator) {
+	ConstBufferAllocator::Allocation allocation;
+	CHECK(allocator.Allocate(allocator.GetPageSize(), allocation));
+	return allocation.page;
+}
+
+} // namespace
+
+void RegisterConstBufferAllocatorTests(TestRunner& runner) {
+	runner.Add("cbuffer/Allocate/256-byte alignment", [] {
+		ConstBufferAllocator allocator;
+		allocator.Initialize(1000, 4);
+		// ページの大きさも 256 の倍数に切り上げる
+		CHECK(allocator.GetPageSize() == 1024);
+		allocator.BeginFrame(0);
+		uint32_t expectedOffset = 0;
+		for (uint32_t size : {1u, 255u, 256u, 257u}) {
+			ConstBufferAllocator::Allocation allocation;
+			CHECK(allocator.Allocate(size, allocation));
+			CHECK(allocation.offset % ConstBufferAllocator::kAlignment == 0);
+			CHECK(allocation.size == ConstBufferAllocator::AlignUp(size));
+			CHECK(allocation.size >= size);
+			// 入りきらなかった 257 は次のページの先頭から
+			if (allocation.page == 0) {
+				CHECK(allocation.offset == expectedOffset);
+				expectedOffset += allocation.size;
+			} else {
+				CHECK(allocation.offset == 0);
+			}
+		}
+		CHECK(allocator.GetPageCount() == 2);
+		CHECK(allocator.GetFrameUsedBytes() == 256 + 256 + 256 + 512);
+
+		// 0 バイトとページより大きいものは切り出さない
+		ConstBufferAllocator::Allocation allocation;
+		CHECK(!allocator.Allocate(0, allocation));
+		CHECK(!allocator.Allocate(1025, allocation));
+	});
+
+	runner.Add("cbuffer/BeginFrame/reuse only after fence", [] {
+		ConstBufferAllocator allocator;
+		allocator.Initialize(256, 4);
+
+		allocator.BeginFrame(0);
+		const uint32_t first = FillPage(allocator);
+		allocator.EndFrame(1);
+
+		// フェンス 1 がまだ終わっていなければ、別のページを使う
+		allocator.BeginFrame(0);
+		CHECK(allocator.GetInFlightPageCount() == 1);
+		const uint32_t second = FillPage(allocator);
+		CHECK(second != first);
+		allocator.EndFrame(2);
+
+		// フェンス 1 を過ぎたら最初のページを使い回す（2 のものはまだ）
+		allocator.BeginFrame(1);
+		CHECK(allocator.GetInFlightPageCount() == 1);
+		CHECK(FillPage(allocator) == first);
+		CHECK(allocator.GetPageCount() == 2);
+		allocator.EndFrame(3);
+	});
+
+	runner.Add("cbuffer/Allocate/maxPages exhausted", [] {
+		ConstBufferAllocator allocator;
+		allocator.Initialize(256, 2);
+		ConstBufferAllocator::Allocation allocation;
+
+		// 1 フレームで上限を超える
+		allocator.BeginFrame(0);
+		CHECK(allocator.Allocate(256, allocation));
+		CHECK(allocator.Allocate(256, allocation));
+		CHECK(!allocator.Allocate(256, allocation));
+		CHECK(allocator.GetPageCount() == 2);
+		allocator.EndFrame(1);
+
+		// どちらも GPU が使っている間は切り出せない
+		allocator.BeginFrame(0);
+		CHECK(!allocator.Allocate(16, allocation));
+		allocator.EndFrame(2);
+
+		// 終わったら戻る
+		allocator.BeginFrame(1);
+		CHECK(allocator.Allocate(256, allocation));
+		CHECK(allocator.Allocate(256, allocation));
+		CHECK(allocator.GetPageCount() == 2);
+		allocator.EndFrame(3);
+	});
+
+	runner.Add("cbuffer/EndFrame/wraparound across frames in flight", [] {
+		// ConstBufferRing と同じ回し方（フェンスはフレーム番号で、kFramesInFlight フレーム前のものを空きに戻す）
+		const uint32_t pagesPerFrame = 3;
+		ConstBufferAllocator allocator;
+		allocator.Initialize(256, pagesPerFrame * kFramesInFlight);
+		std::vector<uint64_t> lastUsed(pagesPerFrame * kFramesInFlight, 0);
+
+		for (uint64_t frame = kFramesInFlight; frame < kFramesInFlight + 100; ++frame) {
+			allocator.BeginFrame(frame - kFramesInFlight);
+			for (uint32_t i = 0; i < pagesPerFrame; ++i) {
+				const uint32_t page = FillPage(allocator);
+				CHECK(page < lastUsed.size());
+				if (page < lastUsed.size()) {
+					// GPU がまだ読んでいるかもしれないページは渡さない
+					CHECK(lastUsed[page] == 0 || frame - lastUsed[page] >= kFramesInFlight);
+					lastUsed[page] = frame;
+				}
+			}
+			allocator.EndFrame(frame);
+		}
+		// 上限（kFramesInFlight フレームぶん）ちょうどで回り続ける
+		CHECK(allocator.GetPageCount() == pagesPerFrame * kFramesInFlight);
+		CHECK(allocator.GetInFlightPageCount() == pagesPerFrame * kFramesInFlight);
+	});
+}
@@ -0,0 +1,108 @@
+// FastMath.h の sin/cos の誤差（|x| ≤ 8192 で絶対誤差 kMaxError 以下）
+#include "FastMath.h"
+#include "Tests.h"
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <vector>
+
+namespace {
+
+// FastMath.h に書いてある誤差の上限
+const double kMaxError = 9.4e-8;
+// 保証する角度の範囲
+const float kMaxAngle = 8192.0f;
+
+// 確かめる角度（範囲全体を等間隔に、0 の近くを細かく、象限の境目の前後、乱数）
+std::vector<float> MakeAngles() {
+	std::vector<float> angles;
+	const int steps = 1 << 21;
+	for (int i = -steps; i <= steps; ++i) {
+		angles.push_back(kMaxAngle * static_cast<float>(i) / static_cast<float>(steps));
+	}
+	for (int i = -4096; i <= 4096; ++i) {
+		angles.push_back(static_cast<float>(i) * 1e-3f);
+	}
+	// π/4 の倍数（多項式の範囲の端と、象限の切り替わり）と、その前後の float
+	for (int k = -static_cast<int>(kMaxAngle / (std::numbers::pi / 4.0)); k <= static_cast<int>(kMaxAngle / (std::numbers::pi / 4.0)); ++k) {
+		const float edge = static_cast<float>(k * std::numbers::pi / 4.0);
+		angles.push_back(std::nextafter(edge, -kMaxAngle));
+		angles.push_back(edge);
+		angles.push_back(std::nextafter(edge, kMaxAngle));
+	}
+	std::mt19937 random(11);
+	std::uniform_real_distribution<float> angle(-kMaxAngle, kMaxAngle);
+	for (int i = 0; i < (1 << 20); ++i) {
+		angles.push_back(angle(random));
+	}
+	// 範囲内の float をすべて調べたときに誤差が一番大きかった角度（sin と cos）
+	for (float worst : {0x1.069cdep+11f, 0x1.f44a32p+1f}) {
+		angles.push_back(worst);
+		angles.push_back(-worst);
+	}
+	angles.push_back(kMaxAngle);
+	angles.push_back(-kMaxAngle);
+	angles.push_back(0.0f);
+	angles.push_back(-0.0f);
+	// 4 つずつ回せるよう端数を埋める
+	while (angles.size() % 4 != 0) {
+		angles.push_back(0.0f);
+	}
+	return angles;
+}
+
+const std::vector<float>& GetAngles() {
+	static const std::vector<float> angles = MakeAngles();
+	return angles;
+}
+
+// double で求めた値との差が上限以内か
+bool WithinBound(float value, double expected) { return std::abs(static_cast<double>(value) - expected) <= kMaxError; }
+
+} // namespace
+
+void RegisterFastMathTests(TestRunner& runner) {
+	runner.Add("fastmath/FastSin/error bound", [] {
+		for (float x : GetAngles()) {
+			CHECK(WithinBound(FastSin(x), std::sin(static_cast<double>(x))));
+		}
+	});
+
+	runner.Add("fastmath/FastCos/error bound", [] {
+		for (float x : GetAngles()) {
+			CHECK(WithinBound(FastCos(x), std::cos(static_cast<double>(x))));
+		}
+	});
+
+	runner.Add("fastmath/FastSinCos/error bound", [] {
+		for (float x : GetAngles()) {
+			float s, c;
+			FastSinCos(x, s, c);
+			CHECK(WithinBound(s, std::sin(static_cast<double>(x))));
+			CHECK(WithinBound(c, std::cos(static_cast<double>(x))));
+		}
+	});
+
+#ifdef METHOD_USE_SSE
+	runner.Add("fastmath/FastSinCos4/error bound and matches scalar", [] {
+		const std::vector<float>& angles = GetAngles();
+		for (size_t i = 0; i < angles.size(); i += 4) {
+			__m128 s4, c4;
+			FastSinCos4(_mm_loadu_ps(&angles[i]), s4, c4);
+			float s[4], c[4];
+			_mm_storeu_ps(s, s4);
+			_mm_storeu_ps(c, c4);
+			for (size_t lane = 0; lane < 4; ++lane) {
+				const double x = static_cast<double>(angles[i + lane]);
+				CHECK(WithinBound(s[lane], std::sin(x)));
+				CHECK(WithinBound(c[lane], std::cos(x)));
+				// Timeline は 4 つずつの残りをスカラー版で求めるので、同じ値でないといけない
+				float scalarSin, scalarCos;
+				FastSinCos(angles[i + lane], scalarSin, scalarCos);
+				CHECK(s[lane] == scalarSin);
+				CHECK(c[lane] == scalarCos);
+			}
+		}
+	});
+#endif
+}
@@ -0,0 +1,206 @@
+// Method.h の SIMD 版（SSE / AVX）がスカラー版と同じ結果を返すか
+// スカラー版の結果は定数式の中で求める（定数式の中では Method.h は SIMD を使わない）。
+// 入力は乱数と、±0・非正規化数・大きな値を混ぜたもの。同じ実行ファイルを AVX でもビルドして回す（TestsAvx）。
+#include "Method.h"
+#include "Tests.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+// SIMD 版とスカラー版の差の上限[ULP]
+// 加算の順番はスカラー版と同じにしてあるので実際には 0 になる（ずれるとしたら FMA への縮約などコンパイラの設定）
+const int64_t kMaxUlp = 1;
+
+// 閉じた形の MakeAffineMatrix と、行列を掛けて作ったものの差の上限（行の大きさに対する比）
+const float kAffineTolerance = 8.0f * FLT_EPSILON;
+
+const size_t kCount = 192;
+
+// 端の値（大きな値は 2 つ掛けて 4 つ足してもあふれない大きさ）
+constexpr float kEdgeValues[] = {0.0f, -0.0f, 1e-40f, -1e-40f, 1.4e-45f, 1.17549435e-38f, 1e18f, -1e18f, 1.0f, -1.0f};
+const size_t kEdgeCount = sizeof(kEdgeValues) / sizeof(kEdgeValues[0]);
+
+// 定数式で使える乱数（xorshift）
+struct Random {
+	uint32_t state = 0x12345678u;
+
+	constexpr uint32_t Next() {
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+	// 符号と仮数は乱数で、大きさは 2^-8 から 2^8
+	constexpr float NextFloat() {
+		const uint32_t bits = Next();
+		const uint32_t exponent = 127u - 8u + (bits >> 23) % 17u;
+		return std::bit_cast<float>((bits & 0x80000000u) | (exponent << 23) | (bits & 0x007FFFFFu));
+	}
+	// 乱数か端の値（4 つに 1 つ）
+	constexpr float NextMixed() {
+		const uint32_t pick = Next();
+		return pick % 4u == 0 ? kEdgeValues[(pick / 4u) % kEdgeCount] : NextFloat();
+	}
+};
+
+// -0 は -0 のまま
+constexpr float Abs(float value) { return value < 0.0f ? -value : value; }
+
+struct Inputs {
+	std::array<Matrix4x4, kCount> a{};
+	std::array<Matrix4x4, kCount> b{};
+	// Transform 用（w が 0 にならないよう、4 列目と points は負にしない）
+	std::array<Matrix4x4, kCount> projective{};
+	std::array<Vector3, kCount> points{};
+	std::array<Vector3, kCount> vectors{};
+};
+
+constexpr Inputs MakeInputs() {
+	Inputs inputs;
+	Random random;
+	for (size_t i = 0; i < kCount; ++i) {
+		for (int r = 0; r < 4; ++r) {
+			for (int c = 0; c < 4; ++c) {
+				inputs.a[i].m[r][c] = random.NextMixed();
+				inputs.b[i].m[r][c] = random.NextMixed();
+				inputs.projective[i].m[r][c] = random.NextMixed();
+			}
+		}
+		// w = x*m03 + y*m13 + z*m23 + m33 が打ち消し合わないよう、どれも 0 以上にして m33 は 1 以上にする
+		for (int r = 0; r < 3; ++r) {
+			inputs.projective[i].m[r][3] = Abs(inputs.projective[i].m[r][3]) * 1e-3f;
+		}
+		inputs.projective[i].m[3][3] = 1.0f + static_cast<float>(random.Next() % 1024u) / 1024.0f;
+		inputs.points[i] = {Abs(random.NextMixed()), Abs(random.NextMixed()), Abs(random.NextMixed())};
+		inputs.vectors[i] = {random.NextMixed(), random.NextMixed(), random.NextMixed()};
+	}
+	return inputs;
+}
+
+constexpr Inputs kInputs = MakeInputs();
+
+// スカラー版の結果
+struct References {
+	std::array<Matrix4x4, kCount> multiplied{};
+	std::array<Vector3, kCount> transformed{};
+	std::array<Vector3, kCount> transformedNormals{};
+};
+
+constexpr References MakeReferences() {
+	References references;
+	for (size_t i = 0; i < kCount; ++i) {
+		references.multiplied[i] = MatrixMultiply(kInputs.a[i], kInputs.b[i]);
+		references.transformed[i] = Transform(kInputs.points[i], kInputs.projective[i]);
+		references.transformedNormals[i] = TransformNormal(kInputs.vectors[i], kInputs.a[i]);
+	}
+	return references;
+}
+
+constexpr References kReferences = MakeReferences();
+
+// 2 つの float の間にある表現可能な値の数（+0 と -0 は同じ、どちらも NaN なら 0）
+int64_t UlpDistance(float a, float b) {
+	if (std::isnan(a) || std::isnan(b)) {
+		return std::isnan(a) && std::isnan(b) ? 0 : INT64_MAX;
+	}
+	auto ordered = [](float value) {
+		const int32_t bits = std::bit_cast<int32_t>(value);
+		return bits < 0 ? -static_cast<int64_t>(bits & 0x7FFFFFFF) : static_cast<int64_t>(bits);
+	};
+	return std::llabs(ordered(a) - ordered(b));
+}
+
+int64_t MaxUlp(const Matrix4x4& a, const Matrix4x4& b) {
+	int64_t result = 0;
+	for (int r = 0; r < 4; ++r) {
+		for (int c = 0; c < 4; ++c) {
+			result = std::max(result, UlpDistance(a.m[r][c], b.m[r][c]));
+		}
+	}
+	return result;
+}
+
+int64_t MaxUlp(const Vector3& a, const Vector3& b) { return std::max({UlpDistance(a.x, b.x), UlpDistance(a.y, b.y), UlpDistance(a.z, b.z)}); }
+
+} // namespace
+
+void RegisterMathConformanceTests(TestRunner& runner) {
+	runner.Add("math/MatrixMultiply/matches scalar", [] {
+		for (size_t i = 0; i < kCount; ++i) {
+			CHECK(MaxUlp(MatrixMultiply(kInputs.a[i], kInputs.b[i]), kReferences.multiplied[i]) <= kMaxUlp);
+		}
+	});
+
+	runner.Add("math/Transform/matches scalar", [] {
+		for (size_t i = 0; i < kCount; ++i) {
+			CHECK(MaxUlp(Transform(kInputs.points[i], kInputs.projective[i]), kReferences.transformed[i]) <= kMaxUlp);
+		}
+	});
+
+	runner.Add("math/TransformNormal/matches scalar", [] {
+		for (size_t i = 0; i < kCount; ++i) {
+			CHECK(MaxUlp(TransformNormal(kInputs.vectors[i], kInputs.a[i]), kReferences.transformedNormals[i]) <= kMaxUlp);
+		}
+	});
+
+	runner.Add("math/TransformPoints/matches scalar", [] {
+		// i 番の点を i 番の行列で変換して参照と比べる
+		std::vector<Vector3> out(kCount);
+		for (size_t i = 0; i < kCount; ++i) {
+			TransformPoints(&kInputs.points[i], &out[i], 1, kInputs.projective[i]);
+			CHECK(MaxUlp(out[i], kReferences.transformed[i]) <= kMaxUlp);
+		}
+		// まとめて変換したものは 1 つずつ Transform したものと同じ
+		for (size_t i = 0; i < kCount; i += 16) {
+			TransformPoints(kInputs.points.data(), out.data(), kCount, kInputs.projective[i]);
+			for (size_t j = 0; j < kCount; ++j) {
+				CHECK(MaxUlp(out[j], Transform(kInputs.points[j], kInputs.projective[i])) <= kMaxUlp);
+			}
+		}
+	});
+
+	runner.Add("math/MakeAffineMatrixBatch/matches S*Rx*Ry*Rz*T", [] {
+		std::vector<Vector3> scales, rotates, translates;
+		Random random;
+		for (size_t i = 0; i < kCount; ++i) {
+			const float u = static_cast<float>(random.Next() % 4096u) / 4096.0f;
+			scales.push_back({0.5f + u, 1.5f - u, 0.25f + 2.0f * u});
+			// X 回転なし（閉じた形が Rx を飛ばす）も混ぜる
+			const float angle = random.NextFloat();
+			rotates.push_back({i % 3 == 0 ? 0.0f : std::fmod(angle, 6.3f), std::fmod(random.NextFloat(), 6.3f), std::fmod(random.NextFloat(), 6.3f)});
+			translates.push_back({random.NextFloat(), random.NextFloat(), random.NextFloat()});
+		}
+		std::vector<Matrix4x4> batch(kCount);
+		MakeAffineMatrixBatch(scales.data(), rotates.data(), translates.data(), batch.data(), kCount);
+		for (size_t i = 0; i < kCount; ++i) {
+			// まとめて作ったものは 1 つずつ作ったものと同じ
+			CHECK(MaxUlp(batch[i], MakeAffineMatrix(scales[i], rotates[i], translates[i])) == 0);
+
+			// 行列を掛けて作ったもの（閉じた形にする前の作り方）と比べる。0 に近い要素は ULP では比べられないので、
+			// 行の大きさ（回転の行はスケール、4 行目は移動）に対する誤差で見る
+			Matrix4x4 scale = MakeIdentityMatrix();
+			scale.m[0][0] = scales[i].x;
+			scale.m[1][1] = scales[i].y;
+			scale.m[2][2] = scales[i].z;
+			Matrix4x4 translate = MakeIdentityMatrix();
+			translate.m[3][0] = translates[i].x;
+			translate.m[3][1] = translates[i].y;
+			translate.m[3][2] = translates[i].z;
+			const float rowScales[3] = {scales[i].x, scales[i].y, scales[i].z};
+			const Matrix4x4 product = scale * MakeRotateXMatrix(rotates[i].x) * MakeRotateYMatrix(rotates[i].y) * MakeRotateZMatrix(rotates[i].z) * translate;
+			for (int r = 0; r < 4; ++r) {
+				for (int c = 0; c < 4; ++c) {
+					const float magnitude = r < 3 ? rowScales[r] : std::abs(product.m[r][c]);
+					CHECK(std::abs(batch[i].m[r][c] - product.m[r][c]) <= kAffineTolerance * std::max(1.0f, magnitude));
+				}
+			}
+		}
+	});
+}
@@ -0,0 +1,191 @@
+// MeshSimplifier の縮約（平らな面の縁、LOD のずれの並び、インデックスの範囲、つぶれた入力）
+#include "MeshSimplifier.h"
+#include "Tests.h"
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// size × size マスの格子（z は height(x, y)）を mesh の後ろにサブメッシュとして足す
+template<class HeightFn> void AddGrid(MeshData& mesh, uint32_t size, HeightFn height) {
+	SubMesh subMesh;
+	subMesh.vertexOffset = static_cast<uint32_t>(mesh.vertices.size());
+	subMesh.indexOffset = static_cast<uint32_t>(mesh.indices.size());
+	for (uint32_t y = 0; y <= size; ++y) {
+		for (uint32_t x = 0; x <= size; ++x) {
+			const float fx = static_cast<float>(x);
+			const float fy = static_cast<float>(y);
+			MeshVertex vertex = {};
+			vertex.pos[0] = fx;
+			vertex.pos[1] = fy;
+			vertex.pos[2] = height(fx, fy);
+			vertex.normal[2] = 1.0f;
+			vertex.uv[0] = fx / static_cast<float>(size);
+			vertex.uv[1] = fy / static_cast<float>(size);
+			mesh.vertices.push_back(vertex);
+		}
+	}
+	const uint32_t stride = size + 1;
+	for (uint32_t y = 0; y < size; ++y) {
+		for (uint32_t x = 0; x < size; ++x) {
+			const uint32_t v = y * stride + x;
+			mesh.indices.insert(mesh.indices.end(), {v, v + 1, v + stride + 1, v, v + stride + 1, v + stride});
+		}
+	}
+	subMesh.vertexCount = static_cast<uint32_t>(mesh.vertices.size()) - subMesh.vertexOffset;
+	subMesh.indexCount = static_cast<uint32_t>(mesh.indices.size()) - subMesh.indexOffset;
+	mesh.subMeshes.push_back(subMesh);
+}
+
+// xy 平面での符号付き面積（反時計回りが正）
+float SignedArea(const MeshVertex* vertices, const uint32_t* triangle) {
+	const float* a = vertices[triangle[0]].pos;
+	const float* b = vertices[triangle[1]].pos;
+	const float* c = vertices[triangle[2]].pos;
+	return 0.5f * ((b[0] - a[0]) * (c[1] - a[1]) - (b[1] - a[1]) * (c[0] - a[0]));
+}
+
+// 2 点が正方形 [0, size]² の同じ辺の上にあるか
+bool OnSameSide(const float* a, const float* b, float size) {
+	return (a[0] == 0.0f && b[0] == 0.0f) || (a[0] == size && b[0] == size) || (a[1] == 0.0f && b[1] == 0.0f) || (a[1] == size && b[1] == size);
+}
+
+// インデックスが三角形単位で、どれも頂点の範囲に入っているか
+bool IndicesInRange(const uint32_t* indices, size_t count, size_t vertexCount) {
+	return count % 3 == 0 && std::all_of(indices, indices + count, [vertexCount](uint32_t index) { return index < vertexCount; });
+}
+
+} // namespace
+
+void RegisterMeshSimplifierTests(TestRunner& runner) {
+	runner.Add("mesh/Simplify/flat grid keeps its boundary", [] {
+		const uint32_t size = 16;
+		MeshData mesh;
+		AddGrid(mesh, size, [](float, float) { return 0.0f; });
+
+		std::vector<uint32_t> result(mesh.indices.size());
+		float error = -1.0f;
+		const size_t count = MeshSimplifier::Simplify(result.data(), mesh.indices.data(), mesh.indices.size(), mesh.vertices.data(), mesh.vertices.size(), mesh.indices.size() / 4, 1e-3f, &error);
+		// 平らなので、ずれなしで減らせる
+		CHECK(count <= mesh.indices.size() / 2);
+		CHECK(error >= 0.0f && error <= 1e-3f);
+		CHECK(IndicesInRange(result.data(), count, mesh.vertices.size()));
+
+		// 裏返った三角形がなく、面積が変わらない（縁が内側へ縮んでいない）
+		float area = 0.0f;
+		for (size_t t = 0; t < count; t += 3) {
+			const float triangleArea = SignedArea(mesh.vertices.data(), &result[t]);
+			CHECK(triangleArea > 0.0f);
+			area += triangleArea;
+		}
+		CHECK(std::abs(area - static_cast<float>(size * size)) < 1e-3f);
+
+		// 相手のいない辺はどれも正方形の辺の上にある
+		std::set<std::pair<uint32_t, uint32_t>> edges;
+		for (size_t i = 0; i < count; ++i) {
+			edges.insert({result[i], result[i - i % 3 + (i + 1) % 3]});
+		}
+		for (const auto& [a, b] : edges) {
+			if (!edges.contains({b, a})) {
+				CHECK(OnSameSide(mesh.vertices[a].pos, mesh.vertices[b].pos, static_cast<float>(size)));
+			}
+		}
+
+		// 四隅は残る
+		const uint32_t stride = size + 1;
+		for (uint32_t corner : {0u, size, size * stride, size * stride + size}) {
+			CHECK(std::find(result.begin(), result.begin() + count, corner) != result.begin() + count);
+		}
+	});
+
+	runner.Add("mesh/GenerateLods/error never decreases", [] {
+		MeshData mesh;
+		AddGrid(mesh, 32, [](float x, float y) { return 2.0f * std::sin(x * 0.3f) * std::cos(y * 0.2f); });
+		const uint32_t baseIndexCount = mesh.subMeshes[0].indexCount;
+		MeshSimplifier::GenerateLods(mesh, 4, 0.2f);
+
+		CHECK(!mesh.lods.empty());
+		float previousError = 0.0f;
+		uint32_t previousCount = baseIndexCount;
+		for (const MeshLod& lod : mesh.lods) {
+			CHECK(lod.ranges.size() == 1);
+			CHECK(std::isfinite(lod.error));
+			CHECK(lod.error >= previousError);
+			CHECK(!lod.ranges.empty() && lod.ranges[0].indexCount < previousCount);
+			previousError = lod.error;
+			previousCount = lod.ranges.empty() ? 0 : lod.ranges[0].indexCount;
+		}
+	});
+
+	runner.Add("mesh/GenerateLods/indices stay inside their sub-mesh", [] {
+		// 大きさの違う 2 つのサブメッシュ（2 つ目の頂点番号も 0 から始まる）
+		MeshData mesh;
+		AddGrid(mesh, 24, [](float x, float y) { return std::sin(x * 0.5f) + std::cos(y * 0.4f); });
+		AddGrid(mesh, 8, [](float x, float y) { return 0.1f * x * y; });
+		const std::vector<uint32_t> baseIndices = mesh.indices;
+		MeshSimplifier::GenerateLods(mesh, 3, 0.2f);
+
+		CHECK(!mesh.lods.empty());
+		// LOD0 のインデックスはそのまま
+		CHECK(std::equal(baseIndices.begin(), baseIndices.end(), mesh.indices.begin()));
+		for (const MeshLod& lod : mesh.lods) {
+			CHECK(lod.ranges.size() == mesh.subMeshes.size());
+			for (size_t s = 0; s < lod.ranges.size() && s < mesh.subMeshes.size(); ++s) {
+				const LodRange& range = lod.ranges[s];
+				CHECK(range.indexOffset >= baseIndices.size());
+				CHECK(size_t{range.indexOffset} + range.indexCount <= mesh.indices.size());
+				if (size_t{range.indexOffset} + range.indexCount <= mesh.indices.size()) {
+					CHECK(IndicesInRange(mesh.indices.data() + range.indexOffset, range.indexCount, mesh.subMeshes[s].vertexCount));
+				}
+			}
+		}
+	});
+
+	runner.Add("mesh/Simplify/degenerate and zero-area input", [] {
+		std::vector<MeshVertex> vertices(6);
+		for (uint32_t i = 0; i < 6; ++i) {
+			// 一直線に並べる（どの三角形も面積 0）
+			vertices[i].pos[0] = static_cast<float>(i);
+		}
+		const std::vector<std::vector<uint32_t>> inputs = {
+		    {},                                           // 空
+		    {0, 1, 2, 1, 2, 3, 2, 3, 4, 3, 4, 5},         // 面積 0
+		    {0, 0, 1, 1, 1, 1, 2, 3, 3, 0, 1, 2},         // 同じ頂点を 2 回以上使う
+		    {0, 1, 2, 0, 1, 2, 2, 1, 0, 3, 4, 5, 5, 4, 3}, // 同じ三角形と裏表
+		};
+		for (const std::vector<uint32_t>& indices : inputs) {
+			std::vector<uint32_t> result(indices.size());
+			float error = -1.0f;
+			const size_t count = MeshSimplifier::Simplify(result.data(), indices.data(), indices.size(), vertices.data(), vertices.size(), 3, 1.0f, &error);
+			CHECK(count <= indices.size());
+			CHECK(IndicesInRange(result.data(), count, vertices.size()));
+			CHECK(std::isfinite(error) && error >= 0.0f);
+		}
+
+		// すべての頂点が同じ位置
+		std::vector<MeshVertex> collapsed(4);
+		const uint32_t indices[] = {0, 1, 2, 1, 3, 2};
+		uint32_t result[6];
+		const size_t count = MeshSimplifier::Simplify(result, indices, 6, collapsed.data(), collapsed.size(), 0, 1.0f);
+		CHECK(IndicesInRange(result, count, collapsed.size()));
+
+		// 頂点のないモデルと、面積 0 の三角形だけのモデルには LOD を作らない（作っても範囲は正しい）
+		MeshData empty;
+		MeshSimplifier::GenerateLods(empty);
+		CHECK(empty.lods.empty());
+		MeshData line;
+		line.vertices = vertices;
+		line.indices = inputs[1];
+		line.subMeshes.push_back({"line", -1, 0, 6, 0, static_cast<uint32_t>(inputs[1].size())});
+		MeshSimplifier::GenerateLods(line);
+		for (const MeshLod& lod : line.lods) {
+			CHECK(std::isfinite(lod.error));
+			for (const LodRange& range : lod.ranges) {
+				CHECK(size_t{range.indexOffset} + range.indexCount <= line.indices.size());
+			}
+		}
+	});
+}
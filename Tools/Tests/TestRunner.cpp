@@ -0,0 +1,33 @@
+#include "TestRunner.h"
+#include <cstdio>
+
+namespace {
+// 実行中のテストで外れた CHECK の数
+int failures = 0;
+} // namespace
+
+void TestRunner::Add(std::string name, Function function) { entries_.push_back({std::move(name), std::move(function)}); }
+
+int TestRunner::Run(const std::string& filter) const {
+	int failed = 0;
+	int ran = 0;
+	for (const Entry& entry : entries_) {
+		if (!filter.empty() && entry.name.find(filter) == std::string::npos) {
+			continue;
+		}
+		failures = 0;
+		entry.function();
+		++ran;
+		if (failures > 0) {
+			++failed;
+		}
+		std::printf("%-56s %s\n", entry.name.c_str(), failures > 0 ? "FAILED" : "ok");
+	}
+	std::printf("%d test(s), %d failed\n", ran, failed);
+	return failed;
+}
+
+void TestRunner::Fail(const char* file, int line, const char* expression) {
+	++failures;
+	std::printf("  %s:%d: CHECK(%s)\n", file, line, expression);
+}
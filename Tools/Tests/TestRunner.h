@@ -0,0 +1,28 @@
+#pragma once
+#include <functional>
+#include <string>
+#include <vector>
+
+// 単体テストの実行と集計
+// テストは名前（「分類/対象/条件」）と関数の組で登録する。CHECK が外れても止めずに続け、場所と式を表示して失敗を数える。
+class TestRunner {
+public:
+	using Function = std::function<void()>;
+
+	void Add(std::string name, Function function);
+	// 名前に filter を含むもの（空なら全部）を実行し、失敗したテストの数を返す
+	int Run(const std::string& filter) const;
+
+	// CHECK から呼ぶ（実行中のテストを失敗にする）
+	static void Fail(const char* file, int line, const char* expression);
+
+private:
+	struct Entry {
+		std::string name;
+		Function function;
+	};
+	std::vector<Entry> entries_;
+};
+
+// 式が false ならテストを失敗にする（そのまま続ける）
+#define CHECK(expression) ((expression) ? (void)0 : TestRunner::Fail(__FILE__, __LINE__, #expression))
@@ -0,0 +1,8 @@
+#pragma once
+#include "TestRunner.h"
+
+// テストの登録（名前は「分類/対象/条件」。ctest は分類ごとに --filter を変えて回す）
+void RegisterConstBufferAllocatorTests(TestRunner& runner);
+void RegisterMathConformanceTests(TestRunner& runner);
+void RegisterFastMathTests(TestRunner& runner);
+void RegisterMeshSimplifierTests(TestRunner& runner);
@@ -0,0 +1,26 @@
+// ゲームのコードのうち Windows なしで動くものの単体テスト
+// 実行は ctest（分類ごとに 1 つのテストとして登録してある）か、直接 Tests [--filter 文字列]。
+// 失敗したテストがあれば終了コード 1 を返す。
+#include "Tests.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+int main(int argc, char** argv) {
+	std::string filter;
+	for (int i = 1; i < argc; ++i) {
+		if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+			filter = argv[++i];
+		} else {
+			std::fprintf(stderr, "usage: %s [--filter text]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	TestRunner runner;
+	RegisterConstBufferAllocatorTests(runner);
+	RegisterMathConformanceTests(runner);
+	RegisterFastMathTests(runner);
+	RegisterMeshSimplifierTests(runner);
+	return runner.Run(filter) > 0 ? 1 : 0;
+}
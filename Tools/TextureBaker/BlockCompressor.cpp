@@ -0,0 +1,789 @@
+#include "BlockCompressor.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// 点の集まりの主軸に沿った両端を low と high に返す（N はチャンネル数）
+template<int N> void FitEndpoints(const float (*points)[4], int count, float* low, float* high) {
+	float mean[4] = {};
+	for (int i = 0; i < count; ++i) {
+		for (int c = 0; c < N; ++c) {
+			mean[c] += points[i][c];
+		}
+	}
+	for (int c = 0; c < N; ++c) {
+		mean[c] /= static_cast<float>(count);
+	}
+	float covariance[4][4] = {};
+	for (int i = 0; i < count; ++i) {
+		for (int a = 0; a < N; ++a) {
+			for (int b = 0; b < N; ++b) {
+				covariance[a][b] += (points[i][a] - mean[a]) * (points[i][b] - mean[b]);
+			}
+		}
+	}
+
+	// 分散の一番大きいチャンネルの行から始めてべき乗法で主軸を求める
+	int largest = 0;
+	for (int c = 1; c < N; ++c) {
+		if (covariance[c][c] > covariance[largest][largest]) {
+			largest = c;
+		}
+	}
+	float axis[4] = {};
+	for (int c = 0; c < N; ++c) {
+		axis[c] = covariance[largest][c];
+	}
+	for (int iteration = 0; iteration < 8; ++iteration) {
+		float next[4] = {};
+		float scale = 0.0f;
+		for (int a = 0; a < N; ++a) {
+			for (int b = 0; b < N; ++b) {
+				next[a] += covariance[a][b] * axis[b];
+			}
+			scale = std::max(scale, std::abs(next[a]));
+		}
+		if (scale == 0.0f) {
+			break;
+		}
+		for (int c = 0; c < N; ++c) {
+			axis[c] = next[c] / scale;
+		}
+	}
+	float lengthSquared = 0.0f;
+	for (int c = 0; c < N; ++c) {
+		lengthSquared += axis[c] * axis[c];
+	}
+
+	// すべて同じ点なら両端とも平均
+	if (lengthSquared < 1e-12f) {
+		std::memcpy(low, mean, sizeof(float) * N);
+		std::memcpy(high, mean, sizeof(float) * N);
+		return;
+	}
+	float minimum = 0.0f;
+	float maximum = 0.0f;
+	for (int i = 0; i < count; ++i) {
+		float t = 0.0f;
+		for (int c = 0; c < N; ++c) {
+			t += (points[i][c] - mean[c]) * axis[c];
+		}
+		minimum = std::min(minimum, t);
+		maximum = std::max(maximum, t);
+	}
+	for (int c = 0; c < N; ++c) {
+		low[c] = mean[c] + axis[c] * minimum / lengthSquared;
+		high[c] = mean[c] + axis[c] * maximum / lengthSquared;
+	}
+}
+
+// 番号ごとの重み（weight は 2 つめの端の割合）から両端を最小二乗で求める。解けなければ false
+template<int N> bool SolveEndpoints(const float (*points)[4], const float* weights, int count, float* first, float* second) {
+	float aa = 0.0f;
+	float ab = 0.0f;
+	float bb = 0.0f;
+	float ap[4] = {};
+	float bp[4] = {};
+	for (int i = 0; i < count; ++i) {
+		const float b = weights[i];
+		const float a = 1.0f - b;
+		aa += a * a;
+		ab += a * b;
+		bb += b * b;
+		for (int c = 0; c < N; ++c) {
+			ap[c] += a * points[i][c];
+			bp[c] += b * points[i][c];
+		}
+	}
+	const float determinant = aa * bb - ab * ab;
+	if (std::abs(determinant) < 1e-6f) {
+		return false;
+	}
+	for (int c = 0; c < N; ++c) {
+		first[c] = std::clamp((ap[c] * bb - bp[c] * ab) / determinant, 0.0f, 255.0f);
+		second[c] = std::clamp((bp[c] * aa - ap[c] * ab) / determinant, 0.0f, 255.0f);
+	}
+	return true;
+}
+
+void LoadPoints(const uint8_t* pixels, float (*points)[4]) {
+	for (int i = 0; i < 16; ++i) {
+		for (int c = 0; c < 4; ++c) {
+			points[i][c] = pixels[i * 4 + c];
+		}
+	}
+}
+
+// ---- BC1 ----
+
+uint32_t Expand5(uint32_t value) { return value << 3 | value >> 2; }
+uint32_t Expand6(uint32_t value) { return value << 2 | value >> 4; }
+
+uint16_t Pack565(const float* color) {
+	const uint32_t r = static_cast<uint32_t>(std::clamp(color[0], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+	const uint32_t g = static_cast<uint32_t>(std::clamp(color[1], 0.0f, 255.0f) * 63.0f / 255.0f + 0.5f);
+	const uint32_t b = static_cast<uint32_t>(std::clamp(color[2], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+	return static_cast<uint16_t>(r << 11 | g << 5 | b);
+}
+
+void Unpack565(uint16_t packed, int* color) {
+	color[0] = static_cast<int>(Expand5(packed >> 11 & 31));
+	color[1] = static_cast<int>(Expand6(packed >> 5 & 63));
+	color[2] = static_cast<int>(Expand5(packed & 31));
+}
+
+// 4 色（fourColor）または 3 色 + 透明の色表
+void MakePalette(uint16_t first, uint16_t second, bool fourColor, int (*palette)[3]) {
+	Unpack565(first, palette[0]);
+	Unpack565(second, palette[1]);
+	for (int c = 0; c < 3; ++c) {
+		if (fourColor) {
+			palette[2][c] = (2 * palette[0][c] + palette[1][c] + 1) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c] + 1) / 3;
+		} else {
+			palette[2][c] = (palette[0][c] + palette[1][c] + 1) / 2;
+			palette[3][c] = 0;
+		}
+	}
+}
+
+int ColorDistance(const int* a, const float* b) {
+	int sum = 0;
+	for (int c = 0; c < 3; ++c) {
+		const int d = a[c] - static_cast<int>(b[c]);
+		sum += d * d;
+	}
+	return sum;
+}
+
+// 単色のブロック用に、8 ビットの値ごとに 2/3 : 1/3 の点がもっとも近くなる両端
+struct SingleColorTable {
+	uint8_t match5[256][2];
+	uint8_t match6[256][2];
+	SingleColorTable() {
+		Fill(match5, 31, Expand5);
+		Fill(match6, 63, Expand6);
+	}
+	static void Fill(uint8_t (*table)[2], uint32_t maximum, uint32_t (*expand)(uint32_t)) {
+		for (int value = 0; value < 256; ++value) {
+			int bestError = 1 << 30;
+			for (uint32_t a = 0; a <= maximum; ++a) {
+				for (uint32_t b = 0; b <= maximum; ++b) {
+					const int mixed = static_cast<int>((2 * expand(a) + expand(b) + 1) / 3);
+					// 同じ誤差なら両端の差が小さいほう
+					const int error = std::abs(mixed - value) * 256 + std::abs(static_cast<int>(a) - static_cast<int>(b));
+					if (error < bestError) {
+						bestError = error;
+						table[value][0] = static_cast<uint8_t>(a);
+						table[value][1] = static_cast<uint8_t>(b);
+					}
+				}
+			}
+		}
+	}
+};
+const SingleColorTable kSingleColor;
+
+// 4 色モードで番号を選んで誤差を返す
+int AssignIndices4(const float (*points)[4], uint16_t first, uint16_t second, uint32_t& bitmap) {
+	int palette[4][3];
+	MakePalette(first, second, true, palette);
+	int total = 0;
+	bitmap = 0;
+	for (int i = 0; i < 16; ++i) {
+		int best = 0;
+		int bestError = ColorDistance(palette[0], points[i]);
+		for (int k = 1; k < 4; ++k) {
+			const int error = ColorDistance(palette[k], points[i]);
+			if (error < bestError) {
+				bestError = error;
+				best = k;
+			}
+		}
+		total += bestError;
+		bitmap |= static_cast<uint32_t>(best) << (i * 2);
+	}
+	return total;
+}
+
+// 色の部分（BC3 でも使う。BC3 の色はつねに 4 色モードで読まれる）
+void EncodeColor4(const uint8_t* pixels, BC1Block& out) {
+	float points[16][4];
+	LoadPoints(pixels, points);
+
+	bool single = true;
+	for (int i = 1; i < 16 && single; ++i) {
+		single = std::memcmp(pixels, pixels + i * 4, 3) == 0;
+	}
+	if (single) {
+		const uint8_t* color = pixels;
+		out.rgb[0] = static_cast<uint16_t>(kSingleColor.match5[color[0]][0] << 11 | kSingleColor.match6[color[1]][0] << 5 | kSingleColor.match5[color[2]][0]);
+		out.rgb[1] = static_cast<uint16_t>(kSingleColor.match5[color[0]][1] << 11 | kSingleColor.match6[color[1]][1] << 5 | kSingleColor.match5[color[2]][1]);
+		out.bitmap = 0xAAAAAAAA; // すべて番号 2
+	} else {
+		float low[4];
+		float high[4];
+		FitEndpoints<3>(points, 16, low, high);
+		out.rgb[0] = Pack565(high);
+		out.rgb[1] = Pack565(low);
+		int error = AssignIndices4(points, out.rgb[0], out.rgb[1], out.bitmap);
+
+		static const float kWeights[4] = {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+		for (int pass = 0; pass < 2 && error > 0; ++pass) {
+			float weights[16];
+			for (int i = 0; i < 16; ++i) {
+				weights[i] = kWeights[out.bitmap >> (i * 2) & 3];
+			}
+			float first[4];
+			float second[4];
+			if (!SolveEndpoints<3>(points, weights, 16, first, second)) {
+				break;
+			}
+			BC1Block candidate{{Pack565(first), Pack565(second)}, 0};
+			const int candidateError = AssignIndices4(points, candidate.rgb[0], candidate.rgb[1], candidate.bitmap);
+			if (candidateError >= error) {
+				break;
+			}
+			error = candidateError;
+			out = candidate;
+		}
+	}
+
+	// 4 色モードにするため rgb[0] > rgb[1] にそろえる（番号は 0 と 1、2 と 3 を入れ替える）
+	if (out.rgb[0] < out.rgb[1]) {
+		std::swap(out.rgb[0], out.rgb[1]);
+		out.bitmap ^= 0x55555555;
+	} else if (out.rgb[0] == out.rgb[1]) {
+		out.bitmap = 0;
+	}
+}
+
+// 3 色 + 透明のモード（アルファが 128 未満の画素を番号 3 にする）
+void EncodeColor3(const uint8_t* pixels, BC1Block& out) {
+	float points[16][4];
+	float opaque[16][4];
+	LoadPoints(pixels, points);
+	int opaqueCount = 0;
+	for (int i = 0; i < 16; ++i) {
+		if (pixels[i * 4 + 3] >= 128) {
+			std::memcpy(opaque[opaqueCount++], points[i], sizeof(points[i]));
+		}
+	}
+	if (opaqueCount == 0) {
+		out.rgb[0] = out.rgb[1] = 0;
+		out.bitmap = 0xFFFFFFFF;
+		return;
+	}
+	float low[4];
+	float high[4];
+	FitEndpoints<3>(opaque, opaqueCount, low, high);
+	out.rgb[0] = Pack565(low);
+	out.rgb[1] = Pack565(high);
+	if (out.rgb[0] > out.rgb[1]) {
+		std::swap(out.rgb[0], out.rgb[1]);
+	}
+	int palette[4][3];
+	MakePalette(out.rgb[0], out.rgb[1], false, palette);
+	out.bitmap = 0;
+	for (int i = 0; i < 16; ++i) {
+		uint32_t best = 3;
+		if (pixels[i * 4 + 3] >= 128) {
+			best = 0;
+			for (uint32_t k = 1; k < 3; ++k) {
+				if (ColorDistance(palette[k], points[i]) < ColorDistance(palette[best], points[i])) {
+					best = k;
+				}
+			}
+		}
+		out.bitmap |= best << (i * 2);
+	}
+}
+
+void DecodeColor(const BC1Block& block, bool fourColor, uint8_t* pixels) {
+	int palette[4][3];
+	MakePalette(block.rgb[0], block.rgb[1], fourColor, palette);
+	for (int i = 0; i < 16; ++i) {
+		const uint32_t index = block.bitmap >> (i * 2) & 3;
+		for (int c = 0; c < 3; ++c) {
+			pixels[i * 4 + c] = static_cast<uint8_t>(palette[index][c]);
+		}
+		pixels[i * 4 + 3] = !fourColor && index == 3 ? 0 : 255;
+	}
+}
+
+// ---- BC3 のアルファ ----
+
+void MakeAlphaPalette(uint8_t first, uint8_t second, int* palette) {
+	palette[0] = first;
+	palette[1] = second;
+	if (first > second) {
+		for (int k = 1; k < 7; ++k) {
+			palette[k + 1] = ((7 - k) * first + k * second + 3) / 7;
+		}
+	} else {
+		for (int k = 1; k < 5; ++k) {
+			palette[k + 1] = ((5 - k) * first + k * second + 2) / 5;
+		}
+		palette[6] = 0;
+		palette[7] = 255;
+	}
+}
+
+// 番号を選んで誤差を返す
+int AssignAlpha(const uint8_t* pixels, uint8_t first, uint8_t second, uint64_t& bits) {
+	int palette[8];
+	MakeAlphaPalette(first, second, palette);
+	int total = 0;
+	bits = 0;
+	for (int i = 0; i < 16; ++i) {
+		const int alpha = pixels[i * 4 + 3];
+		int best = 0;
+		for (int k = 1; k < 8; ++k) {
+			if (std::abs(palette[k] - alpha) < std::abs(palette[best] - alpha)) {
+				best = k;
+			}
+		}
+		total += (palette[best] - alpha) * (palette[best] - alpha);
+		bits |= static_cast<uint64_t>(best) << (i * 3);
+	}
+	return total;
+}
+
+void EncodeAlpha(const uint8_t* pixels, BC3Block& out) {
+	int minimum = 255;
+	int maximum = 0;
+	int innerMinimum = 255; // 0 と 255 を除いた範囲（6 段階モード用）
+	int innerMaximum = 0;
+	for (int i = 0; i < 16; ++i) {
+		const int alpha = pixels[i * 4 + 3];
+		minimum = std::min(minimum, alpha);
+		maximum = std::max(maximum, alpha);
+		if (alpha != 0 && alpha != 255) {
+			innerMinimum = std::min(innerMinimum, alpha);
+			innerMaximum = std::max(innerMaximum, alpha);
+		}
+	}
+	if (innerMinimum > innerMaximum) {
+		innerMinimum = innerMaximum = 0;
+	}
+
+	// 8 段階（first > second）
+	uint64_t bits8 = 0;
+	int error8 = 1 << 30;
+	if (maximum > minimum) {
+		error8 = AssignAlpha(pixels, static_cast<uint8_t>(maximum), static_cast<uint8_t>(minimum), bits8);
+	}
+	// 6 段階 + 0 と 255（first <= second）
+	uint64_t bits6 = 0;
+	const int error6 = AssignAlpha(pixels, static_cast<uint8_t>(innerMinimum), static_cast<uint8_t>(innerMaximum), bits6);
+
+	uint64_t bits = bits6;
+	if (error8 < error6) {
+		out.alpha[0] = static_cast<uint8_t>(maximum);
+		out.alpha[1] = static_cast<uint8_t>(minimum);
+		bits = bits8;
+	} else {
+		out.alpha[0] = static_cast<uint8_t>(innerMinimum);
+		out.alpha[1] = static_cast<uint8_t>(innerMaximum);
+	}
+	for (int i = 0; i < 6; ++i) {
+		out.bitmap[i] = static_cast<uint8_t>(bits >> (i * 8));
+	}
+}
+
+// ---- BC7 モード 6 ----
+
+const int kBC7Weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+// 8 ビットの端の値を、指定した P ビットで表せる一番近い値にする
+int QuantizeWithParity(float value, int parity) {
+	const int steps = static_cast<int>(std::floor((value - parity) / 2.0f + 0.5f));
+	return std::clamp(steps, 0, 127) * 2 + parity;
+}
+
+struct Mode6Candidate {
+	int endpoints[2][4]; // P ビットを含む 8 ビットの値
+	int parity[2];
+	uint8_t indices[16];
+	int error;
+};
+
+int Interpolate(int first, int second, int weight) { return ((64 - weight) * first + weight * second + 32) >> 6; }
+
+// 両端から番号を選び、誤差を返す
+int AssignMode6(const float (*points)[4], Mode6Candidate& candidate) {
+	int direction[4];
+	int lengthSquared = 0;
+	for (int c = 0; c < 4; ++c) {
+		direction[c] = candidate.endpoints[1][c] - candidate.endpoints[0][c];
+		lengthSquared += direction[c] * direction[c];
+	}
+	int total = 0;
+	for (int i = 0; i < 16; ++i) {
+		// 線に射影して近い番号を見つけ、前後の番号と実際の誤差で比べる
+		int guess = 0;
+		if (lengthSquared > 0) {
+			float t = 0.0f;
+			for (int c = 0; c < 4; ++c) {
+				t += (points[i][c] - candidate.endpoints[0][c]) * direction[c];
+			}
+			guess = std::clamp(static_cast<int>(t / lengthSquared * 15.0f + 0.5f), 0, 15);
+		}
+		int best = guess;
+		int bestError = 1 << 30;
+		for (int k = std::max(0, guess - 1); k <= std::min(15, guess + 1); ++k) {
+			int error = 0;
+			for (int c = 0; c < 4; ++c) {
+				const int d = Interpolate(candidate.endpoints[0][c], candidate.endpoints[1][c], kBC7Weights[k]) - static_cast<int>(points[i][c]);
+				error += d * d;
+			}
+			if (error < bestError) {
+				bestError = error;
+				best = k;
+			}
+		}
+		candidate.indices[i] = static_cast<uint8_t>(best);
+		total += bestError;
+	}
+	candidate.error = total;
+	return total;
+}
+
+// 両端（float）を P ビットの組み合わせ 4 通りで量子化して一番よいものを返す
+Mode6Candidate QuantizeMode6(const float (*points)[4], const float* first, const float* second) {
+	Mode6Candidate best{};
+	best.error = 1 << 30;
+	for (int p = 0; p < 4; ++p) {
+		Mode6Candidate candidate{};
+		candidate.parity[0] = p & 1;
+		candidate.parity[1] = p >> 1;
+		for (int c = 0; c < 4; ++c) {
+			candidate.endpoints[0][c] = QuantizeWithParity(first[c], candidate.parity[0]);
+			candidate.endpoints[1][c] = QuantizeWithParity(second[c], candidate.parity[1]);
+		}
+		if (AssignMode6(points, candidate) < best.error) {
+			best = candidate;
+		}
+	}
+	return best;
+}
+
+// ---- BC7 モード 4・5（RGB とアルファを別の線で）----
+
+const int kBC7Weights2[4] = {0, 21, 43, 64};
+const int kBC7Weights3[8] = {0, 9, 18, 27, 37, 46, 55, 64};
+
+// bits ビットの値を 8 ビットに広げる（上位ビットを下にくり返す）
+int ExpandBits(int value, int bits) { return value << (8 - bits) | value >> (2 * bits - 8); }
+
+// bits ビットで表せる一番近い値
+int QuantizeBits(float value, int bits) {
+	const int maximum = (1 << bits) - 1;
+	const int guess = std::clamp(static_cast<int>(value * maximum / 255.0f + 0.5f), 0, maximum);
+	int best = guess;
+	for (int candidate = std::max(0, guess - 1); candidate <= std::min(maximum, guess + 1); ++candidate) {
+		if (std::abs(ExpandBits(candidate, bits) - value) < std::abs(ExpandBits(best, bits) - value)) {
+			best = candidate;
+		}
+	}
+	return best;
+}
+
+// N チャンネルを 1 本の線で近似したもの（両端は bits ビットの値）
+struct LineFit {
+	int endpoints[2][4];
+	uint8_t indices[16];
+	int error;
+};
+
+// 番号を選んで誤差を返す
+template<int N> int AssignLine(const float (*points)[4], LineFit& fit, int bits, const int* weights, int weightCount) {
+	int expanded[2][4] = {};
+	for (int c = 0; c < N; ++c) {
+		expanded[0][c] = ExpandBits(fit.endpoints[0][c], bits);
+		expanded[1][c] = ExpandBits(fit.endpoints[1][c], bits);
+	}
+	fit.error = 0;
+	for (int i = 0; i < 16; ++i) {
+		int best = 0;
+		int bestError = 1 << 30;
+		for (int k = 0; k < weightCount; ++k) {
+			int error = 0;
+			for (int c = 0; c < N; ++c) {
+				const int d = Interpolate(expanded[0][c], expanded[1][c], weights[k]) - static_cast<int>(points[i][c]);
+				error += d * d;
+			}
+			if (error < bestError) {
+				bestError = error;
+				best = k;
+			}
+		}
+		fit.indices[i] = static_cast<uint8_t>(best);
+		fit.error += bestError;
+	}
+	return fit.error;
+}
+
+// 主軸の両端から始めて最小二乗で詰め直す
+template<int N> LineFit FitLine(const float (*points)[4], int bits, const int* weights, int weightCount) {
+	float low[4];
+	float high[4];
+	FitEndpoints<N>(points, 16, low, high);
+	LineFit best{};
+	for (int c = 0; c < N; ++c) {
+		best.endpoints[0][c] = QuantizeBits(low[c], bits);
+		best.endpoints[1][c] = QuantizeBits(high[c], bits);
+	}
+	AssignLine<N>(points, best, bits, weights, weightCount);
+	for (int pass = 0; pass < 2 && best.error > 0; ++pass) {
+		float fractions[16];
+		for (int i = 0; i < 16; ++i) {
+			fractions[i] = weights[best.indices[i]] / 64.0f;
+		}
+		float first[4];
+		float second[4];
+		if (!SolveEndpoints<N>(points, fractions, 16, first, second)) {
+			break;
+		}
+		LineFit candidate{};
+		for (int c = 0; c < N; ++c) {
+			candidate.endpoints[0][c] = QuantizeBits(first[c], bits);
+			candidate.endpoints[1][c] = QuantizeBits(second[c], bits);
+		}
+		if (AssignLine<N>(points, candidate, bits, weights, weightCount) >= best.error) {
+			break;
+		}
+		best = candidate;
+	}
+	// 最初の画素の番号は最上位ビットを省くので半分未満にする
+	if (best.indices[0] >= weightCount / 2) {
+		for (int c = 0; c < N; ++c) {
+			std::swap(best.endpoints[0][c], best.endpoints[1][c]);
+		}
+		for (uint8_t& index : best.indices) {
+			index = static_cast<uint8_t>(weightCount - 1 - index);
+		}
+	}
+	return best;
+}
+
+// モード 4・5 の形（モード 4 は番号の選び方 0 で、色が 2 ビット・アルファが 3 ビットの番号）
+struct SeparateMode {
+	int mode;
+	int colorBits;
+	int alphaBits;
+	int alphaIndexBits;
+};
+const SeparateMode kMode4 = {4, 5, 6, 3};
+const SeparateMode kMode5 = {5, 7, 8, 2};
+
+class BitWriter {
+public:
+	explicit BitWriter(uint8_t* bytes) : bytes_(bytes) { std::memset(bytes_, 0, 16); }
+	void Write(uint32_t value, uint32_t count) {
+		for (uint32_t i = 0; i < count; ++i, ++position_) {
+			bytes_[position_ / 8] |= static_cast<uint8_t>((value >> i & 1) << (position_ % 8));
+		}
+	}
+
+private:
+	uint8_t* bytes_;
+	uint32_t position_ = 0;
+};
+
+class BitReader {
+public:
+	explicit BitReader(const uint8_t* bytes) : bytes_(bytes) {}
+	uint32_t Read(uint32_t count) {
+		uint32_t value = 0;
+		for (uint32_t i = 0; i < count; ++i, ++position_) {
+			value |= static_cast<uint32_t>(bytes_[position_ / 8] >> (position_ % 8) & 1) << i;
+		}
+		return value;
+	}
+
+private:
+	const uint8_t* bytes_;
+	uint32_t position_ = 0;
+};
+
+} // namespace
+
+void BlockCompressor::EncodeBC1(const uint8_t* pixels, BC1Block& out) {
+	for (int i = 0; i < 16; ++i) {
+		if (pixels[i * 4 + 3] < 128) {
+			EncodeColor3(pixels, out);
+			return;
+		}
+	}
+	EncodeColor4(pixels, out);
+}
+
+void BlockCompressor::EncodeBC3(const uint8_t* pixels, BC3Block& out) {
+	EncodeAlpha(pixels, out);
+	EncodeColor4(pixels, out.bc1);
+}
+
+void BlockCompressor::EncodeBC7(const uint8_t* pixels, BC7Block& out) {
+	float points[16][4];
+	LoadPoints(pixels, points);
+
+	// モード 6: RGBA を 1 本の線で
+	float low[4];
+	float high[4];
+	FitEndpoints<4>(points, 16, low, high);
+	Mode6Candidate best = QuantizeMode6(points, low, high);
+	for (int pass = 0; pass < 2 && best.error > 0; ++pass) {
+		float weights[16];
+		for (int i = 0; i < 16; ++i) {
+			weights[i] = kBC7Weights[best.indices[i]] / 64.0f;
+		}
+		float first[4];
+		float second[4];
+		if (!SolveEndpoints<4>(points, weights, 16, first, second)) {
+			break;
+		}
+		const Mode6Candidate candidate = QuantizeMode6(points, first, second);
+		if (candidate.error >= best.error) {
+			break;
+		}
+		best = candidate;
+	}
+
+	// モード 4・5: アルファが色と別に変わるブロック用（アルファが一定ならモード 6 で足りる）
+	bool alphaVaries = false;
+	for (int i = 1; i < 16; ++i) {
+		alphaVaries |= pixels[i * 4 + 3] != pixels[3];
+	}
+	if (best.error > 0 && alphaVaries) {
+		float alphaPoints[16][4] = {};
+		for (int i = 0; i < 16; ++i) {
+			alphaPoints[i][0] = points[i][3];
+		}
+		const SeparateMode* bestMode = nullptr;
+		LineFit bestColor{};
+		LineFit bestAlpha{};
+		int bestError = best.error;
+		for (const SeparateMode* mode : {&kMode5, &kMode4}) {
+			const LineFit color = FitLine<3>(points, mode->colorBits, kBC7Weights2, 4);
+			const LineFit alpha = mode->alphaIndexBits == 2 ? FitLine<1>(alphaPoints, mode->alphaBits, kBC7Weights2, 4) : FitLine<1>(alphaPoints, mode->alphaBits, kBC7Weights3, 8);
+			if (color.error + alpha.error < bestError) {
+				bestError = color.error + alpha.error;
+				bestMode = mode;
+				bestColor = color;
+				bestAlpha = alpha;
+			}
+		}
+		if (bestMode) {
+			BitWriter writer(out.bytes);
+			writer.Write(1u << bestMode->mode, bestMode->mode + 1);
+			writer.Write(0, bestMode->mode == 4 ? 3 : 2); // チャンネルの入れ替えなし（モード 4 は番号の選び方 0 も）
+			for (int c = 0; c < 3; ++c) {
+				writer.Write(static_cast<uint32_t>(bestColor.endpoints[0][c]), bestMode->colorBits);
+				writer.Write(static_cast<uint32_t>(bestColor.endpoints[1][c]), bestMode->colorBits);
+			}
+			writer.Write(static_cast<uint32_t>(bestAlpha.endpoints[0][0]), bestMode->alphaBits);
+			writer.Write(static_cast<uint32_t>(bestAlpha.endpoints[1][0]), bestMode->alphaBits);
+			for (int i = 0; i < 16; ++i) {
+				writer.Write(bestColor.indices[i], i == 0 ? 1 : 2);
+			}
+			for (int i = 0; i < 16; ++i) {
+				writer.Write(bestAlpha.indices[i], i == 0 ? bestMode->alphaIndexBits - 1 : bestMode->alphaIndexBits);
+			}
+			return;
+		}
+	}
+
+	// 最初の画素の番号は最上位ビットを省くので 8 未満にする（両端を入れ替えて番号を反転）
+	if (best.indices[0] >= 8) {
+		for (int c = 0; c < 4; ++c) {
+			std::swap(best.endpoints[0][c], best.endpoints[1][c]);
+		}
+		std::swap(best.parity[0], best.parity[1]);
+		for (uint8_t& index : best.indices) {
+			index = static_cast<uint8_t>(15 - index);
+		}
+	}
+	BitWriter writer(out.bytes);
+	writer.Write(1u << 6, 7); // モード 6
+	for (int c = 0; c < 4; ++c) {
+		writer.Write(static_cast<uint32_t>(best.endpoints[0][c] >> 1), 7);
+		writer.Write(static_cast<uint32_t>(best.endpoints[1][c] >> 1), 7);
+	}
+	writer.Write(static_cast<uint32_t>(best.parity[0]), 1);
+	writer.Write(static_cast<uint32_t>(best.parity[1]), 1);
+	writer.Write(best.indices[0], 3);
+	for (int i = 1; i < 16; ++i) {
+		writer.Write(best.indices[i], 4);
+	}
+}
+
+void BlockCompressor::DecodeBC1(const BC1Block& block, uint8_t* pixels) { DecodeColor(block, block.rgb[0] > block.rgb[1], pixels); }
+
+void BlockCompressor::DecodeBC3(const BC3Block& block, uint8_t* pixels) {
+	DecodeColor(block.bc1, true, pixels);
+	int palette[8];
+	MakeAlphaPalette(block.alpha[0], block.alpha[1], palette);
+	uint64_t bits = 0;
+	for (int i = 0; i < 6; ++i) {
+		bits |= static_cast<uint64_t>(block.bitmap[i]) << (i * 8);
+	}
+	for (int i = 0; i < 16; ++i) {
+		pixels[i * 4 + 3] = static_cast<uint8_t>(palette[bits >> (i * 3) & 7]);
+	}
+}
+
+bool BlockCompressor::DecodeBC7(const BC7Block& block, uint8_t* pixels) {
+	BitReader reader(block.bytes);
+	const uint8_t modeBits = block.bytes[0] & 0x3F;
+	if (modeBits == 1u << 4 || modeBits == 1u << 5) {
+		// モード 4・5（チャンネルの入れ替えなし、モード 4 は番号の選び方 0 のものだけ）
+		const SeparateMode& mode = modeBits == 1u << 4 ? kMode4 : kMode5;
+		reader.Read(mode.mode + 1);
+		if (reader.Read(mode.mode == 4 ? 3 : 2) != 0) {
+			return false;
+		}
+		int color[2][3];
+		for (int c = 0; c < 3; ++c) {
+			color[0][c] = ExpandBits(static_cast<int>(reader.Read(mode.colorBits)), mode.colorBits);
+			color[1][c] = ExpandBits(static_cast<int>(reader.Read(mode.colorBits)), mode.colorBits);
+		}
+		const int alpha0 = ExpandBits(static_cast<int>(reader.Read(mode.alphaBits)), mode.alphaBits);
+		const int alpha1 = ExpandBits(static_cast<int>(reader.Read(mode.alphaBits)), mode.alphaBits);
+		for (int i = 0; i < 16; ++i) {
+			const uint32_t index = reader.Read(i == 0 ? 1 : 2);
+			for (int c = 0; c < 3; ++c) {
+				pixels[i * 4 + c] = static_cast<uint8_t>(Interpolate(color[0][c], color[1][c], kBC7Weights2[index]));
+			}
+		}
+		const int* alphaWeights = mode.alphaIndexBits == 2 ? kBC7Weights2 : kBC7Weights3;
+		for (int i = 0; i < 16; ++i) {
+			const uint32_t index = reader.Read(static_cast<uint32_t>(i == 0 ? mode.alphaIndexBits - 1 : mode.alphaIndexBits));
+			pixels[i * 4 + 3] = static_cast<uint8_t>(Interpolate(alpha0, alpha1, alphaWeights[index]));
+		}
+		return true;
+	}
+	if (reader.Read(7) != 1u << 6) {
+		return false;
+	}
+	int endpoints[2][4];
+	for (int c = 0; c < 4; ++c) {
+		endpoints[0][c] = static_cast<int>(reader.Read(7)) << 1;
+		endpoints[1][c] = static_cast<int>(reader.Read(7)) << 1;
+	}
+	const int parity0 = static_cast<int>(reader.Read(1));
+	const int parity1 = static_cast<int>(reader.Read(1));
+	for (int c = 0; c < 4; ++c) {
+		endpoints[0][c] |= parity0;
+		endpoints[1][c] |= parity1;
+	}
+	for (int i = 0; i < 16; ++i) {
+		const uint32_t index = reader.Read(i == 0 ? 3 : 4);
+		for (int c = 0; c < 4; ++c) {
+			pixels[i * 4 + c] = static_cast<uint8_t>(Interpolate(endpoints[0][c], endpoints[1][c], kBC7Weights[index]));
+		}
+	}
+	return true;
+}
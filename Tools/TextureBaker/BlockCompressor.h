@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+
+// DirectXTex の BC.h（D3DX_BC1 / D3DX_BC3）と同じ並びのブロック
+struct BC1Block {
+	uint16_t rgb[2]; // 565 の両端の色
+	uint32_t bitmap; // 画素ごとに 2 ビットの番号
+};
+struct BC3Block {
+	uint8_t alpha[2];  // アルファの両端
+	uint8_t bitmap[6]; // 画素ごとに 3 ビットの番号
+	BC1Block bc1;
+};
+// BC7 は 128 ビットを下位ビットから詰める
+struct BC7Block {
+	uint8_t bytes[16];
+};
+static_assert(sizeof(BC1Block) == 8);
+static_assert(sizeof(BC3Block) == 16);
+static_assert(sizeof(BC7Block) == 16);
+
+// 4x4 画素のブロック圧縮
+// 入力と出力の画素は RGBA8 を左上から行ごとに 16 個並べたもの（64 バイト）。
+// 両端は画素の主軸（べき乗法で求める）の両端から始め、番号を決めたあと最小二乗で両端を 2 回まで詰め直す。
+class BlockCompressor {
+public:
+	// アルファが 128 未満の画素があれば 3 色モードの透明にする
+	static void EncodeBC1(const uint8_t* pixels, BC1Block& out);
+	// アルファは 8 段階と（0 と 255 を含む）6 段階の両方を試して誤差の小さいほうを使う
+	static void EncodeBC3(const uint8_t* pixels, BC3Block& out);
+	// 分割のないモードのうち、6（RGBA を 1 本の線で、4 ビットの番号）と、アルファが変わるブロックでは 5 と 4（RGB とアルファを別の線で）を試して誤差の一番小さいものを使う
+	static void EncodeBC7(const uint8_t* pixels, BC7Block& out);
+
+	static void DecodeBC1(const BC1Block& block, uint8_t* pixels);
+	static void DecodeBC3(const BC3Block& block, uint8_t* pixels);
+	// EncodeBC7 が書くモード 4・5（チャンネルの入れ替えなし）と 6 だけを戻す（ほかのモードは false）
+	static bool DecodeBC7(const BC7Block& block, uint8_t* pixels);
+};
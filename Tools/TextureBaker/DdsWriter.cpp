@@ -0,0 +1,122 @@
+#include "DdsWriter.h"
+#include <fstream>
+
+namespace {
+
+// DirectXTex の DDS.h と同じ並び
+struct DdsPixelFormat {
+	uint32_t size;
+	uint32_t flags;
+	uint32_t fourCC;
+	uint32_t rgbBitCount;
+	uint32_t rBitMask;
+	uint32_t gBitMask;
+	uint32_t bBitMask;
+	uint32_t aBitMask;
+};
+struct DdsHeader {
+	uint32_t size;
+	uint32_t flags;
+	uint32_t height;
+	uint32_t width;
+	uint32_t pitchOrLinearSize;
+	uint32_t depth;
+	uint32_t mipMapCount;
+	uint32_t reserved1[11];
+	DdsPixelFormat pixelFormat;
+	uint32_t caps;
+	uint32_t caps2;
+	uint32_t caps3;
+	uint32_t caps4;
+	uint32_t reserved2;
+};
+struct DdsHeaderDxt10 {
+	uint32_t dxgiFormat;
+	uint32_t resourceDimension;
+	uint32_t miscFlag;
+	uint32_t arraySize;
+	uint32_t miscFlags2;
+};
+static_assert(sizeof(DdsPixelFormat) == 32);
+static_assert(sizeof(DdsHeader) == 124);
+static_assert(sizeof(DdsHeaderDxt10) == 20);
+
+const uint32_t kMagic = 0x20534444; // "DDS "
+const uint32_t kFourCCDx10 = 0x30315844; // "DX10"
+const uint32_t kPixelFormatFourCC = 0x4;
+const uint32_t kHeaderCaps = 0x1;
+const uint32_t kHeaderHeight = 0x2;
+const uint32_t kHeaderWidth = 0x4;
+const uint32_t kHeaderPitch = 0x8;
+const uint32_t kHeaderPixelFormat = 0x1000;
+const uint32_t kHeaderMipMapCount = 0x20000;
+const uint32_t kHeaderLinearSize = 0x80000;
+const uint32_t kCapsComplex = 0x8;
+const uint32_t kCapsTexture = 0x1000;
+const uint32_t kCapsMipMap = 0x400000;
+const uint32_t kDimensionTexture2D = 3;
+
+} // namespace
+
+uint32_t DdsWriter::GetDxgiFormat(TextureFormat format, bool srgb) {
+	switch (format) {
+	case TextureFormat::BC1:
+		return srgb ? 72 : 71; // DXGI_FORMAT_BC1_UNORM(_SRGB)
+	case TextureFormat::BC3:
+		return srgb ? 78 : 77; // DXGI_FORMAT_BC3_UNORM(_SRGB)
+	case TextureFormat::BC7:
+		return srgb ? 99 : 98; // DXGI_FORMAT_BC7_UNORM(_SRGB)
+	default:
+		return srgb ? 29 : 28; // DXGI_FORMAT_R8G8B8A8_UNORM(_SRGB)
+	}
+}
+
+size_t DdsWriter::GetLevelSize(TextureFormat format, uint32_t width, uint32_t height) {
+	if (format == TextureFormat::RGBA8) {
+		return size_t{width} * height * 4;
+	}
+	const size_t blocks = size_t{(width + 3) / 4} * ((height + 3) / 4);
+	return blocks * (format == TextureFormat::BC1 ? 8 : 16);
+}
+
+bool DdsWriter::Write(const std::filesystem::path& path, TextureFormat format, bool srgb, uint32_t width, uint32_t height, const std::vector<std::vector<uint8_t>>& levels) {
+	const bool compressed = format != TextureFormat::RGBA8;
+	DdsHeader header{};
+	header.size = sizeof(DdsHeader);
+	header.flags = kHeaderCaps | kHeaderHeight | kHeaderWidth | kHeaderPixelFormat | kHeaderMipMapCount | (compressed ? kHeaderLinearSize : kHeaderPitch);
+	header.height = height;
+	header.width = width;
+	header.pitchOrLinearSize = static_cast<uint32_t>(compressed ? GetLevelSize(format, width, height) : size_t{width} * 4);
+	header.depth = 1;
+	header.mipMapCount = static_cast<uint32_t>(levels.size());
+	header.pixelFormat.size = sizeof(DdsPixelFormat);
+	header.pixelFormat.flags = kPixelFormatFourCC;
+	header.pixelFormat.fourCC = kFourCCDx10;
+	header.caps = kCapsTexture | (levels.size() > 1 ? kCapsComplex | kCapsMipMap : 0u);
+
+	DdsHeaderDxt10 extension{};
+	extension.dxgiFormat = GetDxgiFormat(format, srgb);
+	extension.resourceDimension = kDimensionTexture2D;
+	extension.arraySize = 1;
+
+	std::filesystem::path temporary = path;
+	temporary += ".tmp";
+	{
+		std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+		if (!file.is_open()) {
+			return false;
+		}
+		file.write(reinterpret_cast<const char*>(&kMagic), sizeof(kMagic));
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(&extension), sizeof(extension));
+		for (const std::vector<uint8_t>& level : levels) {
+			file.write(reinterpret_cast<const char*>(level.data()), static_cast<std::streamsize>(level.size()));
+		}
+		if (!file) {
+			return false;
+		}
+	}
+	std::error_code error;
+	std::filesystem::rename(temporary, path, error);
+	return !error;
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+// 書き出す画素の形式
+enum class TextureFormat {
+	RGBA8, // 無圧縮（辺が 4 の倍数でない画像用）
+	BC1,
+	BC3,
+	BC7,
+};
+
+// DDS ファイルの書き出し
+// DX10 拡張ヘッダで DXGI_FORMAT を書くので、*_SRGB も区別できる（DirectXTex の LoadFromDDSFile でそのまま読める）。
+class DdsWriter {
+public:
+	// DXGI_FORMAT の値
+	static uint32_t GetDxgiFormat(TextureFormat format, bool srgb);
+	// 1 段の大きさ[byte]（BC は 4x4 ブロック単位に切り上げる）
+	static size_t GetLevelSize(TextureFormat format, uint32_t width, uint32_t height);
+
+	// levels は mip0 から順に、各段の画素（またはブロック）を詰めたもの
+	// 一時ファイルに書いてから置き換えるので、途中で止まっても壊れた .dds は残らない
+	static bool Write(const std::filesystem::path& path, TextureFormat format, bool srgb, uint32_t width, uint32_t height, const std::vector<std::vector<uint8_t>>& levels);
+};
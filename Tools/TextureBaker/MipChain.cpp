@@ -0,0 +1,160 @@
+#include "MipChain.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <xmmintrin.h>
+#define MIPCHAIN_USE_SSE
+#endif
+
+namespace {
+
+// 縮めた 1 画素が元のどの画素からどれだけ取るか（縮小率は 2 倍なので多くて 3 画素）
+struct Tap {
+	uint32_t index[3] = {};
+	float weight[3] = {};
+};
+
+// 長さ source を destination に縮めるときの重み（元の画素が重なる長さに比例）
+std::vector<Tap> MakeTaps(uint32_t source, uint32_t destination) {
+	std::vector<Tap> taps(destination);
+	const double scale = static_cast<double>(source) / destination;
+	for (uint32_t i = 0; i < destination; ++i) {
+		const double begin = i * scale;
+		const double end = (i + 1) * scale;
+		uint32_t count = 0;
+		for (uint32_t j = static_cast<uint32_t>(begin); j < source && j < end && count < 3; ++j) {
+			const double overlap = std::min<double>(end, j + 1.0) - std::max<double>(begin, j);
+			if (overlap <= 0.0) {
+				continue;
+			}
+			taps[i].index[count] = j;
+			taps[i].weight[count] = static_cast<float>(overlap / scale);
+			++count;
+		}
+		// 使わない枠は重み 0 で最初の画素を指しておく
+		for (uint32_t k = count; k < 3; ++k) {
+			taps[i].index[k] = taps[i].index[0];
+		}
+	}
+	return taps;
+}
+
+// destination（RGBA 4 個）= Σ weight * source[index * stride]
+inline void Filter(float* destination, const float* source, size_t stride, const Tap& tap) {
+#ifdef MIPCHAIN_USE_SSE
+	__m128 sum = _mm_mul_ps(_mm_set1_ps(tap.weight[0]), _mm_loadu_ps(source + tap.index[0] * stride));
+	sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(tap.weight[1]), _mm_loadu_ps(source + tap.index[1] * stride)));
+	sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(tap.weight[2]), _mm_loadu_ps(source + tap.index[2] * stride)));
+	_mm_storeu_ps(destination, sum);
+#else
+	for (int c = 0; c < 4; ++c) {
+		destination[c] = tap.weight[0] * source[tap.index[0] * stride + c] + tap.weight[1] * source[tap.index[1] * stride + c] + tap.weight[2] * source[tap.index[2] * stride + c];
+	}
+#endif
+}
+
+// sRGB の 8 ビット値から線形の値への表
+struct SrgbTable {
+	float values[256];
+	SrgbTable() {
+		for (int i = 0; i < 256; ++i) {
+			const double c = i / 255.0;
+			values[i] = static_cast<float>(c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4));
+		}
+	}
+};
+const SrgbTable kSrgbTable;
+
+// 線形・アルファ乗算済みの float から RGBA8 へ
+void Store(const float* linear, size_t pixelCount, uint8_t* pixels) {
+	for (size_t i = 0; i < pixelCount; ++i) {
+		const float* p = linear + i * 4;
+		const float alpha = std::clamp(p[3], 0.0f, 1.0f);
+		const float inverse = alpha > 0.0f ? 1.0f / alpha : 0.0f;
+		for (int c = 0; c < 3; ++c) {
+			pixels[i * 4 + c] = MipChain::LinearToSrgb(p[c] * inverse);
+		}
+		pixels[i * 4 + 3] = static_cast<uint8_t>(alpha * 255.0f + 0.5f);
+	}
+}
+
+} // namespace
+
+float MipChain::SrgbToLinear(uint8_t value) { return kSrgbTable.values[value]; }
+
+uint8_t MipChain::LinearToSrgb(float value) {
+	const float c = std::clamp(value, 0.0f, 1.0f);
+	const float encoded = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+	return static_cast<uint8_t>(encoded * 255.0f + 0.5f);
+}
+
+uint32_t MipChain::CountLevels(uint32_t width, uint32_t height) {
+	uint32_t levels = 1;
+	while (width > 1 || height > 1) {
+		width = std::max(1u, width / 2);
+		height = std::max(1u, height / 2);
+		++levels;
+	}
+	return levels;
+}
+
+std::vector<Image> MipChain::Build(const Image& source, uint32_t threadCount) {
+	std::vector<Image> levels;
+	levels.reserve(CountLevels(source.width, source.height));
+	levels.push_back(source);
+
+	// 縮小は前の段の float から行うので、8 ビットへの丸めは段を重ねてもたまらない
+	std::vector<float> current(size_t{source.width} * source.height * 4);
+	for (size_t i = 0; i < size_t{source.width} * source.height; ++i) {
+		const uint8_t* p = source.pixels.data() + i * 4;
+		const float alpha = p[3] / 255.0f;
+		for (int c = 0; c < 3; ++c) {
+			current[i * 4 + c] = SrgbToLinear(p[c]) * alpha;
+		}
+		current[i * 4 + 3] = alpha;
+	}
+
+	uint32_t width = source.width;
+	uint32_t height = source.height;
+	std::vector<float> horizontal;
+	std::vector<float> next;
+	while (width > 1 || height > 1) {
+		const uint32_t nextWidth = std::max(1u, width / 2);
+		const uint32_t nextHeight = std::max(1u, height / 2);
+		const std::vector<Tap> tapsX = MakeTaps(width, nextWidth);
+		const std::vector<Tap> tapsY = MakeTaps(height, nextHeight);
+
+		// 横に縮める（nextWidth x height）
+		horizontal.resize(size_t{nextWidth} * height * 4);
+		ParallelFor(height, threadCount, [&](size_t y) {
+			const float* row = current.data() + y * width * 4;
+			float* out = horizontal.data() + y * nextWidth * 4;
+			for (uint32_t x = 0; x < nextWidth; ++x) {
+				Filter(out + size_t{x} * 4, row, 4, tapsX[x]);
+			}
+		});
+
+		// 縦に縮めて 8 ビットにもどす
+		next.resize(size_t{nextWidth} * nextHeight * 4);
+		Image level;
+		level.width = nextWidth;
+		level.height = nextHeight;
+		level.srgb = source.srgb;
+		level.pixels.resize(size_t{nextWidth} * nextHeight * 4);
+		ParallelFor(nextHeight, threadCount, [&](size_t y) {
+			float* out = next.data() + y * nextWidth * 4;
+			for (uint32_t x = 0; x < nextWidth; ++x) {
+				Filter(out + size_t{x} * 4, horizontal.data() + size_t{x} * 4, size_t{nextWidth} * 4, tapsY[y]);
+			}
+			Store(out, nextWidth, level.pixels.data() + y * nextWidth * 4);
+		});
+
+		levels.push_back(std::move(level));
+		current.swap(next);
+		width = nextWidth;
+		height = nextHeight;
+	}
+	return levels;
+}
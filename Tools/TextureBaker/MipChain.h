@@ -0,0 +1,20 @@
+#pragma once
+#include "PngDecoder.h"
+#include <cstdint>
+#include <vector>
+
+// sRGB を考えたミップマップの生成
+// 画素は sRGB で描かれているものとして線形の光の量にもどし、アルファを掛けてから縮めて、また sRGB にもどす。
+// 辺が奇数のときは 3 画素にまたがる面積の重みで縮めるので、端の行や列が落ちない。
+// 縮小は縦横に分けて、1 画素の RGBA を SSE でまとめて計算する（SSE がなければスカラー）。
+class MipChain {
+public:
+	// 1x1 までの段数
+	static uint32_t CountLevels(uint32_t width, uint32_t height);
+
+	// source を mip0 として 1x1 までの全段を返す（段の中の行を threadCount 本のスレッドで分ける）
+	static std::vector<Image> Build(const Image& source, uint32_t threadCount);
+
+	static float SrgbToLinear(uint8_t value);
+	static uint8_t LinearToSrgb(float value);
+};
@@ -0,0 +1,28 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// [0, count) を threadCount 本のスレッド（呼んだスレッドを含む）で処理する
+// 番号は一つずつ取り合うので、重さが偏っていても空くスレッドが出にくい
+template<typename Function> void ParallelFor(size_t count, uint32_t threadCount, Function&& function) {
+	std::atomic<size_t> next{0};
+	auto worker = [&]() {
+		for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+			function(i);
+		}
+	};
+	const size_t helperCount = std::min<size_t>(threadCount, count) - (count > 0 ? 1 : 0);
+	std::vector<std::thread> helpers;
+	helpers.reserve(helperCount);
+	for (size_t i = 0; i < helperCount; ++i) {
+		helpers.emplace_back(worker);
+	}
+	worker();
+	for (std::thread& helper : helpers) {
+		helper.join();
+	}
+}
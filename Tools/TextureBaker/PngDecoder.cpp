@@ -0,0 +1,475 @@
+#include "PngDecoder.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+// 下位ビットから順に読む（データの後ろは 0 が続くものとして読み、読みすぎたかは最後に確かめる）
+class BitReader {
+public:
+	BitReader(const uint8_t* data, size_t size) : data_(data), end_(data + size) {}
+
+	// count ビット（最大 32）を先読みする
+	uint32_t Peek(uint32_t count) {
+		Refill();
+		return static_cast<uint32_t>(buffer_ & ((uint64_t{1} << count) - 1));
+	}
+	void Consume(uint32_t count) {
+		buffer_ >>= count;
+		bits_ -= count;
+	}
+	uint32_t Read(uint32_t count) {
+		const uint32_t value = Peek(count);
+		Consume(count);
+		return value;
+	}
+	// 次のバイト境界まで読み飛ばす
+	void AlignToByte() {
+		Refill();
+		Consume(bits_ % 8);
+	}
+	// データの終わりを越えて読んだか
+	bool Overrun() const { return bits_ < padding_ * 8; }
+
+private:
+	void Refill() {
+		while (bits_ <= 56) {
+			uint64_t byte = 0;
+			if (data_ < end_) {
+				byte = *data_++;
+			} else {
+				++padding_;
+			}
+			buffer_ |= byte << bits_;
+			bits_ += 8;
+		}
+	}
+
+	const uint8_t* data_;
+	const uint8_t* end_;
+	uint64_t buffer_ = 0;
+	uint32_t bits_ = 0;
+	size_t padding_ = 0;
+};
+
+// 正準ハフマン符号の表（最長の符号長ぶんのビットで直接引く）
+class Huffman {
+public:
+	bool Build(const uint8_t* lengths, uint32_t count) {
+		uint32_t counts[16] = {};
+		bits_ = 0;
+		for (uint32_t i = 0; i < count; ++i) {
+			++counts[lengths[i]];
+			bits_ = std::max<uint32_t>(bits_, lengths[i]);
+		}
+		counts[0] = 0;
+		// 符号が多すぎたら壊れている（足りないのは、使われない符号があるだけなので許す）
+		int32_t left = 1;
+		for (uint32_t length = 1; length < 16; ++length) {
+			left = left * 2 - static_cast<int32_t>(counts[length]);
+			if (left < 0) {
+				return false;
+			}
+		}
+		uint32_t next[16] = {};
+		uint32_t code = 0;
+		for (uint32_t length = 1; length < 16; ++length) {
+			code = (code + counts[length - 1]) << 1;
+			next[length] = code;
+		}
+
+		// 符号は上位ビットから入っているので、逆順にして下位ビットから引けるようにする
+		table_.assign(size_t{1} << bits_, 0);
+		for (uint32_t symbol = 0; symbol < count; ++symbol) {
+			const uint32_t length = lengths[symbol];
+			if (length == 0) {
+				continue;
+			}
+			const uint32_t value = next[length]++;
+			uint32_t reversed = 0;
+			for (uint32_t i = 0; i < length; ++i) {
+				reversed |= ((value >> i) & 1) << (length - 1 - i);
+			}
+			for (size_t i = reversed; i < table_.size(); i += size_t{1} << length) {
+				table_[i] = static_cast<uint16_t>(symbol << 4 | length);
+			}
+		}
+		return true;
+	}
+
+	// 記号を返す（表にない符号なら -1）
+	int32_t Decode(BitReader& reader) const {
+		const uint16_t entry = table_[reader.Peek(bits_)];
+		const uint32_t length = entry & 15;
+		if (length == 0) {
+			return -1;
+		}
+		reader.Consume(length);
+		return entry >> 4;
+	}
+
+private:
+	std::vector<uint16_t> table_;
+	uint32_t bits_ = 0;
+};
+
+const uint16_t kLengthBase[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+const uint8_t kLengthExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+const uint16_t kDistanceBase[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+const uint8_t kDistanceExtra[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+const uint8_t kCodeLengthOrder[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+// 符号付きブロック（固定・動的ハフマン）の表を読む
+bool ReadTables(BitReader& reader, uint32_t type, Huffman& literal, Huffman& distance) {
+	uint8_t lengths[320] = {};
+	if (type == 1) {
+		// 固定ハフマン
+		std::fill(lengths, lengths + 144, uint8_t{8});
+		std::fill(lengths + 144, lengths + 256, uint8_t{9});
+		std::fill(lengths + 256, lengths + 280, uint8_t{7});
+		std::fill(lengths + 280, lengths + 288, uint8_t{8});
+		std::fill(lengths + 288, lengths + 318, uint8_t{5});
+		return literal.Build(lengths, 288) && distance.Build(lengths + 288, 30);
+	}
+
+	const uint32_t literalCount = reader.Read(5) + 257;
+	const uint32_t distanceCount = reader.Read(5) + 1;
+	const uint32_t codeLengthCount = reader.Read(4) + 4;
+	if (literalCount > 286 || distanceCount > 30) {
+		return false;
+	}
+	uint8_t codeLengths[19] = {};
+	for (uint32_t i = 0; i < codeLengthCount; ++i) {
+		codeLengths[kCodeLengthOrder[i]] = static_cast<uint8_t>(reader.Read(3));
+	}
+	Huffman codeLength;
+	if (!codeLength.Build(codeLengths, 19)) {
+		return false;
+	}
+
+	const uint32_t total = literalCount + distanceCount;
+	uint32_t count = 0;
+	while (count < total) {
+		const int32_t symbol = codeLength.Decode(reader);
+		if (symbol < 0) {
+			return false;
+		}
+		if (symbol < 16) {
+			lengths[count++] = static_cast<uint8_t>(symbol);
+			continue;
+		}
+		// 16 は直前の長さ、17 と 18 は 0 の繰り返し
+		uint8_t value = 0;
+		uint32_t repeat = 0;
+		if (symbol == 16) {
+			if (count == 0) {
+				return false;
+			}
+			value = lengths[count - 1];
+			repeat = 3 + reader.Read(2);
+		} else if (symbol == 17) {
+			repeat = 3 + reader.Read(3);
+		} else {
+			repeat = 11 + reader.Read(7);
+		}
+		if (count + repeat > total) {
+			return false;
+		}
+		std::fill(lengths + count, lengths + count + repeat, value);
+		count += repeat;
+	}
+	// ブロックの終わりの符号がなければ壊れている
+	if (lengths[256] == 0) {
+		return false;
+	}
+	return literal.Build(lengths, literalCount) && distance.Build(lengths + literalCount, distanceCount);
+}
+
+uint32_t ReadBigEndian32(const uint8_t* data) { return uint32_t{data[0]} << 24 | uint32_t{data[1]} << 16 | uint32_t{data[2]} << 8 | data[3]; }
+
+uint8_t Paeth(uint8_t a, uint8_t b, uint8_t c) {
+	const int p = int{a} + b - c;
+	const int pa = std::abs(p - a);
+	const int pb = std::abs(p - b);
+	const int pc = std::abs(p - c);
+	if (pa <= pb && pa <= pc) {
+		return a;
+	}
+	return pb <= pc ? b : c;
+}
+
+bool Fail(std::string* error, const char* message) {
+	if (error) {
+		*error = message;
+	}
+	return false;
+}
+
+} // namespace
+
+bool PngDecoder::Inflate(const uint8_t* data, size_t size, std::vector<uint8_t>& out) {
+	// zlib のヘッダ（deflate・プリセット辞書なし）
+	if (size < 2 || (data[0] & 15) != 8 || (data[0] * 256 + data[1]) % 31 != 0 || (data[1] & 0x20) != 0) {
+		return false;
+	}
+	BitReader reader(data + 2, size - 2);
+	const size_t start = out.size();
+	Huffman literal;
+	Huffman distance;
+	bool last = false;
+	while (!last) {
+		last = reader.Read(1) != 0;
+		const uint32_t type = reader.Read(2);
+		if (type == 0) {
+			// 無圧縮
+			reader.AlignToByte();
+			const uint32_t length = reader.Read(16);
+			const uint32_t inverted = reader.Read(16);
+			if (length != (~inverted & 0xFFFF)) {
+				return false;
+			}
+			for (uint32_t i = 0; i < length; ++i) {
+				out.push_back(static_cast<uint8_t>(reader.Read(8)));
+			}
+			continue;
+		}
+		if (type == 3 || !ReadTables(reader, type, literal, distance)) {
+			return false;
+		}
+
+		for (;;) {
+			const int32_t symbol = literal.Decode(reader);
+			if (symbol < 0) {
+				return false;
+			}
+			if (symbol < 256) {
+				out.push_back(static_cast<uint8_t>(symbol));
+				continue;
+			}
+			if (symbol == 256) {
+				break;
+			}
+			// 長さと距離の組（前に出したバイト列の写し）
+			const uint32_t lengthCode = static_cast<uint32_t>(symbol) - 257;
+			if (lengthCode >= 29) {
+				return false;
+			}
+			const uint32_t length = kLengthBase[lengthCode] + reader.Read(kLengthExtra[lengthCode]);
+			const int32_t distanceCode = distance.Decode(reader);
+			if (distanceCode < 0 || distanceCode >= 30) {
+				return false;
+			}
+			const size_t back = kDistanceBase[distanceCode] + reader.Read(kDistanceExtra[distanceCode]);
+			if (back > out.size() - start) {
+				return false;
+			}
+			const size_t from = out.size() - back;
+			for (size_t i = 0; i < length; ++i) {
+				const uint8_t value = out[from + i];
+				out.push_back(value);
+			}
+		}
+	}
+	return !reader.Overrun();
+}
+
+bool PngDecoder::Load(const std::filesystem::path& path, Image& out, std::string* error) {
+	std::ifstream file(path, std::ios::binary);
+	if (!file.is_open()) {
+		return Fail(error, "cannot open");
+	}
+	const std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	return Decode(data.data(), data.size(), out, error);
+}
+
+bool PngDecoder::Decode(const uint8_t* data, size_t size, Image& out, std::string* error) {
+	static const uint8_t kSignature[8] = {137, 80, 78, 71, 13, 10, 26, 10};
+	if (size < 8 || std::memcmp(data, kSignature, 8) != 0) {
+		return Fail(error, "not a PNG");
+	}
+
+	// チャンクを集める
+	uint32_t width = 0;
+	uint32_t height = 0;
+	uint32_t depth = 0;
+	uint32_t colorType = 0;
+	bool interlaced = false;
+	std::vector<uint8_t> palette;       // RGB の並び
+	std::vector<uint8_t> paletteAlpha;  // tRNS（パレット）
+	uint32_t colorKey[3] = {};          // tRNS（グレー・RGB）
+	bool hasColorKey = false;
+	std::vector<uint8_t> compressed;
+	out.srgb = false;
+	size_t offset = 8;
+	bool ended = false;
+	while (!ended && offset + 12 <= size) {
+		const uint32_t length = ReadBigEndian32(data + offset);
+		const uint8_t* type = data + offset + 4;
+		const uint8_t* body = data + offset + 8;
+		if (length > size - offset - 12) {
+			return Fail(error, "truncated chunk");
+		}
+		if (std::memcmp(type, "IHDR", 4) == 0 && length >= 13) {
+			width = ReadBigEndian32(body);
+			height = ReadBigEndian32(body + 4);
+			depth = body[8];
+			colorType = body[9];
+			interlaced = body[12] != 0;
+		} else if (std::memcmp(type, "PLTE", 4) == 0) {
+			palette.assign(body, body + length);
+		} else if (std::memcmp(type, "tRNS", 4) == 0) {
+			if (colorType == 3) {
+				paletteAlpha.assign(body, body + length);
+			} else if (colorType == 0 && length >= 2) {
+				colorKey[0] = colorKey[1] = colorKey[2] = uint32_t{body[0]} << 8 | body[1];
+				hasColorKey = true;
+			} else if (colorType == 2 && length >= 6) {
+				for (int c = 0; c < 3; ++c) {
+					colorKey[c] = uint32_t{body[c * 2]} << 8 | body[c * 2 + 1];
+				}
+				hasColorKey = true;
+			}
+		} else if (std::memcmp(type, "sRGB", 4) == 0) {
+			out.srgb = true;
+		} else if (std::memcmp(type, "IDAT", 4) == 0) {
+			compressed.insert(compressed.end(), body, body + length);
+		} else if (std::memcmp(type, "IEND", 4) == 0) {
+			ended = true;
+		}
+		offset += size_t{length} + 12;
+	}
+
+	uint32_t channels = 0;
+	switch (colorType) {
+	case 0:
+	case 3:
+		channels = 1;
+		break;
+	case 2:
+		channels = 3;
+		break;
+	case 4:
+		channels = 2;
+		break;
+	case 6:
+		channels = 4;
+		break;
+	default:
+		return Fail(error, "unknown color type");
+	}
+	const bool validDepth = depth == 8 || (depth == 16 && colorType != 3) || ((depth == 1 || depth == 2 || depth == 4) && (colorType == 0 || colorType == 3));
+	if (width == 0 || height == 0 || !validDepth) {
+		return Fail(error, "invalid header");
+	}
+	if (interlaced) {
+		return Fail(error, "interlaced PNG is not supported");
+	}
+	if (colorType == 3 && palette.empty()) {
+		return Fail(error, "missing palette");
+	}
+
+	std::vector<uint8_t> raw;
+	const size_t rowBytes = (size_t{width} * channels * depth + 7) / 8;
+	raw.reserve((rowBytes + 1) * height);
+	if (!Inflate(compressed.data(), compressed.size(), raw) || raw.size() < (rowBytes + 1) * height) {
+		return Fail(error, "broken image data");
+	}
+
+	// 行ごとにフィルタを戻して RGBA8 に広げる
+	out.width = width;
+	out.height = height;
+	out.pixels.assign(size_t{width} * height * 4, 0);
+	const size_t pixelBytes = std::max<size_t>(1, channels * depth / 8);
+	std::vector<uint8_t> previous(rowBytes, 0);
+	for (uint32_t y = 0; y < height; ++y) {
+		uint8_t* row = raw.data() + y * (rowBytes + 1) + 1;
+		const uint8_t filter = row[-1];
+		for (size_t i = 0; i < rowBytes; ++i) {
+			const uint8_t left = i >= pixelBytes ? row[i - pixelBytes] : 0;
+			const uint8_t up = previous[i];
+			const uint8_t upLeft = i >= pixelBytes ? previous[i - pixelBytes] : 0;
+			switch (filter) {
+			case 0:
+				break;
+			case 1:
+				row[i] = static_cast<uint8_t>(row[i] + left);
+				break;
+			case 2:
+				row[i] = static_cast<uint8_t>(row[i] + up);
+				break;
+			case 3:
+				row[i] = static_cast<uint8_t>(row[i] + ((left + up) >> 1));
+				break;
+			case 4:
+				row[i] = static_cast<uint8_t>(row[i] + Paeth(left, up, upLeft));
+				break;
+			default:
+				return Fail(error, "unknown filter");
+			}
+		}
+		std::memcpy(previous.data(), row, rowBytes);
+
+		// 深さそのままの値を取り出す
+		auto sample = [&](uint32_t x, uint32_t channel) -> uint32_t {
+			if (depth == 8) {
+				return row[x * channels + channel];
+			}
+			if (depth == 16) {
+				const uint8_t* p = row + (size_t{x} * channels + channel) * 2;
+				return uint32_t{p[0]} << 8 | p[1];
+			}
+			const size_t bit = size_t{x} * depth;
+			return (row[bit / 8] >> (8 - depth - bit % 8)) & ((1u << depth) - 1);
+		};
+		// 8 ビットにそろえる
+		auto to8 = [&](uint32_t value) -> uint8_t {
+			if (depth == 16) {
+				return static_cast<uint8_t>(value >> 8);
+			}
+			return static_cast<uint8_t>(depth == 8 ? value : value * 255 / ((1u << depth) - 1));
+		};
+
+		uint8_t* destination = out.pixels.data() + size_t{y} * width * 4;
+		for (uint32_t x = 0; x < width; ++x) {
+			uint8_t* pixel = destination + size_t{x} * 4;
+			switch (colorType) {
+			case 0: {
+				const uint32_t value = sample(x, 0);
+				pixel[0] = pixel[1] = pixel[2] = to8(value);
+				pixel[3] = hasColorKey && value == colorKey[0] ? 0 : 255;
+				break;
+			}
+			case 2: {
+				const uint32_t r = sample(x, 0);
+				const uint32_t g = sample(x, 1);
+				const uint32_t b = sample(x, 2);
+				pixel[0] = to8(r);
+				pixel[1] = to8(g);
+				pixel[2] = to8(b);
+				pixel[3] = hasColorKey && r == colorKey[0] && g == colorKey[1] && b == colorKey[2] ? 0 : 255;
+				break;
+			}
+			case 3: {
+				const uint32_t index = sample(x, 0);
+				if (size_t{index} * 3 + 3 > palette.size()) {
+					return Fail(error, "palette index out of range");
+				}
+				std::memcpy(pixel, palette.data() + size_t{index} * 3, 3);
+				pixel[3] = index < paletteAlpha.size() ? paletteAlpha[index] : 255;
+				break;
+			}
+			case 4:
+				pixel[0] = pixel[1] = pixel[2] = to8(sample(x, 0));
+				pixel[3] = to8(sample(x, 1));
+				break;
+			default:
+				for (uint32_t c = 0; c < 4; ++c) {
+					pixel[c] = to8(sample(x, c));
+				}
+				break;
+			}
+		}
+	}
+	return true;
+}
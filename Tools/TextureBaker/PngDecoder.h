@@ -0,0 +1,26 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// 8 ビット RGBA の画像
+struct Image {
+	uint32_t width = 0;
+	uint32_t height = 0;
+	std::vector<uint8_t> pixels; // width * height * 4（左上から行ごと）
+	bool srgb = false;           // sRGB チャンクがあったか（WIC と同じく、あれば *_SRGB 形式で読まれる）
+};
+
+// PNG の読み込み
+// 色の種類はすべて（グレー・RGB・パレット・アルファ付き）、ビット深度は 1〜16 に対応し、RGBA8 に展開する（16 ビットは上位8ビット）。
+// インターレースには対応しない。CRC と Adler-32 は確かめない。
+class PngDecoder {
+public:
+	static bool Load(const std::filesystem::path& path, Image& out, std::string* error = nullptr);
+	static bool Decode(const uint8_t* data, size_t size, Image& out, std::string* error = nullptr);
+
+	// zlib ストリームを展開して out の後ろに足す（RFC 1950 / 1951）
+	static bool Inflate(const uint8_t* data, size_t size, std::vector<uint8_t>& out);
+};
@@ -0,0 +1,252 @@
+// テクスチャの事前変換ツール
+// Resources の下の .png をすべて PngDecoder で読み、MipChain で sRGB を考えたミップマップを作り、BlockCompressor で圧縮して同じ場所に .dds を書き出す。
+// 形式は既定（auto）で、アルファのない画像は BC1、ある画像は BC7 にする。辺が 4 の倍数でない画像は圧縮できないので RGBA8 のまま書く。
+// PNG に sRGB チャンクがあれば *_SRGB 形式にする（エンジンが WIC で PNG を読んだときと同じ形式になる）。
+// テクスチャごとに圧縮の時間と速さ（全段の画素数 / 時間）、mip0 を戻したときの PSNR、ファイルとメモリの大きさを表示する。
+//
+// 使い方: TextureBaker <Resourcesディレクトリ> [--format auto|bc1|bc3|bc7|rgba8] [--threads N]
+#include "BlockCompressor.h"
+#include "DdsWriter.h"
+#include "MipChain.h"
+#include "Parallel.h"
+#include "PngDecoder.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double ElapsedMs(Clock::time_point start) { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); }
+
+// 画像の (x, y) から 4x4 のブロックを取り出す（はみ出す分は端の画素をくり返す）
+void LoadBlock(const Image& image, uint32_t blockX, uint32_t blockY, uint8_t* block) {
+	for (uint32_t y = 0; y < 4; ++y) {
+		const uint32_t sourceY = std::min(blockY * 4 + y, image.height - 1);
+		for (uint32_t x = 0; x < 4; ++x) {
+			const uint32_t sourceX = std::min(blockX * 4 + x, image.width - 1);
+			std::memcpy(block + (y * 4 + x) * 4, image.pixels.data() + (size_t{sourceY} * image.width + sourceX) * 4, 4);
+		}
+	}
+}
+
+size_t GetBlockSize(TextureFormat format) { return format == TextureFormat::BC1 ? sizeof(BC1Block) : sizeof(BC3Block); }
+
+// 1 段を圧縮する（ブロックの行をスレッドで分ける）
+std::vector<uint8_t> EncodeLevel(const Image& image, TextureFormat format, uint32_t threadCount) {
+	if (format == TextureFormat::RGBA8) {
+		return image.pixels;
+	}
+	const uint32_t blocksX = (image.width + 3) / 4;
+	const uint32_t blocksY = (image.height + 3) / 4;
+	const size_t blockSize = GetBlockSize(format);
+	std::vector<uint8_t> out(size_t{blocksX} * blocksY * blockSize);
+	ParallelFor(blocksY, threadCount, [&](size_t blockY) {
+		uint8_t block[64];
+		for (uint32_t blockX = 0; blockX < blocksX; ++blockX) {
+			LoadBlock(image, blockX, static_cast<uint32_t>(blockY), block);
+			uint8_t* destination = out.data() + (blockY * blocksX + blockX) * blockSize;
+			switch (format) {
+			case TextureFormat::BC1:
+				BlockCompressor::EncodeBC1(block, *reinterpret_cast<BC1Block*>(destination));
+				break;
+			case TextureFormat::BC3:
+				BlockCompressor::EncodeBC3(block, *reinterpret_cast<BC3Block*>(destination));
+				break;
+			default:
+				BlockCompressor::EncodeBC7(block, *reinterpret_cast<BC7Block*>(destination));
+				break;
+			}
+		}
+	});
+	return out;
+}
+
+// 圧縮した mip0 を戻して元の画像と比べた PSNR[dB]（RGB とアルファ。差がなければ無限大）
+void MeasurePsnr(const Image& image, TextureFormat format, const std::vector<uint8_t>& encoded, double& psnrRgb, double& psnrAlpha) {
+	double errorRgb = 0.0;
+	double errorAlpha = 0.0;
+	if (format != TextureFormat::RGBA8) {
+		const uint32_t blocksX = (image.width + 3) / 4;
+		const uint32_t blocksY = (image.height + 3) / 4;
+		const size_t blockSize = GetBlockSize(format);
+		for (uint32_t blockY = 0; blockY < blocksY; ++blockY) {
+			for (uint32_t blockX = 0; blockX < blocksX; ++blockX) {
+				uint8_t original[64];
+				uint8_t decoded[64];
+				LoadBlock(image, blockX, blockY, original);
+				const uint8_t* source = encoded.data() + (size_t{blockY} * blocksX + blockX) * blockSize;
+				switch (format) {
+				case TextureFormat::BC1:
+					BlockCompressor::DecodeBC1(*reinterpret_cast<const BC1Block*>(source), decoded);
+					break;
+				case TextureFormat::BC3:
+					BlockCompressor::DecodeBC3(*reinterpret_cast<const BC3Block*>(source), decoded);
+					break;
+				default:
+					BlockCompressor::DecodeBC7(*reinterpret_cast<const BC7Block*>(source), decoded);
+					break;
+				}
+				// 画像の外にはみ出した画素は数えない
+				for (uint32_t i = 0; i < 16; ++i) {
+					if (blockX * 4 + i % 4 >= image.width || blockY * 4 + i / 4 >= image.height) {
+						continue;
+					}
+					for (uint32_t c = 0; c < 4; ++c) {
+						const double d = static_cast<double>(original[i * 4 + c]) - decoded[i * 4 + c];
+						(c < 3 ? errorRgb : errorAlpha) += d * d;
+					}
+				}
+			}
+		}
+	}
+	const double pixelCount = static_cast<double>(image.width) * image.height;
+	auto toPsnr = [](double meanSquaredError) { return meanSquaredError > 0.0 ? 10.0 * std::log10(255.0 * 255.0 / meanSquaredError) : INFINITY; };
+	psnrRgb = toPsnr(errorRgb / (pixelCount * 3.0));
+	psnrAlpha = toPsnr(errorAlpha / pixelCount);
+}
+
+const char* GetFormatName(TextureFormat format) {
+	switch (format) {
+	case TextureFormat::BC1:
+		return "BC1";
+	case TextureFormat::BC3:
+		return "BC3";
+	case TextureFormat::BC7:
+		return "BC7";
+	default:
+		return "RGBA8";
+	}
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	if (argc < 2) {
+		std::fprintf(stderr, "usage: %s <Resources directory> [--format auto|bc1|bc3|bc7|rgba8] [--threads N]\n", argv[0]);
+		return 1;
+	}
+	const std::filesystem::path resourceDirectory = argv[1];
+	bool autoFormat = true;
+	TextureFormat requestedFormat = TextureFormat::BC7;
+	uint32_t threadCount = std::max(1u, std::thread::hardware_concurrency());
+	for (int i = 2; i < argc; ++i) {
+		if (std::strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+			const char* name = argv[++i];
+			autoFormat = std::strcmp(name, "auto") == 0;
+			if (std::strcmp(name, "bc1") == 0) {
+				requestedFormat = TextureFormat::BC1;
+			} else if (std::strcmp(name, "bc3") == 0) {
+				requestedFormat = TextureFormat::BC3;
+			} else if (std::strcmp(name, "bc7") == 0) {
+				requestedFormat = TextureFormat::BC7;
+			} else if (std::strcmp(name, "rgba8") == 0) {
+				requestedFormat = TextureFormat::RGBA8;
+			} else if (!autoFormat) {
+				std::fprintf(stderr, "unknown format %s\n", name);
+				return 1;
+			}
+		} else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+			threadCount = static_cast<uint32_t>(std::max(1, std::atoi(argv[++i])));
+		}
+	}
+
+	// Resources の下の .png を名前順に集める
+	std::vector<std::filesystem::path> pngPaths;
+	std::error_code error;
+	for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator(resourceDirectory, error)) {
+		if (entry.is_regular_file() && entry.path().extension() == ".png") {
+			pngPaths.push_back(entry.path());
+		}
+	}
+	std::sort(pngPaths.begin(), pngPaths.end());
+	if (pngPaths.empty()) {
+		std::fprintf(stderr, "no textures under %s\n", resourceDirectory.string().c_str());
+		return 1;
+	}
+
+	std::printf("threads: %u\n", threadCount);
+	std::printf("%-26s %11s %-10s %4s %8s %9s %8s %8s %8s %10s %10s %10s\n", "texture", "size", "format", "mips", "mip ms", "encode ms", "MPix/s", "PSNR rgb", "PSNR a", "png KB", "dds KB", "rgba8 KB");
+	int failures = 0;
+	uintmax_t totalPng = 0;
+	uintmax_t totalDds = 0;
+	uintmax_t totalRgba = 0;
+	double totalEncodeMs = 0.0;
+	double totalMegaPixels = 0.0;
+	for (const std::filesystem::path& pngPath : pngPaths) {
+		const std::string name = std::filesystem::relative(pngPath, resourceDirectory).generic_string();
+		Image image;
+		std::string message;
+		if (!PngDecoder::Load(pngPath, image, &message)) {
+			std::fprintf(stderr, "%s: %s\n", name.c_str(), message.c_str());
+			++failures;
+			continue;
+		}
+
+		TextureFormat format = requestedFormat;
+		if (autoFormat) {
+			bool opaque = true;
+			for (size_t i = 3; i < image.pixels.size() && opaque; i += 4) {
+				opaque = image.pixels[i] == 255;
+			}
+			format = opaque ? TextureFormat::BC1 : TextureFormat::BC7;
+		}
+		// BC は mip0 の辺が 4 の倍数でないと作れない
+		if (format != TextureFormat::RGBA8 && (image.width % 4 != 0 || image.height % 4 != 0)) {
+			format = TextureFormat::RGBA8;
+		}
+
+		Clock::time_point start = Clock::now();
+		const std::vector<Image> mips = MipChain::Build(image, threadCount);
+		const double mipMs = ElapsedMs(start);
+
+		start = Clock::now();
+		std::vector<std::vector<uint8_t>> levels;
+		levels.reserve(mips.size());
+		double megaPixels = 0.0;
+		for (const Image& mip : mips) {
+			levels.push_back(EncodeLevel(mip, format, threadCount));
+			megaPixels += static_cast<double>(mip.width) * mip.height / 1e6;
+		}
+		const double encodeMs = ElapsedMs(start);
+
+		double psnrRgb = 0.0;
+		double psnrAlpha = 0.0;
+		MeasurePsnr(image, format, levels[0], psnrRgb, psnrAlpha);
+
+		std::filesystem::path ddsPath = pngPath;
+		ddsPath.replace_extension(".dds");
+		if (!DdsWriter::Write(ddsPath, format, image.srgb, image.width, image.height, levels)) {
+			std::fprintf(stderr, "%s: cannot write %s\n", name.c_str(), ddsPath.string().c_str());
+			++failures;
+			continue;
+		}
+
+		const uintmax_t pngBytes = std::filesystem::file_size(pngPath, error);
+		const uintmax_t ddsBytes = std::filesystem::file_size(ddsPath, error);
+		const uintmax_t rgbaBytes = uintmax_t{image.width} * image.height * 4;
+		const std::string size = std::to_string(image.width) + "x" + std::to_string(image.height);
+		const std::string formatName = std::string(GetFormatName(format)) + (image.srgb ? "_SRGB" : "");
+		std::printf(
+		    "%-26s %11s %-10s %4zu %8.2f %9.2f %8.1f %8.2f %8.2f %10.1f %10.1f %10.1f\n", name.c_str(), size.c_str(), formatName.c_str(), mips.size(), mipMs, encodeMs, megaPixels / (encodeMs / 1000.0),
+		    psnrRgb, psnrAlpha, pngBytes / 1024.0, ddsBytes / 1024.0, rgbaBytes / 1024.0);
+		totalPng += pngBytes;
+		totalDds += ddsBytes;
+		totalRgba += rgbaBytes;
+		totalEncodeMs += encodeMs;
+		totalMegaPixels += megaPixels;
+	}
+
+	// rgba8 は今の読み込み（PNG をミップなしの RGBA8 に展開）で使うメモリ。dds はミップ込みでそのまま GPU に載る
+	std::printf(
+	    "total: png %.1f KB, dds %.1f KB (GPU memory %.1f%% of rgba8 %.1f KB), encode %.1f ms (%.1f MPix/s)\n", totalPng / 1024.0, totalDds / 1024.0, totalRgba ? 100.0 * totalDds / totalRgba : 0.0,
+	    totalRgba / 1024.0, totalEncodeMs, totalEncodeMs > 0.0 ? totalMegaPixels / (totalEncodeMs / 1000.0) : 0.0);
+	return failures == 0 ? 0 : 1;
+}